@@ -21,6 +21,8 @@
 #include "oscl_media_data.h"
 #include "oscl_mem.h"
 
+class OsclRefCounterMemFrag;
+
 #define MAX_NUM_FRAGMENTS  10
 const uint32 MAX_GAU_BUNDLE = 40;
 
@@ -73,6 +75,15 @@ struct GAU
     MediaMetaInfo    info[MAX_GAU_BUNDLE];
     bool free_buffer_states_when_done;
     uint64 SampleOffset;
+
+    //Optional zero-copy output.  The caller sets mappedFrags to an array of
+    //MAX_GAU_BUNDLE fragments.  If the source file is memory-mapped, the
+    //parser returns sample i as a read-only fragment of the mapping in
+    //mappedFrags[i], leaves buf untouched and sets numMappedFrags to the
+    //number of samples.  Otherwise numMappedFrags is 0 and the samples are
+    //copied into buf as usual.
+    OsclRefCounterMemFrag* mappedFrags;
+    uint32 numMappedFrags;
     OSCL_IMPORT_REF uint32  getSamplesTotalSize(uint32 number, MediaMetaInfo *metaInfo);  //return the sum of total sample size
 
     OSCL_IMPORT_REF GAU();
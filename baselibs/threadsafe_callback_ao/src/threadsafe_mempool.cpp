@@ -17,6 +17,45 @@
  */
 #include "threadsafe_mempool.h"
 
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+// chunk owner value for chunks allocated without a thread cache
+#define THREADSAFE_MEMPOOL_NO_OWNER 0xFF
+
+// free chunks are linked through their first word
+static inline OsclAny*& NextChunk(OsclAny* aChunk)
+{
+    return *((OsclAny**)aChunk);
+}
+
+// claim and release the free list of a thread cache
+static inline void ClaimCache(ThreadSafeMemPoolThreadCache& aCache)
+{
+    while (!OsclAtomicCompareAndSwap(&aCache.iBusy, 0, 1))
+    {
+        ;
+    }
+}
+
+static inline void ReleaseCache(ThreadSafeMemPoolThreadCache& aCache)
+{
+    OsclAtomicMemoryBarrier();
+    aCache.iBusy = 0;
+}
+
+// take the whole return list of a thread cache. Taking the whole
+// list at once is safe from ABA, since no link is read before.
+static inline OsclAny* TakeReturnList(ThreadSafeMemPoolThreadCache& aCache)
+{
+    OsclAny* head;
+    do
+    {
+        head = aCache.iReturnHead;
+    }
+    while (head != NULL && !OsclAtomicCompareAndSwap(&aCache.iReturnHead, head, (OsclAny*)NULL));
+    return head;
+}
+#endif
+
 OSCL_EXPORT_REF ThreadSafeMemPoolFixedChunkAllocator *ThreadSafeMemPoolFixedChunkAllocator::Create(const uint32 numchunk, const uint32 chunksize, Oscl_DefAlloc *gen_alloc)
 {
 
@@ -63,6 +102,12 @@ OSCL_EXPORT_REF ThreadSafeMemPoolFixedChunkAllocator::ThreadSafeMemPoolFixedChun
         iNextAvailableContextData(NULL),
         iRefCount(1)
 {
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+    oscl_memset(iThreadCache, 0, sizeof(iThreadCache));
+    iNumThreadCaches = 0;
+    iChunkOwner = NULL;
+#endif
+
     iNumChunk = numchunk;
     iChunkSize = chunksize;
 
@@ -84,7 +129,12 @@ OSCL_EXPORT_REF ThreadSafeMemPoolFixedChunkAllocator::ThreadSafeMemPoolFixedChun
 OSCL_EXPORT_REF void ThreadSafeMemPoolFixedChunkAllocator::addRef_internal()
 {
     // Just increment the ref count
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+    // the thread cache updates the count without the mutex
+    OsclAtomicAdd(&iRefCount, 1);
+#else
     ++iRefCount;
+#endif
 }
 
 // could be called externally
@@ -96,19 +146,23 @@ OSCL_EXPORT_REF void ThreadSafeMemPoolFixedChunkAllocator::addRef()
     iMemPoolMutex.Unlock();
 }
 
-OSCL_EXPORT_REF void ThreadSafeMemPoolFixedChunkAllocator::removeRef_internal()
+OSCL_EXPORT_REF int32 ThreadSafeMemPoolFixedChunkAllocator::removeRef_internal()
 {
-    --iRefCount;
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+    return OsclAtomicAdd(&iRefCount, -1);
+#else
+    return --iRefCount;
+#endif
 }
 
 OSCL_EXPORT_REF void ThreadSafeMemPoolFixedChunkAllocator::removeRef()
 {
     // Decrement the ref count
     iMemPoolMutex.Lock();
-    removeRef_internal();
+    int32 refcount = removeRef_internal();
 
     // If ref count reaches 0 then destroy this object automatically
-    if (iRefCount <= 0)
+    if (refcount <= 0)
     {
         iMemPoolMutex.Unlock();
         //OSCL_DELETE(this);
@@ -137,6 +191,24 @@ OSCL_EXPORT_REF ThreadSafeMemPoolFixedChunkAllocator::~ThreadSafeMemPoolFixedChu
 
 OSCL_EXPORT_REF OsclAny* ThreadSafeMemPoolFixedChunkAllocator::allocate(const uint32 n)
 {
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+    // Once the pool is created, use the free list of the calling thread
+    if (iChunkOwner && n <= iChunkSize)
+    {
+        int32 cache = getthreadcache();
+        if (cache >= 0)
+        {
+            OsclAny* freechunk = allocatecached(cache);
+            if (freechunk)
+            {
+                iChunkOwner[((uint8*)freechunk - (uint8*)iMemPool) / iChunkSizeMemAligned] = (uint8)cache;
+                addRef_internal();
+            }
+            return freechunk;
+        }
+    }
+#endif
+
     // Create the memory pool if it hasn't been created yet.
     // Use the allocation size, n, as the chunk size for memory pool
     iMemPoolMutex.Lock();
@@ -144,15 +216,31 @@ OSCL_EXPORT_REF OsclAny* ThreadSafeMemPoolFixedChunkAllocator::allocate(const ui
     if (iChunkSize == 0)
     {
         iChunkSize = n;
-        createmempool();
+        int32 leavecode = 0;
+        OSCL_TRY(leavecode, createmempool());
+        if (leavecode)
+        {
+            iChunkSize = 0;
+            iMemPoolMutex.Unlock();
+            OSCL_LEAVE(leavecode);
+        }
     }
     else if (n > iChunkSize)
     {
+        iMemPoolMutex.Unlock();
         OSCL_LEAVE(OsclErrArgument);
 
     }
 
 
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+    if (iFreeMemChunkList.empty() && iChunkOwner)
+    {
+        // Take back the free chunks the thread caches hold
+        reclaimthreadcaches();
+    }
+#endif
+
     if (iFreeMemChunkList.empty())
     {
         // No free chunk is available
@@ -165,6 +253,10 @@ OSCL_EXPORT_REF OsclAny* ThreadSafeMemPoolFixedChunkAllocator::allocate(const ui
     OsclAny* freechunk = iFreeMemChunkList.back();
     // Remove the chunk from the free list
     iFreeMemChunkList.pop_back();
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+    // Return it to the shared free list when it is freed
+    iChunkOwner[((uint8*)freechunk - (uint8*)iMemPool) / iChunkSizeMemAligned] = THREADSAFE_MEMPOOL_NO_OWNER;
+#endif
     addRef_internal();
     iMemPoolMutex.Unlock();
 
@@ -196,15 +288,28 @@ OSCL_EXPORT_REF void ThreadSafeMemPoolFixedChunkAllocator::deallocate(OsclAny* p
     }
 
 
-    iMemPoolMutex.Lock();
-    // Put the returned chunk in the free pool
-    iFreeMemChunkList.push_back(p);
+    int32 refcount;
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+    uint32 owner = iChunkOwner[(ptmp - mptmp) / iChunkSizeMemAligned];
+    if (owner != THREADSAFE_MEMPOOL_NO_OWNER)
+    {
+        // Give the chunk back to the thread that allocated it, no lock needed
+        returnchunk(owner, p);
+        refcount = removeRef_internal();
+    }
+    else
+#endif
+    {
+        iMemPoolMutex.Lock();
+        // Put the returned chunk in the free pool
+        iFreeMemChunkList.push_back(p);
 
-    removeRef_internal();
+        refcount = removeRef_internal();
+        iMemPoolMutex.Unlock();
+    }
 
-    if (iRefCount > 0)
+    if (refcount > 0)
     {
-        iMemPoolMutex.Unlock();
         // Notify the observer about free chunk available if waiting for such callback
         if (iCheckNextAvailableFreeChunk)
         {
@@ -217,8 +322,6 @@ OSCL_EXPORT_REF void ThreadSafeMemPoolFixedChunkAllocator::deallocate(OsclAny* p
     }
     else
     {
-
-        iMemPoolMutex.Unlock();
         // when the mempool is about to be destroyed, no need to
         // notify the observer. By this time, the observer should not
         // be expecting it
@@ -251,14 +354,26 @@ OSCL_EXPORT_REF void ThreadSafeMemPoolFixedChunkAllocator::createmempool()
 
     // Create one block of memory for the memory pool
     iChunkSizeMemAligned = oscl_mem_aligned_size(iChunkSize);
+    uint32 poolsize = iNumChunk * iChunkSizeMemAligned;
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+    // One byte per chunk for the chunk owner after the chunks.
+    // Free chunks are linked through their first word, so make
+    // room for a pointer.
+    if (iChunkSizeMemAligned < sizeof(OsclAny*))
+    {
+        iChunkSizeMemAligned = oscl_mem_aligned_size(sizeof(OsclAny*));
+        poolsize = iNumChunk * iChunkSizeMemAligned;
+    }
+    poolsize += iNumChunk;
+#endif
     int32 leavecode = 0;
     if (iMemPoolAllocator)
     {
-        OSCL_TRY(leavecode, iMemPool = iMemPoolAllocator->ALLOCATE(iNumChunk * iChunkSizeMemAligned));
+        OSCL_TRY(leavecode, iMemPool = iMemPoolAllocator->ALLOCATE(poolsize));
     }
     else
     {
-        OSCL_TRY(leavecode, iMemPool = OSCL_MALLOC(iNumChunk * iChunkSizeMemAligned));
+        OSCL_TRY(leavecode, iMemPool = OSCL_MALLOC(poolsize));
     }
 
     if (leavecode || iMemPool == NULL)
@@ -279,6 +394,14 @@ OSCL_EXPORT_REF void ThreadSafeMemPoolFixedChunkAllocator::createmempool()
         iFreeMemChunkList.push_back((OsclAny*)chunkptr);
         chunkptr += iChunkSizeMemAligned;
     }
+
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+    // Setting iChunkOwner enables the thread caches in allocate(),
+    // so do it last.
+    oscl_memset(chunkptr, THREADSAFE_MEMPOOL_NO_OWNER, iNumChunk);
+    OsclAtomicMemoryBarrier();
+    iChunkOwner = chunkptr;
+#endif
 }
 
 
@@ -289,7 +412,23 @@ OSCL_EXPORT_REF void ThreadSafeMemPoolFixedChunkAllocator::destroymempool()
     {
 #if OSCL_MEM_CHECK_ALL_MEMPOOL_CHUNKS_ARE_RETURNED
         // Assert if all of the chunks were not returned
-        OSCL_ASSERT(iFreeMemChunkList.size() == iNumChunk);
+        uint32 numfree = iFreeMemChunkList.size();
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+        for (int32 i = 0; i < iNumThreadCaches; i++)
+        {
+            OsclAny* chunk;
+            for (chunk = iThreadCache[i].iFreeHead; chunk; chunk = NextChunk(chunk))
+                numfree++;
+            for (chunk = iThreadCache[i].iReturnHead; chunk; chunk = NextChunk(chunk))
+                numfree++;
+        }
+#endif
+        OSCL_ASSERT(numfree == iNumChunk);
+#endif
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+        iChunkOwner = NULL;
+        oscl_memset(iThreadCache, 0, sizeof(iThreadCache));
+        iNumThreadCaches = 0;
 #endif
 
         iFreeMemChunkList.clear();
@@ -309,3 +448,163 @@ OSCL_EXPORT_REF void ThreadSafeMemPoolFixedChunkAllocator::destroymempool()
         }
     }
 }
+
+OSCL_EXPORT_REF void ThreadSafeMemPoolFixedChunkAllocator::getthreadcachestats(uint32& aHits, uint32& aMisses)
+{
+    aHits = 0;
+    aMisses = 0;
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+    // The counts are updated by their own threads, so they may be a little behind.
+    for (int32 i = 0; i < iNumThreadCaches; i++)
+    {
+        aHits += iThreadCache[i].iHits;
+        aMisses += iThreadCache[i].iMisses;
+    }
+#endif
+}
+
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+int32 ThreadSafeMemPoolFixedChunkAllocator::getthreadcache()
+{
+    // Find the cache of the calling thread, or take the next unused one.
+    // Returns -1 if all caches are taken.
+    TOsclThreadId threadid;
+    if (OsclThread::GetId(threadid) != OsclProcStatus::SUCCESS_ERROR)
+    {
+        return -1;
+    }
+
+    int32 numcaches = iNumThreadCaches;
+    for (int32 i = 0; i < numcaches; i++)
+    {
+        if (iThreadCache[i].iValid && OsclThread::CompareId(threadid, iThreadCache[i].iThreadId))
+        {
+            return i;
+        }
+    }
+
+    int32 cache;
+    do
+    {
+        cache = iNumThreadCaches;
+        if (cache >= THREADSAFE_MEMPOOL_MAX_THREADS)
+        {
+            return -1;
+        }
+    }
+    while (!OsclAtomicCompareAndSwap(&iNumThreadCaches, cache, cache + 1));
+
+    iThreadCache[cache].iThreadId = threadid;
+    OsclAtomicMemoryBarrier();
+    iThreadCache[cache].iValid = 1;
+    return cache;
+}
+
+OsclAny* ThreadSafeMemPoolFixedChunkAllocator::allocatecached(int32 aCache)
+{
+    // Called only by the thread that owns the cache
+    ThreadSafeMemPoolThreadCache& cache = iThreadCache[aCache];
+
+    ClaimCache(cache);
+    if (cache.iFreeHead == NULL)
+    {
+        // Take all chunks the other threads have returned
+        cache.iFreeHead = TakeReturnList(cache);
+    }
+    if (cache.iFreeHead != NULL)
+    {
+        cache.iHits++;
+        OsclAny* freechunk = cache.iFreeHead;
+        cache.iFreeHead = NextChunk(freechunk);
+        ReleaseCache(cache);
+        return freechunk;
+    }
+    ReleaseCache(cache);
+
+    cache.iMisses++;
+
+    // Move a few chunks from the shared free list
+    OsclAny* refill = NULL;
+    iMemPoolMutex.Lock();
+    if (iFreeMemChunkList.empty())
+    {
+        // Take back the free chunks the other threads hold
+        reclaimthreadcaches();
+    }
+    for (uint32 i = 0; i < THREADSAFE_MEMPOOL_REFILL_COUNT && !iFreeMemChunkList.empty(); i++)
+    {
+        OsclAny* chunk = iFreeMemChunkList.back();
+        iFreeMemChunkList.pop_back();
+        NextChunk(chunk) = refill;
+        refill = chunk;
+    }
+    iMemPoolMutex.Unlock();
+
+    if (refill == NULL)
+    {
+        // No free chunk is available
+        return NULL;
+    }
+
+    // Keep the rest on the own free list
+    OsclAny* freechunk = refill;
+    refill = NextChunk(freechunk);
+    if (refill != NULL)
+    {
+        ClaimCache(cache);
+        OsclAny* last = refill;
+        while (NextChunk(last) != NULL)
+        {
+            last = NextChunk(last);
+        }
+        NextChunk(last) = cache.iFreeHead;
+        cache.iFreeHead = refill;
+        ReleaseCache(cache);
+    }
+    return freechunk;
+}
+
+void ThreadSafeMemPoolFixedChunkAllocator::reclaimthreadcaches()
+{
+    // Called with the mutex held, when the shared free list is empty.
+    // Move the free chunks of every thread cache to the shared free list.
+    // A chunk still goes back to the cache of the thread that allocated it
+    // when it is freed, so this only happens when the pool runs short.
+    for (int32 i = 0; i < iNumThreadCaches; i++)
+    {
+        ThreadSafeMemPoolThreadCache& cache = iThreadCache[i];
+        OsclAny* chunk = TakeReturnList(cache);
+        while (chunk != NULL)
+        {
+            OsclAny* next = NextChunk(chunk);
+            iFreeMemChunkList.push_back(chunk);
+            chunk = next;
+        }
+
+        // The owner only claims its free list for a few instructions
+        ClaimCache(cache);
+        chunk = cache.iFreeHead;
+        cache.iFreeHead = NULL;
+        ReleaseCache(cache);
+        while (chunk != NULL)
+        {
+            OsclAny* next = NextChunk(chunk);
+            iFreeMemChunkList.push_back(chunk);
+            chunk = next;
+        }
+    }
+}
+
+void ThreadSafeMemPoolFixedChunkAllocator::returnchunk(uint32 aCache, OsclAny* aChunk)
+{
+    // May be called by any thread, push the chunk on the return list
+    ThreadSafeMemPoolThreadCache& cache = iThreadCache[aCache];
+    OsclAny* head;
+    do
+    {
+        head = cache.iReturnHead;
+        NextChunk(aChunk) = head;
+    }
+    while (!OsclAtomicCompareAndSwap(&cache.iReturnHead, head, aChunk));
+}
+#endif
@@ -27,6 +27,54 @@
 #include "oscl_mutex.h"
 #endif
 
+// Set THREADSAFE_MEMPOOL_THREAD_CACHE to 1 to give each thread that allocates
+// from the pool its own free list. A chunk is returned to the free list of the
+// thread that allocated it through a lock-free stack, so a chunk allocated in
+// one thread and freed in another takes no lock. The shared free list and its
+// mutex are only used when the thread's own list is empty. Before an allocation
+// fails, the free chunks held by the other threads are moved back to the shared
+// free list.
+// Requires thread and atomic support, and is forced to 0 otherwise.
+#ifndef THREADSAFE_MEMPOOL_THREAD_CACHE
+#define THREADSAFE_MEMPOOL_THREAD_CACHE 1
+#endif
+#if !(OSCL_HAS_THREAD_SUPPORT) || !(OSCL_HAS_ATOMIC_SUPPORT)
+#undef THREADSAFE_MEMPOOL_THREAD_CACHE
+#define THREADSAFE_MEMPOOL_THREAD_CACHE 0
+#endif
+
+// Max number of threads with their own free list, threads beyond this use the
+// shared free list.
+#ifndef THREADSAFE_MEMPOOL_MAX_THREADS
+#define THREADSAFE_MEMPOOL_MAX_THREADS 8
+#endif
+
+// Max number of chunks a thread moves from the shared free list to its own
+// free list at once. Chunks on a thread's own free list can only be allocated
+// by that thread, so keep this small.
+#ifndef THREADSAFE_MEMPOOL_REFILL_COUNT
+#define THREADSAFE_MEMPOOL_REFILL_COUNT 4
+#endif
+
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+#ifndef OSCL_THREAD_H_INCLUDED
+#include "oscl_thread.h"
+#endif
+
+// Free chunks of one thread. Free chunks are linked through their first word.
+class ThreadSafeMemPoolThreadCache
+{
+    public:
+        volatile int32 iValid; // set once iThreadId is written
+        TOsclThreadId iThreadId;
+        volatile int32 iBusy; // set while a thread uses iFreeHead, never held across a lock
+        OsclAny* iFreeHead; // chunks to allocate, used by the owning thread or by a reclaim
+        OsclAny* volatile iReturnHead; // chunks freed by any thread, lock-free stack
+        uint32 iHits; // allocate() calls served without the mutex
+        uint32 iMisses; // allocate() calls that used the shared free list
+};
+#endif
+
 class ThreadSafeMemPoolFixedChunkAllocator: public OsclMemPoolFixedChunkAllocator
 {
     public:
@@ -94,6 +142,16 @@ class ThreadSafeMemPoolFixedChunkAllocator: public OsclMemPoolFixedChunkAllocato
           */
         OSCL_IMPORT_REF void removeRef();
 
+        /** Returns the number of allocate() calls served from the free list of
+          * the calling thread (hits) and the number that had to use the shared
+          * free list (misses), summed over all threads. Both are 0 when the
+          * thread cache is not built.
+          *
+          * @return void
+          *
+          */
+        OSCL_IMPORT_REF void getthreadcachestats(uint32& aHits, uint32& aMisses);
+
     protected:
         OSCL_IMPORT_REF ThreadSafeMemPoolFixedChunkAllocator(const uint32 numchunk = 1, const uint32 chunksize = 0, Oscl_DefAlloc* gen_alloc = NULL);
 
@@ -107,7 +165,8 @@ class ThreadSafeMemPoolFixedChunkAllocator: public OsclMemPoolFixedChunkAllocato
         OSCL_IMPORT_REF virtual void destroymempool();
 
         OSCL_IMPORT_REF void addRef_internal();
-        OSCL_IMPORT_REF void removeRef_internal();
+        // returns the new reference count
+        OSCL_IMPORT_REF int32 removeRef_internal();
 
         uint32 iNumChunk;
         uint32 iChunkSize;
@@ -126,8 +185,21 @@ class ThreadSafeMemPoolFixedChunkAllocator: public OsclMemPoolFixedChunkAllocato
         OsclMemPoolFixedChunkAllocatorObserver* iObserver;
         OsclAny* iNextAvailableContextData;
 
-        int32 iRefCount;
+        // updated with atomic operations when the thread cache is built
+        volatile int32 iRefCount;
 
+#if THREADSAFE_MEMPOOL_THREAD_CACHE
+        int32 getthreadcache();
+        OsclAny* allocatecached(int32 aCache);
+        void returnchunk(uint32 aCache, OsclAny* aChunk);
+        void reclaimthreadcaches();
+
+        ThreadSafeMemPoolThreadCache iThreadCache[THREADSAFE_MEMPOOL_MAX_THREADS];
+        volatile int32 iNumThreadCaches;
+        // index of the cache of the thread that allocated each chunk, kept
+        // after the chunks in the pool memory. NULL until the pool is created.
+        uint8* volatile iChunkOwner;
+#endif
 
 };
 
@@ -2,7 +2,8 @@ LOCAL_PATH := $(call my-dir)
 include $(CLEAR_VARS)
 
 LOCAL_SRC_FILES := \
-	src/analysis_sub_band.cpp \
+	src/aac_x86.cpp \
+ 	src/analysis_sub_band.cpp \
  	src/apply_ms_synt.cpp \
  	src/apply_tns.cpp \
  	src/buf_getbits.cpp \
@@ -15,7 +15,8 @@ XCPPFLAGS := -DAAC_PLUS -DHQ_SBR -DPARAMETRICSTEREO
 SRCDIR := ../../src
 INCSRCDIR := ../../include
 
-SRCS := analysis_sub_band.cpp \
+SRCS := aac_x86.cpp \
+	analysis_sub_band.cpp \
 	apply_ms_synt.cpp \
 	apply_tns.cpp \
 	buf_getbits.cpp \
@@ -0,0 +1,478 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*
+
+ Filename: aac_x86.cpp
+
+------------------------------------------------------------------------------
+ REVISION HISTORY
+
+
+ Who:                                   Date: MM/DD/YYYY
+ Description:
+
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ fft_rx4_long_stage_x86
+    Int32 Data[]            complex input/output of fft_rx4_long()
+    const Int32 *pw         twiddle factors (W_256rx4) of j = 1 of this stage
+    Int n1, n2              stage sizes, as in fft_rx4_long()
+
+    Returns the first j that is left for the C loop
+
+ calc_sbr_anafilterbank_window_x86
+    Int32 Y[64]             windowed input of analysis_sub_band(), Y[0] and
+                            Y[32] are left to the caller
+    const Int16 *X          end of the analysis input buffer
+    const Int32 *C          sbrDecoderFilterbankCoefficients_an_filt(_LC)
+
+ calc_sbr_synfilterbank_window_x86
+    Int16 *timeSig          interleaved output, timeSig[0] and timeSig[64]
+                            are left to the caller
+    const Int16 V[1280]     synthesis filter states
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+    x86 SIMD versions of the long window FFT (most of the IMDCT cost) and
+    of the window loops of the SBR QMF analysis and synthesis filterbanks.
+    The loops have independent iterations with the same operations, so
+    each 32-bit lane of an SSE register runs one iteration:
+
+    - fft_rx4_long_stage_x86 runs the radix-4 butterflies of 4 consecutive
+      twiddle factors j.
+    - calc_sbr_anafilterbank_window_x86 computes 4 consecutive Y[] and
+      their mirrored ones, the 32x16 bit products are split in a pmulhw
+      of the low half of the coefficient and a pmaddwd of the high half.
+    - calc_sbr_synfilterbank_window_x86 computes 4 consecutive output
+      samples and their mirrored ones with pmaddwd, each lane multiplies a
+      pair of V[] by the pair of 16 bit coefficients packed in one Int32 of
+      the table.
+
+    The lanes use the same fixed point operations as the C code, so the
+    output is bit-exact. SSE2 has no signed 32x32->64 bit multiply, the SSE2
+    version of the FFT corrects the unsigned product; the SSE4.1 version
+    uses pmuldq and is used when the CPU supports SSE4.1.
+
+------------------------------------------------------------------------------
+ REQUIREMENTS
+
+
+------------------------------------------------------------------------------
+ REFERENCES
+
+------------------------------------------------------------------------------
+ PSEUDO-CODE
+
+------------------------------------------------------------------------------
+*/
+
+
+/*----------------------------------------------------------------------------
+; INCLUDES
+----------------------------------------------------------------------------*/
+#include "aac_x86.h"
+
+#if (AAC_X86_SIMD)
+
+#include "fft_rx4.h"
+#include "fxp_mul32.h"
+#ifdef AAC_PLUS
+#include "calc_sbr_synfilterbank.h"
+#include "qmf_filterbank_coeff.h"
+#endif
+
+#include <emmintrin.h>
+#if (AAC_X86_SSE41)
+#include <smmintrin.h>
+#define SSE41_TARGET __attribute__((target("sse4.1")))
+#endif
+
+/*----------------------------------------------------------------------------
+; MACROS
+; Define module specific macros here
+----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------
+; DEFINES
+; Include all pre-processor statements here. Include conditional
+; compile variables also.
+----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------
+; LOCAL STORE/BUFFER/POINTER DEFINITIONS
+; Variable declaration - defined here and used outside this module
+----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------
+; LOCAL FUNCTION DEFINITIONS
+; Function Prototype declaration
+----------------------------------------------------------------------------*/
+
+static inline __m128i Add(__m128i a, __m128i b)
+{
+    return _mm_add_epi32(a, b);
+}
+
+static inline __m128i Sub(__m128i a, __m128i b)
+{
+    return _mm_sub_epi32(a, b);
+}
+
+static inline __m128i Neg(__m128i a)
+{
+    return _mm_sub_epi32(_mm_setzero_si128(), a);
+}
+
+static inline __m128i Shl(__m128i a, Int n)
+{
+    return _mm_slli_epi32(a, n);
+}
+
+static inline void Store(Int32 *p, __m128i a)
+{
+    _mm_storeu_si128((__m128i*)p, a);
+}
+
+/* 4 consecutive complex values, split in real and imaginary parts */
+static inline void LoadComplex(const Int32 *p, __m128i *re, __m128i *im)
+{
+    __m128 lo = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)p));
+    __m128 hi = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(p + 4)));
+
+    *re = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0)));
+    *im = _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+static inline void StoreComplex(Int32 *p, __m128i re, __m128i im)
+{
+    _mm_storeu_si128((__m128i*)p, _mm_unpacklo_epi32(re, im));
+    _mm_storeu_si128((__m128i*)(p + 4), _mm_unpackhi_epi32(re, im));
+}
+
+/*
+ *  p[0], p[step], p[2*step], p[3*step]. Built with movd and unpacks, the
+ *  compilers tend to go through the stack for _mm_set_epi32(), which stalls
+ *  the load.
+ */
+static inline __m128i Gather(const Int32 *p, Int step)
+{
+    __m128i lo = _mm_unpacklo_epi32(_mm_cvtsi32_si128(p[0]),
+                                    _mm_cvtsi32_si128(p[step]));
+    __m128i hi = _mm_unpacklo_epi32(_mm_cvtsi32_si128(p[2*step]),
+                                    _mm_cvtsi32_si128(p[3*step]));
+
+    return _mm_unpacklo_epi64(lo, hi);
+}
+
+/*
+ *  exp_jw of 4 consecutive j (triplets in W_256rx4) as cos and sin in the
+ *  upper 16 bits, like cmplx_mul32_by_16()
+ */
+static inline void TwiddleFactors(const Int32 *pw, Int k,
+                                  __m128i *cos_w, __m128i *sin_w)
+{
+    __m128i w = Gather(&pw[k], 3);
+
+    *cos_w = _mm_and_si128(w, _mm_set1_epi32((Int32)0xFFFF0000));
+    *sin_w = _mm_slli_epi32(w, 16);
+}
+
+static inline __m128i MulQ_SSE2(__m128i a, __m128i b, Int n)
+{
+    const __m128i hi = _mm_set_epi32(-1, 0, -1, 0);
+
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+    /* signed product = unsigned product - 2^32 * ((a < 0) * b + (b < 0) * a) */
+    __m128i corr = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b),
+                                 _mm_and_si128(_mm_srai_epi32(b, 31), a));
+
+    if (n == 32)
+    {
+        even = _mm_srli_epi64(even, 32);
+        odd  = _mm_and_si128(hi, odd);
+    }
+    else
+    {
+        even = _mm_andnot_si128(hi, _mm_srli_epi64(even, n));
+        odd  = _mm_and_si128(hi, _mm_slli_epi64(odd, 32 - n));
+    }
+
+    return _mm_sub_epi32(_mm_or_si128(even, odd), _mm_slli_epi32(corr, 32 - n));
+}
+
+#if (AAC_X86_SSE41)
+static inline SSE41_TARGET __m128i MulQ_SSE41(__m128i a, __m128i b, Int n)
+{
+    __m128i even = _mm_mul_epi32(a, b);
+    __m128i odd  = _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+    even = _mm_srli_epi64(even, n);
+    odd  = _mm_slli_epi64(odd, 32 - n);
+
+    return _mm_blend_epi16(even, odd, 0xCC);
+}
+#endif
+
+
+/* SSE2 kernels */
+
+#define X86_FN(name)        name##_SSE2
+#define X86_TARGET
+#define X86_MULQ(a, b, n)   MulQ_SSE2(a, b, n)
+
+#include "aac_x86_template.h"
+
+#undef X86_FN
+#undef X86_TARGET
+#undef X86_MULQ
+
+
+/* SSE4.1 kernels */
+
+#if (AAC_X86_SSE41)
+
+#define X86_FN(name)        name##_SSE41
+#define X86_TARGET          SSE41_TARGET
+#define X86_MULQ(a, b, n)   MulQ_SSE41(a, b, n)
+
+#include "aac_x86_template.h"
+
+#undef X86_FN
+#undef X86_TARGET
+#undef X86_MULQ
+
+static bool CpuHasSSE41()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.1") ? true : false;
+}
+
+#endif /* AAC_X86_SSE41 */
+
+
+#ifdef AAC_PLUS
+
+/*
+ *  fxp_mac32_by_16() of 4 consecutive j, out 1 in the lower and out 2 in the
+ *  upper 4 words of x. With c = ch * 65536 + cl (cl unsigned), the product is
+ *  ch * x + ((cl * x) >> 16), the second term fits in 16 bits: pmulhw gives
+ *  it for a signed cl, x is added back when cl >= 32768. pmaddwd then adds
+ *  ch * x to it in 32 bits.
+ */
+static inline void AnaWindowMac(__m128i c, __m128i x,
+                                __m128i *accu1, __m128i *accu2)
+{
+    __m128i cl;
+    __m128i ch;
+    __m128i low;
+
+    /* cl of the 4 j, twice */
+    cl = _mm_shufflelo_epi16(c, _MM_SHUFFLE(3, 1, 2, 0));
+    cl = _mm_shufflehi_epi16(cl, _MM_SHUFFLE(3, 1, 2, 0));
+    cl = _mm_shuffle_epi32(cl, _MM_SHUFFLE(2, 0, 2, 0));
+
+    /* ch and 1 in each lane */
+    ch = _mm_or_si128(_mm_srli_epi32(c, 16), _mm_set1_epi32(0x00010000));
+
+    low = _mm_add_epi16(_mm_mulhi_epi16(cl, x),
+                        _mm_and_si128(x, _mm_srai_epi16(cl, 15)));
+
+    *accu1 = Add(*accu1, _mm_madd_epi16(_mm_unpacklo_epi16(x, low), ch));
+    *accu2 = Add(*accu2, _mm_madd_epi16(_mm_unpackhi_epi16(x, low), ch));
+}
+
+/*
+ *  4 V[] of out 1 (i0 ... i0+3 after V[off_a] and V[off_b]) and of out 2
+ *  (the mirrored ones, before V[1280 - off_a] and V[1280 - off_b]), paired
+ *  as the low and high half of the table coefficients
+ */
+static inline void SynWindowMac(const Int16 V[1280], Int i0, Int off_a,
+                                Int off_b, __m128i c,
+                                __m128i *accu1, __m128i *accu2)
+{
+    __m128i a = _mm_loadl_epi64((const __m128i*)&V[i0 + off_a]);
+    __m128i b = _mm_loadl_epi64((const __m128i*)&V[i0 + off_b]);
+
+    *accu1 = Add(*accu1, _mm_madd_epi16(_mm_unpacklo_epi16(b, a), c));
+
+    a = _mm_shufflelo_epi16(_mm_loadl_epi64((const __m128i*)&V[1277 - i0 - off_a]), 0x1B);
+    b = _mm_shufflelo_epi16(_mm_loadl_epi64((const __m128i*)&V[1277 - i0 - off_b]), 0x1B);
+
+    *accu2 = Add(*accu2, _mm_madd_epi16(_mm_unpacklo_epi16(b, a), c));
+}
+
+/* saturate2() of 4 lanes */
+static inline __m128i SynSaturate(__m128i a)
+{
+    a = _mm_sub_epi32(a, _mm_srai_epi32(a, 2));
+    a = _mm_srai_epi32(a, N);
+
+    return _mm_packs_epi32(a, a);
+}
+
+#endif /* AAC_PLUS */
+
+/*----------------------------------------------------------------------------
+; EXTERNAL FUNCTION REFERENCES
+; Declare functions defined elsewhere and referenced in this module
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+; EXTERNAL GLOBAL STORE/BUFFER/POINTER REFERENCES
+; Declare variables used in this module but defined elsewhere
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+; FUNCTION CODE
+----------------------------------------------------------------------------*/
+
+Int fft_rx4_long_stage_x86(Int32 Data[],
+                           const Int32 *pw,
+                           Int n1,
+                           Int n2)
+{
+#if (AAC_X86_SSE41)
+    if (CpuHasSSE41())
+    {
+        return FftRx4LongStage_SSE41(Data, pw, n1, n2);
+    }
+#endif
+    return FftRx4LongStage_SSE2(Data, pw, n1, n2);
+}
+
+
+#ifdef AAC_PLUS
+
+void calc_sbr_anafilterbank_window_x86(Int32 Y[64],
+                                       const Int16 *X,
+                                       const Int32 *C)
+{
+    Int     j;
+    Int     m;
+
+    __m128i x;
+    __m128i accu1;
+    __m128i accu2;
+
+    for (j = 0; j + 4 <= 31; j += 4)
+    {
+        accu1 = _mm_setzero_si128();
+        accu2 = _mm_setzero_si128();
+
+        for (m = 0; m < 5; m++)
+        {
+            /* X[-1-j-64m] for out 1, X[-319+j+64m] for out 2 */
+            x = _mm_unpacklo_epi64(
+                    _mm_shufflelo_epi16(_mm_loadl_epi64((const __m128i*)&X[-4 - j - 64*m]), 0x1B),
+                    _mm_loadl_epi64((const __m128i*)&X[-319 + j + 64*m]));
+
+            AnaWindowMac(Gather(&C[5*j + m], 5), x, &accu1, &accu2);
+        }
+
+        Store(&Y[1 + j], accu1);
+        Store(&Y[60 - j], _mm_shuffle_epi32(accu2, 0x1B));
+    }
+
+    /* the last 3 j */
+    for (; j < 31; j++)
+    {
+        Int32 realAccu1 = 0;
+        Int32 realAccu2 = 0;
+
+        for (m = 0; m < 5; m++)
+        {
+            realAccu1 = fxp_mac32_by_16(C[5*j + m], X[-1 - j - 64*m], realAccu1);
+            realAccu2 = fxp_mac32_by_16(C[5*j + m], X[-319 + j + 64*m], realAccu2);
+        }
+
+        Y[1 + j]  = realAccu1;
+        Y[63 - j] = realAccu2;
+    }
+}
+
+
+void calc_sbr_synfilterbank_window_x86(Int16 *timeSig,
+                                       const Int16 V[1280])
+{
+    Int     i0;
+    Int     i;
+    Int     m;
+
+    /* V[] offsets of the 10 taps, in pairs of the same table entry */
+    static const Int16 offset[10] =
+    {
+        0, 192, 256, 448, 512, 704, 768, 960, 1024, 1216
+    };
+
+    const Int32 *pt_C = sbrDecoderFilterbankCoefficients;
+
+    __m128i c;
+    __m128i accu1;
+    __m128i accu2;
+    Int16   out1[8];
+    Int16   out2[8];
+
+    /*
+     *  i = 1 ... 31, 4 at a time. The last lane of the last group (i = 32)
+     *  has no coefficients, its V[] are still inside the buffer and its
+     *  output is dropped
+     */
+    for (i0 = 1; i0 < 32; i0 += 4)
+    {
+        accu1 = _mm_set1_epi32(ROUND_SYNFIL);
+        accu2 = _mm_set1_epi32(ROUND_SYNFIL);
+
+        for (m = 0; m < 5; m++)
+        {
+            const Int32 *p = &pt_C[5*(i0 - 1) + m];
+
+            if (i0 + 3 < 32)
+            {
+                c = Gather(p, 5);
+            }
+            else
+            {
+                c = _mm_unpacklo_epi64(
+                        _mm_unpacklo_epi32(_mm_cvtsi32_si128(p[0]), _mm_cvtsi32_si128(p[5])),
+                        _mm_cvtsi32_si128(p[10]));
+            }
+
+            SynWindowMac(V, i0, offset[2*m], offset[2*m + 1], c, &accu1, &accu2);
+        }
+
+        _mm_storeu_si128((__m128i*)out1, SynSaturate(accu1));
+        _mm_storeu_si128((__m128i*)out2, SynSaturate(accu2));
+
+        for (i = 0; (i < 4) && (i0 + i < 32); i++)
+        {
+            timeSig[2*(i0 + i)]       = out1[i];
+            timeSig[128 - 2*(i0 + i)] = out2[i];
+        }
+    }
+}
+
+#endif /* AAC_PLUS */
+
+#endif /* AAC_X86_SIMD */
@@ -0,0 +1,146 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*
+
+ Filename: aac_x86.h
+
+------------------------------------------------------------------------------
+ REVISION HISTORY
+
+ Who:                                   Date: MM/DD/YYYY
+ Description:
+
+------------------------------------------------------------------------------
+ INCLUDE DESCRIPTION
+
+ x86 SIMD versions of the FFT and SBR filterbank kernels, see aac_x86.cpp.
+
+ AAC_X86_SIMD builds the SSE2 versions, it is on by default when the
+ compiler targets SSE2 (never for the ARM builds). AAC_X86_SSE41 also builds
+ an SSE4.1 version of the FFT kernel, it is used only if the CPU supports
+ SSE4.1.
+
+------------------------------------------------------------------------------
+*/
+
+/*----------------------------------------------------------------------------
+; CONTINUE ONLY IF NOT ALREADY DEFINED
+----------------------------------------------------------------------------*/
+#ifndef AAC_X86_H
+#define AAC_X86_H
+
+/*----------------------------------------------------------------------------
+; INCLUDES
+----------------------------------------------------------------------------*/
+#include "pv_audio_type_defs.h"
+
+/*----------------------------------------------------------------------------
+; MACROS
+; Define module specific macros here
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+; DEFINES
+; Include all pre-processor statements here.
+----------------------------------------------------------------------------*/
+#ifndef AAC_X86_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define AAC_X86_SIMD 1
+#else
+#define AAC_X86_SIMD 0
+#endif
+#endif
+
+#ifndef AAC_X86_SSE41
+#if (AAC_X86_SIMD) && defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9) || defined(__clang__))
+#define AAC_X86_SSE41 1
+#else
+#define AAC_X86_SSE41 0
+#endif
+#endif
+
+#if !(AAC_X86_SIMD)
+#undef AAC_X86_SSE41
+#define AAC_X86_SSE41 0
+#endif
+
+/*----------------------------------------------------------------------------
+; EXTERNAL VARIABLES REFERENCES
+; Declare variables used in this module but defined elsewhere
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+; SIMPLE TYPEDEF'S
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+; ENUMERATED TYPEDEF'S
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+; STRUCTURES TYPEDEF'S
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+; GLOBAL FUNCTION DEFINITIONS
+; Function Prototype declaration
+----------------------------------------------------------------------------*/
+#if (AAC_X86_SIMD)
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*
+     *  Radix-4 butterflies of one fft_rx4_long() stage for j = 1 ... n2-1,
+     *  4 consecutive j at a time. pw points to the twiddle factors of j = 1.
+     *  Returns the first j left for the C loop.
+     */
+    Int fft_rx4_long_stage_x86(Int32 Data[],
+                               const Int32 *pw,
+                               Int n1,
+                               Int n2);
+
+    /*
+     *  Window loop of calc_sbr_anafilterbank(_LC), Y[1..31] and Y[33..63]
+     *  of the 64 QMF analysis inputs. C is the coefficient table.
+     */
+    void calc_sbr_anafilterbank_window_x86(Int32 Y[64],
+                                           const Int16 *X,
+                                           const Int32 *C);
+
+    /*
+     *  Window loop of calc_sbr_synfilterbank(_LC), output samples 1..31
+     *  and 33..63 (timeSig[2], timeSig[4] ... timeSig[126], the output is
+     *  interleaved) of the 64 QMF synthesis outputs
+     */
+    void calc_sbr_synfilterbank_window_x86(Int16 *timeSig,
+                                           const Int16 V[1280]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AAC_X86_SIMD */
+
+/*----------------------------------------------------------------------------
+; END
+----------------------------------------------------------------------------*/
+
+#endif /* AAC_X86_H */
@@ -0,0 +1,123 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*
+
+ Filename: aac_x86_template.h
+
+------------------------------------------------------------------------------
+ INCLUDE DESCRIPTION
+
+ Body of the x86 SIMD FFT kernel, it multiplies 32 bit values. It is included
+ once per instruction set by aac_x86.cpp, with these defined:
+
+    X86_FN(name)     function name for this instruction set
+    X86_TARGET       function attribute for this instruction set
+    X86_MULQ(a,b,n)  (Int32)(((int64)a * b) >> n) on 4 lanes
+
+ Each lane computes exactly what the C code computes for one j, with the
+ same operations, so the output is bit-exact.
+
+------------------------------------------------------------------------------
+*/
+
+/*
+ *  cmplx_mul32_by_16() on 4 lanes, cos_w and sin_w are the two halves of
+ *  exp_jw already moved to the upper 16 bits
+ */
+static inline X86_TARGET __m128i X86_FN(CmplxMul)(__m128i x, __m128i y,
+        __m128i cos_w, __m128i sin_w)
+{
+    return Add(X86_MULQ(x, cos_w, 32), X86_MULQ(y, sin_w, 32));
+}
+
+
+/*
+ *  fft_rx4_long(), butterflies of one stage for 4 consecutive j
+ */
+static X86_TARGET Int X86_FN(FftRx4LongStage)(Int32 Data[],
+        const Int32 *pw,
+        Int n1,
+        Int n2)
+{
+    Int     i;
+    Int     j;
+
+    __m128i cos_w1, sin_w1, cos_w2, sin_w2, cos_w3, sin_w3;
+    __m128i re1, im1, re2, im2, re3, im3, re4, im4;
+    __m128i r1, r2, r3, r4, s1, s2, s3, t1, t2;
+
+    for (j = 1; j + 4 <= n2; j += 4)
+    {
+        TwiddleFactors(pw, 0, &cos_w1, &sin_w1);
+        TwiddleFactors(pw, 1, &cos_w2, &sin_w2);
+        TwiddleFactors(pw, 2, &cos_w3, &sin_w3);
+        pw += 12;
+
+        for (i = j; i < FFT_RX4_LONG; i += n1)
+        {
+            /* complex elements i, i + n1/4, i + n1/2 and i + 3*n1/4 */
+            Int32 *pData1 = &Data[i << 1];
+            Int32 *pData3 = pData1 + (n1 >> 1);
+            Int32 *pData2 = pData1 + n1;
+            Int32 *pData4 = pData3 + n1;
+
+            LoadComplex(pData1, &re1, &im1);
+            LoadComplex(pData2, &re2, &im2);
+            LoadComplex(pData3, &re3, &im3);
+            LoadComplex(pData4, &re4, &im4);
+
+            r1 = Add(re1, re2);
+            r2 = Sub(re1, re2);
+            r3 = Add(re3, re4);
+            r4 = Sub(re3, re4);
+
+            re1 = Add(r1, r3);
+            r1  = Shl(Sub(r1, r3), 1);
+
+            s1 = Add(im1, im2);
+            s2 = Sub(im1, im2);
+            s3 = Shl(Add(s2, r4), 1);
+            s2 = Shl(Sub(s2, r4), 1);
+
+            t1 = Add(im3, im4);
+            t2 = Sub(im3, im4);
+
+            im1 = Add(s1, t1);
+            s1  = Shl(Sub(s1, t1), 1);
+
+            im2 = X86_FN(CmplxMul)(s1, Neg(r1), cos_w2, sin_w2);
+            re2 = X86_FN(CmplxMul)(r1, s1, cos_w2, sin_w2);
+
+            r3 = Shl(Sub(r2, t2), 1);
+            r2 = Shl(Add(r2, t2), 1);
+
+            im3 = X86_FN(CmplxMul)(s2, Neg(r2), cos_w1, sin_w1);
+            re3 = X86_FN(CmplxMul)(r2, s2, cos_w1, sin_w1);
+
+            im4 = X86_FN(CmplxMul)(s3, Neg(r3), cos_w3, sin_w3);
+            re4 = X86_FN(CmplxMul)(r3, s3, cos_w3, sin_w3);
+
+            StoreComplex(pData1, re1, im1);
+            StoreComplex(pData2, re2, im2);
+            StoreComplex(pData3, re3, im3);
+            StoreComplex(pData4, re4, im4);
+        }
+    }
+
+    return j;
+}
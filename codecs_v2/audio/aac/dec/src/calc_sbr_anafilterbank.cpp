@@ -92,6 +92,7 @@ Copyright (c) ISO/IEC 2002.
 
 #include    "aac_mem_funcs.h"
 #include    "fxp_mul32.h"
+#include    "aac_x86.h"
 
 
 
@@ -137,17 +138,19 @@ void calc_sbr_anafilterbank_LC(Int32 * Sr,
                                Int32 maxBand)
 {
 
-    Int i;
     Int32   *p_Y_1;
+#if !(AAC_X86_SIMD)
+    Int i;
     Int32   *p_Y_2;
 
-    Int16 * pt_X_1;
     Int16 * pt_X_2;
-    Int32 realAccu1;
-    Int32 realAccu2;
-
     Int32 tmp1;
     Int32 tmp2;
+#endif
+
+    Int16 * pt_X_1;
+    Int32 realAccu1;
+    Int32 realAccu2;
 
 
     const Int32 * pt_C;
@@ -155,7 +158,6 @@ void calc_sbr_anafilterbank_LC(Int32 * Sr,
     p_Y_1 = scratch_mem[0];
 
 
-    p_Y_2 = p_Y_1 + 63;
     pt_C   = &sbrDecoderFilterbankCoefficients_an_filt_LC[0];
 
     pt_X_1 = X;
@@ -170,6 +172,12 @@ void calc_sbr_anafilterbank_LC(Int32 * Sr,
 
     /* create array Y */
 
+#if (AAC_X86_SIMD)
+    calc_sbr_anafilterbank_window_x86(scratch_mem[0], X, pt_C);
+    p_Y_1 += 31;
+#else
+    p_Y_2 = scratch_mem[0] + 63;
+
     pt_X_1 = &X[-1];
     pt_X_2 = &X[-319];
 
@@ -244,6 +252,7 @@ void calc_sbr_anafilterbank_LC(Int32 * Sr,
     tmp2 = pt_X_2[ +255];
     *(p_Y_1++) = fxp_mac32_by_16(*(pt_C), tmp1, realAccu1);
     *(p_Y_2--) = fxp_mac32_by_16(*(pt_C++), tmp2, realAccu2);
+#endif
 
 
     pt_X_1 = X;
@@ -273,27 +282,28 @@ void calc_sbr_anafilterbank(Int32 * Sr,
                             Int32 scratch_mem[][64],
                             Int32   maxBand)
 {
-    Int i;
     Int32   *p_Y_1;
+#if !(AAC_X86_SIMD)
+    Int i;
     Int32   *p_Y_2;
 
+    Int16 * pt_X_1;
+    Int16 * pt_X_2;
+    Int32 tmp1;
+    Int32 tmp2;
+#endif
+
 
 
 
     const Int32 * pt_C;
-    Int16 * pt_X_1;
-    Int16 * pt_X_2;
     Int32 realAccu1;
     Int32 realAccu2;
 
-    Int32 tmp1;
-    Int32 tmp2;
-
 
     p_Y_1 = scratch_mem[0];
 
 
-    p_Y_2 = p_Y_1 + 63;
     pt_C   = &sbrDecoderFilterbankCoefficients_an_filt[0];
 
     realAccu1  =  fxp_mul32_by_16(Qfmt27(-0.36115899F),   X[-192]);
@@ -305,6 +315,12 @@ void calc_sbr_anafilterbank(Int32 * Sr,
 
     /* create array Y */
 
+#if (AAC_X86_SIMD)
+    calc_sbr_anafilterbank_window_x86(scratch_mem[0], X, pt_C);
+    p_Y_1 += 31;
+#else
+    p_Y_2 = scratch_mem[0] + 63;
+
     pt_X_1 = &X[-1];
     pt_X_2 = &X[-319];
 
@@ -332,6 +348,7 @@ void calc_sbr_anafilterbank(Int32 * Sr,
         *(p_Y_1++) = fxp_mac32_by_16(*(pt_C), tmp1, realAccu1);
         *(p_Y_2--) = fxp_mac32_by_16(*(pt_C++), tmp2, realAccu2);
     }
+#endif
 
 
     realAccu2  = fxp_mul32_by_16(Qfmt27(0.002620176F), X[ -32]);
@@ -88,6 +88,7 @@ Copyright (c) ISO/IEC 2002.
 #include    "synthesis_sub_band.h"
 #include    "fxp_mul32.h"
 #include    "aac_mem_funcs.h"
+#include    "aac_x86.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -249,7 +250,9 @@ void calc_sbr_synfilterbank_LC(Int32 * Sr,
     Int16 *pt_timeSig;
 
     Int16 *pt_timeSig_2;
+#if !(AAC_X86_SIMD)
     Int32  test1;
+#endif
     Int16  tmp1;
     Int16  tmp2;
 
@@ -312,6 +315,9 @@ void calc_sbr_synfilterbank_LC(Int32 * Sr,
 
         saturate2(realAccu1, realAccu2, pt_timeSig, pt_timeSig_2);
 
+#if (AAC_X86_SIMD)
+        calc_sbr_synfilterbank_window_x86(timeSig, V);
+#else
         pt_timeSig_2 = &timeSig[126];
 
         pt_V1 = &V[1];
@@ -374,6 +380,7 @@ void calc_sbr_synfilterbank_LC(Int32 * Sr,
             saturate2(realAccu1, realAccu2, pt_timeSig, pt_timeSig_2);
 
         }
+#endif
     }
     else
     {
@@ -455,7 +462,9 @@ void calc_sbr_synfilterbank(Int32 * Sr,
     Int16 *pt_timeSig;
 
     Int16 *pt_timeSig_2;
+#if !(AAC_X86_SIMD)
     Int32  test1;
+#endif
     Int16  tmp1;
     Int16  tmp2;
 
@@ -510,6 +519,9 @@ void calc_sbr_synfilterbank(Int32 * Sr,
 
         saturate2(realAccu1, realAccu2, pt_timeSig, pt_timeSig_2);
 
+#if (AAC_X86_SIMD)
+        calc_sbr_synfilterbank_window_x86(timeSig, V);
+#else
         pt_timeSig_2 = &timeSig[126];
 
         pt_V1 = &V[1];
@@ -571,6 +583,7 @@ void calc_sbr_synfilterbank(Int32 * Sr,
 
             saturate2(realAccu1, realAccu2, pt_timeSig, pt_timeSig_2);
         }
+#endif
 
     }
     else
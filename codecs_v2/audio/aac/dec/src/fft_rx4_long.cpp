@@ -148,6 +148,7 @@
 #include "fft_rx4.h"
 
 #include "fxp_mul32.h"
+#include "aac_x86.h"
 
 /*----------------------------------------------------------------------------
 ; MACROS
@@ -282,7 +283,15 @@ void fft_rx4_long(
 
 
 
-        for (j = 1; j < n2; j++)
+#if (AAC_X86_SIMD)
+        /* 4 consecutive j at a time, the remaining j below */
+        j = fft_rx4_long_stage_x86(Data, pw, n1, n2);
+        pw += 3 * (j - 1);
+#else
+        j = 1;
+#endif
+
+        for (; j < n2; j++)
         {
 
             exp_jw1 = (*pw++);
@@ -31,7 +31,8 @@ LOCAL_SRC_FILES := \
  	src/pvmp3_polyphase_filter_window.cpp \
  	src/pvmp3_mdct_18.cpp \
  	src/pvmp3_dct_9.cpp \
- 	src/pvmp3_dct_16.cpp
+ 	src/pvmp3_dct_16.cpp \
+ 	src/pvmp3_x86.cpp
 
 ifeq ($(TARGET_ARCH),arm)
 LOCAL_SRC_FILES += \
@@ -43,7 +43,8 @@ SRCS := pvmp3_normalize.cpp \
 	pvmp3_polyphase_filter_window.cpp \
 	pvmp3_mdct_18.cpp \
 	pvmp3_dct_9.cpp \
-	pvmp3_dct_16.cpp 
+	pvmp3_dct_16.cpp \
+	pvmp3_x86.cpp
 
 
 HDRS := pvmp3_decoder.h pvmp3decoder_api.h pvmp3_audio_type_defs.h
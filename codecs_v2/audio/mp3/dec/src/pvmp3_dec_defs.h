@@ -70,6 +70,35 @@
 #define HAN_SIZE              512
 
 
+/*
+ *  x86 SIMD synthesis. PVMP3_X86_SIMD builds the SSE2 versions of the
+ *  dct_16, dct_9, mdct_18 and polyphase window kernels in pvmp3_x86.cpp,
+ *  it is on by default when the compiler targets SSE2 (never for the ARM
+ *  assembly builds). PVMP3_X86_SSE41 also builds SSE4.1 versions, they are
+ *  used only if the CPU supports SSE4.1.
+ */
+#ifndef PVMP3_X86_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define PVMP3_X86_SIMD 1
+#else
+#define PVMP3_X86_SIMD 0
+#endif
+#endif
+
+#ifndef PVMP3_X86_SSE41
+#if (PVMP3_X86_SIMD) && defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9) || defined(__clang__))
+#define PVMP3_X86_SSE41 1
+#else
+#define PVMP3_X86_SSE41 0
+#endif
+#endif
+
+#if !(PVMP3_X86_SIMD)
+#undef PVMP3_X86_SSE41
+#define PVMP3_X86_SSE41 0
+#endif
+
+
 /* MPEG Header Definitions - ID Bit Values */
 
 #define MPEG_1              0
@@ -101,6 +101,7 @@ Overlapping and adding with previous block
 #include "pvmp3_mdct_18.h"
 #include "pvmp3_mdct_6.h"
 #include "mp3_mem_funcs.h"
+#include "pvmp3_x86.h"
 
 
 
@@ -223,6 +224,9 @@ void pvmp3_imdct_synth(int32  in[SUBBANDS_NUMBER*FILTERBANK_BANDS],
 
     int32 band;
     int32 bands2process = used_freq_lines + 2;
+#if (PVMP3_X86_SIMD)
+    int32 x4_bands = 0;
+#endif
 
     if (bands2process > SUBBANDS_NUMBER)
     {
@@ -243,6 +247,27 @@ void pvmp3_imdct_synth(int32  in[SUBBANDS_NUMBER*FILTERBANK_BANDS],
         int32 * out     = in      + (band * FILTERBANK_BANDS);
         int32 * history = overlap + (band * FILTERBANK_BANDS);
 
+#if (PVMP3_X86_SIMD)
+        /*
+         *  4 long transforms with the same window at a time,
+         *  the frequency inversion below is still done per band
+         */
+        if (x4_bands > 0)
+        {
+            x4_bands--;     /* done by pvmp3_mdct_18_x4 */
+        }
+        else if ((current_blk_type != SHORT) &&
+                 (band + 4 <= bands2process) &&
+                 ((band >= mx_band) || (band + 4 <= mx_band)))
+        {
+            pvmp3_mdct_18_x4(out,
+                             history,
+                             (current_blk_type == LONG) ? normal_win :
+                             (current_blk_type == START) ? start_win : stop_win);
+            x4_bands = 3;
+        }
+        else
+#endif
         switch (current_blk_type)
         {
             case LONG:
@@ -80,6 +80,7 @@
 #include "pvmp3_dct_16.h"
 #include "pvmp3_equalizer.h"
 #include "mp3_mem_funcs.h"
+#include "pvmp3_x86.h"
 
 
 /*----------------------------------------------------------------------------
@@ -132,6 +133,14 @@ void pvmp3_poly_phase_synthesis(tmp3dec_chan   *pChVars,
                     pChVars->work_buf_int32);
 
 
+#if (PVMP3_X86_SIMD)
+
+    pvmp3_poly_phase_synthesis_x86(pChVars->circ_buffer,
+                                   numChannels,
+                                   outPcm);
+
+#else
+
     int16 * ptr_out = outPcm;
 
 
@@ -177,6 +186,8 @@ void pvmp3_poly_phase_synthesis(tmp3dec_chan   *pChVars,
 
     }/* end band loop */
 
+#endif
+
     pv_memmove(&pChVars->circ_buffer[576],
                pChVars->circ_buffer,
                480*sizeof(*pChVars->circ_buffer));
@@ -0,0 +1,406 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*
+------------------------------------------------------------------------------
+
+   PacketVideo Corp.
+   MP3 Decoder Library
+
+   Filename: pvmp3_x86.cpp
+
+------------------------------------------------------------------------------
+ REVISION HISTORY
+
+
+ Description:
+
+------------------------------------------------------------------------------
+ INPUT AND OUTPUT DEFINITIONS
+
+ pvmp3_poly_phase_synthesis_x86
+    int32 *circ_buffer      synthesis buffer of one channel, after the
+                            equalizer
+    int32 numChannels       number of channels
+    int16 *outPcm           pointer to the PCM output data
+
+ pvmp3_mdct_18_x4
+    int32 vec[]             4 input vectors of length 18, FILTERBANK_BANDS
+                            apart
+    int32 *history          4 overlap and add vectors, FILTERBANK_BANDS
+                            apart, updated with the next overlap and add
+                            values
+    const int32 *window     window used by all 4 mdcts
+
+------------------------------------------------------------------------------
+ FUNCTION DESCRIPTION
+
+    x86 SIMD versions of the synthesis kernels. The transforms themselves
+    are serial butterfly networks, so instead of vectorizing inside one
+    transform, each 32-bit lane of an SSE register runs one independent
+    transform:
+
+    - pvmp3_poly_phase_synthesis_x86 runs the DCT 32 (split, 2 x dct_16
+      and merge) of 4 time slots at a time, then the polyphase window of
+      each time slot with 4 of its output samples at a time.
+    - pvmp3_mdct_18_x4 runs mdct_18 (with both dct_9) of 4 subbands.
+
+    The lanes use the same fixed point operations in the same order as the
+    C code, so the output is bit-exact. SSE2 has no signed 32x32->64 bit
+    multiply, the SSE2 versions correct the unsigned product; the SSE4.1
+    versions use pmuldq and are used when the CPU supports SSE4.1.
+
+------------------------------------------------------------------------------
+ REQUIREMENTS
+
+
+------------------------------------------------------------------------------
+ REFERENCES
+
+------------------------------------------------------------------------------
+ PSEUDO-CODE
+
+------------------------------------------------------------------------------
+*/
+
+
+/*----------------------------------------------------------------------------
+; INCLUDES
+----------------------------------------------------------------------------*/
+#include "pvmp3_x86.h"
+
+#if (PVMP3_X86_SIMD)
+
+#include "pv_mp3dec_fxd_op.h"
+#include "pvmp3_mdct_18.h"
+#include "pvmp3_polyphase_filter_window.h"
+#include "pvmp3_tables.h"
+#include "mp3_mem_funcs.h"
+
+#include <emmintrin.h>
+#if (PVMP3_X86_SSE41)
+#include <smmintrin.h>
+#define SSE41_TARGET __attribute__((target("sse4.1")))
+#endif
+
+/*----------------------------------------------------------------------------
+; MACROS
+; Define module specific macros here
+----------------------------------------------------------------------------*/
+
+
+/*----------------------------------------------------------------------------
+; DEFINES
+; Include all pre-processor statements here. Include conditional
+; compile variables also.
+----------------------------------------------------------------------------*/
+
+/* same as pvmp3_dct_9.cpp */
+#define Qfmt31(a)   (int32)(a*(0x7FFFFFFF))
+
+#define cos_pi_9    Qfmt31( 0.93969262078591f)
+#define cos_2pi_9   Qfmt31( 0.76604444311898f)
+#define cos_4pi_9   Qfmt31( 0.17364817766693f)
+#define cos_5pi_9   Qfmt31(-0.17364817766693f)
+#define cos_7pi_9   Qfmt31(-0.76604444311898f)
+#define cos_8pi_9   Qfmt31(-0.93969262078591f)
+#define cos_pi_6    Qfmt31( 0.86602540378444f)
+#define cos_5pi_6   Qfmt31(-0.86602540378444f)
+#define cos_5pi_18  Qfmt31( 0.64278760968654f)
+#define cos_7pi_18  Qfmt31( 0.34202014332567f)
+#define cos_11pi_18 Qfmt31(-0.34202014332567f)
+#define cos_13pi_18 Qfmt31(-0.64278760968654f)
+#define cos_17pi_18 Qfmt31(-0.98480775301221f)
+
+/*----------------------------------------------------------------------------
+; LOCAL STORE/BUFFER/POINTER DEFINITIONS
+; Variable declaration - defined here and used outside this module
+----------------------------------------------------------------------------*/
+
+/* same as CosTable_dct32 in pvmp3_dct_16.cpp */
+static const int32 CosTable_dct32_x86[16] =
+{
+    Qfmt_31(0.50060299823520F) ,  Qfmt_31(0.50547095989754F) ,
+    Qfmt_31(0.51544730992262F) ,  Qfmt_31(0.53104259108978F) ,
+    Qfmt_31(0.55310389603444F) ,  Qfmt_31(0.58293496820613F) ,
+    Qfmt_31(0.62250412303566F) ,  Qfmt_31(0.67480834145501F) ,
+    Qfmt_31(0.74453627100230F) ,  Qfmt_31(0.83934964541553F) ,
+
+    Qfmt2(0.97256823786196F) ,  Qfmt2(1.16943993343288F) ,
+    Qfmt2(1.48416461631417F) ,  Qfmt2(2.05778100995341F) ,
+    Qfmt2(3.40760841846872F) ,  Qfmt2(10.19000812354803F)
+};
+
+/* same as cosTerms_dct18 and cosTerms_1_ov_cos_phi in pvmp3_mdct_18.cpp */
+static const int32 cosTerms_dct18_x86[9] =
+{
+    Qfmt(0.50190991877167f),   Qfmt(0.51763809020504f),   Qfmt(0.55168895948125f),
+    Qfmt(0.61038729438073f),   Qfmt(0.70710678118655f),   Qfmt(0.87172339781055f),
+    Qfmt(1.18310079157625f),   Qfmt(1.93185165257814f),   Qfmt(5.73685662283493f)
+};
+
+static const int32 cosTerms_1_ov_cos_phi_x86[18] =
+{
+
+    Qfmt1(0.50047634258166f),  Qfmt1(0.50431448029008f),  Qfmt1(0.51213975715725f),
+    Qfmt1(0.52426456257041f),  Qfmt1(0.54119610014620f),  Qfmt1(0.56369097343317f),
+    Qfmt1(0.59284452371708f),  Qfmt1(0.63023620700513f),  Qfmt1(0.67817085245463f),
+
+    Qfmt2(0.74009361646113f),  Qfmt2(0.82133981585229f),  Qfmt2(0.93057949835179f),
+    Qfmt2(1.08284028510010f),  Qfmt2(1.30656296487638f),  Qfmt2(1.66275476171152f),
+    Qfmt2(2.31011315767265f),  Qfmt2(3.83064878777019f),  Qfmt2(11.46279281302667f)
+};
+
+/*----------------------------------------------------------------------------
+; LOCAL FUNCTION DEFINITIONS
+; Function Prototype declaration
+----------------------------------------------------------------------------*/
+
+static inline __m128i Add(__m128i a, __m128i b)
+{
+    return _mm_add_epi32(a, b);
+}
+
+static inline __m128i Sub(__m128i a, __m128i b)
+{
+    return _mm_sub_epi32(a, b);
+}
+
+static inline __m128i Neg(__m128i a)
+{
+    return _mm_sub_epi32(_mm_setzero_si128(), a);
+}
+
+static inline __m128i Shl(__m128i a, int32 n)
+{
+    return _mm_slli_epi32(a, n);
+}
+
+static inline __m128i Sar(__m128i a, int32 n)
+{
+    return _mm_srai_epi32(a, n);
+}
+
+static inline __m128i Load(const int32 *p)
+{
+    return _mm_loadu_si128((const __m128i*)p);
+}
+
+/* p[3], p[2], p[1], p[0] */
+static inline __m128i LoadReverse(const int32 *p)
+{
+    return _mm_shuffle_epi32(Load(p), 0x1B);
+}
+
+static inline void Transpose4x4(__m128i *x)
+{
+    __m128i t0 = _mm_unpacklo_epi32(x[0], x[1]);
+    __m128i t1 = _mm_unpacklo_epi32(x[2], x[3]);
+    __m128i t2 = _mm_unpackhi_epi32(x[0], x[1]);
+    __m128i t3 = _mm_unpackhi_epi32(x[2], x[3]);
+
+    x[0] = _mm_unpacklo_epi64(t0, t1);
+    x[1] = _mm_unpackhi_epi64(t0, t1);
+    x[2] = _mm_unpacklo_epi64(t2, t3);
+    x[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+/* x[i] = { p0[i], p1[i], p2[i], p3[i] }, i = 0..3 */
+static inline void Load4x4(__m128i *x, const int32 *p0, const int32 *p1, const int32 *p2, const int32 *p3)
+{
+    x[0] = Load(p0);
+    x[1] = Load(p1);
+    x[2] = Load(p2);
+    x[3] = Load(p3);
+    Transpose4x4(x);
+}
+
+static inline void Store4x4(const __m128i *y, int32 *p0, int32 *p1, int32 *p2, int32 *p3)
+{
+    __m128i x[4];
+
+    x[0] = y[0];
+    x[1] = y[1];
+    x[2] = y[2];
+    x[3] = y[3];
+    Transpose4x4(x);
+    _mm_storeu_si128((__m128i*)p0, x[0]);
+    _mm_storeu_si128((__m128i*)p1, x[1]);
+    _mm_storeu_si128((__m128i*)p2, x[2]);
+    _mm_storeu_si128((__m128i*)p3, x[3]);
+}
+
+/* x[i] = { p[i], p[18 + i], p[36 + i], p[54 + i] }, i = 0..17 */
+static inline void Load4x18(__m128i *x, const int32 *p)
+{
+    int32 i;
+
+    for (i = 0; i < 16; i += 4)
+    {
+        Load4x4(&x[i], &p[i], &p[i + FILTERBANK_BANDS], &p[i + 2*FILTERBANK_BANDS], &p[i + 3*FILTERBANK_BANDS]);
+    }
+    for (; i < FILTERBANK_BANDS; i++)
+    {
+        x[i] = _mm_set_epi32(p[i + 3*FILTERBANK_BANDS], p[i + 2*FILTERBANK_BANDS], p[i + FILTERBANK_BANDS], p[i]);
+    }
+}
+
+static inline void Store4x18(const __m128i *x, int32 *p)
+{
+    int32 i;
+    int32 lane[4];
+
+    for (i = 0; i < 16; i += 4)
+    {
+        Store4x4(&x[i], &p[i], &p[i + FILTERBANK_BANDS], &p[i + 2*FILTERBANK_BANDS], &p[i + 3*FILTERBANK_BANDS]);
+    }
+    for (; i < FILTERBANK_BANDS; i++)
+    {
+        _mm_storeu_si128((__m128i*)lane, x[i]);
+        p[i] = lane[0];
+        p[i + FILTERBANK_BANDS] = lane[1];
+        p[i + 2*FILTERBANK_BANDS] = lane[2];
+        p[i + 3*FILTERBANK_BANDS] = lane[3];
+    }
+}
+
+/*
+ *  (int32)(((int64)a * b) >> n) on 4 lanes, 0 < n <= 32. The 64-bit
+ *  products of lanes 0, 2 and of lanes 1, 3 are shifted so that bits
+ *  n..n+31 end up in the low and in the high half of each 64-bit element.
+ */
+static inline __m128i MulQ_SSE2(__m128i a, __m128i b, int32 n)
+{
+    const __m128i hi = _mm_set_epi32(-1, 0, -1, 0);
+
+    /*
+     *  pmuludq is unsigned, a * b = ua * ub - ((a < 0 ? b : 0) + (b < 0 ? a : 0)) << 32,
+     *  the correction only changes bits 32..63, so it is subtracted from
+     *  the 32-bit result, shifted by 32 - n
+     */
+    __m128i corr = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b),
+                                 _mm_and_si128(_mm_srai_epi32(b, 31), a));
+
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+    if (n == 32)
+    {
+        even = _mm_srli_epi64(even, 32);
+        odd  = _mm_and_si128(hi, odd);
+    }
+    else
+    {
+        even = _mm_andnot_si128(hi, _mm_srli_epi64(even, n));
+        odd  = _mm_and_si128(hi, _mm_slli_epi64(odd, 32 - n));
+    }
+
+    return _mm_sub_epi32(_mm_or_si128(even, odd), _mm_slli_epi32(corr, 32 - n));
+}
+
+#if (PVMP3_X86_SSE41)
+static inline SSE41_TARGET __m128i MulQ_SSE41(__m128i a, __m128i b, int32 n)
+{
+    __m128i even = _mm_mul_epi32(a, b);
+    __m128i odd  = _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+    even = _mm_srli_epi64(even, n);
+    odd  = _mm_slli_epi64(odd, 32 - n);
+
+    return _mm_blend_epi16(even, odd, 0xCC);
+}
+#endif
+
+
+/* SSE2 kernels */
+
+#define X86_FN(name)        name##_SSE2
+#define X86_TARGET
+#define X86_MULQ(a, b, n)   MulQ_SSE2(a, b, n)
+
+#include "pvmp3_x86_template.h"
+
+#undef X86_FN
+#undef X86_TARGET
+#undef X86_MULQ
+
+
+/* SSE4.1 kernels */
+
+#if (PVMP3_X86_SSE41)
+
+#define X86_FN(name)        name##_SSE41
+#define X86_TARGET          SSE41_TARGET
+#define X86_MULQ(a, b, n)   MulQ_SSE41(a, b, n)
+
+#include "pvmp3_x86_template.h"
+
+#undef X86_FN
+#undef X86_TARGET
+#undef X86_MULQ
+
+static bool CpuHasSSE41()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.1") ? true : false;
+}
+
+#endif /* PVMP3_X86_SSE41 */
+
+/*----------------------------------------------------------------------------
+; EXTERNAL FUNCTION REFERENCES
+; Declare functions defined elsewhere and referenced in this module
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+; EXTERNAL GLOBAL STORE/BUFFER/POINTER REFERENCES
+; Declare variables used in this module but defined elsewhere
+----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+; FUNCTION CODE
+----------------------------------------------------------------------------*/
+
+void pvmp3_poly_phase_synthesis_x86(int32 *circ_buffer,
+                                    int32 numChannels,
+                                    int16 *outPcm)
+{
+#if (PVMP3_X86_SSE41)
+    if (CpuHasSSE41())
+    {
+        PolyPhaseSynthesis_SSE41(circ_buffer, numChannels, outPcm);
+        return;
+    }
+#endif
+    PolyPhaseSynthesis_SSE2(circ_buffer, numChannels, outPcm);
+}
+
+
+void pvmp3_mdct_18_x4(int32 vec[], int32 *history, const int32 *window)
+{
+#if (PVMP3_X86_SSE41)
+    if (CpuHasSSE41())
+    {
+        Mdct18x4_SSE41(vec, history, window);
+        return;
+    }
+#endif
+    Mdct18x4_SSE2(vec, history, window);
+}
+
+#endif /* PVMP3_X86_SIMD */
+
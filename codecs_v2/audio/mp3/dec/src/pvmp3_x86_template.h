@@ -0,0 +1,558 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*
+------------------------------------------------------------------------------
+   PacketVideo Corp.
+   MP3 Decoder Library
+
+   Filename: pvmp3_x86_template.h
+
+------------------------------------------------------------------------------
+ INCLUDE DESCRIPTION
+
+ Body of the x86 SIMD kernels. It is included once per instruction set by
+ pvmp3_x86.cpp, with these defined:
+
+    X86_FN(name)     function name for this instruction set
+    X86_TARGET       function attribute for this instruction set
+    X86_MULQ(a,b,n)  (int32)(((int64)a * b) >> n) on 4 lanes
+
+ Each lane computes exactly what the C code computes for one transform,
+ with the same operations in the same order, so the output is bit-exact.
+
+------------------------------------------------------------------------------
+*/
+
+#define MUL_Q(a, c, n)  X86_MULQ((a), _mm_set1_epi32(c), n)
+
+
+/*
+ *  pvmp3_dct_16() on 4 lanes
+ */
+static inline X86_TARGET void X86_FN(Dct16)(__m128i *vec, int32 flag)
+{
+    __m128i tmp0, tmp1, tmp2, tmp3, tmp4, tmp5, tmp6, tmp7;
+    __m128i tmp_o0, tmp_o1, tmp_o2, tmp_o3, tmp_o4, tmp_o5, tmp_o6, tmp_o7;
+    __m128i itmp_e0, itmp_e1, itmp_e2;
+
+    /*  split input vector */
+
+    tmp_o0 = MUL_Q(Sub(vec[ 0], vec[15]), Qfmt_31(0.50241928618816F), 32);
+    tmp0   = Add(vec[ 0], vec[15]);
+
+    tmp_o7 = MUL_Q(Shl(Sub(vec[ 7], vec[ 8]), 3), Qfmt_31(0.63764357733614F), 32);
+    tmp7   = Add(vec[ 7], vec[ 8]);
+
+    itmp_e0 = MUL_Q(Sub(tmp0, tmp7), Qfmt_31(0.50979557910416F), 32);
+    tmp7    = Add(tmp0, tmp7);
+
+    tmp_o1 = MUL_Q(Sub(vec[ 1], vec[14]), Qfmt_31(0.52249861493969F), 32);
+    tmp1   = Add(vec[ 1], vec[14]);
+
+    tmp_o6 = MUL_Q(Shl(Sub(vec[ 6], vec[ 9]), 1), Qfmt_31(0.86122354911916F), 32);
+    tmp6   = Add(vec[ 6], vec[ 9]);
+
+    itmp_e1 = Add(tmp1, tmp6);
+    tmp6    = MUL_Q(Sub(tmp1, tmp6), Qfmt_31(0.60134488693505F), 32);
+
+    tmp_o2 = MUL_Q(Sub(vec[ 2], vec[13]), Qfmt_31(0.56694403481636F), 32);
+    tmp2   = Add(vec[ 2], vec[13]);
+    tmp_o5 = MUL_Q(Shl(Sub(vec[ 5], vec[10]), 1), Qfmt_31(0.53033884299517F), 32);
+    tmp5   = Add(vec[ 5], vec[10]);
+
+    itmp_e2 = Add(tmp2, tmp5);
+    tmp5    = MUL_Q(Sub(tmp2, tmp5), Qfmt_31(0.89997622313642F), 32);
+
+    tmp_o3 = MUL_Q(Sub(vec[ 3], vec[12]), Qfmt_31(0.64682178335999F), 32);
+    tmp3   = Add(vec[ 3], vec[12]);
+    tmp_o4 = MUL_Q(Sub(vec[ 4], vec[11]), Qfmt_31(0.78815462345125F), 32);
+    tmp4   = Add(vec[ 4], vec[11]);
+
+    tmp1   = Add(tmp3, tmp4);
+    tmp4   = MUL_Q(Shl(Sub(tmp3, tmp4), 2), Qfmt_31(0.64072886193538F), 32);
+
+    /*  split even part of tmp_e */
+
+    tmp0 = Add(tmp7, tmp1);
+    tmp1 = MUL_Q(Sub(tmp7, tmp1), Qfmt_31(0.54119610014620F), 32);
+
+    tmp3 = MUL_Q(Shl(Sub(itmp_e1, itmp_e2), 1), Qfmt_31(0.65328148243819F), 32);
+    tmp7 = Add(itmp_e1, itmp_e2);
+
+    vec[ 0] = Sar(Add(tmp0, tmp7), 1);
+    vec[ 8] = MUL_Q(Sub(tmp0, tmp7), Qfmt_31(0.70710678118655F), 32);
+    tmp0    = MUL_Q(Shl(Sub(tmp1, tmp3), 1), Qfmt_31(0.70710678118655F), 32);
+    vec[ 4] = Add(Add(tmp1, tmp3), tmp0);
+    vec[12] = tmp0;
+
+    /*  split odd part of tmp_e */
+
+    tmp1 = MUL_Q(Shl(Sub(itmp_e0, tmp4), 1), Qfmt_31(0.54119610014620F), 32);
+    tmp7 = Add(itmp_e0, tmp4);
+
+    tmp3 = MUL_Q(Shl(Sub(tmp6, tmp5), 2), Qfmt_31(0.65328148243819F), 32);
+    tmp6 = Add(tmp6, tmp5);
+
+    tmp4 = MUL_Q(Shl(Sub(tmp7, tmp6), 1), Qfmt_31(0.70710678118655F), 32);
+    tmp6 = Add(tmp6, tmp7);
+    tmp7 = MUL_Q(Shl(Sub(tmp1, tmp3), 1), Qfmt_31(0.70710678118655F), 32);
+
+    tmp1    = Add(tmp1, Add(tmp3, tmp7));
+    vec[ 2] = Add(tmp1, tmp6);
+    vec[ 6] = Add(tmp1, tmp4);
+    vec[10] = Add(tmp7, tmp4);
+    vec[14] = tmp7;
+
+
+    // dct8;
+
+    tmp1 = MUL_Q(Shl(Sub(tmp_o0, tmp_o7), 1), Qfmt_31(0.50979557910416F), 32);
+    tmp7 = Add(tmp_o0, tmp_o7);
+
+    tmp6   = Add(tmp_o1, tmp_o6);
+    tmp_o1 = MUL_Q(Shl(Sub(tmp_o1, tmp_o6), 1), Qfmt_31(0.60134488693505F), 32);
+
+    tmp5   = Add(tmp_o2, tmp_o5);
+    tmp_o5 = MUL_Q(Shl(Sub(tmp_o2, tmp_o5), 1), Qfmt_31(0.89997622313642F), 32);
+
+    tmp0 = MUL_Q(Shl(Sub(tmp_o3, tmp_o4), 3), Qfmt_31(0.6407288619354F), 32);
+    tmp4 = Add(tmp_o3, tmp_o4);
+
+    if (!flag)
+    {
+        tmp7   = Neg(tmp7);
+        tmp1   = Neg(tmp1);
+        tmp6   = Neg(tmp6);
+        tmp_o1 = Neg(tmp_o1);
+        tmp5   = Neg(tmp5);
+        tmp_o5 = Neg(tmp_o5);
+        tmp4   = Neg(tmp4);
+        tmp0   = Neg(tmp0);
+    }
+
+    tmp2   = MUL_Q(Shl(Sub(tmp1, tmp0), 1), Qfmt_31(0.54119610014620F), 32);
+    tmp0   = Add(tmp0, tmp1);
+    tmp1   = MUL_Q(Shl(Sub(tmp7, tmp4), 1), Qfmt_31(0.54119610014620F), 32);
+    tmp7   = Add(tmp7, tmp4);
+    tmp4   = MUL_Q(Shl(Sub(tmp6, tmp5), 2), Qfmt_31(0.65328148243819F), 32);
+    tmp6   = Add(tmp6, tmp5);
+    tmp5   = MUL_Q(Shl(Sub(tmp_o1, tmp_o5), 2), Qfmt_31(0.65328148243819F), 32);
+    tmp_o1 = Add(tmp_o1, tmp_o5);
+
+    vec[13] = MUL_Q(Shl(Sub(tmp1, tmp4), 1), Qfmt_31(0.70710678118655F), 32);
+    vec[ 5] = Add(Add(tmp1, tmp4), vec[13]);
+
+    vec[ 9] = MUL_Q(Shl(Sub(tmp7, tmp6), 1), Qfmt_31(0.70710678118655F), 32);
+    vec[ 1] = Add(tmp7, tmp6);
+
+    tmp4 = MUL_Q(Shl(Sub(tmp0, tmp_o1), 1), Qfmt_31(0.70710678118655F), 32);
+    tmp0 = Add(tmp0, tmp_o1);
+    tmp6 = MUL_Q(Shl(Sub(tmp2, tmp5), 1), Qfmt_31(0.70710678118655F), 32);
+    tmp2 = Add(tmp2, Add(tmp5, tmp6));
+    tmp0 = Add(tmp0, tmp2);
+
+    vec[ 1] = Add(vec[ 1], tmp0);
+    vec[ 3] = Add(tmp0, vec[ 5]);
+    tmp2    = Add(tmp2, tmp4);
+    vec[ 5] = Add(tmp2, vec[ 5]);
+    vec[ 7] = Add(tmp2, vec[ 9]);
+    tmp4    = Add(tmp4, tmp6);
+    vec[ 9] = Add(tmp4, vec[ 9]);
+    vec[11] = Add(tmp4, vec[13]);
+    vec[13] = Add(tmp6, vec[13]);
+    vec[15] = tmp6;
+}
+
+
+/*
+ *  DCT 32 (pvmp3_split(), pvmp3_dct_16() and pvmp3_merge_in_place_N32())
+ *  of 4 time slots, one per lane
+ */
+static X86_TARGET void X86_FN(Dct32x4)(int32 *inData[4])
+{
+    __m128i x[SUBBANDS_NUMBER];
+    __m128i y[SUBBANDS_NUMBER];
+    int32 i;
+
+    for (i = 0; i < SUBBANDS_NUMBER; i += 4)
+    {
+        Load4x4(&x[i], &inData[0][i], &inData[1][i], &inData[2][i], &inData[3][i]);
+    }
+
+    /*  pvmp3_split(&inData[16]) */
+
+    for (i = 0; i < 6; i++)
+    {
+        __m128i tmp1 = x[15 - i];
+        __m128i tmp2 = x[16 + i];
+        x[15 - i] = Add(tmp1, tmp2);
+        x[16 + i] = MUL_Q(Sub(tmp1, tmp2), CosTable_dct32_x86[15 - i], 27);
+    }
+    for (; i < 16; i++)
+    {
+        __m128i tmp1 = x[15 - i];
+        __m128i tmp2 = x[16 + i];
+        x[15 - i] = Add(tmp1, tmp2);
+        x[16 + i] = MUL_Q(Shl(Sub(tmp1, tmp2), 1), CosTable_dct32_x86[15 - i], 32);
+    }
+
+    X86_FN(Dct16)(&x[16], 0);
+    X86_FN(Dct16)(x, 1);     // Even terms
+
+    /*  pvmp3_merge_in_place_N32() */
+
+    for (i = 0; i < 15; i++)
+    {
+        y[2*i    ] = x[i];
+        y[2*i + 1] = Add(x[16 + i], x[17 + i]);
+    }
+    y[30] = x[15];
+    y[31] = x[31];
+
+    for (i = 0; i < SUBBANDS_NUMBER; i += 4)
+    {
+        Store4x4(&y[i], &inData[0][i], &inData[1][i], &inData[2][i], &inData[3][i]);
+    }
+}
+
+
+/*
+ *  pvmp3_polyphase_filter_window(), the outputs j = 1..15 are computed
+ *  4 at a time, one per lane
+ */
+static X86_TARGET void X86_FN(PolyphaseFilterWindow)(int32 *synth_buffer,
+        int16 *outPcm,
+        int32 numChannels)
+{
+    int32 sum1;
+    int32 sum2;
+    const int32 *winPtr;
+    int32 i;
+    int32 j;
+    int32 m;
+
+    for (j = 1; j < SUBBANDS_NUMBER / 2; j += 4)
+    {
+        __m128i win[16];
+        __m128i vsum1 = _mm_set1_epi32(0x00000020);
+        __m128i vsum2 = _mm_set1_epi32(0x00000020);
+        int16 pcm[8];
+
+        /* window coefficients of j..j+3, one lane each. For j = 16 (the
+           last lane of the last group) this reads the next 16 entries of
+           the table, the result is not used */
+        winPtr = &pqmfSynthWin[(j - 1) << 4];
+        for (m = 0; m < 16; m += 4)
+        {
+            Load4x4(&win[m], &winPtr[m], &winPtr[m + 16], &winPtr[m + 32], &winPtr[m + 48]);
+        }
+
+        /* pt_1 = &synth_buffer[16 + j], pt_2 = &synth_buffer[16 - j] */
+        int32 *pt_1 = &synth_buffer[16 + j];
+        int32 *pt_2 = &synth_buffer[16 - j - 3];
+
+        for (m = 0; m < 4; m++)
+        {
+            __m128i temp1 = Load(&pt_1[SUBBANDS_NUMBER * (2*m)]);
+            __m128i temp3 = LoadReverse(&pt_2[SUBBANDS_NUMBER * (15 - 2*m)]);
+            __m128i temp2 = LoadReverse(&pt_2[SUBBANDS_NUMBER * (2*m + 1)]);
+            __m128i temp4 = Load(&pt_1[SUBBANDS_NUMBER * (14 - 2*m)]);
+            __m128i *w = &win[m << 2];
+
+            vsum1 = Add(vsum1, X86_MULQ(temp1, w[0], 32));
+            vsum2 = Add(vsum2, X86_MULQ(temp3, w[0], 32));
+            vsum2 = Add(vsum2, X86_MULQ(temp1, w[1], 32));
+            vsum1 = Sub(vsum1, X86_MULQ(temp3, w[1], 32));
+            vsum1 = Add(vsum1, X86_MULQ(temp2, w[2], 32));
+            vsum2 = Sub(vsum2, X86_MULQ(temp4, w[2], 32));
+            vsum2 = Add(vsum2, X86_MULQ(temp2, w[3], 32));
+            vsum1 = Add(vsum1, X86_MULQ(temp4, w[3], 32));
+        }
+
+        /* saturate16(sum >> 6) */
+        _mm_storeu_si128((__m128i*)pcm, _mm_packs_epi32(Sar(vsum1, 6), Sar(vsum2, 6)));
+
+        for (m = 0; m < 4 && (j + m) < SUBBANDS_NUMBER / 2; m++)
+        {
+            int32 k = (j + m) << (numChannels - 1);
+            outPcm[k] = pcm[m];
+            outPcm[(numChannels<<5) - k] = pcm[4 + m];
+        }
+    }
+
+    winPtr = &pqmfSynthWin[((SUBBANDS_NUMBER / 2) - 1) << 4];
+
+    sum1 = 0x00000020;
+    sum2 = 0x00000020;
+
+
+    for (i = 16; i < HAN_SIZE + 16; i += (SUBBANDS_NUMBER << 2))
+    {
+        int32 *pt_synth = &synth_buffer[i];
+        int32 temp1 = pt_synth[ 0                ];
+        int32 temp2 = pt_synth[ SUBBANDS_NUMBER  ];
+        int32 temp3 = pt_synth[ SUBBANDS_NUMBER/2];
+
+        sum1 = fxp_mac32_Q32(sum1, temp1, winPtr[0]) ;
+        sum1 = fxp_mac32_Q32(sum1, temp2, winPtr[1]) ;
+        sum2 = fxp_mac32_Q32(sum2, temp3, winPtr[2]) ;
+
+        temp1 = pt_synth[ SUBBANDS_NUMBER<<1 ];
+        temp2 = pt_synth[ 3*SUBBANDS_NUMBER  ];
+        temp3 = pt_synth[ SUBBANDS_NUMBER*5/2];
+
+        sum1 = fxp_mac32_Q32(sum1, temp1, winPtr[3]) ;
+        sum1 = fxp_mac32_Q32(sum1, temp2, winPtr[4]) ;
+        sum2 = fxp_mac32_Q32(sum2, temp3, winPtr[5]) ;
+
+        winPtr += 6;
+    }
+
+
+    outPcm[0] = saturate16(sum1 >> 6);
+    outPcm[(SUBBANDS_NUMBER/2)<<(numChannels-1)] = saturate16(sum2 >> 6);
+}
+
+
+static X86_TARGET void X86_FN(PolyPhaseSynthesis)(int32 *circ_buffer,
+        int32 numChannels,
+        int16 *outPcm)
+{
+    int32 pad[2][SUBBANDS_NUMBER];
+    int32 *inData[4];
+    int32 band;
+    int32 i;
+
+    /*
+     *  DCT 32 of all time slots first, 4 at a time. The window of a time
+     *  slot only reads its own slot and the slots above it in circ_buffer,
+     *  so it sees the same data as in the C band loop. 18 slots leave 2
+     *  lanes of the last group, they run on the pad buffer.
+     */
+    pv_memset(pad, 0, sizeof(pad));
+
+    for (band = 0; band < FILTERBANK_BANDS; band += 4)
+    {
+        for (i = 0; i < 4; i++)
+        {
+            if (band + i < FILTERBANK_BANDS)
+            {
+                inData[i] = &circ_buffer[544 - ((band + i) << 5)];
+            }
+            else
+            {
+                inData[i] = pad[(band + i) - FILTERBANK_BANDS];
+            }
+        }
+
+        X86_FN(Dct32x4)(inData);
+    }
+
+    for (band = 0; band < FILTERBANK_BANDS; band++)
+    {
+        X86_FN(PolyphaseFilterWindow)(&circ_buffer[544 - (band << 5)],
+                                      outPcm,
+                                      numChannels);
+
+        outPcm += (numChannels << 5);
+    }
+}
+
+
+/*
+ *  pvmp3_dct_9() on 4 lanes
+ */
+static inline X86_TARGET void X86_FN(Dct9)(__m128i *vec)
+{
+    /*  split input vector */
+
+    __m128i tmp0 = Add(vec[8], vec[0]);
+    __m128i tmp8 = Sub(vec[8], vec[0]);
+    __m128i tmp1 = Add(vec[7], vec[1]);
+    __m128i tmp7 = Sub(vec[7], vec[1]);
+    __m128i tmp2 = Add(vec[6], vec[2]);
+    __m128i tmp6 = Sub(vec[6], vec[2]);
+    __m128i tmp3 = Add(vec[5], vec[3]);
+    __m128i tmp5 = Sub(vec[5], vec[3]);
+
+    vec[0] = Add(Add(Add(tmp0, tmp2), tmp3), Add(tmp1, vec[4]));
+    vec[6] = Sub(Sar(Add(Add(tmp0, tmp2), tmp3), 1), Add(tmp1, vec[4]));
+    vec[2] = Sub(Sar(tmp1, 1), vec[4]);
+    vec[4] = Neg(vec[2]);
+    vec[8] = Neg(vec[2]);
+
+    tmp0 = Shl(tmp0, 1);
+    tmp2 = Shl(tmp2, 1);
+    tmp3 = Shl(tmp3, 1);
+    tmp5 = Shl(tmp5, 1);
+    tmp6 = Shl(tmp6, 1);
+    tmp7 = Shl(tmp7, 1);
+    tmp8 = Shl(tmp8, 1);
+
+    vec[4] = Add(vec[4], MUL_Q(tmp0, cos_2pi_9, 32));
+    vec[8] = Add(vec[8], MUL_Q(tmp0, cos_4pi_9, 32));
+    vec[2] = Add(vec[2], MUL_Q(tmp0, cos_pi_9, 32));
+    vec[2] = Add(vec[2], MUL_Q(tmp2, cos_5pi_9, 32));
+    vec[4] = Add(vec[4], MUL_Q(tmp2, cos_8pi_9, 32));
+    vec[8] = Add(vec[8], MUL_Q(tmp2, cos_2pi_9, 32));
+    vec[8] = Add(vec[8], MUL_Q(tmp3, cos_8pi_9, 32));
+    vec[4] = Add(vec[4], MUL_Q(tmp3, cos_4pi_9, 32));
+    vec[2] = Add(vec[2], MUL_Q(tmp3, cos_7pi_9, 32));
+
+    vec[1] = MUL_Q(tmp5, cos_11pi_18, 32);
+    vec[1] = Add(vec[1], MUL_Q(tmp6, cos_13pi_18, 32));
+    vec[1] = Add(vec[1], MUL_Q(tmp7, cos_5pi_6, 32));
+    vec[1] = Add(vec[1], MUL_Q(tmp8, cos_17pi_18, 32));
+    vec[3] = MUL_Q(Sub(Add(tmp5, tmp6), tmp8), cos_pi_6, 32);
+    vec[5] = MUL_Q(tmp5, cos_17pi_18, 32);
+    vec[5] = Add(vec[5], MUL_Q(tmp6, cos_7pi_18, 32));
+    vec[5] = Add(vec[5], MUL_Q(tmp7, cos_pi_6, 32));
+    vec[5] = Add(vec[5], MUL_Q(tmp8, cos_13pi_18, 32));
+    vec[7] = MUL_Q(tmp5, cos_5pi_18, 32);
+    vec[7] = Add(vec[7], MUL_Q(tmp6, cos_17pi_18, 32));
+    vec[7] = Add(vec[7], MUL_Q(tmp7, cos_pi_6, 32));
+    vec[7] = Add(vec[7], MUL_Q(tmp8, cos_11pi_18, 32));
+}
+
+
+/*
+ *  pvmp3_mdct_18() of 4 subbands, one per lane
+ */
+static X86_TARGET void X86_FN(Mdct18x4)(int32 in[], int32 *overlap, const int32 *window)
+{
+    __m128i vec[FILTERBANK_BANDS];
+    __m128i history[FILTERBANK_BANDS];
+    __m128i prev[9];
+    __m128i tmp, tmp1, tmp2, tmp3, tmp4;
+    int32 i;
+
+    Load4x18(vec, in);
+    Load4x18(history, overlap);
+
+    for (i = 0; i < 9; i++)
+    {
+        tmp  = MUL_Q(Shl(vec[i], 1), cosTerms_1_ov_cos_phi_x86[i], 32);
+        tmp1 = MUL_Q(vec[17 - i], cosTerms_1_ov_cos_phi_x86[17 - i], 27);
+        vec[i]      = Add(tmp, tmp1);
+        vec[17 - i] = MUL_Q(Sub(tmp, tmp1), cosTerms_dct18_x86[i], 28);
+    }
+
+
+    X86_FN(Dct9)(vec);         // Even terms
+    X86_FN(Dct9)(&vec[9]);     // Odd  terms
+
+
+    tmp3     = vec[16];
+    vec[16]  = vec[ 8];
+    tmp4     = vec[14];
+    vec[14]  = vec[ 7];
+    tmp      = vec[12];
+    vec[12]  = vec[ 6];
+    tmp2     = vec[10];
+    vec[10]  = vec[ 5];
+    vec[ 8]  = vec[ 4];
+    vec[ 6]  = vec[ 3];
+    vec[ 4]  = vec[ 2];
+    vec[ 2]  = vec[ 1];
+    vec[ 1]  = Sub(vec[ 9], tmp2);
+    vec[ 3]  = Sub(vec[11], tmp2);
+    vec[ 5]  = Sub(vec[11], tmp);
+    vec[ 7]  = Sub(vec[13], tmp);
+    vec[ 9]  = Sub(vec[13], tmp4);
+    vec[11]  = Sub(vec[15], tmp4);
+    vec[13]  = Sub(vec[15], tmp3);
+    vec[15]  = Sub(vec[17], tmp3);
+
+
+    /* overlap and add */
+
+    tmp2 = vec[0];
+    tmp3 = vec[9];
+
+    for (i = 0; i < 6; i++)
+    {
+        tmp  = history[ i];
+        tmp4 = vec[i+10];
+        vec[i+10] = Add(tmp3, tmp4);
+        tmp1 = vec[i+1];
+        vec[ i] = Add(tmp, MUL_Q(vec[i+10], window[i], 32));
+        tmp3 = tmp4;
+        history[i] = Neg(Add(tmp2, tmp1));
+        tmp2 = tmp1;
+    }
+
+    tmp  = history[ 6];
+    tmp4 = vec[16];
+    vec[16] = Add(tmp3, tmp4);
+    tmp1 = vec[7];
+    vec[ 6] = Add(tmp, MUL_Q(Shl(vec[16], 1), window[6], 32));
+    tmp  = history[ 7];
+    history[6] = Neg(Add(tmp2, tmp1));
+    history[7] = Neg(Add(tmp1, vec[8]));
+
+    tmp1    = history[ 8];
+    tmp4    = Add(vec[17], tmp4);
+    vec[ 7] = Add(tmp, MUL_Q(Shl(tmp4, 1), window[7], 32));
+    history[8] = Neg(Add(vec[8], vec[9]));
+    vec[ 8] = Add(tmp1, MUL_Q(Shl(vec[17], 1), window[8], 32));
+
+    tmp  = history[9];
+    tmp1 = history[17];
+    tmp2 = history[16];
+    vec[ 9] = Add(tmp, MUL_Q(Shl(vec[17], 1), window[9], 32));
+
+    vec[17] = Add(tmp1, MUL_Q(Shl(vec[10], 1), window[17], 32));
+    vec[10] = Neg(vec[16]);
+    vec[16] = Add(tmp2, MUL_Q(Shl(vec[11], 1), window[16], 32));
+    tmp1 = history[15];
+    tmp2 = history[14];
+    vec[11] = Neg(vec[15]);
+    vec[15] = Add(tmp1, MUL_Q(Shl(vec[12], 1), window[15], 32));
+    vec[12] = Neg(vec[14]);
+    vec[14] = Add(tmp2, MUL_Q(Shl(vec[13], 1), window[14], 32));
+
+    tmp  = history[13];
+    tmp1 = history[12];
+    tmp2 = history[11];
+    tmp3 = history[10];
+    vec[13] = Add(tmp,  MUL_Q(Shl(vec[12], 1), window[13], 32));
+    vec[12] = Add(tmp1, MUL_Q(Shl(vec[11], 1), window[12], 32));
+    vec[11] = Add(tmp2, MUL_Q(Shl(vec[10], 1), window[11], 32));
+    vec[10] = Add(tmp3, MUL_Q(Shl(tmp4, 1), window[10], 32));
+
+
+    /* next iteration overlap */
+
+    for (i = 0; i < 9; i++)
+    {
+        prev[i] = Shl(history[i], 1);
+    }
+
+    for (i = 0; i < 9; i++)
+    {
+        history[8 - i] = MUL_Q(prev[i], window[26 - i], 32);
+        history[9 + i] = MUL_Q(prev[i], window[27 + i], 32);
+    }
+
+    Store4x18(vec, in);
+    Store4x18(history, overlap);
+}
+
+
+#undef MUL_Q
+
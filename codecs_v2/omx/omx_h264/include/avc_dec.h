@@ -33,6 +33,12 @@
 
 #define AVC_DEC_TIMESTAMP_ARRAY_SIZE 17
 
+// Number of threads that deblock each picture while it is being decoded.
+// 0 deblocks the picture in the decoder thread once it is complete.
+#ifndef AVC_DEC_DEBLOCK_THREADS
+#define AVC_DEC_DEBLOCK_THREADS 0
+#endif
+
 class AVCCleanupObject_OMX
 {
         AVCHandle* ipavcHandle;
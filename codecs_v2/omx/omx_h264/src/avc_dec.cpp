@@ -223,6 +223,11 @@ OMX_BOOL AvcDecoder_OMX::AvcDecodeVideo_OMX(OMX_U8* aOutBuffer, OMX_U32* aOutput
             return OMX_FALSE;
         }
 
+#if (AVC_DEC_DEBLOCK_THREADS > 0)
+        // falls back to deblocking in this thread if the threads can't be started
+        PVAVCDecSetDeblockThreads(&(AvcHandle), AVC_DEC_DEBLOCK_THREADS);
+#endif
+
         pDecVid = (AVCDecObject*) AvcHandle.AVCObject;
 
         Width = (pDecVid->seqParams[0]->pic_width_in_mbs_minus1 + 1) * 16;
@@ -9,7 +9,9 @@ LOCAL_SRC_FILES := \
  	src/cczoomrotation16.cpp \
  	src/cczoomrotation24.cpp \
  	src/cczoomrotation32.cpp \
+ 	src/cczoomrotation_x86.cpp \
  	src/cczoomrotationbase.cpp \
+ 	src/ccbandthreads.cpp \
  	src/cpvvideoblend.cpp \
  	src/ccrgb24toyuv420.cpp \
  	src/ccrgb12toyuv420.cpp \
@@ -45,6 +47,7 @@ LOCAL_COPY_HEADERS := \
  	include/cczoomrotation16.h \
  	include/cczoomrotation24.h \
  	include/cczoomrotation32.h \
+ 	include/cczoomrotation_x86.h \
  	include/ccrgb16toyuv420.h \
  	include/ccrgb24torgb16.h \
  	include/ccyuv422toyuv420.h \
@@ -22,7 +22,9 @@ SRCS :=	ccrgb16toyuv420.cpp \
 	cczoomrotation16.cpp \
 	cczoomrotation24.cpp \
 	cczoomrotation32.cpp \
+	cczoomrotation_x86.cpp \
 	cczoomrotationbase.cpp \
+	ccbandthreads.cpp \
 	cpvvideoblend.cpp \
 	ccrgb24toyuv420.cpp \
 	ccrgb12toyuv420.cpp \
@@ -34,6 +36,7 @@ HDRS :=  cczoomrotationbase.h \
 	cczoomrotation16.h \
 	cczoomrotation24.h \
 	cczoomrotation32.h \
+	cczoomrotation_x86.h \
 	ccrgb16toyuv420.h \
 	ccrgb24torgb16.h \
 	ccyuv422toyuv420.h \
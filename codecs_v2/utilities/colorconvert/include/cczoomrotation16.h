@@ -54,8 +54,12 @@ class ColorConvert16: public ColorConvertBase
 
         int32 cc16Rotate(uint8 **src, uint8 *dst, DisplayProperties *disp, uint8 *COFF_TBL);
         int32 cc16ZoomIn(uint8 **src, uint8 *dst, DisplayProperties *disp, uint8 *COFF_TBL);
+        int32 cc16ZoomScale(uint8 **src, uint8 *dst, DisplayProperties *disp, uint8 *COFF_TBL);
         int32 cc16ZoomRotate(uint8 **src, uint8 *dst, DisplayProperties *disp, uint8 *COFF_TBL);
 
+        bool GetBandLayout(BandLayout *layout);
+        int32 ConvertBand(uint8 **src, uint8 *dst, DisplayProperties *disp);
+
     private:
         int32(ColorConvert16::*mPtrYUV2RGB)(uint8 **src, uint8 *dst, DisplayProperties *disp, uint8 *COFF_TBL);
 };
@@ -56,6 +56,9 @@ class ColorConvert24: public ColorConvertBase
         int32 cc24ZoomRotate(uint8 **src, uint8 *dst, DisplayProperties *disp, uint8 *COFF_TBL);
 
     private:
+        bool GetBandLayout(BandLayout *layout);
+        int32 ConvertBand(uint8 **src, uint8 *dst, DisplayProperties *disp);
+
         int32(ColorConvert24::*mPtrYUV2RGB)(uint8 **src, uint8 *dst, DisplayProperties *disp, uint8 *COFF_TBL);
 
 };
@@ -0,0 +1,77 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef CCZOOMROTATION_X86_H_INCLUDED
+#define CCZOOMROTATION_X86_H_INCLUDED
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+
+#ifndef COLORCONV_CONFIG_H_INCLUDED
+#include "colorconv_config.h"
+#endif
+
+/**
+*   x86 SIMD versions of cc16, cc24 and cc32, the YUV420 to RGB conversion
+*   without zoom and rotation. They take the same arguments as the C versions
+*   and produce the same output bit for bit, including the vertical flip of
+*   disp[6]. The reverse (disp[6]^disp[7]), rotation and zoom paths stay in C.
+*
+*   Instead of looking up the clip table, the SIMD code computes the clip
+*   table values directly. CCX86InitCoef checks the computed values against
+*   the clip table, and leaves the SIMD code disabled if any of them differ.
+*/
+
+typedef struct
+{
+    int16 y0;       // table index of the first non-zero entry, minus 1
+    int16 kmax;     // last table index above y0 that is not saturated
+    uint16 frac;    // table value is k + ((k*frac)>>16), for k = index - y0
+    int16 dither[4];// RGB16 only, the 5 and 6 bit dither offsets of the left/right pixels
+    bool enabled;   // set if the SIMD version can be used
+} CCX86Coef;
+
+//the coefficients are a member of ColorConvertBase whether or not CCX86SIMD is set,
+//so the class layout doesn't depend on it.
+#if CCX86SIMD
+
+/**
+*   Set up the SIMD coefficients for ColorConvert16.
+*   @param coef     coefficients to set up
+*   @param coff_tbl ColorConvert16 coefficient table, the clip table starts at coff_tbl+400
+*   @param fullRange true for full range (0-255) YUV
+*   @param dither   OFFSET_5_0, OFFSET_5_1, OFFSET_6_0 and OFFSET_6_1 of cc16
+*/
+void CCX86InitCoef16(CCX86Coef *coef, uint8 *coff_tbl, bool fullRange, const int32 *dither);
+
+/**
+*   Set up the SIMD coefficients for ColorConvert24 or ColorConvert32.
+*   @param coef     coefficients to set up
+*   @param clip     clip table, the color coefficients are at clip-400
+*   @param fullRange true for full range (0-255) YUV
+*   @param rgb24    true for ColorConvert24, which also needs SSSE3
+*/
+void CCX86InitCoef(CCX86Coef *coef, uint8 *clip, bool fullRange, bool rgb24);
+
+int32 cc16_x86(uint8 **src, uint8 *dst, int32 *disp, uint8 *coff_tbl, const CCX86Coef *coef);
+int32 cc24_x86(uint8 **src, uint8 *dst, int32 *disp, uint8 *clip, const CCX86Coef *coef);
+int32 cc32_x86(uint8 **src, uint8 *dst, int32 *disp, uint8 *clip, const CCX86Coef *coef);
+
+#endif // CCX86SIMD
+
+#endif // CCZOOMROTATION_X86_H_INCLUDED
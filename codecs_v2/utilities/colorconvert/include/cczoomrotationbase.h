@@ -31,6 +31,10 @@
 #include "colorconv_config.h"
 #endif
 
+#ifndef CCZOOMROTATION_X86_H_INCLUDED
+#include "cczoomrotation_x86.h"
+#endif
+
 /* add capability support */
 #define  CCSUPPORT_ROTATION     0x1
 #define  CCSUPPORT_SCALING      0x2
@@ -43,6 +47,8 @@
 #define CCFLIP                   4
 #define CCBOTTOM_UP              8
 
+class CCBandThreads;
+
 /**
 *   Description - This is the base class of color converter classes.
 *   Each of the 3 libraries needs to include this class in the project.
@@ -157,6 +163,18 @@ class ColorConvertBase
 
         virtual int32  SetYuvFullRange(bool range) = 0;
 
+        /**
+        *   @brief This function sets the number of threads used by Convert(). The source is split
+        *   into bands of rows, which are converted in parallel on a pool of worker threads and on
+        *   the calling thread. Convert() returns when all bands are done. The output is the same
+        *   as with one thread. Modes that cannot be split, e.g. the RGB16 scaling kernels for the
+        *   fixed zoom ratios, are still converted on the calling thread only.
+        *   @param aNumThreads is the number of threads including the calling thread, up to
+        *   CCMAXTHREADS. 0 or 1 turns the threaded mode off, which is the default.
+        *   @return the number of threads that will be used.
+        */
+        OSCL_IMPORT_REF int32 SetNumThreads(int32 aNumThreads);
+
     protected:
 
         /** Internal structure for display property. This structure contains all configuration related
@@ -176,6 +194,9 @@ class ColorConvertBase
             int32 dst_width;
             /** @brief Height of the desired output (in pixel) */
             int32 dst_height;
+            /** @brief Scaling tables to use, _mRowPix and _mColPix or a part of them for a band */
+            uint8 *row_pix;
+            uint8 *col_pix;
         } DisplayProperties ;
         DisplayProperties _mDisp;
 
@@ -187,6 +208,54 @@ class ColorConvertBase
         int32 _mState;  //Zoom? Rotation? etc
         bool _mIsFlip;
         bool _mYuvRange;
+        CCX86Coef _mX86Coef; // set up by SetYuvFullRange of the RGB16/24/32 classes
+
+        /** How the source rows of the current mode map to the output, for the threaded Convert() */
+        typedef struct
+        {
+            /** @brief Output bytes per pixel */
+            int32 bytes_per_pixel;
+            /** @brief Source rows are output columns (90 degree rotation) */
+            bool rotate;
+            /** @brief The first source row is the last output row (column) */
+            bool reverse;
+            /** @brief Source rows are scaled, the repetition count of each row is in the
+            *   table of the source rows, col_pix, or row_pix when rotated */
+            bool scaled;
+            /** @brief The scaling kernel reads the table from the end, i.e. the count of
+            *   source row i is at index src_height-1-i */
+            bool table_reversed;
+        } BandLayout;
+
+        /**
+        *   @brief Converts the frame in bands if the threaded mode is on and the current mode can
+        *   be split, otherwise it does nothing.
+        *   @return 1 if the frame was converted, 0 if the caller must convert it.
+        */
+        int32 ConvertBands(uint8 **src, uint8 *dst);
+
+        /**
+        *   @brief Returns the layout of the current mode, or false if it cannot be split.
+        */
+        virtual bool GetBandLayout(BandLayout *layout)
+        {
+            OSCL_UNUSED_ARG(layout);
+            return false;
+        };
+
+        /**
+        *   @brief Converts one band with the current mode. src, dst and disp describe the band
+        *   as if it was a complete frame.
+        */
+        virtual int32 ConvertBand(uint8 **src, uint8 *dst, DisplayProperties *disp)
+        {
+            OSCL_UNUSED_ARG(src);
+            OSCL_UNUSED_ARG(dst);
+            OSCL_UNUSED_ARG(disp);
+            return 0;
+        };
+
+        CCBandThreads *_mThreads;
 
     private:
         /**
@@ -199,6 +268,17 @@ class ColorConvertBase
         */
         void StretchLine(uint8 *pLinePix, int32 iSrcLen, int32 iDstLen);
 
+        /** One band of the threaded Convert() */
+        typedef struct
+        {
+            ColorConvertBase *cc;
+            uint8 *src[3];
+            uint8 *dst;
+            DisplayProperties disp;
+        } Band;
+
+        static void ConvertBandJob(OsclAny *aContext, int32 aBand);
+
 };
 #endif // CCZOOMROTATIONBASE_H_INCLUDED
 
@@ -28,6 +28,40 @@
 /** To specify RGB format. define RGB_FORMAT to 1. For, BGR format, set it to 0 */
 #define RGB_FORMAT  0
 
+/** For x86 SIMD YUV420 to RGB16/24/32 conversion, define CCX86SIMD to 1, else set it to 0.
+    It needs SSE2, so by default it is on only when the compiler targets SSE2.
+    CCX86SSSE3 adds the SSSE3 RGB24 packing, which is used only if the CPU supports SSSE3. */
+#ifndef CCX86SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define CCX86SIMD 1
+#else
+#define CCX86SIMD 0
+#endif
+#endif
+
+#ifndef CCX86SSSE3
+#if (CCX86SIMD) && defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9) || defined(__clang__))
+#define CCX86SSSE3 1
+#else
+#define CCX86SSSE3 0
+#endif
+#endif
+
+#if !(CCX86SIMD)
+#undef CCX86SSSE3
+#define CCX86SSSE3 0
+#endif
+
+/** For the threaded Convert() of ColorConvertBase::SetNumThreads, define CCTHREADS to 1, else set it to 0.
+    By default it follows the thread support of the platform. CCMAXTHREADS is the largest number of
+    threads, including the calling thread. */
+#ifndef CCTHREADS
+#include "osclconfig_proc.h"
+#define CCTHREADS OSCL_HAS_THREAD_SUPPORT
+#endif
+
+#define CCMAXTHREADS 8
+
 /********************************************************************************************
  For YUV422 to YUV420 conversion, the Input YUV422 data can be in three forms:-
     ENDIAN_1 :
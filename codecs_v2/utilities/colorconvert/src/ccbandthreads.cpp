@@ -0,0 +1,158 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/** Worker threads for the threaded Convert() of ColorConvertBase. */
+#include "ccbandthreads.h"
+
+#if CCTHREADS
+
+#include "oscl_mem.h"
+
+CCBandThreads::CCBandThreads(): iNumWorkers(0), iJob(NULL), iContext(NULL), iQuit(false)
+{
+}
+
+CCBandThreads::~CCBandThreads()
+{
+}
+
+CCBandThreads* CCBandThreads::New(int32 aNumThreads)
+{
+    CCBandThreads *self;
+    int32 i;
+
+    if (aNumThreads > CCMAXTHREADS)
+    {
+        aNumThreads = CCMAXTHREADS;
+    }
+    if (aNumThreads < 2)
+    {
+        return NULL;
+    }
+
+    self = OSCL_NEW(CCBandThreads, ());
+    if (self == NULL)
+    {
+        return NULL;
+    }
+
+    self->iDone.Create();
+
+    for (i = 0; i < aNumThreads - 1; i++)
+    {
+        CCBandWorker *worker = &self->iWorker[i];
+        OsclThread thread;
+
+        worker->owner = self;
+        worker->index = i + 1;
+        worker->wake.Create();
+        worker->exit.Create();
+
+        if (thread.Create((TOsclThreadFuncPtr)ThreadMain, 0, (TOsclThreadFuncArg)worker) != OsclProcStatus::SUCCESS_ERROR)
+        {
+            worker->wake.Close();
+            worker->exit.Close();
+            break;
+        }
+        self->iNumWorkers++;
+    }
+
+    if (self->iNumWorkers == 0)
+    {
+        Delete(self);
+        return NULL;
+    }
+
+    return self;
+}
+
+void CCBandThreads::Delete(CCBandThreads *aThreads)
+{
+    int32 i;
+
+    if (aThreads == NULL)
+    {
+        return ;
+    }
+
+    aThreads->iQuit = true;
+    for (i = 0; i < aThreads->iNumWorkers; i++)
+    {
+        aThreads->iWorker[i].wake.Signal();
+    }
+
+    for (i = 0; i < aThreads->iNumWorkers; i++)
+    {
+        aThreads->iWorker[i].exit.Wait();
+        aThreads->iWorker[i].wake.Close();
+        aThreads->iWorker[i].exit.Close();
+    }
+
+    aThreads->iDone.Close();
+
+    OSCL_DELETE(aThreads);
+}
+
+void CCBandThreads::Run(CCBandJob aJob, OsclAny *aContext, int32 aNumBands)
+{
+    int32 i;
+
+    OSCL_ASSERT(aNumBands <= iNumWorkers + 1);
+
+    iJob = aJob;
+    iContext = aContext;
+
+    for (i = 1; i < aNumBands; i++)
+    {
+        iWorker[i-1].wake.Signal();
+    }
+
+    (*aJob)(aContext, 0);
+
+    /* join, each woken worker signals once */
+    for (i = 1; i < aNumBands; i++)
+    {
+        iDone.Wait();
+    }
+
+    iJob = NULL;
+    iContext = NULL;
+}
+
+TOsclThreadFuncRet OSCL_THREAD_DECL CCBandThreads::ThreadMain(TOsclThreadFuncArg aArg)
+{
+    CCBandWorker *worker = (CCBandWorker*)aArg;
+    CCBandThreads *self = worker->owner;
+
+    for (;;)
+    {
+        worker->wake.Wait();
+        if (self->iQuit)
+        {
+            break;
+        }
+
+        (*self->iJob)(self->iContext, worker->index);
+
+        self->iDone.Signal();
+    }
+
+    worker->exit.Signal();
+    return 0;
+}
+
+#endif // CCTHREADS
@@ -0,0 +1,98 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef CCBANDTHREADS_H_INCLUDED
+#define CCBANDTHREADS_H_INCLUDED
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+
+#ifndef COLORCONV_CONFIG_H_INCLUDED
+#include "colorconv_config.h"
+#endif
+
+#if CCTHREADS
+
+#ifndef OSCL_THREAD_H_INCLUDED
+#include "oscl_thread.h"
+#endif
+
+#ifndef OSCL_SEMAPHORE_H_INCLUDED
+#include "oscl_semaphore.h"
+#endif
+
+/** Band job, called with the job context and the band index. */
+typedef void (*CCBandJob)(OsclAny *aContext, int32 aBand);
+
+class CCBandThreads;
+
+/** Per-thread state of CCBandThreads. */
+typedef struct
+{
+    CCBandThreads *owner;
+    int32 index;            // band run by this thread
+    OsclSemaphore wake;     // signaled when there is a band to run, or on exit
+    OsclSemaphore exit;     // signaled when the thread exits
+} CCBandWorker;
+
+/**
+*   A small pool of persistent worker threads for ColorConvertBase. Run() calls
+*   the job once for each band, band 0 on the calling thread and band i on
+*   worker i, and returns after all of them are done. Since each band always
+*   goes to the same thread and the bands write disjoint parts of the output,
+*   the result does not depend on the thread timing.
+*/
+class CCBandThreads
+{
+    public:
+        /**
+        *   @param aNumThreads total number of threads, including the calling thread.
+        *   @return NULL if no worker thread could be started.
+        */
+        static CCBandThreads* New(int32 aNumThreads);
+        static void Delete(CCBandThreads *aThreads);
+
+        /** @return the number of threads, including the calling thread. */
+        int32 NumThreads()
+        {
+            return iNumWorkers + 1;
+        };
+
+        /** Run aJob for the bands 0 to aNumBands-1. aNumBands must not be larger than NumThreads(). */
+        void Run(CCBandJob aJob, OsclAny *aContext, int32 aNumBands);
+
+    private:
+        CCBandThreads();
+        ~CCBandThreads();
+
+        static TOsclThreadFuncRet OSCL_THREAD_DECL ThreadMain(TOsclThreadFuncArg aArg);
+
+        CCBandWorker iWorker[CCMAXTHREADS-1];
+        int32 iNumWorkers;
+
+        // current job, set before the workers are woken up
+        CCBandJob iJob;
+        OsclAny *iContext;
+        bool iQuit;
+
+        OsclSemaphore iDone;    // signaled by each worker after its band
+};
+
+#endif // CCTHREADS
+
+#endif // CCBANDTHREADS_H_INCLUDED
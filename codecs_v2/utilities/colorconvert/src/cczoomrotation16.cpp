@@ -151,6 +151,13 @@ int32  ColorConvert16::SetYuvFullRange(bool range)
         oscl_memset(&clip[1279], 63, 385*sizeof(*clip));
     }
 
+#if CCX86SIMD
+    {
+        const int32 dither[4] = {OFFSET_5_0, OFFSET_5_1, OFFSET_6_0, OFFSET_6_1};
+        CCX86InitCoef16(&_mX86Coef, mCoefTbl, _mYuvRange, dither);
+    }
+#endif
+
     return 1; // success
 }
 
@@ -231,7 +238,10 @@ int32 ColorConvert16::Convert(uint8 **yuvBuf, uint8 *rgbBuf)
         return 0;
     }
 
-    (*this.*mPtrYUV2RGB)(yuvBuf, rgbBuf, &_mDisp, (uint8 *)mCoefTbl);
+    if (!ConvertBands(yuvBuf, rgbBuf))
+    {
+        (*this.*mPtrYUV2RGB)(yuvBuf, rgbBuf, &_mDisp, (uint8 *)mCoefTbl);
+    }
 
     return 1;
 }
@@ -255,7 +265,10 @@ int32 ColorConvert16::Convert(uint8 *yuvBuf, uint8 *rgbBuf)
     TmpYuvBuf[1]    =   yuvBuf + (_mSrc_pitch) * (_mSrc_mheight);
     TmpYuvBuf[2]    =   TmpYuvBuf[1] + (_mSrc_pitch * _mSrc_mheight) / 4;
 
-    (*this.*mPtrYUV2RGB)(TmpYuvBuf, rgbBuf, &_mDisp, (uint8 *)mCoefTbl);
+    if (!ConvertBands(TmpYuvBuf, rgbBuf))
+    {
+        (*this.*mPtrYUV2RGB)(TmpYuvBuf, rgbBuf, &_mDisp, (uint8 *)mCoefTbl);
+    }
 
     return 1;
 }
@@ -283,6 +296,12 @@ int32 ColorConvert16::get_frame16(uint8 **src, uint8 *dst, DisplayProperties *di
     }
     else
     {
+#if CCX86SIMD
+        if (_mX86Coef.enabled)
+        {
+            return cc16_x86(src, dst, disp_prop, coff_tbl, &_mX86Coef);
+        }
+#endif
         return cc16(src, dst, disp_prop, coff_tbl);
     }
 }
@@ -939,23 +958,13 @@ int32 cc16scaling43(uint8 **src, uint8 *dst,
 int32 cc16scaling128x96(uint8 **src, uint8 *dst,
                         int32 *disp, uint8 *coff_tbl);
 
-// Note:: This zoom algorithm needs an extra line of RGB buffer. So, users
-// have to use GetOutputBufferSize API to get the size it needs. See GetOutputBufferSize().
-int32 ColorConvert16::cc16ZoomIn(uint8 **src, uint8 *dst, DisplayProperties *disp, uint8 *coff_tbl)
+typedef int32(*CC16FixedScaling)(uint8 **src, uint8 *dst, int32 *disp, uint8 *coff_tbl);
+
+/* returns the special kernel for the fixed zoom ratios, or NULL for the generic scaling */
+static CC16FixedScaling cc16FixedScaling(int32 src_width, int32 src_height, int32 dst_width, int32 dst_height)
 {
-    int32 disp_prop[8];
-    int32 src_width, src_height, dst_width, dst_height;
     int32 tempw, temph;
 
-    disp_prop[0] = disp->src_pitch;
-    disp_prop[1] = disp->dst_pitch;
-    disp_prop[2] = src_width = disp->src_width;
-    disp_prop[3] = src_height = disp->src_height;
-    disp_prop[4] = dst_width = disp->dst_width;
-    disp_prop[5] = dst_height = disp->dst_height;
-    disp_prop[6] = (_mRotation > 0 ? 1 : 0);
-    disp_prop[7] = _mIsFlip;
-
     if (src_width > dst_width) /* scale down in width */
     {
         tempw = (3 * src_width) >> 2;
@@ -963,17 +972,13 @@ int32 ColorConvert16::cc16ZoomIn(uint8 **src, uint8 *dst, DisplayProperties *dis
         /* check for special zoom-out case, 3:4 scaling down */
         if (dst_width == tempw  &&  dst_height == temph && !(src_width&3))
         {
-            return cc16scaling34(src, dst, disp_prop, coff_tbl);
+            return &cc16scaling34;
         }
         else
         {
             if ((dst_width == (src_width >> 1)) && (dst_height == (src_height >> 1)))
             {
-                return cc16scalingHalf(src, dst, disp_prop, coff_tbl);
-            }
-            else
-            {
-                return cc16scaledown(src, dst, disp_prop, coff_tbl, _mRowPix, _mColPix);
+                return &cc16scalingHalf;
             }
         }
     }
@@ -985,7 +990,7 @@ int32 ColorConvert16::cc16ZoomIn(uint8 **src, uint8 *dst, DisplayProperties *dis
         /* check for special zoom-out case, 5:4 scaling up */
         if (dst_width == tempw  &&  dst_height == temph && !(src_width&3))
         {
-            return cc16scaling54(src, dst, disp_prop, coff_tbl);
+            return &cc16scaling54;
         }
         else
         {
@@ -993,26 +998,133 @@ int32 ColorConvert16::cc16ZoomIn(uint8 **src, uint8 *dst, DisplayProperties *dis
             temph = (4 * src_height) / 3;
             if (dst_width == tempw  &&  dst_height == temph && !(src_width&3))
             {
-                return cc16scaling43(src, dst, disp_prop, coff_tbl);
+                return &cc16scaling43;
             }
+#ifdef SPECIAL_SCALE_128x96
             else
             {
                 tempw = (15 * src_width) / 8;
                 temph = (15 * src_height) / 8;
-#ifdef SPECIAL_SCALE_128x96
                 if (dst_width == tempw  &&  dst_height == temph && !(src_width&7))
                 {
-                    return cc16scaling128x96(src, dst, disp_prop, coff_tbl);
-                }
-                else
-#endif
-                {
-                    return cc16scaleup(src, dst, disp_prop, coff_tbl, _mRowPix, _mColPix);
+                    return &cc16scaling128x96;
                 }
             }
+#endif
+        }
+    }
+    return NULL;
+}
+
+// Note:: This zoom algorithm needs an extra line of RGB buffer. So, users
+// have to use GetOutputBufferSize API to get the size it needs. See GetOutputBufferSize().
+int32 ColorConvert16::cc16ZoomIn(uint8 **src, uint8 *dst, DisplayProperties *disp, uint8 *coff_tbl)
+{
+    int32 disp_prop[8];
+    CC16FixedScaling fixed;
+
+    fixed = cc16FixedScaling(disp->src_width, disp->src_height, disp->dst_width, disp->dst_height);
+    if (fixed == NULL)
+    {
+        return cc16ZoomScale(src, dst, disp, coff_tbl);
+    }
+
+    disp_prop[0] = disp->src_pitch;
+    disp_prop[1] = disp->dst_pitch;
+    disp_prop[2] = disp->src_width;
+    disp_prop[3] = disp->src_height;
+    disp_prop[4] = disp->dst_width;
+    disp_prop[5] = disp->dst_height;
+    disp_prop[6] = (_mRotation > 0 ? 1 : 0);
+    disp_prop[7] = _mIsFlip;
+
+    return (*fixed)(src, dst, disp_prop, coff_tbl);
+}
+
+/* generic scaling with the _mRowPix and _mColPix tables, any zoom ratio */
+int32 ColorConvert16::cc16ZoomScale(uint8 **src, uint8 *dst, DisplayProperties *disp, uint8 *coff_tbl)
+{
+    int32 disp_prop[8];
+
+    disp_prop[0] = disp->src_pitch;
+    disp_prop[1] = disp->dst_pitch;
+    disp_prop[2] = disp->src_width;
+    disp_prop[3] = disp->src_height;
+    disp_prop[4] = disp->dst_width;
+    disp_prop[5] = disp->dst_height;
+    disp_prop[6] = (_mRotation > 0 ? 1 : 0);
+    disp_prop[7] = _mIsFlip;
+
+    if (disp->src_width > disp->dst_width) /* scale down in width */
+    {
+        return cc16scaledown(src, dst, disp_prop, coff_tbl, disp->row_pix, disp->col_pix);
+    }
+    else
+    {
+        return cc16scaleup(src, dst, disp_prop, coff_tbl, disp->row_pix, disp->col_pix);
+    }
+}
+
+bool ColorConvert16::GetBandLayout(BandLayout *layout)
+{
+    layout->bytes_per_pixel = 2;
+    layout->rotate = false;
+    layout->reverse = false;
+    layout->scaled = false;
+    layout->table_reversed = false;
+
+    if (mPtrYUV2RGB == &ColorConvert16::get_frame16)
+    {
+        layout->reverse = (_mRotation > 0);
+        return true;
+    }
+    if (mPtrYUV2RGB == &ColorConvert16::cc16Rotate)
+    {
+        layout->rotate = true;
+        layout->reverse = ((_mRotation == CCROTATE_CLKWISE) != _mIsFlip);
+        return true;
+    }
+    if (mPtrYUV2RGB == &ColorConvert16::cc16ZoomIn)
+    {
+        /* the kernels for the fixed ratios work on groups of rows */
+        if (cc16FixedScaling(_mDisp.src_width, _mDisp.src_height, _mDisp.dst_width, _mDisp.dst_height))
+        {
+            return false;
         }
+        layout->reverse = (_mRotation > 0);
+        layout->scaled = true;
+        /* cc16scaleup reads the table from the end unless rotated and flipped, cc16scaledown only
+           when not rotated */
+        if (_mDisp.src_width > _mDisp.dst_width)
+        {
+            layout->table_reversed = (_mRotation == 0);
+        }
+        else
+        {
+            layout->table_reversed = !(_mRotation > 0 && _mIsFlip);
+        }
+        return true;
+    }
+    if (mPtrYUV2RGB == &ColorConvert16::cc16ZoomRotate)
+    {
+        layout->rotate = true;
+        layout->reverse = ((_mRotation == CCROTATE_CLKWISE) != _mIsFlip);
+        layout->scaled = true;
+        layout->table_reversed = (_mRotation != CCROTATE_CLKWISE);
+        return true;
+    }
+    return false;
+}
+
 
+int32 ColorConvert16::ConvertBand(uint8 **src, uint8 *dst, DisplayProperties *disp)
+{
+    if (mPtrYUV2RGB == &ColorConvert16::cc16ZoomIn)
+    {
+        /* the band size may match one of the fixed ratios */
+        return cc16ZoomScale(src, dst, disp, (uint8 *)mCoefTbl);
     }
+    return (*this.*mPtrYUV2RGB)(src, dst, disp, (uint8 *)mCoefTbl);
 }
 
 #ifdef SPECIAL_SCALE_128x96
@@ -5287,7 +5399,7 @@ int32 ColorConvert16::cc16ZoomRotate(uint8 **src, uint8 *dst,
     disp_prop[5] = disp->dst_height;
 
     flip = _mIsFlip;
-    return cc16sc_rotate(src, dst, disp_prop, coff_tbl, _mRowPix, _mColPix, (_mRotation == CCROTATE_CLKWISE), flip);
+    return cc16sc_rotate(src, dst, disp_prop, coff_tbl, disp->row_pix, disp->col_pix, (_mRotation == CCROTATE_CLKWISE), flip);
 }
 
 int32 cc16sc_rotate(uint8 **src, uint8 *dst, int32 *disp,
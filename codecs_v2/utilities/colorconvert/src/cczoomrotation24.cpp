@@ -97,6 +97,10 @@ int32 ColorConvert24::SetYuvFullRange(bool range)
         }
     }
 
+#if CCX86SIMD
+    CCX86InitCoef(&_mX86Coef, mClip, _mYuvRange, true);
+#endif
+
     return 1;
 }
 
@@ -181,7 +185,10 @@ int32 ColorConvert24::Convert(uint8 **yuvBuf, uint8 *rgbBuf)
         return 0;
     }
 
-    (*this.*mPtrYUV2RGB)(yuvBuf, rgbBuf, &_mDisp, (uint8 *)mClip);
+    if (!ConvertBands(yuvBuf, rgbBuf))
+    {
+        (*this.*mPtrYUV2RGB)(yuvBuf, rgbBuf, &_mDisp, (uint8 *)mClip);
+    }
 
     return 1;
 }
@@ -204,11 +211,63 @@ int32 ColorConvert24::Convert(uint8 *yuvBuf, uint8 *rgbBuf)
     TmpYuvBuf[0]    =   yuvBuf;
     TmpYuvBuf[1]    =   yuvBuf + (_mSrc_pitch) * (_mSrc_mheight);
     TmpYuvBuf[2]    =   TmpYuvBuf[1] + (_mSrc_pitch * _mSrc_mheight) / 4;
-    (*this.*mPtrYUV2RGB)(TmpYuvBuf, rgbBuf, &_mDisp, (uint8 *)mClip);
+    if (!ConvertBands(TmpYuvBuf, rgbBuf))
+    {
+        (*this.*mPtrYUV2RGB)(TmpYuvBuf, rgbBuf, &_mDisp, (uint8 *)mClip);
+    }
 
     return 1;
 }
 
+
+bool ColorConvert24::GetBandLayout(BandLayout *layout)
+{
+    layout->bytes_per_pixel = 3;
+    layout->rotate = false;
+    layout->reverse = false;
+    layout->scaled = false;
+    layout->table_reversed = false;
+
+    if (mPtrYUV2RGB == &ColorConvert24::get_frame24)
+    {
+        layout->reverse = (_mRotation > 0);
+        return true;
+    }
+    if (mPtrYUV2RGB == &ColorConvert24::cc24Rotate)
+    {
+        /* the flip is ignored when rotating */
+        layout->rotate = true;
+        layout->reverse = (_mRotation == CCROTATE_CLKWISE);
+        return true;
+    }
+    if (mPtrYUV2RGB == &ColorConvert24::cc24ZoomIn)
+    {
+        /* when a source row is dropped, cc24scaling still writes it below the band */
+        if (_mDisp.dst_height < _mDisp.src_height)
+        {
+            return false;
+        }
+        layout->scaled = true;
+        layout->table_reversed = true;
+        return true;
+    }
+    if (mPtrYUV2RGB == &ColorConvert24::cc24ZoomRotate)
+    {
+        layout->rotate = true;
+        layout->reverse = (_mRotation == CCROTATE_CLKWISE);
+        layout->scaled = true;
+        layout->table_reversed = (_mRotation != CCROTATE_CLKWISE);
+        return true;
+    }
+    return false;
+}
+
+
+int32 ColorConvert24::ConvertBand(uint8 **src, uint8 *dst, DisplayProperties *disp)
+{
+    return (*this.*mPtrYUV2RGB)(src, dst, disp, (uint8 *)mClip);
+}
+
 int32 cc24(uint8 **src, uint8 *dst, int32 *disp_prop, uint8 *coeff_tbl);
 
 int32 ColorConvert24::get_frame24(uint8 **src, uint8 *dst, DisplayProperties *disp, uint8 *clip)
@@ -230,6 +289,12 @@ int32 ColorConvert24::get_frame24(uint8 **src, uint8 *dst, DisplayProperties *di
 //  }
 //  else
     {
+#if CCX86SSSE3
+        if (_mX86Coef.enabled)
+        {
+            return cc24_x86(src, dst, disp_prop, clip, &_mX86Coef);
+        }
+#endif
         return cc24(src, dst, disp_prop, clip);
     }
 }
@@ -699,7 +764,7 @@ int32 ColorConvert24::cc24ZoomIn(uint8 **src, uint8 *dst,
     disp_prop[4] = disp->dst_width;
     disp_prop[5] = disp->dst_height;
 
-    return cc24scaling(src, dst, disp_prop, clip, _mRowPix, _mColPix);
+    return cc24scaling(src, dst, disp_prop, clip, disp->row_pix, disp->col_pix);
 }
 
 
@@ -1018,7 +1083,7 @@ int32 ColorConvert24::cc24ZoomRotate(uint8 **src, uint8 *dst,
     disp_prop[4] = disp->dst_width;
     disp_prop[5] = disp->dst_height;
 
-    return cc24sc_rotate(src, dst, disp_prop, clip, _mRowPix, _mColPix, (_mRotation == CCROTATE_CLKWISE));
+    return cc24sc_rotate(src, dst, disp_prop, clip, disp->row_pix, disp->col_pix, (_mRotation == CCROTATE_CLKWISE));
 }
 
 
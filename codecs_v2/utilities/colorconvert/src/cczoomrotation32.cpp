@@ -99,6 +99,10 @@ int32  ColorConvert32::SetYuvFullRange(bool range)
         }
     }
 
+#if CCX86SIMD
+    CCX86InitCoef(&_mX86Coef, mClip, _mYuvRange, false);
+#endif
+
     return 1;
 }
 
@@ -177,7 +181,10 @@ int32 ColorConvert32::Convert(uint8 **yuvBuf, uint8 *rgbBuf)
         return 0;
     }
 
-    (*this.*mPtrYUV2RGB)(yuvBuf, rgbBuf, &_mDisp, (uint8 *)mClip);
+    if (!ConvertBands(yuvBuf, rgbBuf))
+    {
+        (*this.*mPtrYUV2RGB)(yuvBuf, rgbBuf, &_mDisp, (uint8 *)mClip);
+    }
 
     return 1;
 }
@@ -200,12 +207,59 @@ int32 ColorConvert32::Convert(uint8 *yuvBuf, uint8 *rgbBuf)
     TmpYuvBuf[0]    =   yuvBuf;
     TmpYuvBuf[1]    =   yuvBuf + (_mSrc_pitch) * (_mSrc_mheight);
     TmpYuvBuf[2]    =   TmpYuvBuf[1] + (_mSrc_pitch * _mSrc_mheight) / 4;
-    (*this.*mPtrYUV2RGB)(TmpYuvBuf, rgbBuf, &_mDisp, (uint8 *)mClip);
+    if (!ConvertBands(TmpYuvBuf, rgbBuf))
+    {
+        (*this.*mPtrYUV2RGB)(TmpYuvBuf, rgbBuf, &_mDisp, (uint8 *)mClip);
+    }
 
     return 1;
 }
 
 
+bool ColorConvert32::GetBandLayout(BandLayout *layout)
+{
+    layout->bytes_per_pixel = 4;
+    layout->rotate = false;
+    layout->reverse = false;
+    layout->scaled = false;
+    layout->table_reversed = false;
+
+    if (mPtrYUV2RGB == &ColorConvert32::get_frame32)
+    {
+        layout->reverse = (_mRotation > 0);
+        return true;
+    }
+    if (mPtrYUV2RGB == &ColorConvert32::cc32Rotate)
+    {
+        /* the flip is ignored when rotating */
+        layout->rotate = true;
+        layout->reverse = (_mRotation == CCROTATE_CLKWISE);
+        return true;
+    }
+    if (mPtrYUV2RGB == &ColorConvert32::cc32ZoomIn)
+    {
+        layout->scaled = true;
+        layout->table_reversed = true;
+        return true;
+    }
+    if (mPtrYUV2RGB == &ColorConvert32::cc32ZoomRotate)
+    {
+        layout->rotate = true;
+        layout->reverse = (_mRotation == CCROTATE_CLKWISE);
+        layout->scaled = true;
+        layout->table_reversed = (_mRotation != CCROTATE_CLKWISE);
+        return true;
+    }
+    return false;
+}
+
+
+int32 ColorConvert32::ConvertBand(uint8 **src, uint8 *dst, DisplayProperties *disp)
+{
+    return (*this.*mPtrYUV2RGB)(src, dst, disp, (uint8 *)mClip);
+}
+
+
 int32 cc32(uint8 **src, uint8 *dst, int32 *disp_prop, uint8 *coeff_tbl);
 int32 cc32Reverse(uint8 **src, uint8 *dst, int32 *disp_prop, uint8 *coeff_tbl);
 
@@ -228,6 +282,12 @@ int32 ColorConvert32::get_frame32(uint8 **src, uint8 *dst, DisplayProperties *di
     }
     else
     {
+#if CCX86SIMD
+        if (_mX86Coef.enabled)
+        {
+            return cc32_x86(src, dst, disp_prop, clip, &_mX86Coef);
+        }
+#endif
         return cc32(src, dst, disp_prop, clip);
     }
 }
@@ -710,11 +770,11 @@ int32 ColorConvert32::cc32ZoomIn(uint8 **src, uint8 *dst,
 
     if (src_width > dst_width) /* scale down in width */
     {
-        return cc32scaledown(src, dst, disp_prop, clip, _mRowPix, _mColPix);
+        return cc32scaledown(src, dst, disp_prop, clip, disp->row_pix, disp->col_pix);
     }
     else
     {
-        return cc32scaleup(src, dst, disp_prop, clip, _mRowPix, _mColPix);
+        return cc32scaleup(src, dst, disp_prop, clip, disp->row_pix, disp->col_pix);
     }
 }
 
@@ -1174,7 +1234,7 @@ int32 ColorConvert32::cc32ZoomRotate(uint8 **src, uint8 *dst,
     disp_prop[4] = disp->dst_width;
     disp_prop[5] = disp->dst_height;
 
-    return cc32sc_rotate(src, dst, disp_prop, clip, _mRowPix, _mColPix, (_mRotation == CCROTATE_CLKWISE));
+    return cc32sc_rotate(src, dst, disp_prop, clip, disp->row_pix, disp->col_pix, (_mRotation == CCROTATE_CLKWISE));
 }
 
 
@@ -0,0 +1,541 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/** x86 SIMD YUV420 to RGB16/24/32 conversion, for the no zoom, no rotation case.
+    Each step converts 8 pixels of two rows, i.e. 4 Cb and 4 Cr samples. */
+#include "colorconv_config.h"
+#include "cczoomrotation_x86.h"
+
+#if CCX86SIMD
+
+#include <emmintrin.h>
+#if CCX86SSSE3
+#include <tmmintrin.h>
+#define SSSE3_TARGET __attribute__((target("ssse3")))
+#endif
+
+/* the clip table covers indices -384 to 639 */
+#define CLIP_TBL_MIN    (-384)
+#define CLIP_TBL_MAX    640
+
+/* per frame constants */
+typedef struct
+{
+    __m128i lo[3];      /* (Cr, Cb) multipliers for the low 16 bits of the R, G and B coefficients */
+    __m128i hi[3];      /* and for the high 16 bits */
+    __m128i y0;
+    __m128i kmax;
+    __m128i frac;
+    bool    negG;       /* RGB16 subtracts the G offset after the shift */
+    int32   cc1, cc2, cc3, cc4;
+    uint8   *clip;
+} CCX86Const;
+
+/* value of the clip table entry idx, before the 5/6 bit shift of RGB16 */
+static inline int32 ClipValue(const CCX86Coef *coef, int32 idx)
+{
+    int32 k = idx - coef->y0;
+
+    k = (k < 0) ? 0 : ((k > coef->kmax) ? coef->kmax : k);
+    k += (k * coef->frac) >> 16;
+
+    return (k > 255) ? 255 : k;
+}
+
+/* Split a 16.16 coefficient into hi*65536 + lo with lo signed, so that
+   (c*coef)>>16 = c*hi + ((c*lo)>>16) without any 32-bit overflow. */
+static void SplitCoef(int32 coef, int16 *lo, int16 *hi)
+{
+    *lo = (int16)(coef & 0xFFFF);
+    *hi = (int16)((coef - *lo) >> 16);
+}
+
+static __m128i PairCoef(int16 cr, int16 cb)
+{
+    return _mm_set1_epi32((int32)((uint32)(uint16)cr | ((uint32)(uint16)cb << 16)));
+}
+
+/* (Cr, Cb) coefficients of the R, G and B offsets */
+static void SetupConst(CCX86Const *k, const CCX86Coef *coef, uint8 *clip, bool rgb16)
+{
+    int32 cr[3], cb[3];
+    int16 crlo, crhi, cblo, cbhi;
+    int i;
+
+    k->cc1 = *((int32*)(clip - 400));
+    k->cc3 = *((int32*)(clip - 396));
+    k->cc2 = *((int32*)(clip - 392));
+    k->cc4 = *((int32*)(clip - 388));
+    k->clip = clip;
+    k->negG = rgb16;
+
+    cr[0] = k->cc3;
+    cb[0] = 0;
+    cr[1] = rgb16 ? k->cc1 : -k->cc1;
+    cb[1] = rgb16 ? k->cc2 : -k->cc2;
+    cr[2] = 0;
+    cb[2] = k->cc4;
+
+    for (i = 0; i < 3; i++)
+    {
+        SplitCoef(cr[i], &crlo, &crhi);
+        SplitCoef(cb[i], &cblo, &cbhi);
+        k->lo[i] = PairCoef(crlo, cblo);
+        k->hi[i] = PairCoef(crhi, cbhi);
+    }
+
+    k->y0 = _mm_set1_epi16(coef->y0);
+    k->kmax = _mm_set1_epi16(coef->kmax);
+    k->frac = _mm_set1_epi16((int16)coef->frac);
+}
+
+/* R, G and B offsets of 4 chroma samples, each repeated for the two pixels of the pair */
+static inline void ChromaOffsets(const uint8 *pCb, const uint8 *pCr, const CCX86Const *k, __m128i *off)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i c128 = _mm_set1_epi16(128);
+    __m128i cb, cr, crcb, x;
+    int i;
+
+    cb = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(*((const int32*)pCb)), zero), c128);
+    cr = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(*((const int32*)pCr)), zero), c128);
+    crcb = _mm_unpacklo_epi16(cr, cb);
+
+    for (i = 0; i < 3; i++)
+    {
+        x = _mm_add_epi32(_mm_srai_epi32(_mm_madd_epi16(crcb, k->lo[i]), 16), _mm_madd_epi16(crcb, k->hi[i]));
+        x = _mm_packs_epi32(x, x);
+        off[i] = _mm_unpacklo_epi16(x, x);
+    }
+
+    if (k->negG)
+    {
+        off[1] = _mm_sub_epi16(zero, off[1]);
+    }
+}
+
+/* 8 Y samples as 16-bit */
+static inline __m128i LoadY(const uint8 *pY)
+{
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)pY), _mm_setzero_si128());
+}
+
+/* clip table values of 8 indices, same as ClipValue() without the saturation */
+static inline __m128i ClipValue8(__m128i idx, const CCX86Const *k)
+{
+    __m128i x = _mm_sub_epi16(idx, k->y0);
+
+    x = _mm_min_epi16(_mm_max_epi16(x, _mm_setzero_si128()), k->kmax);
+    return _mm_add_epi16(x, _mm_mulhi_epu16(x, k->frac));
+}
+
+/* R, G and B of 8 pixels as saturated 8-bit values in the low half */
+static inline void RGB8(__m128i y, const __m128i *off, const CCX86Const *k, __m128i *r, __m128i *g, __m128i *b)
+{
+    __m128i x;
+
+    x = ClipValue8(_mm_add_epi16(y, off[0]), k);
+    *r = _mm_packus_epi16(x, x);
+    x = ClipValue8(_mm_add_epi16(y, off[1]), k);
+    *g = _mm_packus_epi16(x, x);
+    x = ClipValue8(_mm_add_epi16(y, off[2]), k);
+    *b = _mm_packus_epi16(x, x);
+}
+
+/* 8 pixels of 4 bytes each, in the same byte order as cc32 */
+static inline void PackRGB32(__m128i r, __m128i g, __m128i b, __m128i *lo, __m128i *hi)
+{
+    __m128i c0g, c2a;
+#if RGB_FORMAT
+    c0g = _mm_unpacklo_epi8(r, g);
+    c2a = _mm_unpacklo_epi8(b, _mm_setzero_si128());
+#else
+    c0g = _mm_unpacklo_epi8(b, g);
+    c2a = _mm_unpacklo_epi8(r, _mm_setzero_si128());
+#endif
+    *lo = _mm_unpacklo_epi16(c0g, c2a);
+    *hi = _mm_unpackhi_epi16(c0g, c2a);
+}
+
+/* R, G and B table offsets of one chroma sample, for the scalar tail of a row */
+static inline void ChromaOffset1(int32 Cb, int32 Cr, const CCX86Const *k, int32 *oR, int32 *oG, int32 *oB)
+{
+    int32 Cg;
+
+    Cb -= 128;
+    Cr -= 128;
+    Cg = Cr * k->cc1 + Cb * k->cc2;
+
+    *oR = (Cr * k->cc3) >> 16;
+    *oB = (Cb * k->cc4) >> 16;
+    *oG = k->negG ? -(Cg >> 16) : ((-Cg) >> 16);
+}
+
+/* pixel format specific parts */
+
+static inline uint32 Pixel32(const uint8 *clip, int32 Y, int32 oR, int32 oG, int32 oB)
+{
+#if RGB_FORMAT
+    return clip[Y + oR] | (clip[Y + oG] << 8) | (clip[Y + oB] << 16);
+#else
+    return clip[Y + oB] | (clip[Y + oG] << 8) | (clip[Y + oR] << 16);
+#endif
+}
+
+static void cc32Row(const uint8 *yTop, const uint8 *yBot, const uint8 *pCb, const uint8 *pCr,
+                    uint8 *dTop, uint8 *dBot, int32 width, const CCX86Const *k)
+{
+    __m128i off[3], r, g, b, lo, hi;
+    uint32 *pTop = (uint32*)dTop;
+    uint32 *pBot = (uint32*)dBot;
+    int32 col, oR, oG, oB;
+
+    for (col = 0; col + 8 <= width; col += 8)
+    {
+        ChromaOffsets(pCb, pCr, k, off);
+
+        RGB8(LoadY(yTop), off, k, &r, &g, &b);
+        PackRGB32(r, g, b, &lo, &hi);
+        _mm_storeu_si128((__m128i*)pTop, lo);
+        _mm_storeu_si128((__m128i*)(pTop + 4), hi);
+
+        RGB8(LoadY(yBot), off, k, &r, &g, &b);
+        PackRGB32(r, g, b, &lo, &hi);
+        _mm_storeu_si128((__m128i*)pBot, lo);
+        _mm_storeu_si128((__m128i*)(pBot + 4), hi);
+
+        pCb += 4;
+        pCr += 4;
+        yTop += 8;
+        yBot += 8;
+        pTop += 8;
+        pBot += 8;
+    }
+
+    for (; col < width; col += 2)
+    {
+        ChromaOffset1(*pCb++, *pCr++, k, &oR, &oG, &oB);
+
+        pTop[0] = Pixel32(k->clip, yTop[0], oR, oG, oB);
+        pTop[1] = Pixel32(k->clip, yTop[1], oR, oG, oB);
+        pBot[0] = Pixel32(k->clip, yBot[0], oR, oG, oB);
+        pBot[1] = Pixel32(k->clip, yBot[1], oR, oG, oB);
+
+        yTop += 2;
+        yBot += 2;
+        pTop += 2;
+        pBot += 2;
+    }
+}
+
+#if CCX86SSSE3
+/* drop the 4th byte of each of the 4 pixels */
+static inline SSSE3_TARGET __m128i Pack3(__m128i x)
+{
+    const __m128i shuf = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    return _mm_shuffle_epi8(x, shuf);
+}
+
+/* 8 pixels, 24 bytes */
+static inline SSSE3_TARGET void StoreRGB24(uint8 *pDst, __m128i lo, __m128i hi)
+{
+    lo = Pack3(lo);
+    hi = Pack3(hi);
+    _mm_storeu_si128((__m128i*)pDst, _mm_or_si128(lo, _mm_slli_si128(hi, 12)));
+    _mm_storel_epi64((__m128i*)(pDst + 16), _mm_srli_si128(hi, 4));
+}
+
+static inline void Pixel24(uint8 *pDst, const uint8 *clip, int32 Y, int32 oR, int32 oG, int32 oB)
+{
+#if RGB_FORMAT
+    pDst[0] = clip[Y + oR];
+    pDst[2] = clip[Y + oB];
+#else
+    pDst[0] = clip[Y + oB];
+    pDst[2] = clip[Y + oR];
+#endif
+    pDst[1] = clip[Y + oG];
+}
+
+static SSSE3_TARGET void cc24Row(const uint8 *yTop, const uint8 *yBot, const uint8 *pCb, const uint8 *pCr,
+                                 uint8 *dTop, uint8 *dBot, int32 width, const CCX86Const *k)
+{
+    __m128i off[3], r, g, b, lo, hi;
+    int32 col, oR, oG, oB;
+
+    for (col = 0; col + 8 <= width; col += 8)
+    {
+        ChromaOffsets(pCb, pCr, k, off);
+
+        RGB8(LoadY(yTop), off, k, &r, &g, &b);
+        PackRGB32(r, g, b, &lo, &hi);
+        StoreRGB24(dTop, lo, hi);
+
+        RGB8(LoadY(yBot), off, k, &r, &g, &b);
+        PackRGB32(r, g, b, &lo, &hi);
+        StoreRGB24(dBot, lo, hi);
+
+        pCb += 4;
+        pCr += 4;
+        yTop += 8;
+        yBot += 8;
+        dTop += 24;
+        dBot += 24;
+    }
+
+    for (; col < width; col += 2)
+    {
+        ChromaOffset1(*pCb++, *pCr++, k, &oR, &oG, &oB);
+
+        Pixel24(dTop, k->clip, yTop[0], oR, oG, oB);
+        Pixel24(dTop + 3, k->clip, yTop[1], oR, oG, oB);
+        Pixel24(dBot, k->clip, yBot[0], oR, oG, oB);
+        Pixel24(dBot + 3, k->clip, yBot[1], oR, oG, oB);
+
+        yTop += 2;
+        yBot += 2;
+        dTop += 6;
+        dBot += 6;
+    }
+}
+#endif /* CCX86SSSE3 */
+
+static inline uint16 Pixel16(const uint8 *clip, int32 Y, int32 d5, int32 d6, int32 oR, int32 oG, int32 oB)
+{
+    return (uint16)(clip[Y + d5 + oB] | (clip[Y + d6 + 1024 + oG] << 5) | (clip[Y + d5 + oR] << 11));
+}
+
+/* RGB565 of 8 pixels, d5 and d6 are the dither offsets */
+static inline __m128i RGB16(__m128i y, const __m128i *off, __m128i d5, __m128i d6, const CCX86Const *k)
+{
+    __m128i r, g, b;
+
+    r = _mm_srli_epi16(ClipValue8(_mm_add_epi16(_mm_add_epi16(y, d5), off[0]), k), 3);
+    g = _mm_srli_epi16(ClipValue8(_mm_add_epi16(_mm_add_epi16(y, d6), off[1]), k), 2);
+    b = _mm_srli_epi16(ClipValue8(_mm_add_epi16(_mm_add_epi16(y, d5), off[2]), k), 3);
+
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+}
+
+static void cc16Row(const uint8 *yTop, const uint8 *yBot, const uint8 *pCb, const uint8 *pCr,
+                    uint8 *dTop, uint8 *dBot, int32 width, const CCX86Const *k, const int16 *dither)
+{
+    /* the left pixel of the top row and the right pixel of the bottom row use the _1 offsets */
+    const __m128i d5Top = PairCoef(dither[1], dither[0]);
+    const __m128i d6Top = PairCoef(dither[3], dither[2]);
+    const __m128i d5Bot = PairCoef(dither[0], dither[1]);
+    const __m128i d6Bot = PairCoef(dither[2], dither[3]);
+    __m128i off[3];
+    uint16 *pTop = (uint16*)dTop;
+    uint16 *pBot = (uint16*)dBot;
+    int32 col, oR, oG, oB;
+
+    for (col = 0; col + 8 <= width; col += 8)
+    {
+        ChromaOffsets(pCb, pCr, k, off);
+
+        _mm_storeu_si128((__m128i*)pTop, RGB16(LoadY(yTop), off, d5Top, d6Top, k));
+        _mm_storeu_si128((__m128i*)pBot, RGB16(LoadY(yBot), off, d5Bot, d6Bot, k));
+
+        pCb += 4;
+        pCr += 4;
+        yTop += 8;
+        yBot += 8;
+        pTop += 8;
+        pBot += 8;
+    }
+
+    for (; col < width; col += 2)
+    {
+        ChromaOffset1(*pCb++, *pCr++, k, &oR, &oG, &oB);
+
+        pTop[0] = Pixel16(k->clip, yTop[0], dither[1], dither[3], oR, oG, oB);
+        pTop[1] = Pixel16(k->clip, yTop[1], dither[0], dither[2], oR, oG, oB);
+        pBot[0] = Pixel16(k->clip, yBot[0], dither[0], dither[2], oR, oG, oB);
+        pBot[1] = Pixel16(k->clip, yBot[1], dither[1], dither[3], oR, oG, oB);
+
+        yTop += 2;
+        yBot += 2;
+        pTop += 2;
+        pBot += 2;
+    }
+}
+
+/* Walk the frame two rows at a time, bottom up if disp[6] is set, like cc16/cc24/cc32.
+   Returns the start of the two source rows and the destination rows for each step. */
+typedef struct
+{
+    uint8 *pY, *pCb, *pCr, *pDst;
+    int32 yPitch, cPitch, dPitch;
+    int32 rows;
+} CCX86Frame;
+
+static void FrameStart(CCX86Frame *f, uint8 **src, uint8 *dst, int32 *disp, int32 bytesPerPixel)
+{
+    f->yPitch = disp[0];
+    f->cPitch = disp[0] >> 1;
+    f->dPitch = disp[1] * bytesPerPixel;
+    f->rows = disp[3];
+    f->pY = src[0];
+    f->pCb = src[1];
+    f->pCr = src[2];
+    f->pDst = dst;
+
+    if (disp[6]) /* start from the bottom of the picture */
+    {
+        f->pY += f->yPitch * (f->rows - 1);
+        f->pCb += f->cPitch * ((f->rows >> 1) - 1);
+        f->pCr += f->cPitch * ((f->rows >> 1) - 1);
+        f->yPitch = -f->yPitch;
+        f->cPitch = -f->cPitch;
+    }
+}
+
+static inline void FrameNext(CCX86Frame *f)
+{
+    f->pY += (f->yPitch << 1);
+    f->pCb += f->cPitch;
+    f->pCr += f->cPitch;
+    f->pDst += (f->dPitch << 1);
+    f->rows -= 2;
+}
+
+int32 cc16_x86(uint8 **src, uint8 *dst, int32 *disp, uint8 *coff_tbl, const CCX86Coef *coef)
+{
+    CCX86Const k;
+    CCX86Frame f;
+
+    SetupConst(&k, coef, coff_tbl + 400, true);
+
+    for (FrameStart(&f, src, dst, disp, 2); f.rows > 0; FrameNext(&f))
+    {
+        cc16Row(f.pY, f.pY + f.yPitch, f.pCb, f.pCr, f.pDst, f.pDst + f.dPitch, disp[2], &k, coef->dither);
+    }
+
+    return 1;
+}
+
+#if CCX86SSSE3
+int32 cc24_x86(uint8 **src, uint8 *dst, int32 *disp, uint8 *clip, const CCX86Coef *coef)
+{
+    CCX86Const k;
+    CCX86Frame f;
+    /* cc24 converts 4 pixels at a time */
+    int32 width = (disp[2] + 3) & ~3;
+
+    SetupConst(&k, coef, clip, false);
+
+    for (FrameStart(&f, src, dst, disp, 3); f.rows > 0; FrameNext(&f))
+    {
+        cc24Row(f.pY, f.pY + f.yPitch, f.pCb, f.pCr, f.pDst, f.pDst + f.dPitch, width, &k);
+    }
+
+    return 1;
+}
+#endif
+
+int32 cc32_x86(uint8 **src, uint8 *dst, int32 *disp, uint8 *clip, const CCX86Coef *coef)
+{
+    CCX86Const k;
+    CCX86Frame f;
+
+    SetupConst(&k, coef, clip, false);
+
+    for (FrameStart(&f, src, dst, disp, 4); f.rows > 0; FrameNext(&f))
+    {
+        cc32Row(f.pY, f.pY + f.yPitch, f.pCb, f.pCr, f.pDst, f.pDst + f.dPitch, disp[2], &k);
+    }
+
+    return 1;
+}
+
+#if CCX86SSSE3
+static bool CpuHasSSSE3()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") ? true : false;
+}
+#endif
+
+static void SetClipParams(CCX86Coef *coef, bool fullRange, int16 kmax)
+{
+    if (fullRange)
+    {
+        coef->y0 = 0;
+        coef->kmax = 255;
+        coef->frac = 0;
+    }
+    else /* 1.164*(i-16) */
+    {
+        coef->y0 = 16;
+        coef->kmax = kmax;
+        coef->frac = 10748; /* 0.164*65536 */
+    }
+}
+
+void CCX86InitCoef16(CCX86Coef *coef, uint8 *coff_tbl, bool fullRange, const int32 *dither)
+{
+    uint8 *clip = coff_tbl + 400;
+    int32 i, v;
+
+    /* above 219, the 5 and 6 bit values saturate */
+    SetClipParams(coef, fullRange, 219);
+
+    coef->dither[0] = (int16)dither[0];
+    coef->dither[1] = (int16)dither[1];
+    coef->dither[2] = (int16)(dither[2] - 1024);
+    coef->dither[3] = (int16)(dither[3] - 1024);
+
+    coef->enabled = true;
+    for (i = CLIP_TBL_MIN; i < CLIP_TBL_MAX; i++)
+    {
+        v = ClipValue(coef, i);
+        if (clip[i] != (v >> 3) || clip[i + 1024] != (v >> 2))
+        {
+            coef->enabled = false;
+            break;
+        }
+    }
+}
+
+void CCX86InitCoef(CCX86Coef *coef, uint8 *clip, bool fullRange, bool rgb24)
+{
+    int32 i;
+
+    SetClipParams(coef, fullRange, 255);
+
+    coef->enabled = true;
+    for (i = CLIP_TBL_MIN; i < CLIP_TBL_MAX; i++)
+    {
+        if (clip[i] != ClipValue(coef, i))
+        {
+            coef->enabled = false;
+            break;
+        }
+    }
+
+    if (rgb24)
+    {
+#if CCX86SSSE3
+        coef->enabled = coef->enabled && CpuHasSSSE3();
+#else
+        coef->enabled = false;
+#endif
+    }
+}
+
+#endif /* CCX86SIMD */
@@ -17,6 +17,7 @@
  */
 #include "colorconv_config.h"
 #include "cczoomrotationbase.h"
+#include "ccbandthreads.h"
 
 // Use default DLL entry point
 #include "oscl_dll.h"
@@ -34,13 +35,19 @@ ASSUMPTIONS:
 **************************************************************/
 
 
-ColorConvertBase::ColorConvertBase(): _mRowPix(NULL), _mColPix(NULL), _mInitialized(false), _mState(0), _mYuvRange(false)
+ColorConvertBase::ColorConvertBase(): _mRowPix(NULL), _mColPix(NULL), _mInitialized(false), _mState(0), _mYuvRange(false), _mThreads(NULL)
 {
+    _mDisp.row_pix = NULL;
+    _mDisp.col_pix = NULL;
+    _mX86Coef.enabled = false;
 }
 
 
 OSCL_EXPORT_REF ColorConvertBase::~ColorConvertBase()
 {
+#if CCTHREADS
+    CCBandThreads::Delete(_mThreads);
+#endif
     if (_mRowPix)
     {
         OSCL_ARRAY_DELETE(_mRowPix);
@@ -212,6 +219,9 @@ int32 ColorConvertBase::Init(int32 Src_width, int32 Src_height, int32 Src_pitch,
         }
     }
 
+    _mDisp.row_pix = _mRowPix;
+    _mDisp.col_pix = _mColPix;
+
     _mInitialized = true;
 
     return 1;
@@ -344,3 +354,161 @@ void ColorConvertBase::StretchLine(uint8 *pLinePix, int32 iSrcLen, int32 iDstLen
         }
     }
 }
+
+
+/**************************************************************
+Threaded Convert(): the source is split into bands of rows, a
+multiple of 4 rows each, so that the chroma rows and the 2x2
+blocks of the kernels are not split. Each band is converted as
+if it was a complete frame, with the output pointer moved to
+where the band goes in the output. With scaling, the band uses
+the part of the scaling table for its rows.
+**************************************************************/
+
+/* bands are at least this many source rows */
+#define CC_MIN_BAND_ROWS    16
+
+OSCL_EXPORT_REF int32 ColorConvertBase::SetNumThreads(int32 aNumThreads)
+{
+#if CCTHREADS
+    if (_mThreads && _mThreads->NumThreads() == aNumThreads)
+    {
+        return aNumThreads;
+    }
+
+    CCBandThreads::Delete(_mThreads);
+    _mThreads = NULL;
+
+    if (aNumThreads > 1)
+    {
+        _mThreads = CCBandThreads::New(aNumThreads);
+    }
+
+    return _mThreads ? _mThreads->NumThreads() : 1;
+#else
+    OSCL_UNUSED_ARG(aNumThreads);
+    return 1;
+#endif
+}
+
+/* number of output lines of the source rows row0 to row1-1 */
+static int32 BandLines(uint8 *table, bool reversed, int32 height, int32 row0, int32 row1)
+{
+    int32 lines = 0;
+    int32 i;
+
+    if (table == NULL)
+    {
+        return row1 - row0;
+    }
+
+    for (i = row0; i < row1; i++)
+    {
+        lines += reversed ? table[height - 1 - i] : table[i];
+    }
+    return lines;
+}
+
+int32 ColorConvertBase::ConvertBands(uint8 **src, uint8 *dst)
+{
+#if CCTHREADS
+    Band band[CCMAXTHREADS];
+    BandLayout layout;
+    uint8 *table = NULL;
+    int32 height = _mDisp.src_height;
+    int32 numBands, i, row0, row1, lines, total, done, start, offset;
+
+    if (_mThreads == NULL || !GetBandLayout(&layout))
+    {
+        return 0;
+    }
+
+    numBands = height / CC_MIN_BAND_ROWS;
+    if (numBands > _mThreads->NumThreads())
+    {
+        numBands = _mThreads->NumThreads();
+    }
+    if (numBands < 2)
+    {
+        return 0;
+    }
+
+    if (layout.scaled)
+    {
+        table = layout.rotate ? _mDisp.row_pix : _mDisp.col_pix;
+        if (table == NULL)
+        {
+            return 0;
+        }
+    }
+
+    total = BandLines(table, layout.table_reversed, height, 0, height);
+    done = 0;
+    row0 = 0;
+
+    for (i = 0; i < numBands; i++)
+    {
+        row1 = (i == numBands - 1) ? height : (((height * (i + 1)) / numBands) & ~3);
+        lines = BandLines(table, layout.table_reversed, height, row0, row1);
+
+        /* first output line (column) of the band */
+        start = layout.reverse ? (total - done - lines) : done;
+
+        band[i].cc = this;
+        band[i].disp = _mDisp;
+        band[i].disp.src_height = row1 - row0;
+        band[i].src[0] = src[0] + row0 * _mDisp.src_pitch;
+        band[i].src[1] = src[1] + (row0 >> 1) * (_mDisp.src_pitch >> 1);
+        band[i].src[2] = src[2] + (row0 >> 1) * (_mDisp.src_pitch >> 1);
+
+        if (layout.rotate)
+        {
+            band[i].disp.dst_width = lines;
+            offset = start * layout.bytes_per_pixel;
+        }
+        else
+        {
+            band[i].disp.dst_height = lines;
+            offset = start * _mDisp.dst_pitch * layout.bytes_per_pixel;
+        }
+
+        /* the kernels need word aligned output */
+        if (offset & 0x3)
+        {
+            return 0;
+        }
+        band[i].dst = dst + offset;
+
+        /* the band table starts at the count of its first row, in the order the kernel reads it */
+        if (table)
+        {
+            if (layout.rotate)
+            {
+                band[i].disp.row_pix = layout.table_reversed ? (_mDisp.row_pix + height - row1) : (_mDisp.row_pix + row0);
+            }
+            else
+            {
+                band[i].disp.col_pix = layout.table_reversed ? (_mDisp.col_pix + height - row1) : (_mDisp.col_pix + row0);
+            }
+        }
+
+        done += lines;
+        row0 = row1;
+    }
+
+    _mThreads->Run(ConvertBandJob, (OsclAny*)band, numBands);
+
+    return 1;
+#else
+    OSCL_UNUSED_ARG(src);
+    OSCL_UNUSED_ARG(dst);
+    return 0;
+#endif
+}
+
+void ColorConvertBase::ConvertBandJob(OsclAny *aContext, int32 aBand)
+{
+    Band *band = ((Band*)aContext) + aBand;
+
+    band->cc->ConvertBand(band->src, band->dst, &band->disp);
+}
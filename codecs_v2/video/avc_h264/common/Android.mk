@@ -3,6 +3,7 @@ include $(CLEAR_VARS)
 
 LOCAL_SRC_FILES := \
 	src/deblock.cpp \
+ 	src/deblock_thread.cpp \
  	src/dpb.cpp \
  	src/fmo.cpp \
  	src/mb_access.cpp \
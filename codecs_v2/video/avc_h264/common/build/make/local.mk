@@ -14,6 +14,7 @@ SRCDIR := ../../src
 INCSRCDIR := ../../include
 
 SRCS := deblock.cpp \
+	deblock_thread.cpp \
 	dpb.cpp \
 	fmo.cpp \
 	mb_access.cpp \
@@ -603,6 +603,11 @@ typedef struct tagMacroblock
     int QSc; /* Chroma QP S-picture */
 
     int slice_id;           // MC slice
+
+    /* deblocking parameters of the slice containing this MB */
+    uint disable_deblocking_filter_idc;
+    int FilterOffsetA;
+    int FilterOffsetB;
 } AVCMacroblock;
 
 
@@ -776,6 +781,9 @@ typedef struct tagCommonObj
     int (*is_short_ref)(AVCPictureData *s);
     int (*is_long_ref)(AVCPictureData *s);
 
+    /* background deblocking, NULL when deblocking is done at the end of the picture */
+    void *deblockThread;
+
 } AVCCommonObj;
 
 /**
@@ -46,6 +46,56 @@ is defined at compile time.
 */
 void MBInLoopDeblock(AVCCommonObj *video);
 
+/**
+This function performs conditional deblocking on a range of macroblocks in one MB row.
+The macroblocks above and to the left of the range must have been deblocked.
+\param "video"  "Pointer to AVCCommonObj."
+\param "mb_y"   "MB row."
+\param "mb_x_start" "First MB column of the range."
+\param "mb_x_end"   "One past the last MB column of the range."
+*/
+void DeblockMbRange(AVCCommonObj *video, int mb_y, int mb_x_start, int mb_x_end);
+
+/*----------- deblock_thread.c --------------*/
+/**
+This function starts the background deblocking threads. The rows of each picture are
+deblocked in a wavefront, two MB rows behind decoding, while the rest of the picture
+is decoded. It does nothing if the threads are already running.
+\param "video"  "Pointer to AVCCommonObj."
+\param "numThreads" "Number of deblocking threads."
+\return "AVC_SUCCESS for success and AVC_FAIL otherwise."
+*/
+AVCStatus DeblockThreadInit(AVCCommonObj *video, int numThreads);
+
+/**
+This function stops the deblocking threads and frees their resources.
+\param "video"  "Pointer to AVCCommonObj."
+*/
+void DeblockThreadCleanUp(AVCCommonObj *video);
+
+/**
+This function starts background deblocking of video->currPic. It must be called after
+the MB array and the current picture have been set up for the new picture.
+\param "video"  "Pointer to AVCCommonObj."
+*/
+void DeblockThreadStartPicture(AVCCommonObj *video);
+
+/**
+This function tells the deblocking threads that a macroblock has been decoded. Rows are
+released for deblocking as long as macroblocks are decoded in raster order. Otherwise
+(FMO, ASO) the picture is deblocked by DeblockThreadFinishPicture.
+\param "video"  "Pointer to AVCCommonObj."
+\param "mbAddr" "Address of the decoded macroblock."
+*/
+void DeblockThreadMbDecoded(AVCCommonObj *video, int mbAddr);
+
+/**
+This function waits for the deblocking threads to finish with the current picture.
+\param "video"  "Pointer to AVCCommonObj."
+\param "deblockAll" "TRUE to deblock the rest of the picture, FALSE to abandon it."
+*/
+void DeblockThreadFinishPicture(AVCCommonObj *video, bool deblockAll);
+
 
 /*---------- dpb.c --------------------*/
 /**
@@ -41,8 +41,8 @@ const static int CLIP_TAB[52][5]  =
     { 0, 9, 12, 18, 18}, { 0, 10, 13, 20, 20}, { 0, 11, 15, 23, 23}, { 0, 13, 17, 25, 25}
 };
 
-// NOTE: this table is only QP clipping, index = QP + video->FilterOffsetA/B, clipped to [0, 51]
-//       video->FilterOffsetA/B is in {-12, 12]
+// NOTE: this table is only QP clipping, index = QP + MbQ->FilterOffsetA/B, clipped to [0, 51]
+//       MbQ->FilterOffsetA/B is in {-12, 12]
 const static int QP_CLIP_TAB[76] =
 {
     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,              // [-12, 0]
@@ -101,6 +101,34 @@ OSCL_EXPORT_REF AVCStatus DeblockPicture(AVCCommonObj *video)
     return AVC_SUCCESS;
 }
 
+/*
+ *****************************************************************************************
+ * \brief Filter a range of macroblocks in one MB row, used by the deblocking threads.
+ *****************************************************************************************
+*/
+void DeblockMbRange(AVCCommonObj *video, int mb_y, int mb_x_start, int mb_x_end)
+{
+    int   j;
+    int   pitch = video->currPic->pitch, pitch_c;
+    uint8 *SrcY, *SrcU, *SrcV;
+
+    pitch_c = pitch >> 1;
+
+    SrcY = video->currPic->Sl + (mb_y << 4) * pitch + (mb_x_start << 4);
+    SrcU = video->currPic->Scb + (mb_y << 3) * pitch_c + (mb_x_start << 3);
+    SrcV = video->currPic->Scr + (mb_y << 3) * pitch_c + (mb_x_start << 3);
+
+    for (j = mb_x_start; j < mb_x_end; j++)
+    {
+        DeblockMb(video, j, mb_y, SrcY, SrcU, SrcV);
+        SrcY += MB_BLOCK_SIZE;
+        SrcU += (MB_BLOCK_SIZE >> 1);
+        SrcV += (MB_BLOCK_SIZE >> 1);
+    }
+
+    return ;
+}
+
 #ifdef MB_BASED_DEBLOCK
 /*
  *****************************************************************************************
@@ -303,9 +331,9 @@ void DeblockMb(AVCCommonObj *video, int mb_x, int mb_y, uint8 *SrcY, uint8 *SrcU
 
 
     // If filter is disabled, return
-    if (video->sliceHdr->disable_deblocking_filter_idc == 1) return;
+    if (MbQ->disable_deblocking_filter_idc == 1) return;
 
-    if (video->sliceHdr->disable_deblocking_filter_idc == 2)
+    if (MbQ->disable_deblocking_filter_idc == 2)
     {
         // don't filter at slice boundaries
         filterLeftMbEdgeFlag = mb_is_available(video->mblock, video->PicSizeInMbs, mbNum - 1, mbNum);
@@ -328,10 +356,10 @@ void DeblockMb(AVCCommonObj *video, int mb_x, int mb_y, uint8 *SrcY, uint8 *SrcU
         if (*((uint32*)str))    // only if one of the 4 Strength bytes is != 0
         {
             QP = (MbP->QPy + MbQ->QPy + 1) >> 1; // Average QP of the two blocks;
-            indexA = QP + video->FilterOffsetA;
-            indexB = QP + video->FilterOffsetB;
-            indexA = qp_clip_tab[indexA]; // IClip(0, MAX_QP, QP+video->FilterOffsetA)
-            indexB = qp_clip_tab[indexB]; // IClip(0, MAX_QP, QP+video->FilterOffsetB)
+            indexA = QP + MbQ->FilterOffsetA;
+            indexB = QP + MbQ->FilterOffsetB;
+            indexA = qp_clip_tab[indexA]; // IClip(0, MAX_QP, QP+MbQ->FilterOffsetA)
+            indexB = qp_clip_tab[indexB]; // IClip(0, MAX_QP, QP+MbQ->FilterOffsetB)
 
             Alpha  = ALPHA_TABLE[indexA];
             Beta = BETA_TABLE[indexB];
@@ -345,10 +373,10 @@ void DeblockMb(AVCCommonObj *video, int mb_x, int mb_y, uint8 *SrcY, uint8 *SrcU
 #endif
 
             QPC = (MbP->QPc + MbQ->QPc + 1) >> 1;
-            indexA = QPC + video->FilterOffsetA;
-            indexB = QPC + video->FilterOffsetB;
-            indexA = qp_clip_tab[indexA]; // IClip(0, MAX_QP, QP+video->FilterOffsetA)
-            indexB = qp_clip_tab[indexB]; // IClip(0, MAX_QP, QP+video->FilterOffsetB)
+            indexA = QPC + MbQ->FilterOffsetA;
+            indexB = QPC + MbQ->FilterOffsetB;
+            indexA = qp_clip_tab[indexA]; // IClip(0, MAX_QP, QP+MbQ->FilterOffsetA)
+            indexB = qp_clip_tab[indexB]; // IClip(0, MAX_QP, QP+MbQ->FilterOffsetB)
 
             Alpha  = ALPHA_TABLE[indexA];
             Beta = BETA_TABLE[indexB];
@@ -371,11 +399,11 @@ void DeblockMb(AVCCommonObj *video, int mb_x, int mb_y, uint8 *SrcY, uint8 *SrcU
     /* First calculate the necesary parameters all at once, outside the loop */
     MbP = MbQ;
 
-    indexA = MbQ->QPy + video->FilterOffsetA;
-    indexB = MbQ->QPy + video->FilterOffsetB;
+    indexA = MbQ->QPy + MbQ->FilterOffsetA;
+    indexB = MbQ->QPy + MbQ->FilterOffsetB;
     //  index
-    indexA = qp_clip_tab[indexA]; // IClip(0, MAX_QP, QP+video->FilterOffsetA)
-    indexB = qp_clip_tab[indexB]; // IClip(0, MAX_QP, QP+video->FilterOffsetB)
+    indexA = qp_clip_tab[indexA]; // IClip(0, MAX_QP, QP+MbQ->FilterOffsetA)
+    indexB = qp_clip_tab[indexB]; // IClip(0, MAX_QP, QP+MbQ->FilterOffsetB)
 
     Alpha = ALPHA_TABLE[indexA];
     Beta = BETA_TABLE[indexB];
@@ -386,10 +414,10 @@ void DeblockMb(AVCCommonObj *video, int mb_x, int mb_y, uint8 *SrcY, uint8 *SrcU
     mbNum = Beta;
     tmp = (int)clipTable;
 
-    indexA = MbQ->QPc + video->FilterOffsetA;
-    indexB = MbQ->QPc + video->FilterOffsetB;
-    indexA = qp_clip_tab[indexA]; // IClip(0, MAX_QP, QP+video->FilterOffsetA)
-    indexB = qp_clip_tab[indexB]; // IClip(0, MAX_QP, QP+video->FilterOffsetB)
+    indexA = MbQ->QPc + MbQ->FilterOffsetA;
+    indexB = MbQ->QPc + MbQ->FilterOffsetB;
+    indexA = qp_clip_tab[indexA]; // IClip(0, MAX_QP, QP+MbQ->FilterOffsetA)
+    indexB = qp_clip_tab[indexB]; // IClip(0, MAX_QP, QP+MbQ->FilterOffsetB)
 
     Alpha_c  = ALPHA_TABLE[indexA];
     Beta_c = BETA_TABLE[indexB];
@@ -435,10 +463,10 @@ void DeblockMb(AVCCommonObj *video, int mb_x, int mb_y, uint8 *SrcY, uint8 *SrcU
         if (*((uint32*)str))    // only if one of the 4 Strength bytes is != 0
         {
             QP = (MbP->QPy + MbQ->QPy + 1) >> 1; // Average QP of the two blocks;
-            indexA = QP + video->FilterOffsetA;
-            indexB = QP + video->FilterOffsetB;
-            indexA = qp_clip_tab[indexA]; // IClip(0, MAX_QP, QP+video->FilterOffsetA)
-            indexB = qp_clip_tab[indexB]; // IClip(0, MAX_QP, QP+video->FilterOffsetB)
+            indexA = QP + MbQ->FilterOffsetA;
+            indexB = QP + MbQ->FilterOffsetB;
+            indexA = qp_clip_tab[indexA]; // IClip(0, MAX_QP, QP+MbQ->FilterOffsetA)
+            indexB = qp_clip_tab[indexB]; // IClip(0, MAX_QP, QP+MbQ->FilterOffsetB)
 
             Alpha  = ALPHA_TABLE[indexA];
             Beta = BETA_TABLE[indexB];
@@ -454,10 +482,10 @@ void DeblockMb(AVCCommonObj *video, int mb_x, int mb_y, uint8 *SrcY, uint8 *SrcU
             }
 
             QPC = (MbP->QPc + MbQ->QPc + 1) >> 1;
-            indexA = QPC + video->FilterOffsetA;
-            indexB = QPC + video->FilterOffsetB;
-            indexA = qp_clip_tab[indexA]; // IClip(0, MAX_QP, QP+video->FilterOffsetA)
-            indexB = qp_clip_tab[indexB]; // IClip(0, MAX_QP, QP+video->FilterOffsetB)
+            indexA = QPC + MbQ->FilterOffsetA;
+            indexB = QPC + MbQ->FilterOffsetB;
+            indexA = qp_clip_tab[indexA]; // IClip(0, MAX_QP, QP+MbQ->FilterOffsetA)
+            indexB = qp_clip_tab[indexB]; // IClip(0, MAX_QP, QP+MbQ->FilterOffsetB)
 
             Alpha  = ALPHA_TABLE[indexA];
             Beta = BETA_TABLE[indexB];
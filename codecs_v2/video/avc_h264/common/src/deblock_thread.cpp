@@ -0,0 +1,455 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#include "avclib_common.h"
+#include "oscl_mem.h"
+#include "osclconfig_proc.h"
+
+/*
+ * Wavefront deblocking.  Deblocking MB (x,y) changes pixels of MB (x,y), of the
+ * MB to its left and of the MB above it, and it needs the MBs above and to the
+ * left to be deblocked first.  The decoder uses the undeblocked pixels of MB row
+ * y for intra prediction of row y+1.  So row y can be deblocked up to column x as
+ * soon as rows 0..y+1 are decoded and row y-1 is deblocked up to column x+1.
+ *
+ * Thread i deblocks rows i, i+N, i+2N, ...  The decoder releases MB rows as they
+ * are completed in raster order.  If the MBs arrive out of order (FMO, ASO), the
+ * rows are released when the picture is complete, so the picture is still
+ * deblocked in parallel, just not overlapped with decoding.
+ */
+
+#if (OSCL_HAS_THREAD_SUPPORT)
+
+#include "oscl_thread.h"
+#include "oscl_mutex.h"
+#include "oscl_semaphore.h"
+
+#define MAX_DEBLOCK_THREADS 8
+
+typedef struct tagDeblockThread AVCDeblockThread;
+
+typedef struct tagDeblockWorker
+{
+    AVCDeblockThread *owner;
+    int index;
+    OsclSemaphore wake;     /* signaled when the worker may be able to make progress */
+    OsclSemaphore exit;     /* signaled when the thread exits */
+    bool waiting;           /* set while the worker waits on wake, under lock */
+    uint gen;               /* the picture this worker is working on */
+    int row;                /* the row this worker is working on */
+} AVCDeblockWorker;
+
+struct tagDeblockThread
+{
+    AVCCommonObj *video;
+    int numThreads;
+    AVCDeblockWorker worker[MAX_DEBLOCK_THREADS];
+
+    OsclMutex lock;         /* protects everything below, apart from nextMb and frozen */
+    OsclSemaphore done;     /* signaled once by each worker at the end of each picture */
+    uint gen;               /* incremented for each picture */
+    bool picActive;
+    bool abort;             /* stop deblocking the current picture */
+    bool quit;              /* exit the threads */
+    int width;              /* picture size in MBs */
+    int height;
+    int rowsDecoded;        /* number of MB rows released for deblocking */
+    int *rowDone;           /* number of deblocked MBs in each row */
+    int rowDoneSize;
+
+    /* used by the decoder thread only */
+    int nextMb;             /* next MB address expected in raster order */
+    bool frozen;            /* MBs are not in raster order, wait for the end of the picture */
+};
+
+/* wake a worker, the lock must be held */
+static void WakeWorker(AVCDeblockThread *dbt, int i)
+{
+    AVCDeblockWorker *worker = &dbt->worker[i];
+    if (worker->waiting)
+    {
+        worker->waiting = FALSE;
+        worker->wake.Signal();
+    }
+}
+
+static void WakeRowOwner(AVCDeblockThread *dbt, int row)
+{
+    if (row >= 0 && row < dbt->height)
+    {
+        WakeWorker(dbt, row % dbt->numThreads);
+    }
+}
+
+/* wait for a wakeup, the lock must be held */
+static void WaitWorker(AVCDeblockThread *dbt, AVCDeblockWorker *worker)
+{
+    worker->waiting = TRUE;
+    dbt->lock.Unlock();
+    worker->wake.Wait();
+    dbt->lock.Lock();
+}
+
+/* return the end of the range of MBs in the worker's row that can be deblocked now,
+   the lock must be held */
+static int AvailableMbs(AVCDeblockThread *dbt, int row)
+{
+    int above;
+
+    /* the row below must be decoded, since it uses our pixels for intra prediction */
+    if (dbt->rowsDecoded < dbt->height && dbt->rowsDecoded < row + 2)
+    {
+        return 0;
+    }
+
+    if (row == 0)
+    {
+        return dbt->width;
+    }
+
+    above = dbt->rowDone[row-1];
+    if (above == dbt->width)
+    {
+        return above;
+    }
+
+    /* MB x needs MB x+1 of the row above to be done */
+    return (above > 0) ? above - 1 : 0;
+}
+
+static TOsclThreadFuncRet OSCL_THREAD_DECL DeblockThreadMain(TOsclThreadFuncArg arg)
+{
+    AVCDeblockWorker *worker = (AVCDeblockWorker*)arg;
+    AVCDeblockThread *dbt = worker->owner;
+    int start, end;
+
+    dbt->lock.Lock();
+    for (;;)
+    {
+        if (dbt->quit)
+        {
+            break;
+        }
+
+        /* wait for a picture to work on */
+        if (!dbt->picActive || worker->gen == dbt->gen)
+        {
+            WaitWorker(dbt, worker);
+            continue;
+        }
+
+        if (worker->row >= dbt->height || dbt->abort)
+        {
+            /* done with this picture */
+            worker->gen = dbt->gen;
+            dbt->done.Signal();
+            continue;
+        }
+
+        start = dbt->rowDone[worker->row];
+        end = AvailableMbs(dbt, worker->row);
+        if (end <= start)
+        {
+            WaitWorker(dbt, worker);
+            continue;
+        }
+
+        dbt->lock.Unlock();
+        DeblockMbRange(dbt->video, worker->row, start, end);
+        dbt->lock.Lock();
+
+        dbt->rowDone[worker->row] = end;
+        WakeRowOwner(dbt, worker->row + 1);
+        if (end == dbt->width)
+        {
+            worker->row += dbt->numThreads;
+        }
+    }
+    dbt->lock.Unlock();
+
+    worker->exit.Signal();
+    return 0;
+}
+
+AVCStatus DeblockThreadInit(AVCCommonObj *video, int numThreads)
+{
+    AVCDeblockThread *dbt;
+    int i;
+
+    if (video->deblockThread)
+    {
+        return AVC_SUCCESS;
+    }
+
+    if (numThreads <= 0)
+    {
+        return AVC_FAIL;
+    }
+    if (numThreads > MAX_DEBLOCK_THREADS)
+    {
+        numThreads = MAX_DEBLOCK_THREADS;
+    }
+
+    dbt = OSCL_NEW(AVCDeblockThread, ());
+    if (dbt == NULL)
+    {
+        return AVC_FAIL;
+    }
+
+    dbt->video = video;
+    dbt->numThreads = 0;
+    dbt->gen = 0;
+    dbt->picActive = FALSE;
+    dbt->abort = FALSE;
+    dbt->quit = FALSE;
+    dbt->width = 0;
+    dbt->height = 0;
+    dbt->rowsDecoded = 0;
+    dbt->rowDone = NULL;
+    dbt->rowDoneSize = 0;
+    dbt->nextMb = 0;
+    dbt->frozen = FALSE;
+
+    dbt->lock.Create();
+    dbt->done.Create();
+
+    video->deblockThread = (void*)dbt;
+
+    for (i = 0; i < numThreads; i++)
+    {
+        AVCDeblockWorker *worker = &dbt->worker[i];
+        OsclThread thread;
+
+        worker->owner = dbt;
+        worker->index = i;
+        worker->waiting = FALSE;
+        worker->gen = 0;
+        worker->row = 0;
+        worker->wake.Create();
+        worker->exit.Create();
+
+        if (thread.Create((TOsclThreadFuncPtr)DeblockThreadMain, 0, (TOsclThreadFuncArg)worker) != OsclProcStatus::SUCCESS_ERROR)
+        {
+            worker->wake.Close();
+            worker->exit.Close();
+            break;
+        }
+        dbt->numThreads++;
+    }
+
+    if (dbt->numThreads == 0)
+    {
+        DeblockThreadCleanUp(video);
+        return AVC_FAIL;
+    }
+
+    return AVC_SUCCESS;
+}
+
+void DeblockThreadCleanUp(AVCCommonObj *video)
+{
+    AVCDeblockThread *dbt = (AVCDeblockThread*)video->deblockThread;
+    int i;
+
+    if (dbt == NULL)
+    {
+        return ;
+    }
+
+    DeblockThreadFinishPicture(video, FALSE);
+
+    dbt->lock.Lock();
+    dbt->quit = TRUE;
+    for (i = 0; i < dbt->numThreads; i++)
+    {
+        WakeWorker(dbt, i);
+    }
+    dbt->lock.Unlock();
+
+    for (i = 0; i < dbt->numThreads; i++)
+    {
+        dbt->worker[i].exit.Wait();
+        dbt->worker[i].wake.Close();
+        dbt->worker[i].exit.Close();
+    }
+
+    dbt->done.Close();
+    dbt->lock.Close();
+
+    if (dbt->rowDone)
+    {
+        OSCL_ARRAY_DELETE(dbt->rowDone);
+    }
+    OSCL_DELETE(dbt);
+
+    video->deblockThread = NULL;
+
+    return ;
+}
+
+void DeblockThreadStartPicture(AVCCommonObj *video)
+{
+    AVCDeblockThread *dbt = (AVCDeblockThread*)video->deblockThread;
+    int i;
+
+    if (dbt == NULL)
+    {
+        return ;
+    }
+
+    if (dbt->picActive)
+    {
+        DeblockThreadFinishPicture(video, FALSE);
+    }
+
+    dbt->lock.Lock();
+
+    dbt->width = video->PicWidthInMbs;
+    dbt->height = video->PicHeightInMbs;
+    if (dbt->rowDoneSize < dbt->height)
+    {
+        if (dbt->rowDone)
+        {
+            OSCL_ARRAY_DELETE(dbt->rowDone);
+        }
+        dbt->rowDone = OSCL_ARRAY_NEW(int, dbt->height);
+        dbt->rowDoneSize = dbt->height;
+    }
+    oscl_memset(dbt->rowDone, 0, dbt->height * sizeof(int));
+
+    dbt->rowsDecoded = 0;
+    dbt->abort = FALSE;
+    dbt->gen++;
+    dbt->picActive = TRUE;
+    dbt->nextMb = 0;
+    dbt->frozen = FALSE;
+
+    for (i = 0; i < dbt->numThreads; i++)
+    {
+        dbt->worker[i].row = i;
+        WakeWorker(dbt, i);
+    }
+
+    dbt->lock.Unlock();
+
+    return ;
+}
+
+void DeblockThreadMbDecoded(AVCCommonObj *video, int mbAddr)
+{
+    AVCDeblockThread *dbt = (AVCDeblockThread*)video->deblockThread;
+    int rows;
+
+    if (!dbt->picActive || dbt->frozen)
+    {
+        return ;
+    }
+
+    if (mbAddr != dbt->nextMb)
+    {
+        dbt->frozen = TRUE;
+        return ;
+    }
+
+    dbt->nextMb++;
+    if (dbt->nextMb % dbt->width == 0)
+    {
+        rows = dbt->nextMb / dbt->width;
+
+        dbt->lock.Lock();
+        dbt->rowsDecoded = rows;
+        WakeRowOwner(dbt, rows - 2);
+        if (rows == dbt->height)
+        {
+            WakeRowOwner(dbt, rows - 1);
+        }
+        dbt->lock.Unlock();
+    }
+
+    return ;
+}
+
+void DeblockThreadFinishPicture(AVCCommonObj *video, bool deblockAll)
+{
+    AVCDeblockThread *dbt = (AVCDeblockThread*)video->deblockThread;
+    int i;
+
+    if (dbt == NULL || !dbt->picActive)
+    {
+        return ;
+    }
+
+    dbt->lock.Lock();
+    if (deblockAll)
+    {
+        dbt->rowsDecoded = dbt->height;
+    }
+    else
+    {
+        dbt->abort = TRUE;
+    }
+    for (i = 0; i < dbt->numThreads; i++)
+    {
+        WakeWorker(dbt, i);
+    }
+    dbt->lock.Unlock();
+
+    for (i = 0; i < dbt->numThreads; i++)
+    {
+        dbt->done.Wait();
+    }
+
+    dbt->lock.Lock();
+    dbt->picActive = FALSE;
+    dbt->lock.Unlock();
+
+    return ;
+}
+
+#else
+
+AVCStatus DeblockThreadInit(AVCCommonObj *video, int numThreads)
+{
+    OSCL_UNUSED_ARG(video);
+    OSCL_UNUSED_ARG(numThreads);
+    return AVC_FAIL;
+}
+
+void DeblockThreadCleanUp(AVCCommonObj *video)
+{
+    OSCL_UNUSED_ARG(video);
+}
+
+void DeblockThreadStartPicture(AVCCommonObj *video)
+{
+    OSCL_UNUSED_ARG(video);
+}
+
+void DeblockThreadMbDecoded(AVCCommonObj *video, int mbAddr)
+{
+    OSCL_UNUSED_ARG(video);
+    OSCL_UNUSED_ARG(mbAddr);
+}
+
+void DeblockThreadFinishPicture(AVCCommonObj *video, bool deblockAll)
+{
+    OSCL_UNUSED_ARG(video);
+    OSCL_UNUSED_ARG(deblockAll);
+}
+
+#endif /* OSCL_HAS_THREAD_SUPPORT */
+
@@ -7,6 +7,7 @@ LOCAL_SRC_FILES := \
  	src/header.cpp \
  	src/itrans.cpp \
  	src/pred_inter.cpp \
+ 	src/pred_inter_x86.cpp \
  	src/pred_intra.cpp \
  	src/pvavcdecoder.cpp \
  	src/pvavcdecoder_factory.cpp \
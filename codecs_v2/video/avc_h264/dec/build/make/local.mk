@@ -18,6 +18,7 @@ SRCS := avcdec_api.cpp \
 	header.cpp \
 	itrans.cpp \
 	pred_inter.cpp \
+	pred_inter_x86.cpp \
 	pred_intra.cpp \
 	pvavcdecoder.cpp \
 	pvavcdecoder_factory.cpp \
@@ -186,6 +186,18 @@ extern "C"
     \param "avcHandle"  "Handle to the AVC decoder library object."
     */
     OSCL_IMPORT_REF void    PVAVCCleanUpDecoder(AVCHandle *avcHandle);
+
+    /**
+    This function starts background threads that deblock each picture while it is being
+    decoded, a few MB rows behind the decoder. It can be called after the first SPS has
+    been decoded, between pictures. If the threads are already running they are kept.
+    The threads are stopped by PVAVCCleanUpDecoder.
+    \param "avcHandle"  "Handle to the AVC decoder library object."
+    \param "numThreads" "Number of deblocking threads, 0 to keep deblocking at the end of the picture."
+    \return "AVCDEC_SUCCESS if success, AVCDEC_FAIL if threads are not supported or
+            a picture is being decoded."
+    */
+    OSCL_IMPORT_REF AVCDec_Status PVAVCDecSetDeblockThreads(AVCHandle *avcHandle, int numThreads);
 //AVCDec_Status EBSPtoRBSP(uint8 *nal_unit,int *size);
 
 
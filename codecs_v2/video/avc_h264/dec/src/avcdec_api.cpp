@@ -235,6 +235,9 @@ OSCL_EXPORT_REF AVCDec_Status   PVAVCDecSeqParamSet(AVCHandle *avcHandle, uint8
             return AVCDEC_MEMORY_FAIL;
         }
 
+        /* motion compensation kernels for this CPU */
+        InitMCFuncs(&decvid->mc);
+
         decvid->bitstream->userData = avcHandle->userData; /* callback for more data */
         decvid->avcHandle = avcHandle;
         decvid->debugEnable = avcHandle->debugEnable;
@@ -521,7 +524,18 @@ OSCL_EXPORT_REF AVCDec_Status PVAVCDecodeSlice(AVCHandle *avcHandle, uint8 *buff
                 ConcealSlice(decvid, video->PicSizeInMbs - video->numMBs, video->PicSizeInMbs);  // Conceal
                 video->numMBs = 0;
 
-                //              DeblockPicture(video);   // No need to deblock
+#ifndef MB_BASED_DEBLOCK
+                /* deblock the concealed picture as a complete one, the threads
+                   may have deblocked its first rows already */
+                if (video->deblockThread)
+                {
+                    DeblockThreadFinishPicture(video, TRUE);
+                }
+                else
+                {
+                    DeblockPicture(video);
+                }
+#endif
 
                 /* 3.2 Decoded frame reference marking. */
                 /* 3.3 Put the decoded picture in output buffers */
@@ -547,6 +561,7 @@ OSCL_EXPORT_REF AVCDec_Status PVAVCDecodeSlice(AVCHandle *avcHandle, uint8 *buff
             if (video->sliceHdr->frame_num != video->PrevRefFrameNum && video->sliceHdr->frame_num != (video->PrevRefFrameNum + 1) % video->MaxFrameNum)
             {
                 // Conceal missing MBs of previously decoded frame
+                DeblockThreadFinishPicture(video, FALSE);
                 video->numMBs = 0;
                 video->newPic = TRUE;
                 video->prevFrameNum++; // FIX
@@ -583,6 +598,9 @@ OSCL_EXPORT_REF AVCDec_Status PVAVCDecodeSlice(AVCHandle *avcHandle, uint8 *buff
 
     if (video->newPic == TRUE)
     {
+        /* in case the previous picture was left incomplete */
+        DeblockThreadFinishPicture(video, FALSE);
+
         status = (AVCDec_Status)DPBInitBuffer(avcHandle, video);
         if (status != AVCDEC_SUCCESS)
         {
@@ -642,6 +660,9 @@ OSCL_EXPORT_REF AVCDec_Status PVAVCDecodeSlice(AVCHandle *avcHandle, uint8 *buff
 
         FMOInit(video);
 
+        /* start deblocking the rows of this picture as they are decoded */
+        DeblockThreadStartPicture(video);
+
         if (video->currPic->isReference)
         {
             video->PrevRefFrameNum = video->sliceHdr->frame_num;
@@ -674,7 +695,14 @@ OSCL_EXPORT_REF AVCDec_Status PVAVCDecodeSlice(AVCHandle *avcHandle, uint8 *buff
         /* 3. Check complete picture */
 #ifndef MB_BASED_DEBLOCK
         /* 3.1 Deblock */
-        DeblockPicture(video);
+        if (video->deblockThread)
+        {
+            DeblockThreadFinishPicture(video, TRUE);
+        }
+        else
+        {
+            DeblockPicture(video);
+        }
 #endif
         /* 3.2 Decoded frame reference marking. */
         /* 3.3 Put the decoded picture in output buffers */
@@ -890,6 +918,54 @@ OSCL_EXPORT_REF AVCDec_Status PVAVCDecGetOutput(AVCHandle *avcHandle, int *indx,
 }
 
 
+/* ======================================================================== */
+/*  Function : PVAVCDecSetDeblockThreads()                                  */
+/*  Purpose  : Start or stop background deblocking threads.                 */
+/*  In/out   :                                                              */
+/*  Return   : AVCDEC_SUCCESS if succeed, AVCDEC_FAIL if fail.              */
+/*  Modified :                                                              */
+/* ======================================================================== */
+OSCL_EXPORT_REF AVCDec_Status PVAVCDecSetDeblockThreads(AVCHandle *avcHandle, int numThreads)
+{
+    AVCDecObject *decvid = (AVCDecObject*) avcHandle->AVCObject;
+    AVCCommonObj *video;
+
+    if (decvid == NULL || decvid->common == NULL)
+    {
+        return AVCDEC_FAIL;
+    }
+
+    video = decvid->common;
+
+    /* already running, keep the threads */
+    if (numThreads > 0 && video->deblockThread)
+    {
+        return AVCDEC_SUCCESS;
+    }
+
+    /* can't change in the middle of a picture */
+    if (video->numMBs > 0)
+    {
+        return AVCDEC_FAIL;
+    }
+
+    if (numThreads <= 0)
+    {
+        DeblockThreadCleanUp(video);
+        return AVCDEC_SUCCESS;
+    }
+
+#ifdef MB_BASED_DEBLOCK
+    return AVCDEC_FAIL;
+#else
+    if (DeblockThreadInit(video, numThreads) != AVC_SUCCESS)
+    {
+        return AVCDEC_FAIL;
+    }
+    return AVCDEC_SUCCESS;
+#endif
+}
+
 /* ======================================================================== */
 /*  Function : PVAVCDecReset()                                              */
 /*  Date     : 03/04/2004                                                   */
@@ -913,6 +989,8 @@ OSCL_EXPORT_REF void    PVAVCDecReset(AVCHandle *avcHandle)
     video = decvid->common;
     dpb = video->decPicBuf;
 
+    DeblockThreadFinishPicture(video, FALSE);
+
     /* reset the DPB */
 
 
@@ -965,6 +1043,8 @@ OSCL_EXPORT_REF void PVAVCCleanUpDecoder(AVCHandle *avcHandle)
         video = decvid->common;
         if (video != NULL)
         {
+            DeblockThreadCleanUp(video);
+
             if (video->MbToSliceGroupMap != NULL)
             {
                 avcHandle->CBAVC_Free(userData, (int)video->MbToSliceGroupMap);
@@ -52,6 +52,53 @@ typedef struct tagDecBitstream
     void *userData;
 } AVCDecBitstream;
 
+/**
+x86 SIMD motion compensation. AVCDEC_X86_SIMD builds the SSE2 kernels in
+pred_inter_x86.cpp, it is on by default when the compiler targets SSE2.
+AVCDEC_X86_AVX2 also builds AVX2 kernels for 16-pixel wide blocks, they are
+used only if the CPU supports AVX2.
+*/
+#ifndef AVCDEC_X86_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define AVCDEC_X86_SIMD 1
+#else
+#define AVCDEC_X86_SIMD 0
+#endif
+#endif
+
+#ifndef AVCDEC_X86_AVX2
+#if (AVCDEC_X86_SIMD) && defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9) || defined(__clang__))
+#define AVCDEC_X86_AVX2 1
+#else
+#define AVCDEC_X86_AVX2 0
+#endif
+#endif
+
+#if !(AVCDEC_X86_SIMD)
+#undef AVCDEC_X86_AVX2
+#define AVCDEC_X86_AVX2 0
+#endif
+
+/**
+Motion compensation kernels. They are set up by InitMCFuncs to the C versions in
+pred_inter.cpp, or to faster versions for the CPU the decoder is running on. All
+versions give exactly the same output.
+@publishedAll
+*/
+typedef struct tagDecMCFuncs
+{
+    void (*FullPelMC)(uint8 *in, int inpitch, uint8 *out, int outpitch,
+                      int blkwidth, int blkheight);
+    void (*HorzInterp1MC)(uint8 *in, int inpitch, uint8 *out, int outpitch,
+                          int blkwidth, int blkheight, int dx);
+    void (*VertInterp1MC)(uint8 *in, int inpitch, uint8 *out, int outpitch,
+                          int blkwidth, int blkheight, int dy);
+    void (*DiagonalInterpMC)(uint8 *in1, uint8 *in2, int inpitch,
+                             uint8 *out, int outpitch, int blkwidth, int blkheight);
+    void (*ChromaMC)(uint8 *pRef, int srcPitch, int dx, int dy,
+                     uint8 *pOut, int predPitch, int blkwidth, int blkheight);
+} AVCDecMCFuncs;
+
 /**
 This structure is the main object for AVC decoder library providing access to all
 global variables. It is allocated at PVAVCInitDecoder and freed at PVAVCCleanUpDecoder.
@@ -77,6 +124,7 @@ typedef struct tagDecObject
     /* function pointers */
     AVCDec_Status(*residual_block)(struct tagDecObject*, int,  int,
                                    int *, int *, int *);
+    AVCDecMCFuncs mc;
     /* Application control data */
     AVCHandle *avcHandle;
     void (*AVC_DebugLog)(AVCLogType type, char *string1, char *string2);
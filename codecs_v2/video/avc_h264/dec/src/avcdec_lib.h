@@ -69,13 +69,21 @@ void  Intra_Chroma_Plane(AVCCommonObj *video, int pitch, uint8 *predCb, uint8 *p
 This function is the main entrance to inter prediction operation for
 a macroblock. For decoding, this function also calls inverse transform and
 compensation.
-\param "video"  "Pointer to AVCCommonObj."
+\param "decvid" "Pointer to AVCDecObject."
 \return "void"
 */
-void InterMBPrediction(AVCCommonObj *video);
+void InterMBPrediction(AVCDecObject *decvid);
+
+/**
+This function sets up the motion compensation kernels for the CPU.
+\param "mc"     "Pointer to the kernel table."
+\return "void"
+*/
+void InitMCFuncs(AVCDecMCFuncs *mc);
 
 /**
 This function is called for luma motion compensation.
+\param "mc"     "Motion compensation kernels."
 \param "ref"    "Pointer to the origin of a reference luma."
 \param "picwidth"   "Width of the picture."
 \param "picheight"  "Height of the picture."
@@ -87,7 +95,7 @@ This function is called for luma motion compensation.
 \param "blkheight"  "Height of the current partition."
 \return "void"
 */
-void LumaMotionComp(uint8 *ref, int picwidth, int picheight,
+void LumaMotionComp(const AVCDecMCFuncs *mc, uint8 *ref, int picwidth, int picheight,
                     int x_pos, int y_pos,
                     uint8 *pred, int pred_pitch,
                     int blkwidth, int blkheight);
@@ -141,10 +149,28 @@ void DiagonalInterpMC(uint8 *in1, uint8 *in2, int inpitch,
                       int blkwidth, int blkheight);
 
 
-void ChromaMotionComp(uint8 *ref, int picwidth, int picheight,
+void ChromaMotionComp(const AVCDecMCFuncs *mc, uint8 *ref, int picwidth, int picheight,
                       int x_pos, int y_pos, uint8 *pred, int pred_pitch,
                       int blkwidth, int blkheight);
 
+/**
+C version of AVCDecMCFuncs::ChromaMC, picks one of the ChromaXXXMC_SIMD functions.
+dx and dy are the fractions in 1/8 pel.
+*/
+void ChromaMC_C(uint8 *pRef, int srcPitch, int dx, int dy,
+                uint8 *pOut, int predPitch, int blkwidth, int blkheight);
+
+#if (AVCDEC_X86_SIMD)
+/*------------ pred_inter_x86.c ---------------*/
+/**
+This function replaces the kernels in the table with the x86 SIMD versions
+supported by the CPU.
+\param "mc"     "Pointer to the kernel table."
+\return "void"
+*/
+void InitMCFuncs_x86(AVCDecMCFuncs *mc);
+#endif
+
 void ChromaFullPelMC(uint8 *in, int inpitch, uint8 *out, int outpitch,
                      int blkwidth, int blkheight) ;
 void ChromaBorderMC(uint8 *ref, int picwidth, int dx, int dy,
@@ -570,6 +570,8 @@ AVCDec_Status DecodeSliceHeader(AVCDecObject *decvid, AVCCommonObj *video, AVCDe
     if (currPPS->seq_parameter_set_id != video->seq_parameter_set_id)
     {
         video->seq_parameter_set_id = currPPS->seq_parameter_set_id;
+        /* the MB array is re-allocated */
+        DeblockThreadFinishPicture(video, FALSE);
         status = (AVCDec_Status)AVCConfigureSequence(decvid->avcHandle, video, false);
         if (status != AVCDEC_SUCCESS)
             return status;
@@ -34,9 +34,26 @@ static void (*const ChromaMC_SIMD[8])(uint8 *, int , int , int , uint8 *, int, i
     &ChromaVerticalMC2_SIMD,
     &ChromaDiagonalMC2_SIMD
 };
+
+void InitMCFuncs(AVCDecMCFuncs *mc)
+{
+    mc->FullPelMC = &FullPelMC;
+    mc->HorzInterp1MC = &HorzInterp1MC;
+    mc->VertInterp1MC = &VertInterp1MC;
+    mc->DiagonalInterpMC = &DiagonalInterpMC;
+    mc->ChromaMC = &ChromaMC_C;
+
+#if (AVCDEC_X86_SIMD)
+    InitMCFuncs_x86(mc);
+#endif
+    return ;
+}
+
 /* Perform motion prediction and compensation with residue if exist. */
-void InterMBPrediction(AVCCommonObj *video)
+void InterMBPrediction(AVCDecObject *decvid)
 {
+    AVCCommonObj *video = decvid->common;
+    const AVCDecMCFuncs *mc = &decvid->mc;
     AVCMacroblock *currMB = video->currMB;
     AVCPictureData *currPic = video->currPic;
     int mbPartIdx, subMbPartIdx;
@@ -102,30 +119,30 @@ void InterMBPrediction(AVCCommonObj *video)
             //offsetC = (offset >> 2) + (offset_x >> 1);
 #ifdef USE_PRED_BLOCK
             offsetP = (block_y * 80) + (block_x << 2);
-            LumaMotionComp(ref_l, picWidth, picHeight, x_pos, y_pos,
+            LumaMotionComp(mc, ref_l, picWidth, picHeight, x_pos, y_pos,
                            /*comp_Sl + offset + offset_x,*/
                            predBlock + offsetP, 20, MbWidth, MbHeight);
 #else
             offsetP = (block_y << 2) * picWidth + (block_x << 2);
-            LumaMotionComp(ref_l, picWidth, picHeight, x_pos, y_pos,
+            LumaMotionComp(mc, ref_l, picWidth, picHeight, x_pos, y_pos,
                            /*comp_Sl + offset + offset_x,*/
                            predBlock + offsetP, picWidth, MbWidth, MbHeight);
 #endif
 
 #ifdef USE_PRED_BLOCK
             offsetP = (block_y * 24) + (block_x << 1);
-            ChromaMotionComp(ref_Cb, picWidth >> 1, picHeight >> 1, x_pos, y_pos,
+            ChromaMotionComp(mc, ref_Cb, picWidth >> 1, picHeight >> 1, x_pos, y_pos,
                              /*comp_Scb +  offsetC,*/
                              predCb + offsetP, 12, MbWidth >> 1, MbHeight >> 1);
-            ChromaMotionComp(ref_Cr, picWidth >> 1, picHeight >> 1, x_pos, y_pos,
+            ChromaMotionComp(mc, ref_Cr, picWidth >> 1, picHeight >> 1, x_pos, y_pos,
                              /*comp_Scr +  offsetC,*/
                              predCr + offsetP, 12, MbWidth >> 1, MbHeight >> 1);
 #else
             offsetP = (block_y * picWidth) + (block_x << 1);
-            ChromaMotionComp(ref_Cb, picWidth >> 1, picHeight >> 1, x_pos, y_pos,
+            ChromaMotionComp(mc, ref_Cb, picWidth >> 1, picHeight >> 1, x_pos, y_pos,
                              /*comp_Scb +  offsetC,*/
                              predCb + offsetP, picWidth >> 1, MbWidth >> 1, MbHeight >> 1);
-            ChromaMotionComp(ref_Cr, picWidth >> 1, picHeight >> 1, x_pos, y_pos,
+            ChromaMotionComp(mc, ref_Cr, picWidth >> 1, picHeight >> 1, x_pos, y_pos,
                              /*comp_Scr +  offsetC,*/
                              predCr + offsetP, picWidth >> 1, MbWidth >> 1, MbHeight >> 1);
 #endif
@@ -237,7 +254,7 @@ void InterMBPrediction(AVCCommonObj *video)
 
 
 /* preform the actual  motion comp here */
-void LumaMotionComp(uint8 *ref, int picwidth, int picheight,
+void LumaMotionComp(const AVCDecMCFuncs *mc, uint8 *ref, int picwidth, int picheight,
                     int x_pos, int y_pos,
                     uint8 *pred, int pred_pitch,
                     int blkwidth, int blkheight)
@@ -258,12 +275,12 @@ void LumaMotionComp(uint8 *ref, int picwidth, int picheight,
         if (x_pos >= 0 && x_pos + blkwidth <= picwidth && y_pos >= 0 && y_pos + blkheight <= picheight)
         {
             ref += y_pos * picwidth + x_pos;
-            FullPelMC(ref, picwidth, pred, pred_pitch, blkwidth, blkheight);
+            mc->FullPelMC(ref, picwidth, pred, pred_pitch, blkwidth, blkheight);
         }
         else
         {
             CreatePad(ref, picwidth, picheight, x_pos, y_pos, &temp[0][0], blkwidth, blkheight);
-            FullPelMC(&temp[0][0], 24, pred, pred_pitch, blkwidth, blkheight);
+            mc->FullPelMC(&temp[0][0], 24, pred, pred_pitch, blkwidth, blkheight);
         }
 
     }   /* other positions */
@@ -274,13 +291,13 @@ void LumaMotionComp(uint8 *ref, int picwidth, int picheight,
         {
             ref += y_pos * picwidth + x_pos;
 
-            HorzInterp1MC(ref, picwidth, pred, pred_pitch, blkwidth, blkheight, dx);
+            mc->HorzInterp1MC(ref, picwidth, pred, pred_pitch, blkwidth, blkheight, dx);
         }
         else  /* need padding */
         {
             CreatePad(ref, picwidth, picheight, x_pos - 2, y_pos, &temp[0][0], blkwidth + 5, blkheight);
 
-            HorzInterp1MC(&temp[0][2], 24, pred, pred_pitch, blkwidth, blkheight, dx);
+            mc->HorzInterp1MC(&temp[0][2], 24, pred, pred_pitch, blkwidth, blkheight, dx);
         }
     }
     else if (dx == 0)
@@ -290,13 +307,13 @@ void LumaMotionComp(uint8 *ref, int picwidth, int picheight,
         {
             ref += y_pos * picwidth + x_pos;
 
-            VertInterp1MC(ref, picwidth, pred, pred_pitch, blkwidth, blkheight, dy);
+            mc->VertInterp1MC(ref, picwidth, pred, pred_pitch, blkwidth, blkheight, dy);
         }
         else  /* need padding */
         {
             CreatePad(ref, picwidth, picheight, x_pos, y_pos - 2, &temp[0][0], blkwidth, blkheight + 5);
 
-            VertInterp1MC(&temp[2][0], 24, pred, pred_pitch, blkwidth, blkheight, dy);
+            mc->VertInterp1MC(&temp[2][0], 24, pred, pred_pitch, blkwidth, blkheight, dy);
         }
     }
     else if (dy == 2)
@@ -346,7 +363,7 @@ void LumaMotionComp(uint8 *ref, int picwidth, int picheight,
 
             ref += (y_pos * picwidth) + x_pos + (dx / 2);
 
-            DiagonalInterpMC(ref2, ref, picwidth, pred, pred_pitch, blkwidth, blkheight);
+            mc->DiagonalInterpMC(ref2, ref, picwidth, pred, pred_pitch, blkwidth, blkheight);
         }
         else  /* need padding */
         {
@@ -356,7 +373,7 @@ void LumaMotionComp(uint8 *ref, int picwidth, int picheight,
 
             ref = &temp[2][2 + (dx/2)];
 
-            DiagonalInterpMC(ref2, ref, 24, pred, pred_pitch, blkwidth, blkheight);
+            mc->DiagonalInterpMC(ref2, ref, 24, pred, pred_pitch, blkwidth, blkheight);
         }
     }
 
@@ -1978,14 +1995,13 @@ void FullPelMC(uint8 *in, int inpitch, uint8 *out, int outpitch,
     return ;
 }
 
-void ChromaMotionComp(uint8 *ref, int picwidth, int picheight,
+void ChromaMotionComp(const AVCDecMCFuncs *mc, uint8 *ref, int picwidth, int picheight,
                       int x_pos, int y_pos,
                       uint8 *pred, int pred_pitch,
                       int blkwidth, int blkheight)
 {
     int dx, dy;
     int offset_dx, offset_dy;
-    int index;
     uint8 temp[24][24];
 
     dx = x_pos & 7;
@@ -2006,9 +2022,18 @@ void ChromaMotionComp(uint8 *ref, int picwidth, int picheight,
         picwidth = 24;
     }
 
-    index = offset_dx + (offset_dy << 1) + ((blkwidth << 1) & 0x7);
+    mc->ChromaMC(ref, picwidth , dx, dy, pred, pred_pitch, blkwidth, blkheight);
+    return ;
+}
+
+void ChromaMC_C(uint8 *pRef, int srcPitch, int dx, int dy,
+                uint8 *pOut, int predPitch, int blkwidth, int blkheight)
+{
+    int index;
+
+    index = ((dx + 7) >> 3) + (((dy + 7) >> 3) << 1) + ((blkwidth << 1) & 0x7);
 
-    (*(ChromaMC_SIMD[index]))(ref, picwidth , dx, dy, pred, pred_pitch, blkwidth, blkheight);
+    (*(ChromaMC_SIMD[index]))(pRef, srcPitch, dx, dy, pOut, predPitch, blkwidth, blkheight);
     return ;
 }
 
@@ -0,0 +1,518 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/* x86 SIMD versions of the motion compensation kernels in pred_inter.cpp.
+   They give exactly the same output as the C versions, and read exactly the
+   same reference pixels, so they can be used on unpadded reference frames. */
+
+#include "avcdec_lib.h"
+#include "oscl_mem.h"
+
+#if (AVCDEC_X86_SIMD)
+
+#include <emmintrin.h>
+#if (AVCDEC_X86_AVX2)
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+/* load/store 4 or 8 pixels */
+static inline __m128i Load4(const uint8 *p)
+{
+    int32 word;
+    oscl_memcpy(&word, p, 4);
+    return _mm_cvtsi32_si128(word);
+}
+
+static inline void Store4(uint8 *p, __m128i x)
+{
+    int32 word = _mm_cvtsi128_si32(x);
+    oscl_memcpy(p, &word, 4);
+}
+
+static inline __m128i Load8(const uint8 *p)
+{
+    return _mm_loadl_epi64((const __m128i*)p);
+}
+
+static inline void Store8(uint8 *p, __m128i x)
+{
+    _mm_storel_epi64((__m128i*)p, x);
+}
+
+/* load 4 or 8 pixels as 16-bit values */
+static inline __m128i Load4w(const uint8 *p)
+{
+    return _mm_unpacklo_epi8(Load4(p), _mm_setzero_si128());
+}
+
+static inline __m128i Load8w(const uint8 *p)
+{
+    return _mm_unpacklo_epi8(Load8(p), _mm_setzero_si128());
+}
+
+/* 6-tap filter on 16-bit values, (a - 5b + 20c + 20d - 5e + f + 16) >> 5.
+   The range of the sum fits in 16 bits. The result is clipped when packed. */
+static inline __m128i Tap6(__m128i a, __m128i b, __m128i c, __m128i d, __m128i e, __m128i f)
+{
+    __m128i ce = _mm_add_epi16(c, d);
+    __m128i be = _mm_add_epi16(b, e);
+    __m128i af = _mm_add_epi16(a, f);
+
+    af = _mm_add_epi16(af, _mm_mullo_epi16(ce, _mm_set1_epi16(20)));
+    af = _mm_sub_epi16(af, _mm_mullo_epi16(be, _mm_set1_epi16(5)));
+    af = _mm_add_epi16(af, _mm_set1_epi16(16));
+    return _mm_srai_epi16(af, 5);
+}
+
+/* horizontal half-pel of 4 or 8 pixels at p, packed to 8-bit */
+static inline __m128i HorzHalf4(const uint8 *p)
+{
+    __m128i res = Tap6(Load4w(p - 2), Load4w(p - 1), Load4w(p), Load4w(p + 1), Load4w(p + 2), Load4w(p + 3));
+    return _mm_packus_epi16(res, res);
+}
+
+static inline __m128i HorzHalf8(const uint8 *p)
+{
+    __m128i res = Tap6(Load8w(p - 2), Load8w(p - 1), Load8w(p), Load8w(p + 1), Load8w(p + 2), Load8w(p + 3));
+    return _mm_packus_epi16(res, res);
+}
+
+static void FullPelMC_SSE2(uint8 *in, int inpitch, uint8 *out, int outpitch,
+                           int blkwidth, int blkheight)
+{
+    int j;
+
+    if (blkwidth == 16)
+    {
+        for (j = blkheight; j > 0; j--)
+        {
+            _mm_storeu_si128((__m128i*)out, _mm_loadu_si128((const __m128i*)in));
+            in += inpitch;
+            out += outpitch;
+        }
+    }
+    else if (blkwidth == 8)
+    {
+        for (j = blkheight; j > 0; j--)
+        {
+            Store8(out, Load8(in));
+            in += inpitch;
+            out += outpitch;
+        }
+    }
+    else
+    {
+        for (j = blkheight; j > 0; j--)
+        {
+            Store4(out, Load4(in));
+            in += inpitch;
+            out += outpitch;
+        }
+    }
+    return ;
+}
+
+static void HorzInterp1MC_SSE2(uint8 *in, int inpitch, uint8 *out, int outpitch,
+                               int blkwidth, int blkheight, int dx)
+{
+    int i, j;
+    int qpel = (dx & 1);
+    int offset = (dx >> 1); /* 1/4 pel averages with the full pel on the left, 3/4 pel on the right */
+    __m128i res;
+
+    for (j = blkheight; j > 0; j--)
+    {
+        if (blkwidth == 4)
+        {
+            res = HorzHalf4(in);
+            if (qpel)
+            {
+                res = _mm_avg_epu8(res, Load4(in + offset));
+            }
+            Store4(out, res);
+        }
+        else
+        {
+            for (i = 0; i < blkwidth; i += 8)
+            {
+                res = HorzHalf8(in + i);
+                if (qpel)
+                {
+                    res = _mm_avg_epu8(res, Load8(in + i + offset));
+                }
+                Store8(out + i, res);
+            }
+        }
+        in += inpitch;
+        out += outpitch;
+    }
+    return ;
+}
+
+/* vertical filter of one 4 or 8 pixel wide column, optionally averaged with avg,
+   a column of the same size with the given pitch */
+static inline void VertColumn8(uint8 *in, int inpitch, uint8 *out, int outpitch,
+                               int blkheight, uint8 *avg, int avgpitch)
+{
+    __m128i r0, r1, r2, r3, r4, r5, res;
+    int j;
+
+    r0 = Load8w(in - 2 * inpitch);
+    r1 = Load8w(in - inpitch);
+    r2 = Load8w(in);
+    r3 = Load8w(in + inpitch);
+    r4 = Load8w(in + 2 * inpitch);
+    in += 3 * inpitch;
+
+    for (j = blkheight; j > 0; j--)
+    {
+        r5 = Load8w(in);
+        res = Tap6(r0, r1, r2, r3, r4, r5);
+        res = _mm_packus_epi16(res, res);
+        if (avg)
+        {
+            res = _mm_avg_epu8(res, Load8(avg));
+            avg += avgpitch;
+        }
+        Store8(out, res);
+        out += outpitch;
+        in += inpitch;
+        r0 = r1;
+        r1 = r2;
+        r2 = r3;
+        r3 = r4;
+        r4 = r5;
+    }
+}
+
+static inline void VertColumn4(uint8 *in, int inpitch, uint8 *out, int outpitch,
+                               int blkheight, uint8 *avg, int avgpitch)
+{
+    __m128i r0, r1, r2, r3, r4, r5, res;
+    int j;
+
+    r0 = Load4w(in - 2 * inpitch);
+    r1 = Load4w(in - inpitch);
+    r2 = Load4w(in);
+    r3 = Load4w(in + inpitch);
+    r4 = Load4w(in + 2 * inpitch);
+    in += 3 * inpitch;
+
+    for (j = blkheight; j > 0; j--)
+    {
+        r5 = Load4w(in);
+        res = Tap6(r0, r1, r2, r3, r4, r5);
+        res = _mm_packus_epi16(res, res);
+        if (avg)
+        {
+            res = _mm_avg_epu8(res, Load4(avg));
+            avg += avgpitch;
+        }
+        Store4(out, res);
+        out += outpitch;
+        in += inpitch;
+        r0 = r1;
+        r1 = r2;
+        r2 = r3;
+        r3 = r4;
+        r4 = r5;
+    }
+}
+
+static void VertInterp1MC_SSE2(uint8 *in, int inpitch, uint8 *out, int outpitch,
+                               int blkwidth, int blkheight, int dy)
+{
+    int i;
+    uint8 *avg = NULL;
+
+    if (dy & 1)
+    {
+        /* 1/4 pel averages with the full pel above, 3/4 pel below */
+        avg = in + (dy >> 1) * inpitch;
+    }
+
+    if (blkwidth == 4)
+    {
+        VertColumn4(in, inpitch, out, outpitch, blkheight, avg, inpitch);
+        return ;
+    }
+
+    for (i = 0; i < blkwidth; i += 8)
+    {
+        VertColumn8(in + i, inpitch, out + i, outpitch, blkheight, avg ? avg + i : NULL, inpitch);
+    }
+    return ;
+}
+
+static void DiagonalInterpMC_SSE2(uint8 *in1, uint8 *in2, int inpitch,
+                                  uint8 *out, int outpitch,
+                                  int blkwidth, int blkheight)
+{
+    uint8 tmp_res[16][16]; /* horizontal half-pel of in1 */
+    int i, j;
+
+    /* the horizontal half-pel goes to tmp_res, then the vertical half-pel of in2 is
+       averaged with it */
+    for (j = 0; j < blkheight; j++)
+    {
+        if (blkwidth == 4)
+        {
+            Store4(&tmp_res[j][0], HorzHalf4(in1));
+        }
+        else
+        {
+            for (i = 0; i < blkwidth; i += 8)
+            {
+                Store8(&tmp_res[j][i], HorzHalf8(in1 + i));
+            }
+        }
+        in1 += inpitch;
+    }
+
+    if (blkwidth == 4)
+    {
+        VertColumn4(in2, inpitch, out, outpitch, blkheight, &tmp_res[0][0], 16);
+        return ;
+    }
+
+    for (i = 0; i < blkwidth; i += 8)
+    {
+        VertColumn8(in2 + i, inpitch, out + i, outpitch, blkheight, &tmp_res[0][i], 16);
+    }
+    return ;
+}
+
+/* bilinear chroma interpolation, ((8-dx)(8-dy)A + dx(8-dy)B + (8-dx)dyC + dxdyD + 32) >> 6.
+   The full pel and one-dimensional cases of the C version give the same result. */
+static void ChromaMC_SSE2(uint8 *pRef, int srcPitch, int dx, int dy,
+                          uint8 *pOut, int predPitch, int blkwidth, int blkheight)
+{
+    __m128i wA, wB, wC, wD, round, res;
+    int offx, offy;
+    int i, j;
+
+    if (blkwidth < 4)
+    {
+        ChromaMC_C(pRef, srcPitch, dx, dy, pOut, predPitch, blkwidth, blkheight);
+        return ;
+    }
+
+    wA = _mm_set1_epi16((int16)((8 - dx) * (8 - dy)));
+    wB = _mm_set1_epi16((int16)(dx * (8 - dy)));
+    wC = _mm_set1_epi16((int16)((8 - dx) * dy));
+    wD = _mm_set1_epi16((int16)(dx * dy));
+    round = _mm_set1_epi16(32);
+
+    /* don't touch the pixels right of or below the block unless they are used */
+    offx = (dx ? 1 : 0);
+    offy = (dy ? srcPitch : 0);
+
+    for (j = blkheight; j > 0; j--)
+    {
+        for (i = 0; i < blkwidth; i += 8)
+        {
+            uint8 *p = pRef + i;
+            if (blkwidth == 4)
+            {
+                res = _mm_mullo_epi16(Load4w(p), wA);
+                res = _mm_add_epi16(res, _mm_mullo_epi16(Load4w(p + offx), wB));
+                res = _mm_add_epi16(res, _mm_mullo_epi16(Load4w(p + offy), wC));
+                res = _mm_add_epi16(res, _mm_mullo_epi16(Load4w(p + offy + offx), wD));
+            }
+            else
+            {
+                res = _mm_mullo_epi16(Load8w(p), wA);
+                res = _mm_add_epi16(res, _mm_mullo_epi16(Load8w(p + offx), wB));
+                res = _mm_add_epi16(res, _mm_mullo_epi16(Load8w(p + offy), wC));
+                res = _mm_add_epi16(res, _mm_mullo_epi16(Load8w(p + offy + offx), wD));
+            }
+            res = _mm_srli_epi16(_mm_add_epi16(res, round), 6);
+            res = _mm_packus_epi16(res, res);
+            if (blkwidth == 4)
+            {
+                Store4(pOut + i, res);
+            }
+            else
+            {
+                Store8(pOut + i, res);
+            }
+        }
+        pRef += srcPitch;
+        pOut += predPitch;
+    }
+    return ;
+}
+
+#if (AVCDEC_X86_AVX2)
+/* AVX2 versions for 16 pixel wide blocks, the most common partition size.
+   Other sizes go to the SSE2 versions. */
+
+AVX2_TARGET static inline __m256i Load16w(const uint8 *p)
+{
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)p));
+}
+
+AVX2_TARGET static inline __m128i Pack16(__m256i x)
+{
+    return _mm_packus_epi16(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+}
+
+AVX2_TARGET static inline __m256i Tap6_AVX2(__m256i a, __m256i b, __m256i c, __m256i d, __m256i e, __m256i f)
+{
+    __m256i ce = _mm256_add_epi16(c, d);
+    __m256i be = _mm256_add_epi16(b, e);
+    __m256i af = _mm256_add_epi16(a, f);
+
+    af = _mm256_add_epi16(af, _mm256_mullo_epi16(ce, _mm256_set1_epi16(20)));
+    af = _mm256_sub_epi16(af, _mm256_mullo_epi16(be, _mm256_set1_epi16(5)));
+    af = _mm256_add_epi16(af, _mm256_set1_epi16(16));
+    return _mm256_srai_epi16(af, 5);
+}
+
+AVX2_TARGET static inline __m128i HorzHalf16(const uint8 *p)
+{
+    return Pack16(Tap6_AVX2(Load16w(p - 2), Load16w(p - 1), Load16w(p), Load16w(p + 1), Load16w(p + 2), Load16w(p + 3)));
+}
+
+AVX2_TARGET static void VertColumn16(uint8 *in, int inpitch, uint8 *out, int outpitch,
+                                     int blkheight, uint8 *avg, int avgpitch)
+{
+    __m256i r0, r1, r2, r3, r4, r5;
+    __m128i res;
+    int j;
+
+    r0 = Load16w(in - 2 * inpitch);
+    r1 = Load16w(in - inpitch);
+    r2 = Load16w(in);
+    r3 = Load16w(in + inpitch);
+    r4 = Load16w(in + 2 * inpitch);
+    in += 3 * inpitch;
+
+    for (j = blkheight; j > 0; j--)
+    {
+        r5 = Load16w(in);
+        res = Pack16(Tap6_AVX2(r0, r1, r2, r3, r4, r5));
+        if (avg)
+        {
+            res = _mm_avg_epu8(res, _mm_loadu_si128((const __m128i*)avg));
+            avg += avgpitch;
+        }
+        _mm_storeu_si128((__m128i*)out, res);
+        out += outpitch;
+        in += inpitch;
+        r0 = r1;
+        r1 = r2;
+        r2 = r3;
+        r3 = r4;
+        r4 = r5;
+    }
+}
+
+AVX2_TARGET static void HorzInterp1MC_AVX2(uint8 *in, int inpitch, uint8 *out, int outpitch,
+        int blkwidth, int blkheight, int dx)
+{
+    int j;
+    int qpel = (dx & 1);
+    int offset = (dx >> 1);
+    __m128i res;
+
+    if (blkwidth != 16)
+    {
+        HorzInterp1MC_SSE2(in, inpitch, out, outpitch, blkwidth, blkheight, dx);
+        return ;
+    }
+
+    for (j = blkheight; j > 0; j--)
+    {
+        res = HorzHalf16(in);
+        if (qpel)
+        {
+            res = _mm_avg_epu8(res, _mm_loadu_si128((const __m128i*)(in + offset)));
+        }
+        _mm_storeu_si128((__m128i*)out, res);
+        in += inpitch;
+        out += outpitch;
+    }
+    return ;
+}
+
+AVX2_TARGET static void VertInterp1MC_AVX2(uint8 *in, int inpitch, uint8 *out, int outpitch,
+        int blkwidth, int blkheight, int dy)
+{
+    if (blkwidth != 16)
+    {
+        VertInterp1MC_SSE2(in, inpitch, out, outpitch, blkwidth, blkheight, dy);
+        return ;
+    }
+
+    VertColumn16(in, inpitch, out, outpitch, blkheight, (dy & 1) ? in + (dy >> 1) * inpitch : NULL, inpitch);
+    return ;
+}
+
+AVX2_TARGET static void DiagonalInterpMC_AVX2(uint8 *in1, uint8 *in2, int inpitch,
+        uint8 *out, int outpitch,
+        int blkwidth, int blkheight)
+{
+    uint8 tmp_res[16][16];
+    int j;
+
+    if (blkwidth != 16)
+    {
+        DiagonalInterpMC_SSE2(in1, in2, inpitch, out, outpitch, blkwidth, blkheight);
+        return ;
+    }
+
+    for (j = 0; j < blkheight; j++)
+    {
+        _mm_storeu_si128((__m128i*)&tmp_res[j][0], HorzHalf16(in1));
+        in1 += inpitch;
+    }
+
+    VertColumn16(in2, inpitch, out, outpitch, blkheight, &tmp_res[0][0], 16);
+    return ;
+}
+
+static bool CpuHasAVX2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? true : false;
+}
+#endif /* AVCDEC_X86_AVX2 */
+
+void InitMCFuncs_x86(AVCDecMCFuncs *mc)
+{
+    /* SSE2 is always there when AVCDEC_X86_SIMD is on */
+    mc->FullPelMC = &FullPelMC_SSE2;
+    mc->HorzInterp1MC = &HorzInterp1MC_SSE2;
+    mc->VertInterp1MC = &VertInterp1MC_SSE2;
+    mc->DiagonalInterpMC = &DiagonalInterpMC_SSE2;
+    mc->ChromaMC = &ChromaMC_SSE2;
+
+#if (AVCDEC_X86_AVX2)
+    if (CpuHasAVX2())
+    {
+        mc->HorzInterp1MC = &HorzInterp1MC_AVX2;
+        mc->VertInterp1MC = &VertInterp1MC_AVX2;
+        mc->DiagonalInterpMC = &DiagonalInterpMC_AVX2;
+    }
+#endif
+    return ;
+}
+
+#endif /* AVCDEC_X86_SIMD */
+
@@ -59,6 +59,9 @@ AVCDec_Status DecodeSlice(AVCDecObject *decvid)
         currMB = video->currMB = &(video->mblock[CurrMbAddr]);
         video->mbNum = CurrMbAddr;
         currMB->slice_id = video->slice_id;  //  slice
+        currMB->disable_deblocking_filter_idc = sliceHdr->disable_deblocking_filter_idc;
+        currMB->FilterOffsetA = video->FilterOffsetA;
+        currMB->FilterOffsetB = video->FilterOffsetB;
 
         /* we can remove this check if we don't support Mbaff. */
         /* we can wrap below into an initMB() function which will also
@@ -87,6 +90,10 @@ AVCDec_Status DecodeSlice(AVCDecObject *decvid)
         }
 #endif
         video->numMBs--;
+        if (video->deblockThread)
+        {
+            DeblockThreadMbDecoded(video, CurrMbAddr);
+        }
 
         moreDataFlag = more_rbsp_data(stream);
 
@@ -167,7 +174,7 @@ AVCDec_Status DecodeMB(AVCDecObject *decvid)
             /* for skipped MB, always look at the first entry in RefPicList */
             currMB->RefIdx[0] = currMB->RefIdx[1] =
                                     currMB->RefIdx[2] = currMB->RefIdx[3] = video->RefPicList0[0]->RefIdx;
-            InterMBPrediction(video);
+            InterMBPrediction(decvid);
             video->mb_skip_run--;
             return AVCDEC_SUCCESS;
         }
@@ -267,7 +274,7 @@ AVCDec_Status DecodeMB(AVCDecObject *decvid)
     }
     else
     {
-        InterMBPrediction(video);
+        InterMBPrediction(decvid);
     }
 
 
@@ -728,6 +735,9 @@ AVCDec_Status ConcealSlice(AVCDecObject *decvid, int mbnum_start, int mbnum_end)
         currMB = video->currMB = &(video->mblock[CurrMbAddr]);
         video->mbNum = CurrMbAddr;
         currMB->slice_id = video->slice_id++;  //  slice
+        currMB->disable_deblocking_filter_idc = video->sliceHdr->disable_deblocking_filter_idc;
+        currMB->FilterOffsetA = video->FilterOffsetA;
+        currMB->FilterOffsetB = video->FilterOffsetB;
 
         /* we can remove this check if we don't support Mbaff. */
         /* we can wrap below into an initMB() function which will also
@@ -760,9 +770,13 @@ AVCDec_Status ConcealSlice(AVCDecObject *decvid, int mbnum_start, int mbnum_end)
         /* for skipped MB, always look at the first entry in RefPicList */
         currMB->RefIdx[0] = currMB->RefIdx[1] =
                                 currMB->RefIdx[2] = currMB->RefIdx[3] = video->RefPicList0[0]->RefIdx;
-        InterMBPrediction(video);
+        InterMBPrediction(decvid);
 
         video->numMBs--;
+        if (video->deblockThread)
+        {
+            DeblockThreadMbDecoded(video, CurrMbAddr);
+        }
 
     }
 
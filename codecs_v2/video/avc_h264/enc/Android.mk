@@ -17,6 +17,7 @@ LOCAL_SRC_FILES := \
  	src/residual.cpp \
  	src/sad.cpp \
  	src/sad_halfpel.cpp \
+ 	src/sad_x86.cpp \
  	src/slice.cpp \
  	src/vlc_encode.cpp
 
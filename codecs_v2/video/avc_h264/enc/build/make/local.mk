@@ -37,6 +37,7 @@ SRCS := avcenc_api.cpp \
 	residual.cpp \
 	sad.cpp \
 	sad_halfpel.cpp \
+	sad_x86.cpp \
 	slice.cpp \
 	vlc_encode.cpp
 
@@ -326,6 +326,33 @@ typedef struct tagMV
     uint sad;
 } AVCMV;
 
+/**
+x86 SIMD SAD. AVCENC_X86_SIMD builds the SSE2 versions of the SAD functions in
+sad_x86.cpp, it is on by default when the compiler targets SSE2.
+AVCENC_X86_AVX2 also builds AVX2 versions, they are used only if the CPU
+supports AVX2.
+*/
+#ifndef AVCENC_X86_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define AVCENC_X86_SIMD 1
+#else
+#define AVCENC_X86_SIMD 0
+#endif
+#endif
+
+#ifndef AVCENC_X86_AVX2
+#if (AVCENC_X86_SIMD) && defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9) || defined(__clang__))
+#define AVCENC_X86_AVX2 1
+#else
+#define AVCENC_X86_AVX2 0
+#endif
+#endif
+
+#if !(AVCENC_X86_SIMD)
+#undef AVCENC_X86_AVX2
+#define AVCENC_X86_AVX2 0
+#endif
+
 /**
 This structure contains function pointers for different platform dependent implementation of
 functions. */
@@ -334,6 +361,8 @@ typedef struct tagAVCEncFuncPtr
 
     int (*SAD_MB_HalfPel[4])(uint8*, uint8*, int, void *);
     int (*SAD_Macroblock)(uint8 *ref, uint8 *blk, int dmin_lx, void *extra_info);
+    /* full 16x16 SAD, it is not replaced by the HTFM version, used by the sub-pel search and rate control */
+    int (*SAD_MB_Full)(uint8 *ref, uint8 *blk, int dmin_lx, void *extra_info);
 
 } AVCEncFuncPtr;
 
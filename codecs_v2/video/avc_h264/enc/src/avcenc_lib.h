@@ -650,12 +650,13 @@ extern "C"
 
     /**
     This function calculates the SATD of a subpel candidate.
+    \param "encvid" "Pointer to AVCEncObject."
     \param "cand"   "Pointer to a candidate."
     \param "cur"    "Pointer to the current block."
     \param "dmin"   "Min-so-far SATD."
     \return "Sum of Absolute Transformed Difference."
     */
-    int SATD_MB(uint8 *cand, uint8 *cur, int dmin);
+    int SATD_MB(AVCEncObject *encvid, uint8 *cand, uint8 *cur, int dmin);
 
     /*------------- rate_control.c -------------------*/
 
@@ -816,6 +817,16 @@ extern "C"
     int AVCSAD_MB_HTFM(uint8 *ref, uint8 *blk, int dmin_lx, void *extra_info);
 #endif
 
+    /*------------- sad_x86.c -----------------------*/
+
+    /**
+    This function replaces the SAD functions in the function pointer table with the SSE2
+    or AVX2 versions, depending on the CPU. They give exactly the same results as the C versions.
+    \param "funcPtr" "Pointer to AVCEncFuncPtr, already set up with the C versions."
+    \return "void"
+    */
+    void InitSADFuncs_x86(AVCEncFuncPtr *funcPtr);
+
 
     /*------------- slice.c -------------------------*/
 
@@ -83,7 +83,7 @@ int AVCFindHalfPelMB(AVCEncObject *encvid, uint8 *cur, AVCMV *mot, uint8 *ncand,
     cand = hpel_cand[0];
 
     // find cost for the current full-pel position
-    dmin = SATD_MB(cand, cur, 65535); // get Hadamaard transform SAD
+    dmin = SATD_MB(encvid, cand, cur, 65535); // get Hadamaard transform SAD
     mvcost = MV_COST_S(lambda_motion, mot->x, mot->y, cmvx, cmvy);
     satd_min = dmin;
     dmin += mvcost;
@@ -92,7 +92,7 @@ int AVCFindHalfPelMB(AVCEncObject *encvid, uint8 *cur, AVCMV *mot, uint8 *ncand,
     /* find half-pel */
     for (h = 1; h < 9; h++)
     {
-        d = SATD_MB(hpel_cand[h], cur, dmin);
+        d = SATD_MB(encvid, hpel_cand[h], cur, dmin);
         mvcost = MV_COST_S(lambda_motion, mot->x + xh[h], mot->y + yh[h], cmvx, cmvy);
         d += mvcost;
 
@@ -116,7 +116,7 @@ int AVCFindHalfPelMB(AVCEncObject *encvid, uint8 *cur, AVCMV *mot, uint8 *ncand,
 
     for (q = 0; q < 8; q++)
     {
-        d = SATD_MB(encvid->qpel_cand[q], cur, dmin);
+        d = SATD_MB(encvid, encvid->qpel_cand[q], cur, dmin);
         mvcost = MV_COST_S(lambda_motion, mot->x + xq[q], mot->y + yq[q], cmvx, cmvy);
         d += mvcost;
         if (d < dmin)
@@ -606,13 +606,13 @@ void GenerateQuartPelPred(uint8 **bilin_base, uint8 *qpel_cand, int hpel_pos)
 
 
 /* assuming cand always has a pitch of 24 */
-int SATD_MB(uint8 *cand, uint8 *cur, int dmin)
+int SATD_MB(AVCEncObject *encvid, uint8 *cand, uint8 *cur, int dmin)
 {
     int cost;
 
 
     dmin = (dmin << 16) | 24;
-    cost = AVCSAD_Macroblock_C(cand, cur, dmin, NULL);
+    cost = (*encvid->functionPointer->SAD_MB_Full)(cand, cur, dmin, NULL);
 
     return cost;
 }
@@ -777,7 +777,7 @@ void RCCalculateMAD(AVCEncObject *encvid, AVCMacroblock *currMB, uint8 *orgL, in
             if (currMB->mbMode == AVC_I16)
             {
                 dmin_lx = (0xFFFF << 16) | orgPitch;
-                rateCtrl->MADofMB[video->mbNum] = AVCSAD_Macroblock_C(orgL,
+                rateCtrl->MADofMB[video->mbNum] = (*encvid->functionPointer->SAD_MB_Full)(orgL,
                                                   encvid->pred_i16[currMB->i16Mode], dmin_lx, NULL);
             }
             else /* i4 */
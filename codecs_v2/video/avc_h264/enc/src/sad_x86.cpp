@@ -0,0 +1,325 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/* x86 SIMD versions of the 16x16 SAD functions in sad.cpp and sad_halfpel.cpp.
+   Like the C versions, they check the SAD against dmin after every row and
+   return the partial SAD as soon as it is larger, so the results are exactly
+   the same. The current MB (blk) always has a pitch of 16. */
+
+#include "avcenc_lib.h"
+
+#if (AVCENC_X86_SIMD)
+
+#include <emmintrin.h>
+#if (AVCENC_X86_AVX2)
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+/* add the two 64-bit halves of the psadbw result */
+static inline int SumSad(__m128i x)
+{
+    return _mm_cvtsi128_si32(x) + _mm_cvtsi128_si32(_mm_srli_si128(x, 8));
+}
+
+static inline __m128i Load16(const uint8 *p)
+{
+    return _mm_loadu_si128((const __m128i*)p);
+}
+
+/* (a + b + c + d + 2) >> 2 on 16 pixels, a + b and c + d are given as 16-bit sums */
+static inline __m128i Avg4(__m128i ab_lo, __m128i ab_hi, __m128i cd_lo, __m128i cd_hi)
+{
+    const __m128i two = _mm_set1_epi16(2);
+    __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(ab_lo, cd_lo), two), 2);
+    __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(ab_hi, cd_hi), two), 2);
+    return _mm_packus_epi16(lo, hi);
+}
+
+/* a + b on 16 pixels, as 16-bit sums */
+static inline void HorzSum(const uint8 *p, __m128i *lo, __m128i *hi)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a = Load16(p);
+    __m128i b = Load16(p + 1);
+    *lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+    *hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+}
+
+static int AVCSAD_Macroblock_SSE2(uint8 *ref, uint8 *blk, int dmin_lx, void *extra_info)
+{
+    (void)(extra_info);
+
+    int i;
+    int sad = 0;
+    int dmin = (uint32)dmin_lx >> 16;
+    int lx = dmin_lx & 0xFFFF;
+
+    for (i = 0; i < 16; i++)
+    {
+        sad += SumSad(_mm_sad_epu8(Load16(ref), Load16(blk)));
+
+        if (sad > dmin)
+            return sad;
+
+        ref += lx;
+        blk += 16;
+    }
+    return sad;
+}
+
+static int AVCSAD_MB_HalfPel_SSE2xh(uint8 *ref, uint8 *blk, int dmin_rx, void *extra_info)
+{
+    (void)(extra_info);
+
+    int i;
+    int sad = 0;
+    int dmin = (uint32)dmin_rx >> 16;
+    int rx = dmin_rx & 0xFFFF;
+    __m128i pred;
+
+    for (i = 0; i < 16; i++)
+    {
+        pred = _mm_avg_epu8(Load16(ref), Load16(ref + 1));
+        sad += SumSad(_mm_sad_epu8(pred, Load16(blk)));
+
+        if (sad > dmin)
+            return sad;
+
+        ref += rx;
+        blk += 16;
+    }
+    return sad;
+}
+
+static int AVCSAD_MB_HalfPel_SSE2yh(uint8 *ref, uint8 *blk, int dmin_rx, void *extra_info)
+{
+    (void)(extra_info);
+
+    int i;
+    int sad = 0;
+    int dmin = (uint32)dmin_rx >> 16;
+    int rx = dmin_rx & 0xFFFF;
+    __m128i top, bot, pred;
+
+    top = Load16(ref);
+    for (i = 0; i < 16; i++)
+    {
+        ref += rx;
+        bot = Load16(ref);
+        pred = _mm_avg_epu8(top, bot);
+        sad += SumSad(_mm_sad_epu8(pred, Load16(blk)));
+
+        if (sad > dmin)
+            return sad;
+
+        top = bot;
+        blk += 16;
+    }
+    return sad;
+}
+
+static int AVCSAD_MB_HalfPel_SSE2xhyh(uint8 *ref, uint8 *blk, int dmin_rx, void *extra_info)
+{
+    (void)(extra_info);
+
+    int i;
+    int sad = 0;
+    int dmin = (uint32)dmin_rx >> 16;
+    int rx = dmin_rx & 0xFFFF;
+    __m128i top_lo, top_hi, bot_lo, bot_hi, pred;
+
+    HorzSum(ref, &top_lo, &top_hi);
+    for (i = 0; i < 16; i++)
+    {
+        ref += rx;
+        HorzSum(ref, &bot_lo, &bot_hi);
+        pred = Avg4(top_lo, top_hi, bot_lo, bot_hi);
+        sad += SumSad(_mm_sad_epu8(pred, Load16(blk)));
+
+        if (sad > dmin)
+            return sad;
+
+        top_lo = bot_lo;
+        top_hi = bot_hi;
+        blk += 16;
+    }
+    return sad;
+}
+
+#if (AVCENC_X86_AVX2)
+/* The AVX2 versions work on two rows at a time, each 128-bit lane holds one row.
+   The SAD is still checked against dmin after every row. */
+
+/* load 16 pixels of two rows */
+static inline AVX2_TARGET __m256i Load16x2(const uint8 *p0, const uint8 *p1)
+{
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(Load16(p0)), Load16(p1), 1);
+}
+
+/* add the SAD of two rows to sad, checking dmin after each row. Returns 1 on early exit. */
+static inline AVX2_TARGET int AddSadx2(__m256i pred, const uint8 *blk, int *sad, int dmin)
+{
+    __m256i x = _mm256_sad_epu8(pred, _mm256_loadu_si256((const __m256i*)blk));
+
+    *sad += SumSad(_mm256_castsi256_si128(x));
+    if (*sad > dmin)
+        return 1;
+
+    *sad += SumSad(_mm256_extracti128_si256(x, 1));
+    if (*sad > dmin)
+        return 1;
+
+    return 0;
+}
+
+static AVX2_TARGET int AVCSAD_Macroblock_AVX2(uint8 *ref, uint8 *blk, int dmin_lx, void *extra_info)
+{
+    (void)(extra_info);
+
+    int i;
+    int sad = 0;
+    int dmin = (uint32)dmin_lx >> 16;
+    int lx = dmin_lx & 0xFFFF;
+
+    for (i = 0; i < 16; i += 2)
+    {
+        if (AddSadx2(Load16x2(ref, ref + lx), blk, &sad, dmin))
+            return sad;
+
+        ref += (lx << 1);
+        blk += 32;
+    }
+    return sad;
+}
+
+static AVX2_TARGET int AVCSAD_MB_HalfPel_AVX2xh(uint8 *ref, uint8 *blk, int dmin_rx, void *extra_info)
+{
+    (void)(extra_info);
+
+    int i;
+    int sad = 0;
+    int dmin = (uint32)dmin_rx >> 16;
+    int rx = dmin_rx & 0xFFFF;
+    __m256i pred;
+
+    for (i = 0; i < 16; i += 2)
+    {
+        pred = _mm256_avg_epu8(Load16x2(ref, ref + rx), Load16x2(ref + 1, ref + rx + 1));
+        if (AddSadx2(pred, blk, &sad, dmin))
+            return sad;
+
+        ref += (rx << 1);
+        blk += 32;
+    }
+    return sad;
+}
+
+static AVX2_TARGET int AVCSAD_MB_HalfPel_AVX2yh(uint8 *ref, uint8 *blk, int dmin_rx, void *extra_info)
+{
+    (void)(extra_info);
+
+    int i;
+    int sad = 0;
+    int dmin = (uint32)dmin_rx >> 16;
+    int rx = dmin_rx & 0xFFFF;
+    __m256i pred;
+
+    for (i = 0; i < 16; i += 2)
+    {
+        pred = _mm256_avg_epu8(Load16x2(ref, ref + rx), Load16x2(ref + rx, ref + (rx << 1)));
+        if (AddSadx2(pred, blk, &sad, dmin))
+            return sad;
+
+        ref += (rx << 1);
+        blk += 32;
+    }
+    return sad;
+}
+
+/* a + b on 16 pixels, as 16-bit sums in one register */
+static inline AVX2_TARGET __m256i HorzSumx16(const uint8 *p)
+{
+    return _mm256_add_epi16(_mm256_cvtepu8_epi16(Load16(p)), _mm256_cvtepu8_epi16(Load16(p + 1)));
+}
+
+/* (a + b + c + d + 2) >> 2 on 16 pixels */
+static inline AVX2_TARGET __m128i Avg4x16(__m256i ab, __m256i cd)
+{
+    __m256i x = _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(ab, cd), _mm256_set1_epi16(2)), 2);
+    return _mm_packus_epi16(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+}
+
+static AVX2_TARGET int AVCSAD_MB_HalfPel_AVX2xhyh(uint8 *ref, uint8 *blk, int dmin_rx, void *extra_info)
+{
+    (void)(extra_info);
+
+    int i;
+    int sad = 0;
+    int dmin = (uint32)dmin_rx >> 16;
+    int rx = dmin_rx & 0xFFFF;
+    __m256i row0, row1, row2;
+    __m128i pred0, pred1;
+
+    row0 = HorzSumx16(ref);
+    for (i = 0; i < 16; i += 2)
+    {
+        row1 = HorzSumx16(ref + rx);
+        row2 = HorzSumx16(ref + (rx << 1));
+        pred0 = Avg4x16(row0, row1);
+        pred1 = Avg4x16(row1, row2);
+        if (AddSadx2(_mm256_inserti128_si256(_mm256_castsi128_si256(pred0), pred1, 1), blk, &sad, dmin))
+            return sad;
+
+        row0 = row2;
+        ref += (rx << 1);
+        blk += 32;
+    }
+    return sad;
+}
+
+static bool CpuHasAVX2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? true : false;
+}
+#endif /* AVCENC_X86_AVX2 */
+
+void InitSADFuncs_x86(AVCEncFuncPtr *funcPtr)
+{
+    /* SSE2 is always there when AVCENC_X86_SIMD is on */
+    funcPtr->SAD_Macroblock = &AVCSAD_Macroblock_SSE2;
+    funcPtr->SAD_MB_HalfPel[1] = &AVCSAD_MB_HalfPel_SSE2xh;
+    funcPtr->SAD_MB_HalfPel[2] = &AVCSAD_MB_HalfPel_SSE2yh;
+    funcPtr->SAD_MB_HalfPel[3] = &AVCSAD_MB_HalfPel_SSE2xhyh;
+    funcPtr->SAD_MB_Full = &AVCSAD_Macroblock_SSE2;
+
+#if (AVCENC_X86_AVX2)
+    if (CpuHasAVX2())
+    {
+        funcPtr->SAD_Macroblock = &AVCSAD_Macroblock_AVX2;
+        funcPtr->SAD_MB_HalfPel[1] = &AVCSAD_MB_HalfPel_AVX2xh;
+        funcPtr->SAD_MB_HalfPel[2] = &AVCSAD_MB_HalfPel_AVX2yh;
+        funcPtr->SAD_MB_HalfPel[3] = &AVCSAD_MB_HalfPel_AVX2xhyh;
+        funcPtr->SAD_MB_Full = &AVCSAD_Macroblock_AVX2;
+    }
+#endif
+    return ;
+}
+
+#endif /* AVCENC_X86_SIMD */
+
@@ -44,6 +44,9 @@ AVCEnc_Status AVCEncodeSlice(AVCEncObject *encvid)
         video->mbNum = CurrMbAddr;
         currMB = video->currMB = &(video->mblock[CurrMbAddr]);
         currMB->slice_id = video->slice_id;  // for deblocking
+        currMB->disable_deblocking_filter_idc = sliceHdr->disable_deblocking_filter_idc;
+        currMB->FilterOffsetA = video->FilterOffsetA;
+        currMB->FilterOffsetB = video->FilterOffsetB;
 
         video->mb_x = CurrMbAddr % video->PicWidthInMbs;
         video->mb_y = CurrMbAddr / video->PicWidthInMbs;
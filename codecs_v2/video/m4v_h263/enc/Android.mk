@@ -18,6 +18,7 @@ LOCAL_SRC_FILES := \
  	src/motion_comp.cpp \
  	src/sad.cpp \
  	src/sad_halfpel.cpp \
+ 	src/sad_x86.cpp \
  	src/vlc_encode.cpp \
  	src/vop.cpp
 
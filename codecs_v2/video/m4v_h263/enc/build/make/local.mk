@@ -33,6 +33,7 @@ SRCS := bitstream_io.cpp \
 	motion_comp.cpp \
 	sad.cpp \
 	sad_halfpel.cpp \
+	sad_x86.cpp \
 	vlc_encode.cpp \
 	vop.cpp 
 
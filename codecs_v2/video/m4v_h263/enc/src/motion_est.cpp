@@ -557,7 +557,11 @@ void InitHTFM(VideoEncData *video, HTFM_Stat *htfm_stat, double *newvar, Int *co
             newvar[i] = 0.0;
         }
 //      video->functionPointer->SAD_MB_PADDING = &SAD_MB_PADDING_HTFM_Collect;
+#if (M4VENC_X86_SIMD)
+        video->functionPointer->SAD_Macroblock = &SAD_MB_HTFM_Collect_SSE2;
+#else
         video->functionPointer->SAD_Macroblock = &SAD_MB_HTFM_Collect;
+#endif
         video->functionPointer->SAD_MB_HalfPel[0] = NULL;
         video->functionPointer->SAD_MB_HalfPel[1] = &SAD_MB_HP_HTFM_Collectxh;
         video->functionPointer->SAD_MB_HalfPel[2] = &SAD_MB_HP_HTFM_Collectyh;
@@ -569,7 +573,11 @@ void InitHTFM(VideoEncData *video, HTFM_Stat *htfm_stat, double *newvar, Int *co
     else
     {
 //      video->functionPointer->SAD_MB_PADDING = &SAD_MB_PADDING_HTFM;
+#if (M4VENC_X86_SIMD)
+        video->functionPointer->SAD_Macroblock = &SAD_MB_HTFM_SSE2;
+#else
         video->functionPointer->SAD_Macroblock = &SAD_MB_HTFM;
+#endif
         video->functionPointer->SAD_MB_HalfPel[0] = NULL;
         video->functionPointer->SAD_MB_HalfPel[1] = &SAD_MB_HP_HTFMxh;
         video->functionPointer->SAD_MB_HalfPel[2] = &SAD_MB_HP_HTFMyh;
@@ -21,6 +21,29 @@
 /********** platform dependent in-line assembly *****************************/
 
 /*************** Intel *****************/
+/* M4VENC_X86_SIMD builds the SSE2 versions of the SAD functions in sad_x86.cpp,
+   it is on by default when the compiler targets SSE2. M4VENC_X86_AVX2 also
+   builds AVX2 versions, they are used only if the CPU supports AVX2. */
+#ifndef M4VENC_X86_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define M4VENC_X86_SIMD 1
+#else
+#define M4VENC_X86_SIMD 0
+#endif
+#endif
+
+#ifndef M4VENC_X86_AVX2
+#if (M4VENC_X86_SIMD) && defined(__GNUC__) && ((__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9) || defined(__clang__))
+#define M4VENC_X86_AVX2 1
+#else
+#define M4VENC_X86_AVX2 0
+#endif
+#endif
+
+#if !(M4VENC_X86_SIMD)
+#undef M4VENC_X86_AVX2
+#define M4VENC_X86_AVX2 0
+#endif
 
 /*************** ARM *****************/
 /* for general ARM instruction. #define __ARM has to be defined in compiler set up.*/
@@ -1052,6 +1052,9 @@ OSCL_EXPORT_REF Bool    PVInitVideoEncoder(VideoEncControls *encoderControl, Vid
     video->functionPointer->ChooseMode = &ChooseMode_C;
     video->functionPointer->GetHalfPelMBRegion = &GetHalfPelMBRegion_C;
 //  video->functionPointer->SAD_MB_PADDING = &SAD_MB_PADDING; /* 4/21/01 */
+#if (M4VENC_X86_SIMD)
+    InitSADFuncs_x86(video->functionPointer);
+#endif
 
 
     encoderControl->videoEncoderInit = 1;  /* init done! */
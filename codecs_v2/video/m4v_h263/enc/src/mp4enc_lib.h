@@ -156,6 +156,9 @@ extern "C"
     Int SAD_Block_MMX(UChar *ref, UChar *blk, Int dmin, Int lx, void *extra_info);
     Int SAD_Block_SSE(UChar *ref, UChar *blk, Int dmin, Int lx, void *extra_info);
 
+    /* defined in sad_x86.c, replaces the C versions in the table with the SSE2 or AVX2 versions */
+    void InitSADFuncs_x86(FuncPtr *funcPtr);
+
 #ifdef HTFM /* Hypothesis Testing Fast Matching */
     Int SAD_MB_HP_HTFM_Collectxhyh(UChar *ref, UChar *blk, Int dmin_x, void *extra_info);
     Int SAD_MB_HP_HTFM_Collectyh(UChar *ref, UChar *blk, Int dmin_x, void *extra_info);
@@ -165,6 +168,11 @@ extern "C"
     Int SAD_MB_HP_HTFMxh(UChar *ref, UChar *blk, Int dmin_lx, void *extra_info);
     Int SAD_MB_HTFM_Collect(UChar *ref, UChar *blk, Int dmin_lx, void *extra_info);
     Int SAD_MB_HTFM(UChar *ref, UChar *blk, Int dmin_lx, void *extra_info);
+#if (M4VENC_X86_SIMD)
+    /* defined in sad_x86.c */
+    Int SAD_MB_HTFM_Collect_SSE2(UChar *ref, UChar *blk, Int dmin_lx, void *extra_info);
+    Int SAD_MB_HTFM_SSE2(UChar *ref, UChar *blk, Int dmin_lx, void *extra_info);
+#endif
 #endif
     /* on-the-fly padding */
     Int SAD_Blk_PADDING(UChar *ref, UChar *cur, Int dmin, Int lx, void *extra_info);
@@ -27,6 +27,12 @@
 #ifndef PV_ENGINE_TYPES_H_INCLUDED
 #include "pv_engine_types.h"
 #endif
+#ifndef PVMF_RETURN_CODES_H_INCLUDED
+#include "pvmf_return_codes.h"
+#endif
+#ifndef OSCL_SCHEDULER_PROFILE_H_INCLUDED
+#include "oscl_scheduler_profile.h"
+#endif
 
 // Forward declarations
 class PVMFNodeInterface;
@@ -447,6 +453,19 @@ class PVAuthorEngineInterface
          */
         virtual PVAEState GetPVAuthorState() = 0;
 
+        /**
+         * This function returns a profile of the scheduler that runs the pvAuthor Engine:
+         * the Run time and queued time of each active object, and the depth of the ready
+         * queue for each priority band. The counts add up from the time the scheduler was
+         * started, so the activity in an interval is the difference of two profiles.
+         * This function must be called in the thread the engine runs in.
+         *
+         * @param aProfile Output parameter to hold the scheduler profile
+         * @returns PVMFSuccess if the profile was retrieved, PVMFErrNotSupported if the
+         *          scheduler was built without profiling.
+         */
+        virtual PVMFStatus GetSchedulerProfileSync(OsclSchedulerProfile& aProfile) = 0;
+
         /**
          * Discover the UUIDs of interfaces associated with the specified MIME type and node
          *
@@ -50,6 +50,9 @@
 #ifndef PVMI_KVP_UTIL_H_INCLUDED
 #include "pvmi_kvp_util.h"
 #endif
+#ifndef OSCL_SCHEDULER_H_INCLUDED
+#include "oscl_scheduler.h"
+#endif
 #define PVAE_NUM_PENDING_CMDS 10
 #define PVAE_NUM_PENDING_EVENTS 10
 
@@ -441,6 +444,28 @@ OSCL_EXPORT_REF PVAEState PVAuthorEngine::GetPVAuthorState()
     return GetPVAEState();
 }
 
+////////////////////////////////////////////////////////////////////////////
+OSCL_EXPORT_REF PVMFStatus PVAuthorEngine::GetSchedulerProfileSync(OsclSchedulerProfile& aProfile)
+{
+    LOG_STACK_TRACE((0, "PVAuthorEngine::GetSchedulerProfileSync"));
+
+    OsclExecScheduler* sched = OsclExecScheduler::Current();
+    if (!sched)
+    {
+        LOG_ERR((0, "PVAuthorEngine::GetSchedulerProfileSync: Error - No scheduler installed"));
+        return PVMFErrInvalidState;
+    }
+
+    int32 err = OsclErrNone;
+    OSCL_TRY(err, sched->GetProfile(aProfile););
+    if (err != OsclErrNone)
+    {
+        LOG_ERR((0, "PVAuthorEngine::GetSchedulerProfileSync: Error - GetProfile left with %d", err));
+        return (err == OsclErrNotSupported) ? PVMFErrNotSupported : PVMFFailure;
+    }
+    return PVMFSuccess;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 OSCL_EXPORT_REF PVCommandId PVAuthorEngine::GetSDKInfo(PVSDKInfo &aSDKInfo, const OsclAny* aContextData)
 {
@@ -199,6 +199,7 @@ class PVAuthorEngine : public PVAuthorEngineInterface,
                 PVInterface*& aInterfacePtr,
                 const OsclAny* aContextData = NULL);
         OSCL_IMPORT_REF PVAEState GetPVAuthorState();
+        OSCL_IMPORT_REF PVMFStatus GetSchedulerProfileSync(OsclSchedulerProfile& aProfile);
         OSCL_IMPORT_REF PVCommandId GetSDKInfo(PVSDKInfo& aSDKInfo, const OsclAny* aContextData = NULL);
         OSCL_IMPORT_REF PVCommandId GetSDKModuleInfo(PVSDKModuleInfo& aSDKModuleInfo, const OsclAny* aContextData = NULL);
         OSCL_IMPORT_REF PVCommandId CancelAllCommands(const OsclAny* aContextData = NULL);
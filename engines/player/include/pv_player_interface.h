@@ -83,6 +83,10 @@
 #include "pvmf_media_clock.h"
 #endif
 
+#ifndef OSCL_SCHEDULER_PROFILE_H_INCLUDED
+#include "oscl_scheduler_profile.h"
+#endif
+
 
 // CLASS DECLARATION
 /**
@@ -618,6 +622,19 @@ class PVPlayerInterface
          **/
         virtual PVMFStatus GetCurrentPositionSync(PVPPlaybackPosition &aPos) = 0;
 
+        /**
+         * This function returns a profile of the scheduler that runs pvPlayer as a synchronous
+         * command: the Run time and queued time of each active object, and the depth of the
+         * ready queue for each priority band. The counts add up from the time the scheduler
+         * was started, so the activity in an interval is the difference of two profiles.
+         *
+         * @param aProfile
+         *         Reference to place the scheduler profile
+         * @returns PVMFSuccess if the profile was retrieved, PVMFErrNotSupported if the
+         *         scheduler was built without profiling.
+         **/
+        virtual PVMFStatus GetSchedulerProfileSync(OsclSchedulerProfile& aProfile) = 0;
+
         /**
          * This functions prepares pvPlayer for playback. pvPlayer connects the data source with the data sinks and starts
          * the data source to queue the media data for playback(e.g. for 3GPP streaming, fills the jitter buffer).
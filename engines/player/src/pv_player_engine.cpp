@@ -71,6 +71,8 @@
 
 #include "oscl_registry_access_client.h"
 
+#include "oscl_scheduler.h"
+
 #include "pvmf_source_context_data.h"
 
 #include "pv_player_node_registry.h"
@@ -546,6 +548,28 @@ PVMFStatus PVPlayerEngine::GetCurrentPositionSync(PVPPlaybackPosition &aPos)
 }
 
 
+PVMFStatus PVPlayerEngine::GetSchedulerProfileSync(OsclSchedulerProfile& aProfile)
+{
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "PVPlayerEngine::GetSchedulerProfileSync()"));
+    Oscl_Vector<PVPlayerEngineCommandParamUnion, OsclMemAllocator> paramvec;
+    paramvec.reserve(1);
+    paramvec.clear();
+    PVPlayerEngineCommandParamUnion param;
+    param.pOsclAny_value = (OsclAny*) & aProfile;
+    paramvec.push_back(param);
+    if (iThreadSafeQueue.IsInThread())
+    {
+        PVPlayerEngineCommand cmd(PVP_ENGINE_COMMAND_GET_SCHEDULER_PROFILE_OOTSYNC, -1, NULL, &paramvec);
+        return DoGetSchedulerProfile(cmd);
+    }
+    else
+    {
+        //the profile must be read in the engine thread.
+        return DoOOTSyncCommand(PVP_ENGINE_COMMAND_GET_SCHEDULER_PROFILE_OOTSYNC, &paramvec);
+    }
+}
+
+
 PVCommandId PVPlayerEngine::SetPlaybackRate(int32 aRate, PVMFTimebase* aTimebase, const OsclAny* aContextData)
 {
     PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "PVPlayerEngine::SetPlaybackRate()"));
@@ -1606,6 +1630,11 @@ void PVPlayerEngine::Run()
                 cmdstatus = DoGetLicenseStatusSync(cmd);
                 break;
 
+            case PVP_ENGINE_COMMAND_GET_SCHEDULER_PROFILE_OOTSYNC:
+                ootsync = true;
+                cmdstatus = DoGetSchedulerProfile(cmd);
+                break;
+
             case PVP_ENGINE_COMMAND_CANCEL_COMMAND:
                 // Cancel() should not be handled here
                 PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_ERR, (0, "PVPlayerEngine::Run() CancelCommand should be not handled in here. Return Failure"));
@@ -4306,6 +4335,37 @@ PVMFStatus PVPlayerEngine::DoGetPVPlayerState(PVPlayerEngineCommand& aCmd, bool
 }
 
 
+PVMFStatus PVPlayerEngine::DoGetSchedulerProfile(PVPlayerEngineCommand& aCmd)
+{
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "PVPlayerEngine::DoGetSchedulerProfile() In"));
+
+    OsclSchedulerProfile* profile = (OsclSchedulerProfile*)(aCmd.GetParam(0).pOsclAny_value);
+    if (profile == NULL)
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_ERR, (0, "PVPlayerEngine::DoGetSchedulerProfile() Passed in parameter invalid."));
+        return PVMFErrArgument;
+    }
+
+    OsclExecScheduler* sched = OsclExecScheduler::Current();
+    if (sched == NULL)
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_ERR, (0, "PVPlayerEngine::DoGetSchedulerProfile() No scheduler installed."));
+        return PVMFErrInvalidState;
+    }
+
+    int32 leavecode = OsclErrNone;
+    OSCL_TRY(leavecode, sched->GetProfile(*profile));
+    if (leavecode != OsclErrNone)
+    {
+        PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG, iLogger, PVLOGMSG_ERR, (0, "PVPlayerEngine::DoGetSchedulerProfile() GetProfile left with %d", leavecode));
+        return (leavecode == OsclErrNotSupported) ? PVMFErrNotSupported : PVMFFailure;
+    }
+
+    PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, iLogger, PVLOGMSG_STACK_TRACE, (0, "PVPlayerEngine::DoGetSchedulerProfile() Out"));
+    return PVMFSuccess;
+}
+
+
 PVMFStatus PVPlayerEngine::DoAddDataSource(PVPlayerEngineCommand& aCmd)
 {
     PVLOGGER_LOGMSG(PVLOGMSG_INST_PROF, iPerfLogger, PVLOGMSG_NOTICE,
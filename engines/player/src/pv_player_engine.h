@@ -383,6 +383,7 @@ typedef enum
     PVP_ENGINE_COMMAND_CAPCONFIG_GET_PARAMETERS_OOTSYNC,
     PVP_ENGINE_COMMAND_CAPCONFIG_RELEASE_PARAMETERS_OOTSYNC,
     PVP_ENGINE_COMMAND_CAPCONFIG_VERIFY_PARAMETERS_OOTSYNC,
+    PVP_ENGINE_COMMAND_GET_SCHEDULER_PROFILE_OOTSYNC,
     // Internal engine commands
     PVP_ENGINE_COMMAND_PAUSE_DUE_TO_ENDTIME_REACHED,
     PVP_ENGINE_COMMAND_PAUSE_DUE_TO_ENDOFCLIP,
@@ -920,6 +921,7 @@ class PVPlayerEngine : public OsclTimerObject,
         PVCommandId GetPlaybackRange(PVPPlaybackPosition &aBeginPos, PVPPlaybackPosition &aEndPos, bool aQueued, const OsclAny* aContextData = NULL);
         PVCommandId GetCurrentPosition(PVPPlaybackPosition &aPos, const OsclAny* aContextData = NULL);
         PVMFStatus GetCurrentPositionSync(PVPPlaybackPosition &aPos);
+        PVMFStatus GetSchedulerProfileSync(OsclSchedulerProfile& aProfile);
         PVCommandId SetPlaybackRate(int32 aRate, PVMFTimebase* aTimebase = NULL, const OsclAny* aContextData = NULL);
         PVCommandId GetPlaybackRate(int32& aRate, PVMFTimebase*& aTimebase, const OsclAny* aContextData = NULL);
         PVCommandId GetPlaybackMinMaxRate(int32& aMinRate, int32& aMaxRate, const OsclAny* aContextData = NULL);
@@ -1119,6 +1121,7 @@ class PVPlayerEngine : public OsclTimerObject,
                 bool aSFR = false);
         PVMFStatus DoGetPlaybackRange(PVPlayerEngineCommand& aCmd);
         PVMFStatus DoGetCurrentPosition(PVPlayerEngineCommand& aCmd, bool aSyncCmd = false);
+        PVMFStatus DoGetSchedulerProfile(PVPlayerEngineCommand& aCmd);
         PVMFStatus DoSetPlaybackRate(PVPlayerEngineCommand& aCmd);
         PVMFStatus DoGetPlaybackRate(PVPlayerEngineCommand& aCmd);
         PVMFStatus DoGetPlaybackMinMaxRate(PVPlayerEngineCommand& aCmd);
@@ -102,6 +102,32 @@ class PVAviFile: public PVAviFileParserStatus
         OSCL_IMPORT_REF virtual PV_AVI_FILE_PARSER_ERROR_TYPE
         GetNextStreamSampleInfo(uint32 aStreamNo, uint32& arSize, uint32& arOffset) = 0;
 
+        /**
+         * function to find the closest key frame at or before a sample of a stream, or
+         * before the last sample if aSampleNo is beyond it. this function will use index
+         * table if present otherwise it will return failure
+         *
+         * @param aStreamNo stream number
+         * @param aSampleNo sample number
+         * @return arKeySampleNo sample number of the key frame
+         */
+
+        OSCL_IMPORT_REF virtual PV_AVI_FILE_PARSER_ERROR_TYPE
+        GetKeyFrameSampleNum(uint32 aStreamNo, uint32 aSampleNo, uint32& arKeySampleNo) = 0;
+
+        /**
+         * function to set the sample GetNextStreamMediaSample and GetNextStreamSampleInfo
+         * return next for a stream. this function will use index table if present otherwise
+         * it will return failure. video timestamps follow the sample number, audio
+         * timestamps are not recomputed.
+         *
+         * @param aStreamNo stream number
+         * @param aSampleNo sample number
+         */
+
+        OSCL_IMPORT_REF virtual PV_AVI_FILE_PARSER_ERROR_TYPE
+        SetStreamSampleNum(uint32 aStreamNo, uint32 aSampleNo) = 0;
+
         /**
          * function to reset stream pointers to retrieve data from the begining. .
          * @param
@@ -246,6 +246,11 @@ class PVAviFileHeader: public PVAviFileParserStatus
             return ((iStreamList[aStreamNum]).GetCodecSpecificData(aBuff, aSize));
         }
 
+        const Oscl_Vector<SuperIndexEntryType, OsclMemAllocator>& GetSuperIndex(uint32 aStreamNum)
+        {
+            return ((iStreamList[aStreamNum]).GetSuperIndex());
+        }
+
 
     private:
 
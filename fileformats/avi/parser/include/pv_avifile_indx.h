@@ -26,57 +26,131 @@
 #include "pv_avifile_parser_utils.h"
 #endif
 
-typedef Oscl_Vector<IdxTblType, OsclMemAllocator> IndxTblVector;
+//size of the buffer used to read idx1 and ix## entries, idx1 is read 256 entries at a time.
+//the index is read through PVFile, which may be a CPM source, so it is read in pages
+//rather than from a memory mapping of the file (see Oscl_File::SetMemoryMapEnable).
+#ifndef AVI_INDEX_PAGE_SZ
+#define AVI_INDEX_PAGE_SZ 4096
+#endif
 
-//class to parse values in index chunk. index chunk contains offset and size info of media sample.
-class PVAviFileIdxChunk: public PVAviFileParserStatus
+//the offset of every Nth sample is stored in full, the ones in between as differences
+#ifndef AVI_INDEX_CHECKPOINT_INTERVAL
+#define AVI_INDEX_CHECKPOINT_INTERVAL 32
+#endif
+
+typedef struct
+{
+    uint32  prevOffset;     //offset of the sample before the checkpoint
+    uint32  entryPos;       //position of the checkpoint sample in the entry bytes
+} IdxCheckpointType;
+
+//position in the ix## chunks of a stream with an OpenDML super index
+typedef struct
+{
+    uint32  nextSuperIdx;   //next super index entry to read
+    uint32  entryOffset;    //file offset of the next ix## entry
+    uint32  entriesLeft;    //entries left in the current ix## chunk
+    uint32  entrySize;
+    uint32  baseOffset;
+} StdIdxStateType;
+
+typedef Oscl_Vector<SuperIndexEntryType, OsclMemAllocator> SuperIdxVector;
+
+//offset, size and key frame info of the samples of one stream. each sample takes an
+//offset difference and a size, both as variable length numbers, typically 5 bytes.
+class PVAviFileStreamIdx
 {
 
     public:
 
         //constructor
-        PVAviFileIdxChunk(PVFile* aFp, uint32 aIndxSize, uint32 aNumStreams);
+        PVAviFileStreamIdx();
 
         //destructor
-        ~PVAviFileIdxChunk() { };
+        ~PVAviFileStreamIdx() { };
 
-        uint32 GetOffset(uint32 aStreamNo, uint32 aSampleNo)
-        {
-            return (((iIndexTable[aStreamNo])[aSampleNo]).offset);
-        }
+        PV_AVI_FILE_PARSER_ERROR_TYPE AddSample(uint32 aOffset, uint32 aSize, bool aKeyFrame);
 
-        uint32 GetSampleSize(uint32 aStreamNo, uint32 aSampleNo)
-        {
-            return (((iIndexTable[aStreamNo])[aSampleNo]).size);
-        }
+        bool GetSample(uint32 aSampleNo, uint32& arOffset, uint32& arSize);
 
-        uint32 GetNumberOfSamplesInStream(uint32 aStreamNo)
-        {
-            return ((iIndexTable[aStreamNo]).size());
-        }
+        //closest key frame at or before aSampleNo
+        bool GetKeyFrame(uint32 aSampleNo, uint32& arKeySampleNo);
 
-        bool IsOffsetFromMoviList()
+        uint32 GetNumSamples()
         {
-            return iOffsetFrmMoviLst;
+            return iNumSamples;
         }
 
-        Oscl_Vector<IndxTblVector, OsclMemAllocator>
-        GetIndexTable()
-        {
-            return iIndexTable;
-        }
+    private:
+
+        Oscl_Vector<uint8, OsclMemAllocator>                iEntries;
+        Oscl_Vector<IdxCheckpointType, OsclMemAllocator>    iCheckpoints;
+
+        //sample numbers of the key frames, empty as long as all samples are key frames
+        Oscl_Vector<uint32, OsclMemAllocator>               iKeyFrames;
+        bool                                                iAllKeyFrames;
+
+        uint32                                              iNumSamples;
+        uint32                                              iLastOffset;
+
+        //samples are mostly read in order, the next one is decoded from here
+        uint32                                              iNextSample;
+        uint32                                              iNextEntryPos;
+        uint32                                              iNextPrevOffset;
+};
+
+//class to parse values in index chunk. index chunk contains offset and size info of media sample.
+//entries are read from the file only when a sample beyond the ones read so far is asked for,
+//from idx1 or, for streams with an OpenDML super index, from the stream's ix## chunks.
+class PVAviFileIdxChunk: public PVAviFileParserStatus
+{
+
+    public:
+
+        //constructor
+        PVAviFileIdxChunk(PVFile* aFp, uint32 aIdx1Offset, uint32 aIdx1Size,
+                          uint32 aMovieChunkStartOffset, uint32 aNumStreams);
+
+        //destructor
+        ~PVAviFileIdxChunk() { };
+
+        void SetSuperIndex(uint32 aStreamNo, const SuperIdxVector& aSuperIndex);
+
+        //offset of the sample data in the file and sample size
+        PV_AVI_FILE_PARSER_ERROR_TYPE
+        GetSampleInfo(uint32 aStreamNo, uint32 aSampleNo, uint32& arOffset, uint32& arSize);
+
+        //closest key frame at or before aSampleNo, or before the last sample if aSampleNo is beyond it
+        PV_AVI_FILE_PARSER_ERROR_TYPE
+        GetKeyFrameSampleNum(uint32 aStreamNo, uint32 aSampleNo, uint32& arKeySampleNo);
 
     private:
 
-        // variable iIndexTable stores the offset and size info of ever sample in a stream
-        // size of IndxTblTypeVector = number of samples ("movi" Subchunks) in a stream.
-        // size of iIndexTable = number of streams.
+        PV_AVI_FILE_PARSER_ERROR_TYPE   LoadSamples(uint32 aStreamNo, uint32 aSampleNo);
+        PV_AVI_FILE_PARSER_ERROR_TYPE   ReadIdx1Page();
+        PV_AVI_FILE_PARSER_ERROR_TYPE   ReadStdIndexPage(uint32 aStreamNo);
+        bool                            ReadAt(uint32 aOffset, uint8* aBuff, uint32 aSize);
+
+        PVFile*                         ipFilePtr;
+        uint32                          iNumStreams;
+        uint32                          iMovieChunkStartOffset;
+
+        //idx1 entries not read yet
+        uint32                          iIdx1Offset;
+        uint32                          iIdx1BytesLeft;
+        bool                            iIdx1FirstEntry;
+        bool                            iOffsetFrmMoviLst;
+
+        Oscl_Vector < PVAviFileStreamIdx,
+        OsclMemAllocator >              iStreamIdx;
+
+        Oscl_Vector < SuperIdxVector,
+        OsclMemAllocator >              iSuperIndex;
+
+        Oscl_Vector < StdIdxStateType,
+        OsclMemAllocator >              iStdIdxState;
 
-        Oscl_Vector < IndxTblVector,
-        OsclMemAllocator >    iIndexTable;
-        uint32                           iIndexSize;
-        uint32                           iNumStreams;
-        bool                             iOffsetFrmMoviLst;
+        uint8                           iPage[AVI_INDEX_PAGE_SZ];
 
 };
 
@@ -67,6 +67,12 @@ class PVAviFileParser: public PVAviFile
         PV_AVI_FILE_PARSER_ERROR_TYPE
         GetNextStreamSampleInfo(uint32 aStreamNo, uint32& arSize, uint32& arOffset);
 
+        OSCL_IMPORT_REF PV_AVI_FILE_PARSER_ERROR_TYPE
+        GetKeyFrameSampleNum(uint32 aStreamNo, uint32 aSampleNo, uint32& arKeySampleNo);
+
+        OSCL_IMPORT_REF PV_AVI_FILE_PARSER_ERROR_TYPE
+        SetStreamSampleNum(uint32 aStreamNo, uint32 aSampleNo);
+
         //methods to retrieve file properties
         PVAviFileMainHeaderStruct GetMainHeaderStruct()
         {
@@ -246,6 +252,10 @@ class PVAviFileParser: public PVAviFile
         //store the offset of first sample. used if index table is not present.
         uint32                  iMovieChunkStartOffset;
         uint32                  iIndxChunkSize;
+        uint32                  iIndxChunkOffset;
+
+        //size of the file, OpenDML files have data after the first RIFF chunk (iFileSize)
+        uint32                  iTotalFileSize;
         Oscl_Vector < uint32,
         OsclMemAllocator >  iStreamCount;
 
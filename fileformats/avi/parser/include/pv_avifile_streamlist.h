@@ -168,10 +168,17 @@ class PVAviFileStreamlist: public PVAviFileParserStatus
 
         bool GetCodecSpecificData(uint8*& aBuff, uint32& aSize);
 
+        //OpenDML super index, empty if the stream has none
+        const Oscl_Vector<SuperIndexEntryType, OsclMemAllocator>& GetSuperIndex()
+        {
+            return iSuperIndex;
+        }
+
     private:
 
         PV_AVI_FILE_PARSER_ERROR_TYPE   ParseStreamHeader(PVFile *aFp, uint32 aHdrSize);
         PV_AVI_FILE_PARSER_ERROR_TYPE   ParseStreamFormat(PVFile *aFp, uint32 aHdrSize);
+        PV_AVI_FILE_PARSER_ERROR_TYPE   ParseSuperIndex(PVFile *aFp, uint32 aIndxSize);
 
         uint32                          iStreamListSize;
         PVAviFileStreamHeaderStruct     iStreamHdr;
@@ -179,6 +186,8 @@ class PVAviFileStreamlist: public PVAviFileParserStatus
         uint8*                          ipCodecSpecificHdrData;    //strd chunk
         uint32                          iCodecSpecificHdrDataSize;
         char                            iStreamName[MAX_STRN_SZ];  //strn chunk
+        Oscl_Vector < SuperIndexEntryType,
+        OsclMemAllocator >              iSuperIndex;               //indx chunk
 };
 
 
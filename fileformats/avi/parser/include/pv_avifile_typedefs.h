@@ -171,10 +171,18 @@ const uint32    AVIF_WASCAPTUREFILE     = 0x100;
 const uint32    AVISF_DISABLED          = 0x01000000;
 const uint32    AVISF_VIDEO_PALCHANGES  = 0x10000000;
 
-//idx1 flags
-const uint32    AVIIF_KEYFRAME          = 0x01000000;
-const uint32    AVIIF_LIST              = 0x10000000;
-const uint32    AVIIF_NO_TIME           = 0x100000;
+//idx1 flags, in the byte order of PVAviFileParserUtils::read32(aFp, aBuff)
+const uint32    AVIIF_KEYFRAME          = 0x10000000;
+const uint32    AVIIF_LIST              = 0x01000000;
+const uint32    AVIIF_NO_TIME           = 0x00010000;
+
+//OpenDML indx and ix## chunks
+const uint8     AVI_INDEX_OF_INDEXES    = 0x00;
+const uint8     AVI_INDEX_OF_CHUNKS     = 0x01;
+const uint32    AVI_INDEX_DELTAFRAME    = 0x80000000;   //ix## entry size flag, set for non key frames
+const uint32    AVI_INDEX_HDR_SZ        = 24;           //indx and ix## header after the chunk size
+const uint32    AVI_SUPER_INDEX_ENTRY_SZ = 16;
+const uint32    IDX1_ENTRY_SZ           = 16;
 
 typedef struct
 {
@@ -347,6 +355,14 @@ typedef struct
 
 } IdxTblType;
 
+//entry of the OpenDML super index (indx chunk in strl), points to an ix## chunk
+typedef struct
+{
+    uint32  offset;     //file offset of the ix## chunk
+    uint32  size;
+    uint32  duration;   //in stream ticks
+} SuperIndexEntryType;
+
 typedef struct
 {
     uint8 Red;
@@ -17,108 +17,444 @@
  */
 #include "pv_avifile_indx.h"
 
-PVAviFileIdxChunk::PVAviFileIdxChunk(PVFile* aFp, uint32 aIndxSize, uint32 aNumStreams)
+static uint32 LittleEndian32(const uint8* aBuff)
 {
-    iIndexSize = aIndxSize;
+    return ((uint32)aBuff[0]) | ((uint32)aBuff[1] << 8) |
+           ((uint32)aBuff[2] << 16) | ((uint32)aBuff[3] << 24);
+}
+
+//same byte order as PVAviFileParserUtils::read32(aFp, aBuff)
+static uint32 BigEndian32(const uint8* aBuff)
+{
+    return ((uint32)aBuff[0] << 24) | ((uint32)aBuff[1] << 16) |
+           ((uint32)aBuff[2] << 8) | ((uint32)aBuff[3]);
+}
+
+//7 bits per byte, top bit set on all but the last byte
+static uint32 WriteVarInt(uint8* aBuff, uint32 aValue)
+{
+    uint32 len = 0;
+    while (aValue >= 0x80)
+    {
+        aBuff[len++] = (uint8)(aValue | 0x80);
+        aValue >>= 7;
+    }
+    aBuff[len++] = (uint8)aValue;
+    return len;
+}
+
+static uint32 ReadVarInt(const uint8* aBuff, uint32& arPos)
+{
+    uint32 value = 0;
+    uint32 shift = 0;
+    uint8 byte;
+    do
+    {
+        byte = aBuff[arPos++];
+        value |= (uint32)(byte & 0x7F) << shift;
+        shift += 7;
+    }
+    while (byte & 0x80);
+    return value;
+}
+
+PVAviFileStreamIdx::PVAviFileStreamIdx()
+{
+    iAllKeyFrames = true;
+    iNumSamples = 0;
+    iLastOffset = 0;
+    iNextSample = 0;
+    iNextEntryPos = 0;
+    iNextPrevOffset = 0;
+}
+
+PV_AVI_FILE_PARSER_ERROR_TYPE
+PVAviFileStreamIdx::AddSample(uint32 aOffset, uint32 aSize, bool aKeyFrame)
+{
+    //offsets mostly grow, but are not required to. keep the sign in the lowest bit.
+    uint32 diff = aOffset - iLastOffset;
+    diff = (diff << 1) ^ (uint32)((int32)diff >> 31);
+
+    uint8 entry[10];
+    uint32 len = WriteVarInt(entry, diff);
+    len += WriteVarInt(entry + len, aSize);
+
+    int32 leavecode = 0;
+    if ((iNumSamples % AVI_INDEX_CHECKPOINT_INTERVAL) == 0)
+    {
+        IdxCheckpointType checkpoint;
+        checkpoint.prevOffset = iLastOffset;
+        checkpoint.entryPos = iEntries.size();
+        OSCL_TRY(leavecode, iCheckpoints.push_back(checkpoint));
+    }
+
+    for (uint32 ii = 0; (ii < len) && (0 == leavecode); ii++)
+    {
+        OSCL_TRY(leavecode, iEntries.push_back(entry[ii]));
+    }
+
+    if (!aKeyFrame && iAllKeyFrames)
+    {
+        //first delta frame, list the key frames so far
+        iAllKeyFrames = false;
+        for (uint32 ii = 0; (ii < iNumSamples) && (0 == leavecode); ii++)
+        {
+            OSCL_TRY(leavecode, iKeyFrames.push_back(ii));
+        }
+    }
+    else if (aKeyFrame && !iAllKeyFrames && (0 == leavecode))
+    {
+        OSCL_TRY(leavecode, iKeyFrames.push_back(iNumSamples));
+    }
+
+    if (leavecode != 0)
+    {
+        return PV_AVI_FILE_PARSER_INSUFFICIENT_MEMORY;
+    }
+
+    iLastOffset = aOffset;
+    iNumSamples++;
+    return PV_AVI_FILE_PARSER_SUCCESS;
+}
+
+bool PVAviFileStreamIdx::GetSample(uint32 aSampleNo, uint32& arOffset, uint32& arSize)
+{
+    if (aSampleNo >= iNumSamples)
+    {
+        return false;
+    }
+
+    uint32 sampleNo = iNextSample;
+    uint32 pos = iNextEntryPos;
+    uint32 offset = iNextPrevOffset;
+
+    //start from the checkpoint unless the sample follows the last one returned
+    uint32 checkpoint = aSampleNo / AVI_INDEX_CHECKPOINT_INTERVAL;
+    if ((aSampleNo < iNextSample) || (checkpoint * AVI_INDEX_CHECKPOINT_INTERVAL > iNextSample))
+    {
+        sampleNo = checkpoint * AVI_INDEX_CHECKPOINT_INTERVAL;
+        pos = iCheckpoints[checkpoint].entryPos;
+        offset = iCheckpoints[checkpoint].prevOffset;
+    }
+
+    const uint8* entries = &iEntries[0];
+    uint32 size = 0;
+    for (; sampleNo <= aSampleNo; sampleNo++)
+    {
+        uint32 diff = ReadVarInt(entries, pos);
+        offset += (diff >> 1) ^ (0 - (diff & 1));
+        size = ReadVarInt(entries, pos);
+    }
+
+    iNextSample = sampleNo;
+    iNextEntryPos = pos;
+    iNextPrevOffset = offset;
+
+    arOffset = offset;
+    arSize = size;
+    return true;
+}
+
+bool PVAviFileStreamIdx::GetKeyFrame(uint32 aSampleNo, uint32& arKeySampleNo)
+{
+    if (aSampleNo >= iNumSamples)
+    {
+        return false;
+    }
+
+    if (iAllKeyFrames)
+    {
+        arKeySampleNo = aSampleNo;
+        return true;
+    }
+
+    //last key frame not after aSampleNo
+    uint32 low = 0;
+    uint32 high = iKeyFrames.size();
+    while (low < high)
+    {
+        uint32 mid = (low + high) / 2;
+        if (iKeyFrames[mid] <= aSampleNo)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    if (0 == low)
+    {
+        return false;
+    }
+
+    arKeySampleNo = iKeyFrames[low - 1];
+    return true;
+}
+
+PVAviFileIdxChunk::PVAviFileIdxChunk(PVFile* aFp, uint32 aIdx1Offset, uint32 aIdx1Size,
+                                     uint32 aMovieChunkStartOffset, uint32 aNumStreams)
+{
+    ipFilePtr = aFp;
     iNumStreams = aNumStreams;
-    uint32 bytesRead = 0;
-    int32 strNum = 0;
-    uint32 data = 0;
-    iError = PV_AVI_FILE_PARSER_SUCCESS;
+    iMovieChunkStartOffset = aMovieChunkStartOffset;
+    iIdx1Offset = aIdx1Offset;
+    iIdx1BytesLeft = aIdx1Size - (aIdx1Size % IDX1_ENTRY_SZ);
+    iIdx1FirstEntry = true;
     iOffsetFrmMoviLst = false;
-    bool firstSample = true;
+    iError = PV_AVI_FILE_PARSER_SUCCESS;
 
+    int32 leavecode = 0;
     for (uint32 ii = 0; ii < iNumStreams; ii++)
     {
-        IndxTblVector  xtbl;
-        iIndexTable.push_back(xtbl);
+        PVAviFileStreamIdx streamIdx;
+        SuperIdxVector superIdx;
+        StdIdxStateType state;
+        oscl_memset(&state, 0, sizeof(StdIdxStateType));
+
+        OSCL_TRY(leavecode,
+                 iStreamIdx.push_back(streamIdx);
+                 iSuperIndex.push_back(superIdx);
+                 iStdIdxState.push_back(state));
+        if (leavecode != 0)
+        {
+            iError = PV_AVI_FILE_PARSER_INSUFFICIENT_MEMORY;
+            break;
+        }
     }
+}
 
-    while (bytesRead < iIndexSize)
+void PVAviFileIdxChunk::SetSuperIndex(uint32 aStreamNo, const SuperIdxVector& aSuperIndex)
+{
+    iSuperIndex[aStreamNo] = aSuperIndex;
+}
+
+PV_AVI_FILE_PARSER_ERROR_TYPE
+PVAviFileIdxChunk::GetSampleInfo(uint32 aStreamNo, uint32 aSampleNo, uint32& arOffset, uint32& arSize)
+{
+    if (aStreamNo >= iNumStreams)
+    {
+        return PV_AVI_FILE_PARSER_ERROR_WRONG_STREAM_NUM;
+    }
+
+    PV_AVI_FILE_PARSER_ERROR_TYPE error = LoadSamples(aStreamNo, aSampleNo);
+    if (error != PV_AVI_FILE_PARSER_SUCCESS)
+    {
+        return error;
+    }
+
+    iStreamIdx[aStreamNo].GetSample(aSampleNo, arOffset, arSize);
+    return PV_AVI_FILE_PARSER_SUCCESS;
+}
+
+PV_AVI_FILE_PARSER_ERROR_TYPE
+PVAviFileIdxChunk::GetKeyFrameSampleNum(uint32 aStreamNo, uint32 aSampleNo, uint32& arKeySampleNo)
+{
+    if (aStreamNo >= iNumStreams)
+    {
+        return PV_AVI_FILE_PARSER_ERROR_WRONG_STREAM_NUM;
+    }
+
+    PV_AVI_FILE_PARSER_ERROR_TYPE error = LoadSamples(aStreamNo, aSampleNo);
+    if (PV_AVI_FILE_PARSER_EOS_REACHED == error)
     {
-        if (PV_AVI_FILE_PARSER_SUCCESS != PVAviFileParserUtils::read32(aFp, data))
+        uint32 numSamples = iStreamIdx[aStreamNo].GetNumSamples();
+        if (0 == numSamples)
         {
-            iError = PV_AVI_FILE_PARSER_READ_ERROR;
-            break;
+            return error;
+        }
+        aSampleNo = numSamples - 1;
+    }
+    else if (error != PV_AVI_FILE_PARSER_SUCCESS)
+    {
+        return error;
+    }
+
+    if (!iStreamIdx[aStreamNo].GetKeyFrame(aSampleNo, arKeySampleNo))
+    {
+        return PV_AVI_FILE_PARSER_NO_OFFSET_FOUND;
+    }
+    return PV_AVI_FILE_PARSER_SUCCESS;
+}
+
+PV_AVI_FILE_PARSER_ERROR_TYPE
+PVAviFileIdxChunk::LoadSamples(uint32 aStreamNo, uint32 aSampleNo)
+{
+    //a page may be read partially if memory runs out, later reads can't be trusted
+    if (iError != PV_AVI_FILE_PARSER_SUCCESS)
+    {
+        return iError;
+    }
+
+    PV_AVI_FILE_PARSER_ERROR_TYPE error = PV_AVI_FILE_PARSER_SUCCESS;
+    while (iStreamIdx[aStreamNo].GetNumSamples() <= aSampleNo)
+    {
+        if (iSuperIndex[aStreamNo].size() > 0)
+        {
+            error = ReadStdIndexPage(aStreamNo);
         }
-        bytesRead += CHUNK_SIZE;
-        if (bytesRead > iIndexSize)
+        else
+        {
+            error = ReadIdx1Page();
+        }
+
+        if (error != PV_AVI_FILE_PARSER_SUCCESS)
         {
-            iError = PV_AVI_FILE_PARSER_BYTE_COUNT_ERROR;
+            if (PV_AVI_FILE_PARSER_INSUFFICIENT_MEMORY == error)
+            {
+                iError = error;
+            }
             break;
         }
+    }
+    return error;
+}
 
-        strNum = PVAviFileParserUtils::GetStreamNumber(data);
+PV_AVI_FILE_PARSER_ERROR_TYPE
+PVAviFileIdxChunk::ReadIdx1Page()
+{
+    uint32 pageSize = OSCL_MIN(iIdx1BytesLeft, (uint32)(AVI_INDEX_PAGE_SZ - (AVI_INDEX_PAGE_SZ % IDX1_ENTRY_SZ)));
+    if (0 == pageSize)
+    {
+        return PV_AVI_FILE_PARSER_EOS_REACHED;
+    }
+
+    if (!ReadAt(iIdx1Offset, iPage, pageSize))
+    {
+        return PV_AVI_FILE_PARSER_READ_ERROR;
+    }
+    iIdx1Offset += pageSize;
+    iIdx1BytesLeft -= pageSize;
 
+    for (uint32 pos = 0; pos < pageSize; pos += IDX1_ENTRY_SZ)
+    {
+        uint8* entry = iPage + pos;
+
+        //chunk id, flags, offset, size
+        int32 strNum = PVAviFileParserUtils::GetStreamNumber(BigEndian32(entry));
         if ((strNum < 0) || (strNum >= (int32)iNumStreams))
         {
             //bogus entry skip it.
-            aFp->Seek((CHUNK_SIZE + CHUNK_SIZE + CHUNK_SIZE), Oscl_File::SEEKCUR);
-
-            bytesRead += CHUNK_SIZE + CHUNK_SIZE + CHUNK_SIZE ; //flags+offset+size
             continue;
         }
 
-        IdxTblType tbl;
-        tbl.chunkId = data;
+        uint32 flags = BigEndian32(entry + 4);
+        uint32 offset = LittleEndian32(entry + 8);
+        uint32 size = LittleEndian32(entry + 12);
 
-        if (PV_AVI_FILE_PARSER_SUCCESS != PVAviFileParserUtils::read32(aFp, (tbl.flags)))
+        if (iIdx1FirstEntry)
         {
-            iError = PV_AVI_FILE_PARSER_READ_ERROR;
-            break;
+            iIdx1FirstEntry = false;
+            iOffsetFrmMoviLst = (OFFSET_FROM_MOVI_LST == offset);
         }
 
-        bytesRead += CHUNK_SIZE;
-        if (bytesRead > iIndexSize)
+        //the stream's ix## chunks are used instead
+        if (iSuperIndex[strNum].size() > 0)
         {
-            iError = PV_AVI_FILE_PARSER_BYTE_COUNT_ERROR;
-            break;
+            continue;
         }
 
-        if (tbl.flags & AVIIF_KEYFRAME)
-            tbl.isKeyFrame = true;
-        if (tbl.flags & AVIIF_LIST)
-            tbl.ifRecList = true;
-        if (tbl.flags & AVIIF_NO_TIME)
-            tbl.ifNoTime  = true;
+        if (iOffsetFrmMoviLst)
+        {
+            offset = iMovieChunkStartOffset + offset - CHUNK_SIZE;
+        }
+        offset += (CHUNK_SIZE + CHUNK_SIZE); //add 4 bytes each for sample type and data size param.
 
-        if (PV_AVI_FILE_PARSER_SUCCESS != PVAviFileParserUtils::read32(aFp, tbl.offset, true))
+        PV_AVI_FILE_PARSER_ERROR_TYPE error = iStreamIdx[strNum].AddSample(offset, size, (flags & AVIIF_KEYFRAME) != 0);
+        if (error != PV_AVI_FILE_PARSER_SUCCESS)
         {
-            iError = PV_AVI_FILE_PARSER_READ_ERROR;
-            break;
+            return error;
         }
+    }
+    return PV_AVI_FILE_PARSER_SUCCESS;
+}
+
+PV_AVI_FILE_PARSER_ERROR_TYPE
+PVAviFileIdxChunk::ReadStdIndexPage(uint32 aStreamNo)
+{
+    StdIdxStateType& state = iStdIdxState[aStreamNo];
+    SuperIdxVector& superIdx = iSuperIndex[aStreamNo];
 
-        bytesRead += CHUNK_SIZE;
-        if (bytesRead > iIndexSize)
+    while (0 == state.entriesLeft)
+    {
+        if (state.nextSuperIdx >= superIdx.size())
         {
-            iError = PV_AVI_FILE_PARSER_BYTE_COUNT_ERROR;
-            break;
+            return PV_AVI_FILE_PARSER_EOS_REACHED;
         }
 
-        if (firstSample)
+        //ix## chunk header, then wLongsPerEntry, bIndexSubType, bIndexType, nEntriesInUse,
+        //dwChunkId, qwBaseOffset, dwReserved
+        uint8 hdr[CHUNK_SIZE + CHUNK_SIZE + AVI_INDEX_HDR_SZ];
+        uint32 chunkOffset = superIdx[state.nextSuperIdx].offset;
+        if (!ReadAt(chunkOffset, hdr, sizeof(hdr)))
         {
-            firstSample = false;
-            if (OFFSET_FROM_MOVI_LST == tbl.offset)
-            {
-                iOffsetFrmMoviLst = true;
-            }
+            return PV_AVI_FILE_PARSER_READ_ERROR;
         }
+        state.nextSuperIdx++;
+
+        uint32 chunkSize = LittleEndian32(hdr + 4);
+        uint32 longsPerEntry = hdr[8] | (hdr[9] << 8);
+        uint8 indexType = hdr[11];
+        uint32 numEntries = LittleEndian32(hdr + 12);
+        uint32 baseOffset = LittleEndian32(hdr + 20);
+        uint32 baseOffsetHigh = LittleEndian32(hdr + 24);
 
-        if (PV_AVI_FILE_PARSER_SUCCESS != PVAviFileParserUtils::read32(aFp, tbl.size, true))
+        //field indexes have a third entry value, only the first two are used
+        if ((AVI_INDEX_OF_CHUNKS != indexType) || (longsPerEntry < 2) ||
+                (chunkSize < AVI_INDEX_HDR_SZ) || (baseOffsetHigh != 0))
         {
-            iError = PV_AVI_FILE_PARSER_READ_ERROR;
-            break;
+            PVAVIFILE_LOGINFO((0, "PVAviFileIdxChunk::ReadStdIndexPage: ix## chunk skipped"));
+            continue;
         }
 
-        bytesRead += CHUNK_SIZE;
-        if (bytesRead > iIndexSize)
+        state.entrySize = longsPerEntry * 4;
+        state.entriesLeft = OSCL_MIN(numEntries, (chunkSize - AVI_INDEX_HDR_SZ) / state.entrySize);
+        state.entryOffset = chunkOffset + sizeof(hdr);
+        state.baseOffset = baseOffset;
+    }
+
+    uint32 numEntries = OSCL_MIN(state.entriesLeft, AVI_INDEX_PAGE_SZ / state.entrySize);
+    if (!ReadAt(state.entryOffset, iPage, numEntries * state.entrySize))
+    {
+        return PV_AVI_FILE_PARSER_READ_ERROR;
+    }
+    state.entryOffset += numEntries * state.entrySize;
+    state.entriesLeft -= numEntries;
+
+    for (uint32 ii = 0; ii < numEntries; ii++)
+    {
+        //dwOffset from qwBaseOffset to the sample data, dwSize
+        uint8* entry = iPage + ii * state.entrySize;
+        uint32 offset = state.baseOffset + LittleEndian32(entry);
+        uint32 size = LittleEndian32(entry + 4);
+
+        if (offset < state.baseOffset)
         {
-            iError = PV_AVI_FILE_PARSER_BYTE_COUNT_ERROR;
+            //beyond 4GB, the rest of the stream can't be read either
+            state.entriesLeft = 0;
+            state.nextSuperIdx = superIdx.size();
             break;
         }
 
-        (iIndexTable[strNum]).push_back(tbl);
-
+        PV_AVI_FILE_PARSER_ERROR_TYPE error =
+            iStreamIdx[aStreamNo].AddSample(offset, size & ~AVI_INDEX_DELTAFRAME, !(size & AVI_INDEX_DELTAFRAME));
+        if (error != PV_AVI_FILE_PARSER_SUCCESS)
+        {
+            return error;
+        }
     }
+    return PV_AVI_FILE_PARSER_SUCCESS;
 }
 
+bool PVAviFileIdxChunk::ReadAt(uint32 aOffset, uint8* aBuff, uint32 aSize)
+{
+    //GetNextMediaSample() continues from the current position, keep it
+    int32 currPos = ipFilePtr->Tell();
+
+    bool status = ((0 == ipFilePtr->Seek(aOffset, Oscl_File::SEEKSET)) &&
+                   (ipFilePtr->Read(aBuff, 1, aSize) == aSize));
+
+    ipFilePtr->Seek(currPos, Oscl_File::SEEKSET);
+    return status;
+}
@@ -29,6 +29,8 @@ PVAviFileParser::PVAviFileParser(OSCL_wHeapString<OsclMemAllocator> aFileName, i
     iMovieChunkSize = 0;
     iMovieChunkStartOffset = 0;
     iIndxChunkSize = 0;
+    iIndxChunkOffset = 0;
+    iTotalFileSize = 0;
     iSampleOffset = 0;
     iTimeStampVideo = 0;
     iTimeStampAudio = 0;
@@ -63,6 +65,7 @@ PVAviFileParser::ParseFile()
         return iError;
     }
     filesize = ipFilePtr->Tell();
+    iTotalFileSize = filesize;
 
     // Seek back to the beginning
     ipFilePtr->Seek(0, Oscl_File::SEEKSET);
@@ -240,19 +243,10 @@ PVAviFileParser::ParseFile()
                 iError = PV_AVI_FILE_PARSER_WRONG_SIZE;
                 break;
             }
-            uint32 numStreams = GetNumStreams();
-            ipIdxChunk = OSCL_NEW(PVAviFileIdxChunk, (ipFilePtr, iIndxChunkSize, numStreams));
-            if (ipIdxChunk != NULL)
-            {
-                iError = ipIdxChunk->GetStatus();
-                if (iError != PV_AVI_FILE_PARSER_SUCCESS)
-                {
-                    OSCL_DELETE(ipIdxChunk);
-                    ipIdxChunk = NULL;
-                    break;
-                }
-                iIdxChunkPresent = true;
-            }
+
+            //entries are read when the samples are asked for
+            iIndxChunkOffset = ipFilePtr->Tell();
+            ipFilePtr->Seek(iIndxChunkSize, Oscl_File::SEEKCUR);
             bytesRead += iIndxChunkSize;
         }
         else if (JUNK == chunkType)
@@ -295,6 +289,41 @@ PVAviFileParser::ParseFile()
 
     }   //while (bytesRead <= iFileSize)
 
+    if ((PV_AVI_FILE_PARSER_SUCCESS == iError) && (NULL != ipFileHeader))
+    {
+        uint32 numStreams = GetNumStreams();
+        bool superIdxPresent = false;
+        for (uint32 ii = 0; ii < numStreams; ii++)
+        {
+            if (ipFileHeader->GetSuperIndex(ii).size() > 0)
+            {
+                superIdxPresent = true;
+            }
+        }
+
+        if ((iIndxChunkSize > 0) || superIdxPresent)
+        {
+            ipIdxChunk = OSCL_NEW(PVAviFileIdxChunk, (ipFilePtr, iIndxChunkOffset, iIndxChunkSize,
+                                  iMovieChunkStartOffset, numStreams));
+            if (ipIdxChunk != NULL)
+            {
+                iError = ipIdxChunk->GetStatus();
+                if (iError != PV_AVI_FILE_PARSER_SUCCESS)
+                {
+                    OSCL_DELETE(ipIdxChunk);
+                    ipIdxChunk = NULL;
+                    return iError;
+                }
+
+                for (uint32 ii = 0; ii < numStreams; ii++)
+                {
+                    ipIdxChunk->SetSuperIndex(ii, ipFileHeader->GetSuperIndex(ii));
+                }
+                iIdxChunkPresent = true;
+            }
+        }
+    }
+
     return iError;
 }
 
@@ -514,15 +543,20 @@ PV_AVI_FILE_PARSER_ERROR_TYPE
 PVAviFileParser::GetStreamOffsetFromIndexTable(uint32 aStreamNo, uint32& arSize, uint32& arOffset)
 {
     uint32 sampleOffset = 0;
+    uint32 size = 0;
 
-    if (iStreamSampleCount[aStreamNo] >= ipIdxChunk->GetNumberOfSamplesInStream(aStreamNo))
+    PV_AVI_FILE_PARSER_ERROR_TYPE error =
+        ipIdxChunk->GetSampleInfo(aStreamNo, iStreamSampleCount[aStreamNo], sampleOffset, size);
+    if (PV_AVI_FILE_PARSER_EOS_REACHED == error)
     {
         PVAVIFILE_LOGINFO((0, "PVAviFileParser::GetNextMediaSample: EOF Reached"));
-        return PV_AVI_FILE_PARSER_EOS_REACHED;
+        return error;
+    }
+    else if (error != PV_AVI_FILE_PARSER_SUCCESS)
+    {
+        PVAVIFILE_LOGERROR((0, "PVAviFileParser::GetNextMediaSample: Index Table Read Error"));
+        return error;
     }
-
-    sampleOffset = ipIdxChunk->GetOffset(aStreamNo, iStreamSampleCount[aStreamNo]);
-    uint32 size = ipIdxChunk->GetSampleSize(aStreamNo, iStreamSampleCount[aStreamNo]);
 
     if (size > arSize)
     {
@@ -531,19 +565,10 @@ PVAviFileParser::GetStreamOffsetFromIndexTable(uint32 aStreamNo, uint32& arSize,
     }
 
     arSize = size;
+    arOffset = sampleOffset;
 
-    if (ipIdxChunk->IsOffsetFromMoviList())
-    {
-        arOffset = iMovieChunkStartOffset + sampleOffset - CHUNK_SIZE;
-    }
-    else
-    {
-        arOffset = sampleOffset;
-    }
-
-    arOffset += (CHUNK_SIZE + CHUNK_SIZE); //add 4 bytes each for sample type and data size param.
-
-    if ((arOffset > iFileSize))
+    //OpenDML files continue after the first RIFF chunk
+    if ((arOffset > iTotalFileSize))
     {
         PVAVIFILE_LOGERROR((0, "PVAviFileParser::GetNextMediaSample: File Size & Byte Count mismatch"));
         return PV_AVI_FILE_PARSER_BYTE_COUNT_ERROR;
@@ -639,6 +664,34 @@ PVAviFileParser::GetStreamOffset(uint32 aStreamNo, uint32& arSampleSize, uint32&
     }
 }
 
+OSCL_EXPORT_REF PV_AVI_FILE_PARSER_ERROR_TYPE
+PVAviFileParser::GetKeyFrameSampleNum(uint32 aStreamNo, uint32 aSampleNo, uint32& arKeySampleNo)
+{
+    if (false == iIdxChunkPresent)
+    {
+        return PV_AVI_FILE_PARSER_NO_INDEX_CHUNK;
+    }
+
+    return ipIdxChunk->GetKeyFrameSampleNum(aStreamNo, aSampleNo, arKeySampleNo);
+}
+
+OSCL_EXPORT_REF PV_AVI_FILE_PARSER_ERROR_TYPE
+PVAviFileParser::SetStreamSampleNum(uint32 aStreamNo, uint32 aSampleNo)
+{
+    if (false == iIdxChunkPresent)
+    {
+        return PV_AVI_FILE_PARSER_NO_INDEX_CHUNK;
+    }
+
+    if (aStreamNo >= iStreamSampleCount.size())
+    {
+        return PV_AVI_FILE_PARSER_ERROR_WRONG_STREAM_NUM;
+    }
+
+    iStreamSampleCount[aStreamNo] = aSampleNo;
+    return PV_AVI_FILE_PARSER_SUCCESS;
+}
+
 OSCL_EXPORT_REF void PVAviFileParser::Reset()
 {
     PVAVIFILE_LOGINFO((0, "PVAviFileParser::Reset"));
@@ -48,6 +48,7 @@ PVAviFileParserUtils::ReadNextChunkType(PVFile* aFp, uint32& aChkType)
             || aChkType == STRN
             || aChkType == STRD
             || aChkType == IDX1
+            || aChkType == INDX
             || aChkType == VIDS
             || aChkType == AUDS
             || aChkType == MIDS
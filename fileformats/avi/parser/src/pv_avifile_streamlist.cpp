@@ -242,6 +242,34 @@ PVAviFileStreamlist::PVAviFileStreamlist(PVFile *aFp, uint32 aStrListSz)
             }
 
         }
+        else if (INDX == chunkType)
+        {
+            PVAVIFILE_LOGINFO((0, "PVAviFileStreamlist::PVAviFileStreamlist: Found OpenDML Super Index"));
+
+            uint32 indxSize = 0;
+            if (PV_AVI_FILE_PARSER_SUCCESS != PVAviFileParserUtils::read32(aFp, indxSize, true))
+            {
+                PVAVIFILE_LOGERROR((0, "PVAviFileStreamlist::PVAviFileStreamlist: File Read Error"));
+                iError =  PV_AVI_FILE_PARSER_READ_ERROR;
+                break;
+            }
+
+            bytesRead += CHUNK_SIZE;
+            if ((indxSize < AVI_INDEX_HDR_SZ) || ((bytesRead + indxSize) > iStreamListSize))
+            {
+                PVAVIFILE_LOGERROR((0, "PVAviFileStreamlist::PVAviFileStreamlist: File Size & Byte Count Mismatch"));
+                iError =  PV_AVI_FILE_PARSER_WRONG_SIZE;
+                break;
+            }
+
+            if ((iError = ParseSuperIndex(aFp, indxSize)) != PV_AVI_FILE_PARSER_SUCCESS)
+            {
+                PVAVIFILE_LOGERROR((0, "PVAviFileStreamlist::PVAviFileStreamlist: ParseSuperIndex returned error"));
+                break;
+            }
+
+            bytesRead += indxSize;
+        }
         else if (JUNK == chunkType)
         {
             PVAVIFILE_LOGINFO((0, "PVAviFileStreamlist::PVAviFileStreamlist: Skip Junk Data"));
@@ -292,6 +320,62 @@ PVAviFileStreamlist::PVAviFileStreamlist(PVFile *aFp, uint32 aStrListSz)
 }
 
 
+PV_AVI_FILE_PARSER_ERROR_TYPE
+PVAviFileStreamlist::ParseSuperIndex(PVFile *aFp, uint32 aIndxSize)
+{
+    //wLongsPerEntry, bIndexSubType, bIndexType, nEntriesInUse, dwChunkId, dwReserved[3]
+    uint8 hdr[AVI_INDEX_HDR_SZ];
+    if (aFp->Read(hdr, 1, AVI_INDEX_HDR_SZ) != AVI_INDEX_HDR_SZ)
+    {
+        return PV_AVI_FILE_PARSER_READ_ERROR;
+    }
+
+    uint32 bytesRead = AVI_INDEX_HDR_SZ;
+    uint16 longsPerEntry = (uint16)(hdr[0] | (hdr[1] << 8));
+    uint8 indexType = hdr[3];
+    uint32 numEntries = hdr[4] | (hdr[5] << 8) | (hdr[6] << 16) | ((uint32)hdr[7] << 24);
+
+    //only an index of ix## chunks is used, the stream falls back to idx1 otherwise
+    if ((AVI_INDEX_OF_INDEXES == indexType) && ((longsPerEntry * 4) == AVI_SUPER_INDEX_ENTRY_SZ))
+    {
+        numEntries = OSCL_MIN(numEntries, (aIndxSize - AVI_INDEX_HDR_SZ) / AVI_SUPER_INDEX_ENTRY_SZ);
+
+        for (uint32 ii = 0; ii < numEntries; ii++)
+        {
+            //qwOffset, dwSize, dwDuration
+            uint8 entry[AVI_SUPER_INDEX_ENTRY_SZ];
+            if (aFp->Read(entry, 1, AVI_SUPER_INDEX_ENTRY_SZ) != AVI_SUPER_INDEX_ENTRY_SZ)
+            {
+                return PV_AVI_FILE_PARSER_READ_ERROR;
+            }
+            bytesRead += AVI_SUPER_INDEX_ENTRY_SZ;
+
+            //file offsets are 32 bit in this parser, ignore the part beyond 4GB
+            if (entry[4] | entry[5] | entry[6] | entry[7])
+            {
+                PVAVIFILE_LOGINFO((0, "PVAviFileStreamlist::ParseSuperIndex: ix## chunk beyond 4GB ignored"));
+                break;
+            }
+
+            SuperIndexEntryType superIdx;
+            superIdx.offset = entry[0] | (entry[1] << 8) | (entry[2] << 16) | ((uint32)entry[3] << 24);
+            superIdx.size = entry[8] | (entry[9] << 8) | (entry[10] << 16) | ((uint32)entry[11] << 24);
+            superIdx.duration = entry[12] | (entry[13] << 8) | (entry[14] << 16) | ((uint32)entry[15] << 24);
+
+            int32 leavecode = 0;
+            OSCL_TRY(leavecode, iSuperIndex.push_back(superIdx));
+            if (leavecode != 0)
+            {
+                return PV_AVI_FILE_PARSER_INSUFFICIENT_MEMORY;
+            }
+        }
+    }
+
+    //skip unused entries
+    aFp->Seek(aIndxSize - bytesRead, Oscl_File::SEEKCUR);
+    return PV_AVI_FILE_PARSER_SUCCESS;
+}
+
 PV_AVI_FILE_PARSER_ERROR_TYPE
 PVAviFileStreamlist::ParseStreamHeader(PVFile *aFp, uint32 aHdrSize)
 {
@@ -50,6 +50,7 @@
 class PVMFCPMPluginAccessInterfaceFactory;
 class PVMIDataStreamSyncInterface;
 class PvmiDataStreamObserver;
+class OsclRefCounterMemFrag;
 
 #define PVFILE_DEFAULT_CACHE_SIZE 4*1024
 #define PVFILE_DEFAULT_ASYNC_READ_BUFFER_SIZE 0
@@ -65,6 +66,7 @@ class PVFileCacheParams
             iNativeAccessMode = PVFILE_DEFAULT_NATIVE_ACCESS_MODE;
             iPVLoggerEnableFlag = false;
             iPVLoggerStateEnableFlag = false;
+            iMemoryMapEnable = false;
         }
 
         PVFileCacheParams(const PVFileCacheParams& a)
@@ -89,6 +91,8 @@ class PVFileCacheParams
         bool iPVLoggerEnableFlag;
         bool iPVLoggerStateEnableFlag;
         uint32 iNativeAccessMode;
+        //map the file into memory when possible, see Oscl_File::SetMemoryMapEnable.
+        bool iMemoryMapEnable;
 
     private:
         void MyCopy(const PVFileCacheParams& a)
@@ -98,6 +102,7 @@ class PVFileCacheParams
             iPVLoggerEnableFlag = a.iPVLoggerEnableFlag;
             iPVLoggerStateEnableFlag = a.iPVLoggerStateEnableFlag;
             iNativeAccessMode = a.iNativeAccessMode;
+            iMemoryMapEnable = a.iMemoryMapEnable;
         }
 };
 
@@ -208,6 +213,11 @@ class PVFile
             iOsclFileCacheParams = aParams;
         }
 
+        const PVFileCacheParams& GetFileCacheParams() const
+        {
+            return iOsclFileCacheParams;
+        }
+
         //Access APIs, same functionality as Oscl File I/O.
         OSCL_IMPORT_REF int32 Seek(int32 offset, Oscl_File::seek_type origin);
         OSCL_IMPORT_REF int32 Tell();
@@ -245,6 +255,20 @@ class PVFile
         // returns the byte range availabe in the stream cache
         OSCL_IMPORT_REF void GetCurrentByteRange(uint32& aCurrentFirstByteOffset, uint32& aCurrentLastByteOffset);
 
+        // For memory-mapped local files
+        // returns a fragment of the file without copying the data,
+        // or false if the file isn't mapped.  See Oscl_File::GetMappedFragment.
+        OSCL_IMPORT_REF bool GetMappedFragment(uint32 aOffset, uint32 aLen, OsclRefCounterMemFrag& aFrag);
+
+        bool IsMemoryMapped()
+        {
+            if (iFile)
+                return iFile->IsMemoryMapped();
+            if (iFilePtr)
+                return iFilePtr->IsMemoryMapped();
+            return false;
+        }
+
     private:
         //Access parameters from local source data
         PVMFCPMPluginAccessInterfaceFactory* iCPMAccessFactory;
@@ -32,6 +32,7 @@
 #include "pvfile.h"
 #include "pvmf_cpmplugin_access_interface_factory.h"
 #include "pvmi_data_stream_interface.h"
+#include "oscl_refcounter_memfrag.h"
 
 OSCL_EXPORT_REF int32 PVFile::Seek(int32 offset, Oscl_File::seek_type origin)
 {
@@ -223,6 +224,9 @@ OSCL_EXPORT_REF int32 PVFile::Open(const oscl_wchar *filename,
         // be ignored and the handle will be used instead),
         // Otherwise, open it using its filename.
 
+        //memory mapping works with an external file handle too.
+        iFile->SetMemoryMapEnable(iOsclFileCacheParams.iMemoryMapEnable);
+
         int32 result;
         if (iFileHandle)
             result =  iFile->Open("", mode, fileserv);
@@ -414,3 +418,17 @@ PVFile::GetCurrentByteRange(uint32& aCurrentFirstByteOffset, uint32& aCurrentLas
     }
 }
 
+OSCL_EXPORT_REF bool
+PVFile::GetMappedFragment(uint32 aOffset, uint32 aLen, OsclRefCounterMemFrag& aFrag)
+{
+    if (iFile)
+    {
+        return iFile->GetMappedFragment(aOffset, aLen, aFrag);
+    }
+    else if (iFilePtr)
+    {
+        return iFilePtr->GetMappedFragment(aOffset, aLen, aFrag);
+    }
+    return false;
+}
+
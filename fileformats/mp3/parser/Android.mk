@@ -5,6 +5,7 @@ LOCAL_SRC_FILES := \
 	src/imp3ff.cpp \
  	src/mp3fileio.cpp \
  	src/mp3parser.cpp \
+ 	src/mp3seekindex.cpp \
  	src/mp3utils.cpp
 
 
@@ -29,6 +30,7 @@ LOCAL_COPY_HEADERS := \
 	include/imp3ff.h \
  	include/mp3fileio.h \
  	include/mp3parser.h \
+ 	include/mp3seekindex.h \
  	include/mp3utils.h
 
 include $(BUILD_STATIC_LIBRARY)
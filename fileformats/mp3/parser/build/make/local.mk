@@ -21,12 +21,14 @@ SRCS := \
 	imp3ff.cpp \
 	mp3fileio.cpp \
 	mp3parser.cpp \
+	mp3seekindex.cpp \
 	mp3utils.cpp 
 
 HDRS := \
 	imp3ff.h \
 	mp3fileio.h \
 	mp3parser.h \
+	mp3seekindex.h \
 	mp3utils.h
 
 
@@ -431,6 +431,28 @@ class IMpeg3File
 
         OSCL_EXPORT_REF MP3ErrorType ScanMP3File(uint32 aFramesToScan);
 
+        /**
+        * @brief Saves the frame index built by ScanMP3File to a cache file,
+        * once the scan is complete. Only clips without a XING or VBRI TOC
+        * are scanned.
+        *
+        * @param aCacheFileName Name of the cache file, overwritten
+        * @param aFileServSession Pointer to opened file server session
+        * @returns MP3_SUCCESS if the index was saved
+        */
+        OSCL_IMPORT_REF MP3ErrorType SaveSeekIndex(OSCL_wString& aCacheFileName, Oscl_FileServer* aFileServSession);
+
+        /**
+        * @brief Loads the frame index from a cache file saved for the same
+        * clip, the clip is then not scanned. Call after ParseMp3File and
+        * before the first ScanMP3File.
+        *
+        * @param aCacheFileName Name of the cache file
+        * @param aFileServSession Pointer to opened file server session
+        * @returns MP3_SUCCESS if the index was loaded
+        */
+        OSCL_IMPORT_REF MP3ErrorType LoadSeekIndex(OSCL_wString& aCacheFileName, Oscl_FileServer* aFileServSession);
+
     private:
         OsclAny* AllocateKVPKeyArray(int32& leavecode, PvmiKvpValueType aValueType, int32 aNumElements);
         int32 PushKVPValue(PvmiKvp aKVP, Oscl_Vector<PvmiKvp, OsclMemAllocator>& aValueList);
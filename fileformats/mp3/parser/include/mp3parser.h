@@ -67,6 +67,9 @@
 #ifndef PVLOGGER_H_INCLUDED
 #include "pvlogger.h"
 #endif
+#ifndef MP3SEEKINDEX_H_INCLUDED
+#include "mp3seekindex.h"
+#endif
 
 //----------------------------------------------------------------------
 // Global Type Declarations
@@ -404,6 +407,27 @@ class MP3Parser
         }
 
         MP3ErrorType ScanMP3File(PVFile * fpUsed, uint32 aFramesToScan);
+
+        /**
+        * @brief Writes the frame index built by ScanMP3File to a cache file.
+        * Only an index covering the whole clip is written.
+        *
+        * @param aCacheFile Cache file opened for writing
+        * @param fpUsed File the clip was scanned with
+        * @returns MP3_SUCCESS if the index was written
+        */
+        MP3ErrorType SaveSeekIndex(Oscl_File &aCacheFile, PVFile * fpUsed);
+
+        /**
+        * @brief Reads the frame index from a cache file written by
+        * SaveSeekIndex for the same clip. Must be called before the first
+        * ScanMP3File call, the scan is then not needed anymore.
+        *
+        * @param aCacheFile Cache file opened for reading
+        * @param fpUsed File the clip will be scanned with
+        * @returns MP3_SUCCESS if the index was loaded
+        */
+        MP3ErrorType LoadSeekIndex(Oscl_File &aCacheFile, PVFile * fpUsed);
     private:
         MP3ErrorType ScanMP3File(PVFile* fpUsed);
         MP3ErrorType GetDurationFromVBRIHeader(uint32 &aDuration);
@@ -416,6 +440,8 @@ class MP3Parser
         uint32 GetDurationFromMetadata();
 
         MP3ErrorType FillTOCTable(uint32 aFilePos, uint32 aTimeStampToFrame);
+        bool SeekPointFromIndex(uint32 &aTimestamp, uint32 &aSeekPoint);
+        bool GetSeekIndexFingerprint(PVFile * fpUsed, uint32 &aFingerprint);
 
         //duration related values
         uint32 iClipDurationInMsec;
@@ -464,6 +490,8 @@ class MP3Parser
         uint32 iTimestampPrev;
         uint32 iScanTimestamp;
         uint32 iBinWidth;
+        /* frame exact seek index */
+        MP3SeekIndex iSeekIndex;
 
         uint32 iSamplingRate;
         uint32 iSamplesPerFrame;
@@ -0,0 +1,196 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// -*- c++ -*-
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+//                     M P 3   S E E K   I N D E X
+
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+
+/**
+ *  @file mp3seekindex.h
+ *  @brief This include file contains the definitions for the frame offset
+ *  index used to reposition in VBR clips without a XING or VBRI TOC.
+ */
+
+#ifndef MP3SEEKINDEX_H_INCLUDED
+#define MP3SEEKINDEX_H_INCLUDED
+
+
+//----------------------------------------------------------------------
+// Include Files
+//----------------------------------------------------------------------
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+#ifndef OSCL_FILE_IO_H_INCLUDED
+#include "oscl_file_io.h"
+#endif
+#ifndef OSCL_VECTOR_H_INCLUDED
+#include "oscl_vector.h"
+#endif
+#ifndef OSCL_MEM_H_INCLUDED
+#include "oscl_mem.h"
+#endif
+
+//----------------------------------------------------------------------
+// Global Constant Declarations
+//----------------------------------------------------------------------
+
+// One index entry is recorded every MP3_SEEK_INDEX_FRAME_INTERVAL frames.
+// Seeking lands on the entry and walks at most this many frame headers.
+#ifndef MP3_SEEK_INDEX_FRAME_INTERVAL
+#define MP3_SEEK_INDEX_FRAME_INTERVAL 16
+#endif
+
+// Entries are stored as variable length deltas, an absolute offset is kept
+// every MP3_SEEK_INDEX_CHECKPOINT_INTERVAL entries to bound the decoding.
+#ifndef MP3_SEEK_INDEX_CHECKPOINT_INTERVAL
+#define MP3_SEEK_INDEX_CHECKPOINT_INTERVAL 64
+#endif
+
+#define MP3_SEEK_INDEX_CACHE_MAGIC 0x58535650 // "PVSX"
+#define MP3_SEEK_INDEX_CACHE_VERSION 1
+#define MP3_SEEK_INDEX_CACHE_HEADER_SIZE 32
+
+//----------------------------------------------------------------------
+// Global Type Declarations
+//----------------------------------------------------------------------
+
+typedef struct mp3SeekIndexCheckpoint_tag
+{
+    uint32 fileOffset;  // absolute offset of the entry
+    uint32 bytePos;     // position of the next delta in the stream
+} MP3SeekIndexCheckpoint;
+
+//======================================================================
+//  CLASS DEFINITIONS and FUNCTION DECLARATIONS
+//======================================================================
+
+/**
+ *  @brief The MP3SeekIndex Class records the file offset of every Nth
+ *  frame of the clip as it is scanned, so that the frame at any timestamp
+ *  can be found exactly. The index can be saved to and loaded from a
+ *  cache file, keyed by the clip size and a fingerprint supplied by the
+ *  parser.
+ */
+
+class MP3SeekIndex
+{
+    public:
+        MP3SeekIndex();
+        ~MP3SeekIndex();
+
+        /**
+        * @brief Discards all entries.
+        */
+        void Reset();
+
+        /**
+        * @brief Records a frame. Frames must be added in order, starting
+        * with frame 0; out of order frames are ignored.
+        *
+        * @param aFrameNumber Number of the frame
+        * @param aFileOffset Absolute file offset of the frame header
+        * @returns True if the frame was accepted; False otherwise
+        */
+        bool AddFrame(uint32 aFrameNumber, uint32 aFileOffset);
+
+        /**
+        * @brief Marks the index as covering every frame of the clip.
+        */
+        void SetComplete()
+        {
+            iComplete = true;
+        }
+        bool IsComplete() const
+        {
+            return iComplete && iValid;
+        }
+
+        /**
+        * @brief Returns the number of frames recorded so far.
+        */
+        uint32 GetFrameCount() const
+        {
+            return iValid ? iFrameCount : 0;
+        }
+
+        /**
+        * @brief Returns the number of entries in the index.
+        */
+        uint32 GetEntryCount() const
+        {
+            return iValid ? iEntryCount : 0;
+        }
+
+        /**
+        * @brief Returns the file offset of an entry.
+        *
+        * @param aEntry Entry number, entry n is frame n * MP3_SEEK_INDEX_FRAME_INTERVAL
+        * @param aFileOffset Absolute file offset of the frame
+        * @returns True if successful; False otherwise
+        */
+        bool GetEntryOffset(uint32 aEntry, uint32 &aFileOffset) const;
+
+        /**
+        * @brief Finds the closest indexed frame at or before a frame.
+        *
+        * @param aFrameNumber Frame to seek to
+        * @param aIndexedFrame Number of the indexed frame
+        * @param aFileOffset Absolute file offset of the indexed frame
+        * @returns True if successful; False if the index is empty
+        */
+        bool GetSeekPoint(uint32 aFrameNumber, uint32 &aIndexedFrame, uint32 &aFileOffset) const;
+
+        /**
+        * @brief Writes a complete index to a cache file.
+        *
+        * @param aFile Cache file opened for writing
+        * @param aFileSize Size of the clip
+        * @param aFingerprint Fingerprint of the clip
+        * @returns True if successful; False otherwise
+        */
+        bool Save(Oscl_File &aFile, uint32 aFileSize, uint32 aFingerprint) const;
+
+        /**
+        * @brief Reads an index from a cache file. The index is only loaded
+        * if it was saved for a clip of the same size, the caller is expected
+        * to compare the fingerprint and Reset() the index on a mismatch.
+        *
+        * @param aFile Cache file opened for reading
+        * @param aFileSize Size of the clip
+        * @param aFingerprint Fingerprint stored in the cache file
+        * @returns True if successful; False otherwise
+        */
+        bool Load(Oscl_File &aFile, uint32 aFileSize, uint32 &aFingerprint);
+
+    private:
+        bool PushEntry(uint32 aFileOffset);
+
+        Oscl_Vector<uint8, OsclMemAllocator> iDeltas;
+        Oscl_Vector<MP3SeekIndexCheckpoint, OsclMemAllocator> iCheckpoints;
+        uint32 iFrameCount;
+        uint32 iEntryCount;
+        uint32 iLastOffset;
+        bool iComplete;
+        bool iValid;
+};
+
+#endif // #ifndef MP3SEEKINDEX_H_INCLUDED
@@ -1505,6 +1505,40 @@ OSCL_EXPORT_REF MP3ErrorType IMpeg3File::ScanMP3File(uint32 aFramesToScan)
     return MP3_ERROR_UNKNOWN;
 }
 
+OSCL_EXPORT_REF MP3ErrorType IMpeg3File::SaveSeekIndex(OSCL_wString& aCacheFileName, Oscl_FileServer* aFileServSession)
+{
+    if (!pMP3Parser || !iScanFP.IsOpen() || !aFileServSession)
+    {
+        return MP3_ERROR_UNKNOWN;
+    }
+
+    Oscl_File cacheFile;
+    if (cacheFile.Open(aCacheFileName.get_cstr(), (Oscl_File::MODE_READWRITE | Oscl_File::MODE_BINARY), *aFileServSession) != 0)
+    {
+        return MP3_FILE_OPEN_ERR;
+    }
+    MP3ErrorType err = pMP3Parser->SaveSeekIndex(cacheFile, &iScanFP);
+    cacheFile.Close();
+    return err;
+}
+
+OSCL_EXPORT_REF MP3ErrorType IMpeg3File::LoadSeekIndex(OSCL_wString& aCacheFileName, Oscl_FileServer* aFileServSession)
+{
+    if (!pMP3Parser || !iScanFP.IsOpen() || !aFileServSession)
+    {
+        return MP3_ERROR_UNKNOWN;
+    }
+
+    Oscl_File cacheFile;
+    if (cacheFile.Open(aCacheFileName.get_cstr(), (Oscl_File::MODE_READ | Oscl_File::MODE_BINARY), *aFileServSession) != 0)
+    {
+        return MP3_FILE_OPEN_ERR;
+    }
+    MP3ErrorType err = pMP3Parser->LoadSeekIndex(cacheFile, &iScanFP);
+    cacheFile.Close();
+    return err;
+}
+
 OsclAny* IMpeg3File::AllocateKVPKeyArray(int32& aLeaveCode, PvmiKvpValueType aValueType, int32 aNumElements)
 {
     int32 leaveCode = OsclErrNone;
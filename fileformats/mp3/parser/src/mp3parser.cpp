@@ -711,6 +711,12 @@ MP3ErrorType MP3Parser::ScanMP3File(PVFile * fpUsed, uint32 aFramesToScan)
         return MP3_DURATION_PRESENT;
     }
 
+    if (iDurationScanComplete && iSeekIndex.IsComplete())
+    {
+        // seek index was loaded from the cache, nothing left to scan
+        return MP3_DURATION_PRESENT;
+    }
+
     if (iTOCFilledCount == MAX_TOC_ENTRY_COUNT)
     {
         status = FillTOCTable(0, 0);
@@ -855,6 +861,9 @@ MP3ErrorType MP3Parser::ScanMP3File(PVFile * fpUsed, uint32 aFramesToScan)
             return MP3_FILE_HDR_DECODE_ERR;
         }
 
+        // record the frame in the seek index, frame header was just read
+        iSeekIndex.AddFrame(iScannedFrameCount, MP3Utils::getCurrentFilePosition(fpUsed) - MP3_FRAME_HEADER_SIZE);
+
         MP3Utils::SeektoOffset(fpUsed, mp3ConfigInfo.FrameLengthInBytes - MP3_FRAME_HEADER_SIZE, Oscl_File::SEEKCUR);
         bitrate = mp3ConfigInfo.BitRate;
         frameDur = frameDur + (uint32)((OsclFloat) mp3ConfigInfo.FrameLengthInBytes * 8000.00f / mp3ConfigInfo.BitRate);
@@ -1903,6 +1912,11 @@ uint32 MP3Parser::SeekPointFromTimestamp(uint32 &timestamp)
         seekPoint -= (int)((OsclFloat)iVbriHeader.TOC[i-1] * (OsclFloat)(fraction)
                            / (OsclFloat)iVbriHeader.fTableEntry);
     }
+    else if (SeekPointFromIndex(timestamp, seekPoint))
+    {
+        // seek point is the start of the frame, no need to search for sync
+        return seekPoint;
+    }
     else if (bUseTOCForRepos)
     {
         // Use TOC for calculating seek point.
@@ -1960,7 +1974,7 @@ uint32 MP3Parser::SeekPointFromTimestamp(uint32 &timestamp)
         {
             seekPoint += seekOffset;
             MP3Utils::SeektoOffset(fp, seekOffset, Oscl_File::SEEKCUR);
-            if (iDurationScanComplete)
+            if (iDurationScanComplete && bUseTOCForRepos)
             {
                 uint32 offsetDiff = iTOC[binNo+1] - iTOC[binNo];
                 timestamp = (binNo * iBinWidth) + (iBinWidth * (seekPoint - iTOC[binNo]) / offsetDiff);
@@ -3021,6 +3035,7 @@ MP3ErrorType MP3Parser::FillTOCTable(uint32 aFilePos, uint32 aTimeStampToFrame)
 
     if (iDurationScanComplete)
     {
+        iSeekIndex.SetComplete();
         iTOC[iTOCFilledCount] = aFilePos;
         iTOCFilledCount++;
         if (0 == iTimestampPrev)
@@ -3058,6 +3073,205 @@ MP3ErrorType MP3Parser::FillTOCTable(uint32 aFilePos, uint32 aTimeStampToFrame)
     return MP3_SUCCESS;
 }
 
+/***********************************************************************
+ * FUNCTION:    SeekPointFromIndex
+ * DESCRIPTION: Finds the frame at the timestamp from the seek index built
+ *              by ScanMP3File. The index holds every
+ *              MP3_SEEK_INDEX_FRAME_INTERVAL frame, the frames in between
+ *              are found by walking the frame headers.
+ * INPUT/OUTPUT PARAMETERS: aTimestamp, timestamp of the frame found
+ * RETURN VALUE: true if aSeekPoint is valid, false if the frame is not
+ *               in the index yet
+ * SIDE EFFECTS: sets iCurrFrameNumber and iTimestamp
+ ***********************************************************************/
+bool MP3Parser::SeekPointFromIndex(uint32 &aTimestamp, uint32 &aSeekPoint)
+{
+    uint32 frameCount = iSeekIndex.GetFrameCount();
+    if (frameCount == 0 || iMP3ConfigInfo.FrameSizeUnComp <= 0 || iMP3ConfigInfo.SamplingRate <= 0)
+    {
+        return false;
+    }
+
+    uint32 frameNumber = (uint32)(((uint64)aTimestamp * iMP3ConfigInfo.SamplingRate) /
+                                  ((uint64)1000 * iMP3ConfigInfo.FrameSizeUnComp));
+    if (frameNumber >= frameCount)
+    {
+        if (!iSeekIndex.IsComplete())
+        {
+            // scan has not reached this frame yet
+            return false;
+        }
+        // past the last frame, node will report end of track.
+        // like the other seek points, relative to StartOffset
+        aSeekPoint = (iLocalFileSize > StartOffset) ? (iLocalFileSize - StartOffset) : 0;
+        aTimestamp = iClipDurationInMsec;
+        iTimestamp = aTimestamp;
+        return true;
+    }
+
+    uint32 indexedFrame = 0;
+    uint32 offset = 0;
+    if (!iSeekIndex.GetSeekPoint(frameNumber, indexedFrame, offset) || offset < StartOffset)
+    {
+        return false;
+    }
+
+    // the frames in between can be read only for local playback
+    if (indexedFrame < frameNumber && fp->GetFileBufferingCapacity() == 0)
+    {
+        uint8 pFrameHeader[MP3_FRAME_HEADER_SIZE];
+        MP3HeaderType mp3HeaderInfo;
+        MP3ConfigInfoType mp3ConfigInfo;
+        uint32 nextOffset = offset;
+        uint32 nextFrame = indexedFrame;
+
+        for (;;)
+        {
+            if ((MP3_SUCCESS != MP3Utils::SeektoOffset(fp, nextOffset, Oscl_File::SEEKSET)) ||
+                    !MP3FileIO::readByteData(fp, MP3_FRAME_HEADER_SIZE, pFrameHeader))
+            {
+                break;
+            }
+            uint32 frameHeader = SwapFileToHostByteOrderInt32(pFrameHeader);
+            if (!GetMP3Header(frameHeader, mp3HeaderInfo) ||
+                    !DecodeMP3Header(mp3HeaderInfo, mp3ConfigInfo, false))
+            {
+                // not a frame (garbage the scan skipped), stay on the last one found
+                break;
+            }
+            offset = nextOffset;
+            indexedFrame = nextFrame;
+            if (indexedFrame == frameNumber)
+            {
+                break;
+            }
+            nextOffset = offset + mp3ConfigInfo.FrameLengthInBytes;
+            nextFrame++;
+        }
+    }
+
+    aSeekPoint = offset - StartOffset;
+    aTimestamp = GetTimestampForSample(indexedFrame);
+    iCurrFrameNumber = indexedFrame;
+    iTimestamp = aTimestamp;
+    return true;
+}
+
+/***********************************************************************
+ * FUNCTION:    GetSeekIndexFingerprint
+ * DESCRIPTION: Combines the frame count with the frame headers found at
+ *              the first, middle and last index entries, used to check
+ *              that a cached index belongs to the clip.
+ * INPUT/OUTPUT PARAMETERS: fpUsed, aFingerprint
+ * RETURN VALUE: true if the headers could be read
+ * SIDE EFFECTS: file position of fpUsed is preserved
+ ***********************************************************************/
+bool MP3Parser::GetSeekIndexFingerprint(PVFile * fpUsed, uint32 &aFingerprint)
+{
+    uint32 entryCount = iSeekIndex.GetEntryCount();
+    if (entryCount == 0)
+    {
+        return false;
+    }
+
+    uint32 entries[3] = {0, entryCount / 2, entryCount - 1};
+    uint32 fingerprint = iSeekIndex.GetFrameCount();
+    int32 filePosition = MP3Utils::getCurrentFilePosition(fpUsed);
+    bool success = true;
+
+    for (uint32 i = 0; i < 3 && success; i++)
+    {
+        uint32 offset = 0;
+        uint8 pFrameHeader[MP3_FRAME_HEADER_SIZE];
+        success = iSeekIndex.GetEntryOffset(entries[i], offset) &&
+                  (MP3_SUCCESS == MP3Utils::SeektoOffset(fpUsed, offset, Oscl_File::SEEKSET)) &&
+                  MP3FileIO::readByteData(fpUsed, MP3_FRAME_HEADER_SIZE, pFrameHeader);
+        if (success)
+        {
+            fingerprint = (fingerprint * 31) ^ offset;
+            fingerprint = (fingerprint * 31) ^ SwapFileToHostByteOrderInt32(pFrameHeader);
+        }
+    }
+
+    MP3Utils::SeektoOffset(fpUsed, filePosition, Oscl_File::SEEKSET);
+    aFingerprint = fingerprint;
+    return success;
+}
+
+/***********************************************************************
+ * FUNCTION:    SaveSeekIndex
+ * DESCRIPTION: Writes the seek index of a completely scanned clip to
+ *              aCacheFile
+ * INPUT/OUTPUT PARAMETERS: aCacheFile, fpUsed
+ * RETURN VALUE: error code
+ * SIDE EFFECTS:
+ ***********************************************************************/
+MP3ErrorType MP3Parser::SaveSeekIndex(Oscl_File &aCacheFile, PVFile * fpUsed)
+{
+    uint32 fingerprint = 0;
+    if (!iSeekIndex.IsComplete() || !iLocalFileSizeSet)
+    {
+        return MP3_ERROR_UNKNOWN;
+    }
+    if (!GetSeekIndexFingerprint(fpUsed, fingerprint))
+    {
+        return MP3_FILE_READ_ERR;
+    }
+    if (!iSeekIndex.Save(aCacheFile, iLocalFileSize, fingerprint))
+    {
+        return MP3_ERROR_UNKNOWN;
+    }
+    return MP3_SUCCESS;
+}
+
+/***********************************************************************
+ * FUNCTION:    LoadSeekIndex
+ * DESCRIPTION: Reads the seek index from aCacheFile and completes the
+ *              duration scan with it
+ * INPUT/OUTPUT PARAMETERS: aCacheFile, fpUsed
+ * RETURN VALUE: error code
+ * SIDE EFFECTS: the duration scan is marked complete on success
+ ***********************************************************************/
+MP3ErrorType MP3Parser::LoadSeekIndex(Oscl_File &aCacheFile, PVFile * fpUsed)
+{
+    // the index replaces our own TOC, so only before the scan started
+    if (iTOC == NULL || !iFirstScan || iScannedFrameCount > 0 || !iLocalFileSizeSet)
+    {
+        return MP3_ERROR_UNKNOWN;
+    }
 
+    uint32 cachedFingerprint = 0;
+    uint32 fingerprint = 0;
+    if (!iSeekIndex.Load(aCacheFile, iLocalFileSize, cachedFingerprint))
+    {
+        return MP3_ERROR_UNKNOWN;
+    }
+    if (!GetSeekIndexFingerprint(fpUsed, fingerprint) || fingerprint != cachedFingerprint)
+    {
+        // clip was modified after the index was saved
+        iSeekIndex.Reset();
+        return MP3_ERROR_UNKNOWN;
+    }
 
+    uint32 firstOffset = 0;
+    uint32 lastOffset = 0;
+    iSeekIndex.GetEntryOffset(0, firstOffset);
+    iSeekIndex.GetEntryOffset(iSeekIndex.GetEntryCount() - 1, lastOffset);
 
+    iScannedFrameCount = iSeekIndex.GetFrameCount();
+    iDurationScanComplete = true;
+    iClipDurationComputed = 0;
+    uint32 clipDuration = 0;
+    GetDurationFromCompleteScan(clipDuration);
+    if (clipDuration > 0 && lastOffset > firstOffset)
+    {
+        // average over the indexed frames, close enough for the bitrate
+        OsclFloat indexedDuration = (OsclFloat)clipDuration * (OsclFloat)(iSeekIndex.GetEntryCount() - 1) *
+                                    MP3_SEEK_INDEX_FRAME_INTERVAL / (OsclFloat)iScannedFrameCount;
+        if (indexedDuration > 0)
+        {
+            iAvgBitrateInbpsFromCompleteScan = (int32)((OsclFloat)(lastOffset - firstOffset) * 8000.00f / indexedDuration);
+        }
+    }
+    return MP3_SUCCESS;
+}
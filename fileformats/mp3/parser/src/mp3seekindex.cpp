@@ -0,0 +1,293 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*********************************************************************************/
+/*
+    The MP3SeekIndex Class stores the offset of every Nth frame of a clip as
+    the difference to the previous entry, 7 bits per byte with the top bit
+    set on all but the last byte. At 128 kbps an entry takes two bytes.
+*/
+/*********************************************************************************/
+
+#include "mp3seekindex.h"
+
+#ifndef OSCL_ERROR_H_INCLUDED
+#include "oscl_error.h"
+#endif
+
+#define MP3_SEEK_INDEX_READ_CHUNK 256
+
+static void WriteLE32(uint8 *aBuf, uint32 aValue)
+{
+    aBuf[0] = (uint8)(aValue);
+    aBuf[1] = (uint8)(aValue >> 8);
+    aBuf[2] = (uint8)(aValue >> 16);
+    aBuf[3] = (uint8)(aValue >> 24);
+}
+
+static uint32 ReadLE32(const uint8 *aBuf)
+{
+    return ((uint32)aBuf[0]) | ((uint32)aBuf[1] << 8) |
+           ((uint32)aBuf[2] << 16) | ((uint32)aBuf[3] << 24);
+}
+
+MP3SeekIndex::MP3SeekIndex()
+{
+    iFrameCount = 0;
+    iEntryCount = 0;
+    iLastOffset = 0;
+    iComplete = false;
+    iValid = true;
+}
+
+MP3SeekIndex::~MP3SeekIndex()
+{
+    iDeltas.clear();
+    iCheckpoints.clear();
+}
+
+void MP3SeekIndex::Reset()
+{
+    iDeltas.clear();
+    iCheckpoints.clear();
+    iFrameCount = 0;
+    iEntryCount = 0;
+    iLastOffset = 0;
+    iComplete = false;
+    iValid = true;
+}
+
+bool MP3SeekIndex::AddFrame(uint32 aFrameNumber, uint32 aFileOffset)
+{
+    if (!iValid || iComplete || aFrameNumber != iFrameCount)
+    {
+        return false;
+    }
+
+    if ((iFrameCount % MP3_SEEK_INDEX_FRAME_INTERVAL) == 0)
+    {
+        if (!PushEntry(aFileOffset))
+        {
+            // entries would no longer line up with the frames
+            iValid = false;
+            return false;
+        }
+    }
+    iFrameCount++;
+    return true;
+}
+
+bool MP3SeekIndex::PushEntry(uint32 aFileOffset)
+{
+    if (iEntryCount > 0 && aFileOffset <= iLastOffset)
+    {
+        return false;
+    }
+
+    uint8 bytes[5];
+    uint32 numBytes = 0;
+    uint32 delta = aFileOffset - iLastOffset;
+    do
+    {
+        bytes[numBytes] = (uint8)(delta & 0x7F);
+        delta >>= 7;
+        if (delta)
+        {
+            bytes[numBytes] |= 0x80;
+        }
+        numBytes++;
+    }
+    while (delta);
+
+    MP3SeekIndexCheckpoint checkpoint;
+    checkpoint.fileOffset = aFileOffset;
+    checkpoint.bytePos = iDeltas.size() + numBytes;
+    bool addCheckpoint = ((iEntryCount % MP3_SEEK_INDEX_CHECKPOINT_INTERVAL) == 0);
+
+    int32 leavecode = OsclErrNone;
+    for (uint32 i = 0; i < numBytes && leavecode == OsclErrNone; i++)
+    {
+        OSCL_TRY(leavecode, iDeltas.push_back(bytes[i]));
+    }
+    if (addCheckpoint && leavecode == OsclErrNone)
+    {
+        OSCL_TRY(leavecode, iCheckpoints.push_back(checkpoint));
+    }
+    if (leavecode != OsclErrNone)
+    {
+        return false;
+    }
+
+    iLastOffset = aFileOffset;
+    iEntryCount++;
+    return true;
+}
+
+bool MP3SeekIndex::GetEntryOffset(uint32 aEntry, uint32 &aFileOffset) const
+{
+    if (!iValid || aEntry >= iEntryCount)
+    {
+        return false;
+    }
+
+    uint32 checkpoint = aEntry / MP3_SEEK_INDEX_CHECKPOINT_INTERVAL;
+    uint32 offset = iCheckpoints[checkpoint].fileOffset;
+    uint32 pos = iCheckpoints[checkpoint].bytePos;
+
+    // at most MP3_SEEK_INDEX_CHECKPOINT_INTERVAL - 1 deltas to add
+    for (uint32 i = checkpoint * MP3_SEEK_INDEX_CHECKPOINT_INTERVAL; i < aEntry; i++)
+    {
+        uint32 delta = 0;
+        uint32 shift = 0;
+        uint8 byte;
+        do
+        {
+            byte = iDeltas[pos++];
+            delta |= (uint32)(byte & 0x7F) << shift;
+            shift += 7;
+        }
+        while (byte & 0x80);
+        offset += delta;
+    }
+
+    aFileOffset = offset;
+    return true;
+}
+
+bool MP3SeekIndex::GetSeekPoint(uint32 aFrameNumber, uint32 &aIndexedFrame, uint32 &aFileOffset) const
+{
+    if (!iValid || iEntryCount == 0)
+    {
+        return false;
+    }
+
+    // entries are evenly spaced in frames, so no search is needed
+    uint32 entry = aFrameNumber / MP3_SEEK_INDEX_FRAME_INTERVAL;
+    if (entry >= iEntryCount)
+    {
+        entry = iEntryCount - 1;
+    }
+
+    if (!GetEntryOffset(entry, aFileOffset))
+    {
+        return false;
+    }
+    aIndexedFrame = entry * MP3_SEEK_INDEX_FRAME_INTERVAL;
+    return true;
+}
+
+bool MP3SeekIndex::Save(Oscl_File &aFile, uint32 aFileSize, uint32 aFingerprint) const
+{
+    if (!IsComplete() || iEntryCount == 0)
+    {
+        return false;
+    }
+
+    uint8 header[MP3_SEEK_INDEX_CACHE_HEADER_SIZE];
+    WriteLE32(header, MP3_SEEK_INDEX_CACHE_MAGIC);
+    WriteLE32(header + 4, MP3_SEEK_INDEX_CACHE_VERSION);
+    WriteLE32(header + 8, aFileSize);
+    WriteLE32(header + 12, aFingerprint);
+    WriteLE32(header + 16, MP3_SEEK_INDEX_FRAME_INTERVAL);
+    WriteLE32(header + 20, iFrameCount);
+    WriteLE32(header + 24, iEntryCount);
+    WriteLE32(header + 28, iDeltas.size());
+
+    if (aFile.Write(header, 1, MP3_SEEK_INDEX_CACHE_HEADER_SIZE) != MP3_SEEK_INDEX_CACHE_HEADER_SIZE)
+    {
+        return false;
+    }
+    if (aFile.Write(&iDeltas[0], 1, iDeltas.size()) != iDeltas.size())
+    {
+        return false;
+    }
+    return (aFile.Flush() == 0);
+}
+
+bool MP3SeekIndex::Load(Oscl_File &aFile, uint32 aFileSize, uint32 &aFingerprint)
+{
+    Reset();
+
+    uint8 header[MP3_SEEK_INDEX_CACHE_HEADER_SIZE];
+    if (aFile.Read(header, 1, MP3_SEEK_INDEX_CACHE_HEADER_SIZE) != MP3_SEEK_INDEX_CACHE_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    uint32 frameCount = ReadLE32(header + 20);
+    uint32 entryCount = ReadLE32(header + 24);
+    uint32 deltaBytes = ReadLE32(header + 28);
+    if ((ReadLE32(header) != MP3_SEEK_INDEX_CACHE_MAGIC) ||
+            (ReadLE32(header + 4) != MP3_SEEK_INDEX_CACHE_VERSION) ||
+            (ReadLE32(header + 8) != aFileSize) ||
+            (ReadLE32(header + 16) != MP3_SEEK_INDEX_FRAME_INTERVAL) ||
+            (entryCount == 0) ||
+            (entryCount != (frameCount + MP3_SEEK_INDEX_FRAME_INTERVAL - 1) / MP3_SEEK_INDEX_FRAME_INTERVAL) ||
+            (deltaBytes < entryCount) || (deltaBytes > 5 * entryCount))
+    {
+        return false;
+    }
+    aFingerprint = ReadLE32(header + 12);
+
+    // decode the deltas and push them again, this rebuilds the checkpoints
+    // and rejects offsets that do not increase
+    uint8 chunk[MP3_SEEK_INDEX_READ_CHUNK];
+    uint32 offset = 0;
+    uint32 delta = 0;
+    uint32 shift = 0;
+    while (deltaBytes > 0)
+    {
+        uint32 bytesToRead = OSCL_MIN(deltaBytes, (uint32)MP3_SEEK_INDEX_READ_CHUNK);
+        if (aFile.Read(chunk, 1, bytesToRead) != bytesToRead)
+        {
+            Reset();
+            return false;
+        }
+        deltaBytes -= bytesToRead;
+
+        for (uint32 i = 0; i < bytesToRead; i++)
+        {
+            if (shift > 28)
+            {
+                Reset();
+                return false;
+            }
+            delta |= (uint32)(chunk[i] & 0x7F) << shift;
+            shift += 7;
+            if (!(chunk[i] & 0x80))
+            {
+                offset += delta;
+                if (iEntryCount == entryCount || !PushEntry(offset))
+                {
+                    Reset();
+                    return false;
+                }
+                delta = 0;
+                shift = 0;
+            }
+        }
+    }
+
+    if (iEntryCount != entryCount || shift != 0)
+    {
+        Reset();
+        return false;
+    }
+    iFrameCount = frameCount;
+    iComplete = true;
+    return true;
+}
@@ -270,7 +270,10 @@ typedef enum
 //b1 is set - Meta data is upfront, this implies temp files are needed while authoring
 //b2 - undefined
 //b3 is set - Do not use temp files while authoring
-//b4-b31 - Reserved for future use
+//b4 is set - First sample of each track is authored in a separate chunk
+//b5 is set - Movie fragments
+//b6 is set - Space is reserved for the meta data ahead of the media data
+//b7-b31 - Reserved for future use
 
 /**
  * This mode authors non Progressive Downloadable output files using temp files
@@ -306,6 +309,36 @@ typedef enum
 // 6th bit is now reserved movie fragment mode and last bit is reserved for interleaving
 #define PVMP4FF_MOVIE_FRAGMENT_MODE 0x00000021
 
+#define PVMP4FF_SET_META_DATA_RESERVE_MODE 0x00000040
+
+/**
+ * This mode authors 3GPP Progressive Downloadable output files in one pass:
+ * Meta Data is upfront, in space reserved ahead of the media data.
+ * Media Data is interleaved.
+ * No temp files are used.
+ * If the meta data outgrows the reserved space, the media data is moved
+ * back in one buffered pass to make room for it. If the output file can
+ * not be read back (a write only file handle), the meta data is written
+ * after the media data instead.
+ */
+#define PVMP4FF_3GPP_PROGRESSIVE_DOWNLOAD_DIRECT_MODE 0x0000004B
+
+// Expected duration used to size the reserved meta data space, unless set
+// with setMovieAtomReserveDuration()
+#define DEFAULT_MOVIE_ATOM_RESERVE_DURATION_IN_MS 600000
+
+// Estimated sample table size per second of each track type, used to size
+// the reserved meta data space: stsz, stts, stss and stsc entries for
+// 30 fps video, stsz and stts entries for 50 frames/s audio
+#define MOVIE_ATOM_RESERVE_VIDEO_BYTES_PER_SEC 400
+#define MOVIE_ATOM_RESERVE_AUDIO_BYTES_PER_SEC 300
+#define MOVIE_ATOM_RESERVE_TEXT_BYTES_PER_SEC  16
+// Bytes per chunk (stco and stsc entries)
+#define MOVIE_ATOM_RESERVE_BYTES_PER_CHUNK     16
+
+// Buffer used to move the media data when the reserved space is too small
+#define MEDIA_DATA_MOVE_BUFFER_SIZE 65536
+
 #define DEFAULT_MOVIE_FRAGMENT_DURATION_IN_MS 10000
 
 class PVMP4FFComposerAudioEncodeParams
@@ -103,6 +103,10 @@ class PVA_FF_IMpeg4File : public PVA_FF_ISucceedFail
         *                            that file is interleaved, meta data is after the media data in moov
         *                            and movie fragments.
         *
+        *                            SET_3GPP_PROGRESSIVE_DOWNLOAD_DIRECT_MODE - Authors 3GPP PD content
+        *                            without temp files. Media data is interleaved and written to the
+        *                            output file, after space reserved for the meta data.
+        *
         * @return PVA_FF_IMpeg4File*  Pointer to PVA_FF_IMpeg4File class. This is the interface
         *                             object, that the user of the library would use to invoke
         *                             the rest of the APIs, to control the authoring process.
@@ -137,6 +141,9 @@ class PVA_FF_IMpeg4File : public PVA_FF_ISucceedFail
          *                           SET_NO_TEMP_FILE_AUTHORING_MODE - Does not use any temp files.
          *                           Media data is interleaved and meta data is stored at the end
          *                           of the file.
+         *                           SET_3GPP_PROGRESSIVE_DOWNLOAD_DIRECT_MODE - Does not use any temp
+         *                           files. Media data is interleaved and meta data is stored upfront,
+         *                           in space reserved before the media data.
          *
          * @param outputFileHandle  file pointer. This argument contains the target MP4/3GP file pointer,
          *                          that would be the outcome of the authoring process. Note that the
@@ -347,6 +354,10 @@ class PVA_FF_IMpeg4File : public PVA_FF_ISucceedFail
         virtual void setMovieFragmentDuration(uint32 duration) = 0;
         virtual uint32 getMovieFragmentDuration() = 0;
 
+        // expected clip duration, sizes the space reserved for the meta data
+        // in PVMP4FF_3GPP_PROGRESSIVE_DOWNLOAD_DIRECT_MODE
+        virtual void setMovieAtomReserveDuration(uint32 duration) = 0;
+
         OSCL_IMPORT_REF static void DestroyMP4FileObject(PVA_FF_IMpeg4File* aMP4FileObject);
 };
 
@@ -275,7 +275,16 @@ class PVA_FF_Mpeg4File : public PVA_FF_IMpeg4File, public PVA_FF_Parentable
         bool renderMoovAtom();
         bool renderMovieFragments();
 
+        // expected duration, sizes the reserved meta data space
+        void setMovieAtomReserveDuration(uint32 duration)
+        {
+            _movieAtomReserveDuration = duration;
+        }
+
     private:
+        uint32 getMovieAtomReserveSize();
+        bool renderReservedMovieAtom(MP4_AUTHOR_FF_FILE_IO_WRAP *fp, uint32 movieAtomOffset);
+        bool moveMediaData(MP4_AUTHOR_FF_FILE_IO_WRAP *fp, uint32 start, uint32 end, uint32 shift);
 
         PVA_FF_UNICODE_HEAP_STRING _title;
         bool         _oSetTitleDone;
@@ -424,6 +433,10 @@ class PVA_FF_Mpeg4File : public PVA_FF_IMpeg4File, public PVA_FF_Parentable
         bool        _oFileOpenedOutsideAFFLib;
 
         bool        _oFirstSampleEditMode;
+
+        // Meta data reserve mode parameters
+        bool        _oMovieAtomReserved;        // moov is written in space reserved before the mdat
+        uint32      _movieAtomReserveDuration;  // expected duration in milliseconds
         uint32      iCacheSize;
         bool        _oIsFileOpen;
 };
@@ -267,16 +267,25 @@ PVA_FF_MediaDataAtom::prepareTargetFile(uint32 mediaStartOffset)
         {
             if (mediaStartOffset > 0)
             {
-                // Write zeros to accomodate the user data upfront
+                // Write zeros to accomodate the user data upfront, this may
+                // include the space reserved for the meta data so write it
+                // in pieces
+                uint32 bufferSize = OSCL_MIN(mediaStartOffset, (uint32)MEDIA_DATA_MOVE_BUFFER_SIZE);
                 uint8* tempBuffer = NULL;
-                PV_MP4_FF_ARRAY_NEW(NULL, uint8, mediaStartOffset, tempBuffer);
+                PV_MP4_FF_ARRAY_NEW(NULL, uint8, bufferSize, tempBuffer);
 
-                oscl_memset(tempBuffer, 0, mediaStartOffset);
+                oscl_memset(tempBuffer, 0, bufferSize);
 
-                if (!(PVA_FF_AtomUtils::renderByteData(&_pofstream, mediaStartOffset, tempBuffer)))
+                uint32 remaining = mediaStartOffset;
+                while (remaining > 0)
                 {
-                    PV_MP4_ARRAY_DELETE(NULL, tempBuffer);
-                    return false;
+                    uint32 length = OSCL_MIN(remaining, bufferSize);
+                    if (!(PVA_FF_AtomUtils::renderByteData(&_pofstream, length, tempBuffer)))
+                    {
+                        PV_MP4_ARRAY_DELETE(NULL, tempBuffer);
+                        return false;
+                    }
+                    remaining -= length;
                 }
                 PV_MP4_ARRAY_DELETE(NULL, tempBuffer);
             }
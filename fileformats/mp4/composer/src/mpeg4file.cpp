@@ -263,6 +263,9 @@ PVA_FF_Mpeg4File::init(int32 mediaType,
     _oIsFileOpen          = false;
     _oFirstSampleEditMode = false;
 
+    _oMovieAtomReserved       = false;
+    _movieAtomReserveDuration = DEFAULT_MOVIE_ATOM_RESERVE_DURATION_IN_MS;
+
     _fileAuthoringFlags = fileAuthoringFlags;
 
     if (fileAuthoringFlags & PVMP4FF_SET_MEDIA_INTERLEAVE_MODE)
@@ -310,6 +313,19 @@ PVA_FF_Mpeg4File::init(int32 mediaType,
         _oUserDataUpFront     = false;
     }
 
+    if (fileAuthoringFlags & PVMP4FF_SET_META_DATA_RESERVE_MODE)
+    {
+        /* Supported only if media data is written to the output file */
+        if ((!_totalTempFileRemoval) || (_oMovieFragmentEnabled))
+        {
+            return false;
+        }
+        _oMovieAtomReserved = true;
+        // The movie atom is rendered in the reserved space, not ahead
+        // of temp file media data
+        _oMovieAtomUpfront  = false;
+    }
+
     // Create user data atom
     PV_MP4_FF_NEW(fp->auditCB, PVA_FF_UserDataAtom, (), _puserDataAtom);
 
@@ -1356,6 +1372,18 @@ PVA_FF_Mpeg4File::renderToFileStream(MP4_AUTHOR_FF_FILE_IO_WRAP *fp)
 
     _pmovieAtom->prepareToRender();
 
+    if (_oMovieAtomReserved)
+    {
+        // The media data is already in place, render the movie atom
+        // in the space reserved before it
+        if (!renderReservedMovieAtom(fp, metaDataSize))
+        {
+            return false;
+        }
+        _tempFileIndex = 'a';
+        return true;
+    }
+
     if (_oMovieAtomUpfront)
     {
         metaDataSize += _pmovieAtom->getSize();
@@ -2483,6 +2511,11 @@ PVA_FF_Mpeg4File::prepareToEncode()
 
     _oFtypPopulated = true;
 
+    if (_oMovieAtomReserved)
+    {
+        _initialUserDataSize += getMovieAtomReserveSize();
+    }
+
     if (_oDirectRenderEnabled)
     {
         if ((_oSetTitleDone        == false) ||
@@ -2552,6 +2585,197 @@ PVA_FF_Mpeg4File::prepareToEncode()
     return true;
 }
 
+uint32
+PVA_FF_Mpeg4File::getMovieAtomReserveSize()
+{
+    // The headers and sample descriptions are in the movie atom already,
+    // estimate the sample tables from the expected duration
+    uint32 size = _pmovieAtom->getSize();
+    uint32 seconds = (_movieAtomReserveDuration + 999) / 1000;
+    uint32 chunksPerSecond = (1000 + _interLeaveDuration - 1) / _interLeaveDuration;
+
+    for (uint32 k = 0; k < _pmediaDataAtomVec->size(); k++)
+    {
+        Oscl_Vector<PVA_FF_TrackAtom*, OsclMemAllocator> *trefVec =
+            (*_pmediaDataAtomVec)[k]->getTrackReferencePtrVec();
+
+        if (trefVec != NULL)
+        {
+            for (uint32 trefVecIndex = 0;
+                    trefVecIndex < trefVec->size();
+                    trefVecIndex++)
+            {
+                uint32 mediaType = (*trefVec)[trefVecIndex]->getMediaType();
+                uint32 bytesPerSecond = chunksPerSecond * MOVIE_ATOM_RESERVE_BYTES_PER_CHUNK;
+
+                if (mediaType == MEDIA_TYPE_VISUAL)
+                {
+                    bytesPerSecond += MOVIE_ATOM_RESERVE_VIDEO_BYTES_PER_SEC;
+                }
+                else if (mediaType == MEDIA_TYPE_AUDIO)
+                {
+                    bytesPerSecond += MOVIE_ATOM_RESERVE_AUDIO_BYTES_PER_SEC;
+                }
+                else
+                {
+                    bytesPerSecond += MOVIE_ATOM_RESERVE_TEXT_BYTES_PER_SEC;
+                }
+                size += bytesPerSecond * seconds;
+            }
+        }
+    }
+
+    size += 1024; //Gaurd Band
+
+    return size;
+}
+
+bool
+PVA_FF_Mpeg4File::renderReservedMovieAtom(MP4_AUTHOR_FF_FILE_IO_WRAP *fp, uint32 movieAtomOffset)
+{
+    PVA_FF_MediaDataAtom *mdat = NULL;
+
+    for (uint32 k = 0; k < _pmediaDataAtomVec->size(); k++)
+    {
+        if ((*_pmediaDataAtomVec)[k]->IsTargetRender())
+        {
+            mdat = (*_pmediaDataAtomVec)[k];
+        }
+    }
+    if (mdat == NULL)
+    {
+        return false;
+    }
+
+    // closeTargetFile() has set the chunk start to the target file offset
+    uint32 chunkFileOffset = mdat->getFileOffsetForChunkStart();
+    uint32 mediaDataOffset = chunkFileOffset - DEFAULT_ATOM_SIZE;
+    if (mediaDataOffset < movieAtomOffset)
+    {
+        return false;
+    }
+
+    uint32 reservedSize  = mediaDataOffset - movieAtomOffset;
+    uint32 movieAtomSize = _pmovieAtom->getSize();
+    uint32 shift = 0;
+
+    if (movieAtomSize > reservedSize)
+    {
+        shift = movieAtomSize - reservedSize;
+    }
+    else if ((movieAtomSize < reservedSize) &&
+             (reservedSize - movieAtomSize < DEFAULT_ATOM_SIZE))
+    {
+        // No room for a free space atom after the movie atom
+        shift = movieAtomSize + DEFAULT_ATOM_SIZE - reservedSize;
+    }
+
+    // The rest of the reserved space becomes a free space atom
+    uint32 freeSpaceOffset = movieAtomOffset + movieAtomSize;
+    uint32 freeSpaceSize   = 0;
+
+    if (shift > 0)
+    {
+        uint32 mediaDataEnd = mediaDataOffset + mdat->getSize();
+        uint8 header[DEFAULT_ATOM_SIZE];
+
+        PVA_FF_AtomUtils::seekFromStart(fp, mediaDataOffset);
+        if (PVA_FF_AtomUtils::readByteData(fp, DEFAULT_ATOM_SIZE, header))
+        {
+            // The clip is longer than expected, move the media data back
+            // to make room for the movie atom
+            if (!moveMediaData(fp, mediaDataOffset, mediaDataEnd, shift))
+            {
+                _fileWriteFailed = true;
+                return false;
+            }
+            chunkFileOffset += shift;
+            freeSpaceSize    = reservedSize + shift - movieAtomSize;
+        }
+        else
+        {
+            // The target file can not be read back, e.g. a write only
+            // handle opened outside the library. Leave the media data in
+            // place and render the movie atom after it, as in
+            // PVMP4FF_3GPP_DOWNLOAD_MODE, the reserved space is all free
+            freeSpaceOffset = movieAtomOffset;
+            freeSpaceSize   = reservedSize;
+            movieAtomOffset = mediaDataEnd;
+        }
+    }
+    else if (reservedSize > movieAtomSize)
+    {
+        freeSpaceSize = reservedSize - movieAtomSize;
+    }
+
+    // Update all chunk offsets
+    Oscl_Vector<PVA_FF_TrackAtom*, OsclMemAllocator> *trefVec =
+        mdat->getTrackReferencePtrVec();
+
+    if (trefVec != NULL)
+    {
+        for (uint32 trefVecIndex = 0;
+                trefVecIndex < trefVec->size();
+                trefVecIndex++)
+        {
+            (*trefVec)[trefVecIndex]->updateAtomFileOffsets(chunkFileOffset);
+        }
+    }
+
+    // Render the movie atom to the file stream
+    PVA_FF_AtomUtils::seekFromStart(fp, movieAtomOffset);
+    if (!_pmovieAtom->renderToFileStream(fp))
+    {
+        return false;
+    }
+
+    if (freeSpaceSize > 0)
+    {
+        PVA_FF_AtomUtils::seekFromStart(fp, freeSpaceOffset);
+        if (!PVA_FF_AtomUtils::render32(fp, freeSpaceSize))
+        {
+            return false;
+        }
+        if (!PVA_FF_AtomUtils::render32(fp, FREE_SPACE_ATOM))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+PVA_FF_Mpeg4File::moveMediaData(MP4_AUTHOR_FF_FILE_IO_WRAP *fp,
+                                uint32 start,
+                                uint32 end,
+                                uint32 shift)
+{
+    uint8* buffer = NULL;
+    PV_MP4_FF_ARRAY_NEW(NULL, uint8, MEDIA_DATA_MOVE_BUFFER_SIZE, buffer);
+
+    // Copy from the end, so that no data is overwritten before it is read
+    bool status = true;
+    uint32 pos = end;
+
+    while (status && (pos > start))
+    {
+        uint32 length = OSCL_MIN(pos - start, (uint32)MEDIA_DATA_MOVE_BUFFER_SIZE);
+        pos -= length;
+
+        PVA_FF_AtomUtils::seekFromStart(fp, pos);
+        status = PVA_FF_AtomUtils::readByteData(fp, length, buffer);
+        if (status)
+        {
+            PVA_FF_AtomUtils::seekFromStart(fp, pos + shift);
+            status = PVA_FF_AtomUtils::renderByteData(fp, length, buffer);
+        }
+    }
+
+    PV_MP4_ARRAY_DELETE(NULL, buffer);
+    return status;
+}
+
 void
 PVA_FF_Mpeg4File::populateUserDataAtom()
 {
@@ -187,11 +187,15 @@ class IMpeg4File : public ISucceedFail
                 uint32 howManyKeySamples = 1) = 0;
 
         // Static method to read in an MP4 file from disk and return the IMpeg4File interface
+        // If aMemoryMapEnable is set, local files are memory-mapped when possible,
+        // and getNextBundledAccessUnits can return samples as mapped fragments
+        // (see GAU::mappedFrags).
         OSCL_IMPORT_REF static IMpeg4File *readMP4File(OSCL_wString& aFilename,
                 PVMFCPMPluginAccessInterfaceFactory* aCPMAccessFactory,
                 OsclFileHandle* aHandle = NULL,
                 uint32 aParsingMode = 0,
-                Oscl_FileServer* aFileServSession = NULL);
+                Oscl_FileServer* aFileServSession = NULL,
+                bool aMemoryMapEnable = false);
 
         OSCL_IMPORT_REF static void DestroyMP4FileObject(IMpeg4File* aMP4FileObject);
 
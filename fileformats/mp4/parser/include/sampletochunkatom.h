@@ -106,11 +106,34 @@ class SampleToChunkAtom : public FullAtom
 
         bool ParseEntryUnit(uint32 sample_cnt);
         void CheckAndParseEntry(uint32 i);
+        bool BuildWindowIndex(MP4_FF_FILE *fp);
+        uint32 findEntry(uint32 value, uint32 *keyVec, uint32 *windowKeyVec);
+        uint32 findRunForSample(uint32 sampleNum)
+        {
+            return findEntry(sampleNum, _pcumSampleVec, _pwindowSampleVec);
+        }
+        uint32 findRunForChunk(uint32 chunkNum)
+        {
+            return findEntry(chunkNum, _pfirstChunkVec, _pwindowChunkVec);
+        }
         uint32 _entryCount;
         uint32 *_pfirstChunkVec;
         uint32 *_psamplesPerChunkVec;
         uint32 *_psampleDescriptionIndexVec;
 
+        // Number of samples before the first chunk of each run, kept in the
+        // same buffer slots as the runs.  Used to find the run of a sample
+        // with a binary search instead of a linear walk of the table.
+        uint32 *_pcumSampleVec;
+
+        // For parsing mode 1, the number of samples and the first chunk at
+        // the start of each window of _stbl_buff_size runs.  This is used to
+        // locate the window of a run without parsing the windows before it.
+        uint32 _numWindows;
+        uint32 *_pwindowSampleVec;
+        uint32 *_pwindowChunkVec;
+        uint32 _firstChunkOffset;
+
         int32 _mediaType;
 
         uint32 _currentChunkNumSamples;
@@ -148,7 +171,6 @@ class SampleToChunkAtom : public FullAtom
         uint32 _stbl_buff_size;
         uint32 _curr_entry_point;
         uint32 _curr_buff_number;
-        uint32 _next_buff_number;
 
 
 
@@ -81,11 +81,29 @@ class TimeToSampleAtom : public FullAtom
     private:
         bool ParseEntryUnit(uint32 entry_cnt);
         void CheckAndParseEntry(uint32 i);
+        bool BuildWindowIndex(MP4_FF_FILE *fp);
+        uint32 findEntryForTimestamp(uint32 ts);
+        uint32 findEntryForSampleNumber(uint32 num);
         uint32 _entryCount;
 
         uint32 *_psampleCountVec;
         uint32 *_psampleDeltaVec;
 
+        // Running totals, i.e. the number of samples and the decoding time
+        // before each entry.  These are kept in the same buffer slots as the
+        // entries, so that lookups by sample number or by timestamp can do a
+        // binary search instead of a linear walk of the table.
+        uint32 *_pcumSampleVec;
+        uint64 *_pcumTimeVec;
+
+        // For parsing mode 1, the running totals at the start of each
+        // window of _stbl_buff_size entries, plus the totals for the whole
+        // table.  This is used to locate the window of an entry without
+        // parsing the windows before it.
+        uint32 _numWindows;
+        uint32 *_pwindowSampleVec;
+        uint64 *_pwindowTimeVec;
+
         uint32 _mediaType;
 
         // For visual samples
@@ -98,7 +116,6 @@ class TimeToSampleAtom : public FullAtom
         uint32 _stbl_buff_size;
         uint32 _curr_entry_point;
         uint32 _curr_buff_number;
-        uint32 _next_buff_number;
 
         uint32  _parsed_entry_cnt;
 
@@ -57,7 +57,8 @@ OSCL_EXPORT_REF  IMpeg4File *IMpeg4File::readMP4File(OSCL_wString& aFilename,
         PVMFCPMPluginAccessInterfaceFactory* aCPMAccessFactory,
         OsclFileHandle* aHandle,
         uint32 aParsingMode,
-        Oscl_FileServer* aFileServSession)
+        Oscl_FileServer* aFileServSession,
+        bool aMemoryMapEnable)
 {
     //optimized mode is not supported if multiple file ptrs are not allowed
     if (aParsingMode == 1)
@@ -74,6 +75,13 @@ OSCL_EXPORT_REF  IMpeg4File *IMpeg4File::readMP4File(OSCL_wString& aFilename,
     fp->_pvfile.SetCPM(aCPMAccessFactory);
     fp->_pvfile.SetFileHandle(aHandle);
 
+    if (aMemoryMapEnable)
+    {
+        PVFileCacheParams params;
+        params.iMemoryMapEnable = true;
+        fp->_pvfile.SetFileCacheParams(params);
+    }
+
     if (AtomUtils::OpenMP4File(aFilename,
                                Oscl_File::MODE_READ | Oscl_File::MODE_BINARY,
                                fp) != 0)
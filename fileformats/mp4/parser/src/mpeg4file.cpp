@@ -2465,6 +2465,14 @@ int32 Mpeg4File::getNextBundledAccessUnits(const uint32 trackID,
         return -1;
     }
 
+    pgau->numMappedFrags = 0;
+    if (_isMovieFragmentsPresent)
+    {
+        // samples from the movie fragments are always read into the
+        // GAU buffers, so don't mix in mapped fragments.
+        pgau->mappedFrags = NULL;
+    }
+
     if (_pmovieAtom != NULL)
     {
         int32 ret = _pmovieAtom->getNextBundledAccessUnits(trackID, n, pgau);
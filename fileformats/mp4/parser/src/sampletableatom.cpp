@@ -34,6 +34,7 @@
 #include "atomdefs.h"
 #include "oscl_media_data.h"
 #include "pv_gau.h"
+#include "oscl_refcounter_memfrag.h"
 #include "amrdecoderspecificinfo.h"
 #include "oscl_int64_utils.h"
 #if (PVLOGGER_INST_LEVEL > PVLOGMSG_INST_LLDBG)
@@ -106,6 +107,7 @@ SampleTableAtom::SampleTableAtom(MP4_FF_FILE *fp,
         _pinput = OSCL_PLACEMENT_NEW(ptr, MP4_FF_FILE());
         _pinput->_fileServSession = fp->_fileServSession;
         _pinput->_pvfile.SetCPM(fp->_pvfile.GetCPM());
+        _pinput->_pvfile.SetFileCacheParams(fp->_pvfile.GetFileCacheParams());
 
 #ifndef OPEN_FILE_ONCE_PER_TRACK
         ptr = oscl_malloc(sizeof(MP4_FF_FILE));
@@ -2358,6 +2360,8 @@ SampleTableAtom::getNextNSamples(uint32 startSampleNum,
 
     int32  _mp4ErrorCode = EVERYTHING_FINE;
 
+    pgau->numMappedFrags = 0;
+
     if (!_IsUpdateFileSize)
     {
         if (_pinput->IsOpen())
@@ -2727,6 +2731,11 @@ SampleTableAtom::getNextNSamples(uint32 startSampleNum,
 
             return (_mp4ErrorCode);
         }
+        // Return the samples as fragments of the memory-mapped file,
+        // if the caller asked for it, instead of reading them into the
+        // GAU buffers.
+        bool oZeroCopy = (pgau->mappedFrags != NULL) && _pinput->_pvfile.IsMemoryMapped();
+
         uint32 start = 0;
         uint32 rewindPos = 0;
         uint32 totalFragmentLength = 0;
@@ -2735,7 +2744,7 @@ SampleTableAtom::getNextNSamples(uint32 startSampleNum,
             totalFragmentLength += tempgauPtr->buf.fragments[k].len;
         }
 
-        if (totalFragmentLength < sigmaSampleSize)
+        if (!oZeroCopy && (totalFragmentLength < sigmaSampleSize))
         {
             //INSUFFICIENT BUFFER SIZE
             _currentPlaybackSampleNumber = startSampleNum;
@@ -2778,60 +2787,80 @@ SampleTableAtom::getNextNSamples(uint32 startSampleNum,
         currticks = OsclTickCount::TickCount();
         StartTime = OsclTickCount::TicksToMsec(currticks);
 #endif
-#ifdef OPEN_FILE_ONCE_PER_TRACK
-        if (_oPVContentDownloadable)
+        if (oZeroCopy)
         {
-            if (_currentPlaybackSampleNumber == 0)
+            uint32 sampleOffset = (uint32)sampleFileOffset;
+            for (i = s - numSamples; i < s; i++)
             {
-                AtomUtils::seekFromStart(_pinput, sampleFileOffset);
+                if (!_pinput->_pvfile.GetMappedFragment(sampleOffset, pgau->info[i].len, pgau->mappedFrags[i]))
+                {
+                    *n = 0;
+                    pgau->numMappedFrags = 0;
+                    _mp4ErrorCode =  READ_FAILED;
+                    return (_mp4ErrorCode);
+                }
+                sampleOffset += pgau->info[i].len;
             }
+            pgau->numMappedFrags = s;
+            totalBytesRead += sigmaSampleSize;
         }
         else
         {
-            AtomUtils::seekFromStart(_pinput, sampleFileOffset);
-        }
+#ifdef OPEN_FILE_ONCE_PER_TRACK
+            if (_oPVContentDownloadable)
+            {
+                if (_currentPlaybackSampleNumber == 0)
+                {
+                    AtomUtils::seekFromStart(_pinput, sampleFileOffset);
+                }
+            }
+            else
+            {
+                AtomUtils::seekFromStart(_pinput, sampleFileOffset);
+            }
 #else
-        AtomUtils::seekFromStart(_pinput, sampleFileOffset);
+            AtomUtils::seekFromStart(_pinput, sampleFileOffset);
 #endif
 #if (PVLOGGER_INST_LEVEL > PVLOGMSG_INST_LLDBG)
-        currticks = OsclTickCount::TickCount();
-        EndTime = OsclTickCount::TicksToMsec(currticks);
-        totalTimeFileSeek += (EndTime - StartTime);
+            currticks = OsclTickCount::TickCount();
+            EndTime = OsclTickCount::TicksToMsec(currticks);
+            totalTimeFileSeek += (EndTime - StartTime);
 
-        currticks = OsclTickCount::TickCount();
-        StartTime = OsclTickCount::TicksToMsec(currticks);
+            currticks = OsclTickCount::TickCount();
+            StartTime = OsclTickCount::TicksToMsec(currticks);
 #endif
-        start = 0;
-        rewindPos = 0;
-        for (k = start; k < end; k++)
-        {
-            uint32 tmpSize =
-                (tempgauPtr->buf.fragments[k].len > sigmaSampleSize) ? sigmaSampleSize : tempgauPtr->buf.fragments[k].len;
-            if (tmpSize)
+            start = 0;
+            rewindPos = 0;
+            for (k = start; k < end; k++)
             {
-                if (!AtomUtils::readByteData(_pinput, tmpSize,
-                                             (uint8 *)(tempgauPtr->buf.fragments[k].ptr)))
+                uint32 tmpSize =
+                    (tempgauPtr->buf.fragments[k].len > sigmaSampleSize) ? sigmaSampleSize : tempgauPtr->buf.fragments[k].len;
+                if (tmpSize)
                 {
-                    *n = 0;
-                    _mp4ErrorCode =  READ_FAILED;
-                    return (_mp4ErrorCode);
-                }
-                tempgauPtr->buf.fragments[k].len -= tmpSize;
+                    if (!AtomUtils::readByteData(_pinput, tmpSize,
+                                                 (uint8 *)(tempgauPtr->buf.fragments[k].ptr)))
+                    {
+                        *n = 0;
+                        _mp4ErrorCode =  READ_FAILED;
+                        return (_mp4ErrorCode);
+                    }
+                    tempgauPtr->buf.fragments[k].len -= tmpSize;
 
-                uint8* fragment_ptr = NULL;
-                fragment_ptr = (uint8 *)(tempgauPtr->buf.fragments[k].ptr);
-                fragment_ptr += tmpSize;
-                tempgauPtr->buf.fragments[k].ptr = fragment_ptr;
+                    uint8* fragment_ptr = NULL;
+                    fragment_ptr = (uint8 *)(tempgauPtr->buf.fragments[k].ptr);
+                    fragment_ptr += tmpSize;
+                    tempgauPtr->buf.fragments[k].ptr = fragment_ptr;
 
-                sigmaSampleSize -= tmpSize;
-                totalBytesRead += tmpSize;
+                    sigmaSampleSize -= tmpSize;
+                    totalBytesRead += tmpSize;
 
-            }
-            rewindPos += tmpSize;
+                }
+                rewindPos += tmpSize;
 
-            if (sigmaSampleSize == 0)
-            {
-                break;
+                if (sigmaSampleSize == 0)
+                {
+                    break;
+                }
             }
         }
 #if (PVLOGGER_INST_LEVEL > PVLOGMSG_INST_LLDBG)
@@ -2928,6 +2957,7 @@ SampleTableAtom::getNextNSamples(uint32 startSampleNum,
         }
 
         *n = 0;
+        pgau->numMappedFrags = 0;
         if (_mp4ErrorCode != INSUFFICIENT_BUFFER_SIZE)
         {
             _mp4ErrorCode = READ_FAILED;
@@ -43,6 +43,11 @@ SampleToChunkAtom::SampleToChunkAtom(MP4_FF_FILE *fp, uint32 size, uint32 type,
     _pfirstChunkVec = NULL;
     _psamplesPerChunkVec = NULL;
     _psampleDescriptionIndexVec = NULL;
+    _pcumSampleVec = NULL;
+    _numWindows = 0;
+    _pwindowSampleVec = NULL;
+    _pwindowChunkVec = NULL;
+    _firstChunkOffset = 0;
 
     _Index = 0;
     _numChunksInRun = 0;
@@ -66,7 +71,6 @@ SampleToChunkAtom::SampleToChunkAtom(MP4_FF_FILE *fp, uint32 size, uint32 type,
     _fileptr = NULL;
 
     _stbl_buff_size = MAX_CACHED_TABLE_ENTRIES_FILE;
-    _next_buff_number = 0;
     _curr_buff_number = 0;
     _curr_entry_point = 0;
     _stbl_fptr_vec = NULL;
@@ -137,6 +141,21 @@ SampleToChunkAtom::SampleToChunkAtom(MP4_FF_FILE *fp, uint32 size, uint32 type,
                             _mp4ErrorCode = MEMORY_ALLOCATION_FAILED;
                             return;
                         }
+                        PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_stbl_buff_size), _pcumSampleVec);
+                        if (_pcumSampleVec == NULL)
+                        {
+                            _success = false;
+                            _mp4ErrorCode = MEMORY_ALLOCATION_FAILED;
+                            return;
+                        }
+                        PV_MP4_FF_ARRAY_NEW(NULL, uint32, (fptrBuffSize), _pwindowSampleVec);
+                        PV_MP4_FF_ARRAY_NEW(NULL, uint32, (fptrBuffSize), _pwindowChunkVec);
+                        if ((_pwindowSampleVec == NULL) || (_pwindowChunkVec == NULL))
+                        {
+                            _success = false;
+                            _mp4ErrorCode = MEMORY_ALLOCATION_FAILED;
+                            return;
+                        }
 
                         {
                             OsclAny* ptr = (MP4_FF_FILE *)(oscl_malloc(sizeof(MP4_FF_FILE)));
@@ -160,7 +179,18 @@ SampleToChunkAtom::SampleToChunkAtom(MP4_FF_FILE *fp, uint32 size, uint32 type,
                             _fileptr->_fileSize = fp->_fileSize;
                         }
                         int32 _head_offset = AtomUtils::getCurrentFilePosition(fp);
-                        AtomUtils::seekFromCurrPos(fp, dataSize);
+
+                        // One pass over the table to find where each window
+                        // starts.  The runs themselves are parsed on demand,
+                        // one window at a time.
+                        uint32 tableSize = _entryCount * entrySize;
+                        if (!BuildWindowIndex(fp))
+                        {
+                            _success = false;
+                            _mp4ErrorCode = READ_SAMPLE_TO_CHUNK_ATOM_FAILED;
+                            return;
+                        }
+                        AtomUtils::seekFromCurrPos(fp, dataSize - tableSize);
                         AtomUtils::seekFromStart(_fileptr, _head_offset);
 
                         return;
@@ -180,6 +210,16 @@ SampleToChunkAtom::SampleToChunkAtom(MP4_FF_FILE *fp, uint32 size, uint32 type,
                 PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_entryCount), _pfirstChunkVec);
                 PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_entryCount), _psamplesPerChunkVec);
                 PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_entryCount), _psampleDescriptionIndexVec);
+                PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_entryCount), _pcumSampleVec);
+                if ((_pfirstChunkVec == NULL) ||
+                        (_psamplesPerChunkVec == NULL) ||
+                        (_psampleDescriptionIndexVec == NULL) ||
+                        (_pcumSampleVec == NULL))
+                {
+                    _success = false;
+                    _mp4ErrorCode = MEMORY_ALLOCATION_FAILED;
+                    return;
+                }
 
                 uint32 firstChunk;
                 uint32 samplesPerChunk;
@@ -222,6 +262,17 @@ SampleToChunkAtom::SampleToChunkAtom(MP4_FF_FILE *fp, uint32 size, uint32 type,
                     }
                 }
                 _entryCount = j;
+
+                uint32 cumSamples = 0;
+                for (j = 0; j < _entryCount; j++)
+                {
+                    if (j > 0)
+                    {
+                        cumSamples += _psamplesPerChunkVec[j-1] * (_pfirstChunkVec[j] - _pfirstChunkVec[j-1]);
+                    }
+                    _pcumSampleVec[j] = cumSamples;
+                }
+
                 uint32 firstsamplenum = 0;
                 resetStateVariables(firstsamplenum);
             }
@@ -248,12 +299,67 @@ SampleToChunkAtom::SampleToChunkAtom(MP4_FF_FILE *fp, uint32 size, uint32 type,
         }
     }
 }
-bool SampleToChunkAtom::ParseEntryUnit(uint32 sample_cnt)
+bool SampleToChunkAtom::BuildWindowIndex(MP4_FF_FILE *fp)
 {
-
+    // Runs that do not start after the previous run are dropped, the same
+    // as for a table that is parsed in full, so the windows are made up of
+    // the runs that are kept.
+    uint32 entrySize = (4 + 4 + 4);
+    uint32 filePos = AtomUtils::getCurrentFilePosition(fp);
     uint32 prevFirstChunk = 0;
+    uint32 prevSamplesPerChunk = 0;
+    uint32 cumSamples = 0;
+    uint32 j = 0;
 
+    for (uint32 i = 0; i < _entryCount; i++)
+    {
+        uint32 firstChunk;
+        uint32 samplesPerChunk;
+        uint32 sampleDescrIndex;
 
+        if (!AtomUtils::read32(fp, firstChunk))
+        {
+            return false;
+        }
+        if (!AtomUtils::read32(fp, samplesPerChunk))
+        {
+            return false;
+        }
+        if (!AtomUtils::read32(fp, sampleDescrIndex))
+        {
+            return false;
+        }
+
+        if (i == 0)
+            _firstChunkOffset = firstChunk;
+
+        if (firstChunk > prevFirstChunk)
+        {
+            if (j > 0)
+            {
+                cumSamples += prevSamplesPerChunk * (firstChunk - prevFirstChunk);
+            }
+            if ((j % _stbl_buff_size) == 0)
+            {
+                uint32 window = j / _stbl_buff_size;
+                _stbl_fptr_vec[window] = filePos;
+                _pwindowSampleVec[window] = cumSamples;
+                _pwindowChunkVec[window] = firstChunk - _firstChunkOffset;
+            }
+            prevFirstChunk = firstChunk;
+            prevSamplesPerChunk = samplesPerChunk;
+            j++;
+        }
+        filePos += entrySize;
+    }
+
+    _entryCount = j;
+    _numWindows = (_entryCount + _stbl_buff_size - 1) / _stbl_buff_size;
+    return true;
+}
+
+bool SampleToChunkAtom::ParseEntryUnit(uint32 sample_cnt)
+{
     const uint32 threshold = 512;
     sample_cnt += threshold;
 
@@ -264,12 +370,6 @@ bool SampleToChunkAtom::ParseEntryUnit(uint32 sample_cnt)
     {
         _curr_entry_point = _parsed_entry_cnt % _stbl_buff_size;
         _curr_buff_number = _parsed_entry_cnt / _stbl_buff_size;
-        if (_curr_buff_number  == _next_buff_number)
-        {
-            uint32 currFilePointer = AtomUtils::getCurrentFilePosition(_fileptr);
-            _stbl_fptr_vec[_curr_buff_number] = currFilePointer;
-            _next_buff_number++;
-        }
 
         if (!_curr_entry_point)
         {
@@ -285,10 +385,6 @@ bool SampleToChunkAtom::ParseEntryUnit(uint32 sample_cnt)
             _success = false;
             break;
         }
-        uint32 offSet = 1;
-        if (_parsed_entry_cnt == 0)
-            offSet = firstChunk;
-
         if (!AtomUtils::read32(_fileptr, samplesPerChunk))
         {
             _success = false;
@@ -299,14 +395,28 @@ bool SampleToChunkAtom::ParseEntryUnit(uint32 sample_cnt)
             _success = false;
             break;
         }
-        if (firstChunk > prevFirstChunk)
+
+        // Each window starts with a run that is kept.  Within the window,
+        // skip the runs that BuildWindowIndex dropped.
+        if (_curr_entry_point)
         {
-            _pfirstChunkVec[_curr_entry_point] = (firstChunk - offSet);
-            _psamplesPerChunkVec[_curr_entry_point] = (samplesPerChunk);
-            _psampleDescriptionIndexVec[_curr_entry_point] = (sampleDescrIndex);
-            _parsed_entry_cnt++;
-            prevFirstChunk = firstChunk;
+            uint32 prev = _curr_entry_point - 1;
+            if (firstChunk <= (_pfirstChunkVec[prev] + _firstChunkOffset))
+            {
+                continue;
+            }
+            _pfirstChunkVec[_curr_entry_point] = (firstChunk - _firstChunkOffset);
+            _pcumSampleVec[_curr_entry_point] = _pcumSampleVec[prev] +
+                                                _psamplesPerChunkVec[prev] * (_pfirstChunkVec[_curr_entry_point] - _pfirstChunkVec[prev]);
+        }
+        else
+        {
+            _pfirstChunkVec[_curr_entry_point] = (firstChunk - _firstChunkOffset);
+            _pcumSampleVec[_curr_entry_point] = _pwindowSampleVec[_curr_buff_number];
         }
+        _psamplesPerChunkVec[_curr_entry_point] = (samplesPerChunk);
+        _psampleDescriptionIndexVec[_curr_entry_point] = (sampleDescrIndex);
+        _parsed_entry_cnt++;
     }
     return true;
 }
@@ -325,6 +435,18 @@ SampleToChunkAtom::~SampleToChunkAtom()
     {
         PV_MP4_ARRAY_DELETE(NULL, _psampleDescriptionIndexVec);
     }
+    if (_pcumSampleVec != NULL)
+    {
+        PV_MP4_ARRAY_DELETE(NULL, _pcumSampleVec);
+    }
+    if (_pwindowSampleVec != NULL)
+    {
+        PV_MP4_ARRAY_DELETE(NULL, _pwindowSampleVec);
+    }
+    if (_pwindowChunkVec != NULL)
+    {
+        PV_MP4_ARRAY_DELETE(NULL, _pwindowChunkVec);
+    }
     if (_fileptr != NULL)
     {
         if (_fileptr->IsOpen())
@@ -532,81 +654,82 @@ SampleToChunkAtom::getChunkNumberForSampleGet(uint32 sampleNum)
     return (uint32)PV_ERROR; // Should never get here
 }
 
-// Returns the chunk number for the given sample number
+// Returns the last run whose key (the first sample or the first chunk of the
+// run) is not greater than value.  Both keys start at 0 for the first run and
+// never decrease, so this is a binary search.  _entryCount must not be 0.
 uint32
-SampleToChunkAtom::getChunkNumberForSample(uint32 sampleNum)
+SampleToChunkAtom::findEntry(uint32 value, uint32 *keyVec, uint32 *windowKeyVec)
 {
-    if ((_pfirstChunkVec == NULL) ||
-            (_psamplesPerChunkVec == NULL))
+    uint32 lo = 0;
+    uint32 hi = _entryCount;
+
+    if (_parsing_mode == 1)
     {
-        return (uint32)PV_ERROR;
+        // find the first window that starts after value.  The run is in the
+        // window before it.
+        uint32 wlo = 1;
+        uint32 whi = _numWindows;
+        while (wlo < whi)
+        {
+            uint32 mid = wlo + ((whi - wlo) >> 1);
+            if (windowKeyVec[mid] <= value)
+                wlo = mid + 1;
+            else
+                whi = mid;
+        }
+        lo = (wlo - 1) * _stbl_buff_size;
+        if ((wlo * _stbl_buff_size) < hi)
+            hi = wlo * _stbl_buff_size;
     }
 
-    uint32 sampleCount = 0;
-
-    for (uint32 i = 0; i < _entryCount; i++)
+    // find the first run after value, then step back one.
+    lo++;
+    while (lo < hi)
     {
-        uint32 chunkNum = 0;
-        uint32 samplesPerChunkInRun = 0;
-
+        uint32 mid = lo + ((hi - lo) >> 1);
         if (_parsing_mode == 1)
         {
-            CheckAndParseEntry(i);
+            CheckAndParseEntry(mid);
         }
-        chunkNum = _pfirstChunkVec[i%_stbl_buff_size];
-        samplesPerChunkInRun = _psamplesPerChunkVec[i%_stbl_buff_size];
 
-        if ((i + 1) < _entryCount)
-        {
-            if (_parsing_mode == 1)
-            {
-                CheckAndParseEntry(i + 1);
-            }
+        if (keyVec[mid%_stbl_buff_size] <= value)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return (lo - 1);
+}
+
+// Returns the chunk number for the given sample number
+uint32
+SampleToChunkAtom::getChunkNumberForSample(uint32 sampleNum)
+{
+    if ((_pfirstChunkVec == NULL) ||
+            (_psamplesPerChunkVec == NULL) ||
+            (_entryCount == 0))
+    {
+        return (uint32)PV_ERROR;
+    }
 
-            uint32 nextChunkNum = _pfirstChunkVec[(int32)((i+1)%_stbl_buff_size)];
-            uint32 numChunksInRun = nextChunkNum - chunkNum;
-            uint32 count = sampleCount + samplesPerChunkInRun * numChunksInRun;
+    // Find run of chunks in which sample lies - now find actual chunk
+    uint32 i = findRunForSample(sampleNum);
+    if (_parsing_mode == 1)
+    {
+        CheckAndParseEntry(i);
+    }
 
-            if (count < sampleNum)
-            { // Haven't found chunk yet - running count still less than sampleNum
-                sampleCount = count;
-                continue;
-            }
-            else
-            { // Found run of chunks in which sample lies - now find actual chunk
-                for (int32 j = 0; j < (int32)numChunksInRun; j++)
-                {
-                    sampleCount += samplesPerChunkInRun; //  samples for jth chunk
-                    if (sampleNum < sampleCount)
-                    { // Found specific chunk
-                        _Index = i;
-                        return chunkNum + j; // Return jth chunk in run
-                    }
-                }
-            }
-        }
-        else
-        { // Last run of chunks - simply find specific chunk
-            int k = 0;
-            while (sampleNum >= sampleCount)
-            {
-                // Continue until find chunk number - we do not know how many chunks are in
-                // this final run so keep going til we find a number
-                sampleCount += samplesPerChunkInRun;
-                if (sampleNum < sampleCount)
-                {
-                    // Found specific chunk
-                    _Index = i;
-                    return chunkNum + k; // Return ith chunk in run
-                    // Since we do not actually know how many chunk are in this last run,
-                    // the chunkNum that is returned may not be a valid chunk!
-                    // This is handled in the exception handling in the chunkOffset atom
-                }
-                k++;
-            }
-        }
+    uint32 index = i % _stbl_buff_size;
+    uint32 samplesPerChunkInRun = _psamplesPerChunkVec[index];
+    if (samplesPerChunkInRun == 0)
+    {
+        return (uint32)PV_ERROR;
     }
-    return (uint32)PV_ERROR; // Should never get here
+
+    _Index = i;
+    // Since we do not actually know how many chunk are in the last run,
+    // the chunkNum that is returned for it may not be a valid chunk!
+    // This is handled in the exception handling in the chunkOffset atom
+    return _pfirstChunkVec[index] + ((sampleNum - _pcumSampleVec[index]) / samplesPerChunkInRun);
 }
 
 
@@ -624,85 +747,22 @@ SampleToChunkAtom::getFirstSampleNumInChunk(uint32 chunkNum)
         return (uint32)PV_ERROR;
     }
 
-    uint32 firstChunkCurrentRun = 0; // chunk number of first chunk in this run
-    uint32 firstChunkNextRun = 0; // chunk number of first chunk in next run
-    uint32 firstSample = 0; // number of first sample in the run of chunks in which chunk 'chunkNum' lies
-    // once we find the correct run, this value holds the sample number of the first
-    // sample in chunk 'chunkNum'
-    uint32 samplesInRun = 0;    // Number of samples in the entire run of chunks (not just in each chunk)
-
-    for (uint32 i = 0; i < _entryCount; i++)
+    if (_entryCount == 0)
     {
-        // Go through vector of first chunks in runs
-
-        if (_parsing_mode == 1)
-        {
-            CheckAndParseEntry(i);
-        }
-
-        firstChunkCurrentRun = _pfirstChunkVec[i%_stbl_buff_size]; // Get first chunk number for run i
-
-        if (chunkNum < firstChunkCurrentRun)
-        {
-            // Chunk is in previous run of chunks
-            firstSample -= samplesInRun; // Backtrack to first sample of last run
-
-            // Now need to find specific chunk and sample in this run
-            if (_parsing_mode == 1)
-            {
-                CheckAndParseEntry(i - 1);
-            }
-
-            firstChunkCurrentRun = _pfirstChunkVec[(int32)((i-1)%_stbl_buff_size)];  // Backtrack to  last run
-            uint32 samplesPerChunk = _psamplesPerChunkVec[(int32)((i-1)%_stbl_buff_size)];
-
-            uint32 chunkOffset = chunkNum - firstChunkCurrentRun; // Offset from firstChunk
-            uint32 sampleOffset = chunkOffset * samplesPerChunk;
-            firstSample += sampleOffset;
-
-            return firstSample;
-        }
-        else if (chunkNum == firstChunkCurrentRun)
-        {
-            // Requested chunk is first in this run
-            return firstSample; // Return first sample in this run
-        }
-        else
-        {
-            // Haven't found chunk in run
-
-            if ((i + 1) < _entryCount)
-            {
-                if (_parsing_mode == 1)
-                {
-                    CheckAndParseEntry(i + 1);
-                }
-
-                firstChunkNextRun = _pfirstChunkVec[(int32)(((i+1)%_stbl_buff_size))];  // If we are out of range of the vector
-                // This means we are in the last run of chunks
-                int32 numChunks = firstChunkNextRun - firstChunkCurrentRun;
-                samplesInRun = _psamplesPerChunkVec[i%_stbl_buff_size] * numChunks; // Once you advance, this value maintains the
-                // number of samples in the previous run
-                firstSample += samplesInRun;
-            }
-            else
-            {
-                // In last run of chunks - we know the chunk is here
-                // Now need to find specific chunk and sample
-
-                firstChunkCurrentRun = _pfirstChunkVec[i%_stbl_buff_size]; // Get first chunk number for this run
-                uint32 samplesPerChunk = _psamplesPerChunkVec[i%_stbl_buff_size];
-
-                uint32 chunkOffset = chunkNum - firstChunkCurrentRun; // Offset from firstChunk
-                uint32 sampleOffset = chunkOffset * samplesPerChunk;
-                firstSample += sampleOffset;
+        return 0; // Error condition
+    }
 
-                return firstSample;
-            }
-        }
+    // Find the run of chunks in which chunk 'chunkNum' lies
+    uint32 i = findRunForChunk(chunkNum);
+    if (_parsing_mode == 1)
+    {
+        CheckAndParseEntry(i);
     }
 
-    return 0; // Error condition
+    uint32 index = i % _stbl_buff_size;
+    uint32 chunkOffset = chunkNum - _pfirstChunkVec[index]; // Offset from firstChunk
+    uint32 sampleOffset = chunkOffset * _psamplesPerChunkVec[index];
+    return (_pcumSampleVec[index] + sampleOffset);
 }
 
 uint32
@@ -715,115 +775,41 @@ SampleToChunkAtom::getNumChunksInRunofChunks(uint32 chunk)
 
     if ((chunk + 1) < _entryCount)
     {
-        for (uint32 i = 0; i < _entryCount; i++)
+        // The first chunk numbers go up by at least one per run, so the run
+        // after the one that holds 'chunk' always exists here.
+        uint32 i = findRunForChunk(chunk) + 1;
+        if (_parsing_mode == 1)
         {
-            if (_parsing_mode == 1)
-            {
-                CheckAndParseEntry(i);
-            }
-
-            if (_pfirstChunkVec[i%_stbl_buff_size] < chunk)
-            {
-                continue;
-            }
-            else if (_pfirstChunkVec[i%_stbl_buff_size] == chunk)
-            {
-                uint32 chunkNum = _pfirstChunkVec[(int32)(i%_stbl_buff_size)];
-                if (_parsing_mode == 1)
-                {
-                    CheckAndParseEntry(i + 1);
-                }
-                uint32 nextChunkNum = _pfirstChunkVec[(int32)((i+1)%_stbl_buff_size)];
-                return(nextChunkNum - chunkNum);
-            }
-            else if (_pfirstChunkVec[(i%_stbl_buff_size)] > chunk)
-            {
-                return(_pfirstChunkVec[(i%_stbl_buff_size)] - chunk);
-            }
+            CheckAndParseEntry(i);
         }
+        return (_pfirstChunkVec[i%_stbl_buff_size] - chunk);
     }
     else
     {
         return (1);
     }
-
-    return (uint32)PV_ERROR;
 }
 
 uint32
 SampleToChunkAtom::getSamplesPerChunkCorrespondingToSample(uint32 sampleNum)
 {
-    uint32 sampleCount = 0;
-
     if ((_pfirstChunkVec == NULL) ||
             (_psamplesPerChunkVec == NULL))
     {
         return (uint32)PV_ERROR;
     }
 
-    for (uint32 i = 0; i < _entryCount; i++)
+    if (_entryCount == 0)
     {
-        if (_parsing_mode == 1)
-        {
-            CheckAndParseEntry(i);
-        }
-
-        uint32 chunkNum = 0;
-        uint32 samplesPerChunkInRun = 0;
-
-        chunkNum = _pfirstChunkVec[(i%_stbl_buff_size)];
-        samplesPerChunkInRun = _psamplesPerChunkVec[(i%_stbl_buff_size)];
-
-        if ((i + 1) < _entryCount)
-        {
-            if (_parsing_mode == 1)
-            {
-                CheckAndParseEntry(i + 1);
-            }
-
-            uint32 nextChunkNum = _pfirstChunkVec[(int32)(((i+1)%_stbl_buff_size))];
-            uint32 numChunksInRun = nextChunkNum - chunkNum;
-            uint32 count = sampleCount + samplesPerChunkInRun * numChunksInRun;
+        return 0; // Should never get here
+    }
 
-            if (count < sampleNum)
-            { // Haven't found chunk yet - running count still less than sampleNum
-                sampleCount = count;
-                continue;
-            }
-            else
-            { // Found run of chunks in which sample lies - now find actual chunk
-                for (int32 j = 0; j < (int32)numChunksInRun; j++)
-                {
-                    sampleCount += samplesPerChunkInRun; //  samples for jth chunk
-                    if (sampleNum < sampleCount)
-                    { // Found specific chunk
-                        return (samplesPerChunkInRun);
-                    }
-                }
-            }
-        }
-        else
-        {
-            // Last run of chunks - simply find specific chunk
-            int k = 0;
-            int for_ever = 1;
-            while (for_ever)
-            {
-                // Continue until find chunk number - we do not know how many chunks are in
-                // this final run so keep going til we find a number
-                sampleCount += samplesPerChunkInRun;
-                if (sampleNum < sampleCount)
-                { // Found specific chunk
-                    return (samplesPerChunkInRun);
-                    // Since we do not actually know how many chunk are in this last run,
-                    // the chunkNum that is returned may not be a valid chunk!
-                    // This is handled in the exception handling in the chunkOffset atom
-                }
-                k++;
-            }
-        }
+    uint32 i = findRunForSample(sampleNum);
+    if (_parsing_mode == 1)
+    {
+        CheckAndParseEntry(i);
     }
-    return 0; // Should never get here
+    return (_psamplesPerChunkVec[i%_stbl_buff_size]);
 }
 
 
@@ -1093,121 +1079,76 @@ SampleToChunkAtom::resetStateVariables(uint32 sampleNum)
         return PV_ERROR;
     }
 
-    uint32 sampleCount = 0;
+    if (_entryCount == 0)
+    {
+        return PV_ERROR;
+    }
 
-    for (uint32 i = 0; i < _entryCount; i++)
+    // Find run of chunks in which sample lies - now find actual chunk
+    uint32 i = findRunForSample(sampleNum);
+    if (_parsing_mode == 1)
     {
-        uint32 chunkNum = 0;
-        uint32 samplesPerChunkInRun = 0;
+        CheckAndParseEntry(i);
+    }
 
+    uint32 index = i % _stbl_buff_size;
+    uint32 chunkNum = _pfirstChunkVec[index];
+    uint32 samplesPerChunkInRun = _psamplesPerChunkVec[index];
+    uint32 sampleDescrIndex = _psampleDescriptionIndexVec[index];
+    if (samplesPerChunkInRun == 0)
+    {
+        return PV_ERROR;
+    }
+    uint32 j = (sampleNum - _pcumSampleVec[index]) / samplesPerChunkInRun;
+
+    if ((i + 1) < _entryCount)
+    {
         if (_parsing_mode == 1)
         {
             CheckAndParseEntry(i + 1);
         }
-
-        chunkNum = _pfirstChunkVec[i%_stbl_buff_size];
-        samplesPerChunkInRun = _psamplesPerChunkVec[i%_stbl_buff_size];
-
-        if ((i + 1) < _entryCount)
-        {
-            uint32 nextChunkNum = _pfirstChunkVec[(int32)(i+1)%_stbl_buff_size];
-            uint32 numChunksInRun = nextChunkNum - chunkNum;
-            uint32 count = sampleCount + samplesPerChunkInRun * numChunksInRun;
-
-            if (count < sampleNum)
-            {
-                // Haven't found chunk yet - running count still less than sampleNum
-                sampleCount = count;
-                continue;
-            }
-            else
-            {
-                _numGetChunksInRun = numChunksInRun;
-
-                // Found run of chunks in which sample lies - now find actual chunk
-                for (int32 j = 0; j < (int32)numChunksInRun; j++)
-                {
-                    //  samples for jth chunk
-                    _firstGetSampleInCurrChunk = sampleCount;
-                    _numGetSamplesPerChunk = samplesPerChunkInRun;
-                    sampleCount += samplesPerChunkInRun;
-
-                    if (sampleNum < sampleCount)
-                    {
-                        _majorGetIndex = i;
-                        _numChunksInRun = numChunksInRun;
-                        _currGetSampleCount = sampleCount;
-                        _currGetChunk =  chunkNum + j;
-                        _currGetSDI =
-                            _psampleDescriptionIndexVec[_majorGetIndex%_stbl_buff_size];
-
-                        goto END_OF_RESET;
-                    }
-                    _numGetChunksInRun--;
-                }
-            }
-        }
-        else
-        {
-            // Last run of chunks - simply find specific chunk
-            int k = 0;
-            while (sampleNum >= sampleCount)
-            {
-                // Continue until find chunk number - we do not know how many chunks are in
-                // this final run so keep going til we find a number
-                _firstGetSampleInCurrChunk = sampleCount;
-                _numGetSamplesPerChunk = samplesPerChunkInRun;
-
-                sampleCount += samplesPerChunkInRun;
-
-                if (sampleNum < sampleCount)
-                {
-                    // Found specific chunk
-                    _majorGetIndex = i;
-                    _numGetChunksInRun = 1;
-                    _numChunksInRun = _numGetChunksInRun;
-                    _currGetSampleCount = sampleCount;
-                    _currGetChunk =  chunkNum + k;
-                    _currGetSDI =
-                        _psampleDescriptionIndexVec[_majorGetIndex%_stbl_buff_size];
-
-                    goto END_OF_RESET;
-                    // Return ith chunk in run
-                    // Since we do not actually know how many chunk are in this last run,
-                    // the chunkNum that is returned may not be a valid chunk!
-                    // This is handled in the exception handling in the chunkOffset atom
-                }
-                k++;
-            }
-        }
+        uint32 nextChunkNum = _pfirstChunkVec[(i+1)%_stbl_buff_size];
+        _numChunksInRun = nextChunkNum - chunkNum;
+        _numGetChunksInRun = _numChunksInRun - j;
+    }
+    else
+    {
+        // Last run of chunks
+        // Since we do not actually know how many chunk are in this last run,
+        // the chunkNum that is found may not be a valid chunk!
+        // This is handled in the exception handling in the chunkOffset atom
+        _numGetChunksInRun = 1;
+        _numChunksInRun = _numGetChunksInRun;
     }
 
-    return PV_ERROR; // Should never get here
+    _majorGetIndex = i;
+    _firstGetSampleInCurrChunk = _pcumSampleVec[index] + (j * samplesPerChunkInRun);
+    _numGetSamplesPerChunk = samplesPerChunkInRun;
+    _currGetSampleCount = _firstGetSampleInCurrChunk + samplesPerChunkInRun;
+    _currGetChunk =  chunkNum + j;
+    _currGetSDI = sampleDescrIndex;
 
-END_OF_RESET:
+    if (_majorGetIndex < (int32)(_entryCount - 1))
     {
-        if (_majorGetIndex < (int32)(_entryCount - 1))
-        {
-            _majorGetIndex++;
-        }
-        _majorPeekIndex = _majorGetIndex;
-        _currPeekChunk = _currGetChunk;
-        _numPeekChunksInRun = _numGetChunksInRun;
-        _currPeekSampleCount  = _currGetSampleCount;
-        _firstPeekSampleInCurrChunk = _firstGetSampleInCurrChunk;
-        _numPeekSamplesPerChunk = _numGetSamplesPerChunk;
-        _currPeekSDI = _currGetSDI;
-
-        PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _majorPeekIndex = _majorGetIndex =%d", _majorPeekIndex));
-        PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _currPeekChunk = _currGetChunk =%d", _currPeekChunk));
-        PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _numPeekChunksInRun = _numGetChunksInRun = %d", _numPeekChunksInRun));
-        PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _currPeekSampleCount = _currGetSampleCount = %d", _currPeekSampleCount));
-        PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _firstPeekSampleInCurrChunk = _firstGetSampleInCurrChunk = %d", _firstPeekSampleInCurrChunk));
-        PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _numPeekSamplesPerChunk = _numGetSamplesPerChunk = %d", _numPeekSamplesPerChunk));
-        PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _numPeekSamplesPerChunk = _currGetSDI = %d", _currPeekSDI));
-
-        return (EVERYTHING_FINE);
+        _majorGetIndex++;
     }
+    _majorPeekIndex = _majorGetIndex;
+    _currPeekChunk = _currGetChunk;
+    _numPeekChunksInRun = _numGetChunksInRun;
+    _currPeekSampleCount  = _currGetSampleCount;
+    _firstPeekSampleInCurrChunk = _firstGetSampleInCurrChunk;
+    _numPeekSamplesPerChunk = _numGetSamplesPerChunk;
+    _currPeekSDI = _currGetSDI;
+
+    PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _majorPeekIndex = _majorGetIndex =%d", _majorPeekIndex));
+    PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _currPeekChunk = _currGetChunk =%d", _currPeekChunk));
+    PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _numPeekChunksInRun = _numGetChunksInRun = %d", _numPeekChunksInRun));
+    PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _currPeekSampleCount = _currGetSampleCount = %d", _currPeekSampleCount));
+    PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _firstPeekSampleInCurrChunk = _firstGetSampleInCurrChunk = %d", _firstPeekSampleInCurrChunk));
+    PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _numPeekSamplesPerChunk = _numGetSamplesPerChunk = %d", _numPeekSamplesPerChunk));
+    PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "SampleToChunkAtom::resetStateVariables- _numPeekSamplesPerChunk = _currGetSDI = %d", _currPeekSDI));
+
+    return (EVERYTHING_FINE);
 }
 
 int32 SampleToChunkAtom::resetPeekwithGet()
@@ -1225,6 +1166,13 @@ void SampleToChunkAtom::CheckAndParseEntry(uint32 i)
 {
     if (i >= _parsed_entry_cnt)
     {
+        // the file position of every window is known up front, so go
+        // straight to the window of the entry.
+        uint32 entryLoc = i / _stbl_buff_size;
+        if (entryLoc != (_parsed_entry_cnt / _stbl_buff_size))
+        {
+            _parsed_entry_cnt = entryLoc * _stbl_buff_size;
+        }
         ParseEntryUnit(i);
     }
     else
@@ -44,6 +44,11 @@ TimeToSampleAtom::TimeToSampleAtom(MP4_FF_FILE *fp,
 
     _psampleCountVec = NULL;
     _psampleDeltaVec = NULL;
+    _pcumSampleVec = NULL;
+    _pcumTimeVec = NULL;
+    _numWindows = 0;
+    _pwindowSampleVec = NULL;
+    _pwindowTimeVec = NULL;
 
     _currGetSampleCount = 0;
     _currGetIndex = -1;
@@ -59,7 +64,6 @@ TimeToSampleAtom::TimeToSampleAtom(MP4_FF_FILE *fp,
     _parsing_mode = parsingMode;
 
     _stbl_buff_size = MAX_CACHED_TABLE_ENTRIES_FILE;
-    _next_buff_number = 0;
     _curr_buff_number = 0;
     _curr_entry_point = 0;
     _stbl_fptr_vec = NULL;
@@ -121,10 +125,30 @@ TimeToSampleAtom::TimeToSampleAtom(MP4_FF_FILE *fp,
                             _mp4ErrorCode = MEMORY_ALLOCATION_FAILED;
                             return;
                         }
+                        PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_stbl_buff_size), _pcumSampleVec);
+                        PV_MP4_FF_ARRAY_NEW(NULL, uint64, (_stbl_buff_size), _pcumTimeVec);
+                        if ((_pcumSampleVec == NULL) || (_pcumTimeVec == NULL))
+                        {
+                            _success = false;
+                            _mp4ErrorCode = MEMORY_ALLOCATION_FAILED;
+                            return;
+                        }
                         for (uint32 idx = 0; idx < _stbl_buff_size; idx++)  //initialization
                         {
                             _psampleCountVec[idx] = 0;
                             _psampleDeltaVec[idx] = 0;
+                            _pcumSampleVec[idx] = 0;
+                            _pcumTimeVec[idx] = 0;
+                        }
+
+                        _numWindows = (_entryCount + _stbl_buff_size - 1) / _stbl_buff_size;
+                        PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_numWindows + 1), _pwindowSampleVec);
+                        PV_MP4_FF_ARRAY_NEW(NULL, uint64, (_numWindows + 1), _pwindowTimeVec);
+                        if ((_pwindowSampleVec == NULL) || (_pwindowTimeVec == NULL))
+                        {
+                            _success = false;
+                            _mp4ErrorCode = MEMORY_ALLOCATION_FAILED;
+                            return;
                         }
 
                         OsclAny* ptr = (MP4_FF_FILE *)(oscl_malloc(sizeof(MP4_FF_FILE)));
@@ -148,7 +172,21 @@ TimeToSampleAtom::TimeToSampleAtom(MP4_FF_FILE *fp,
                         _fileptr->_fileSize = fp->_fileSize;
 
                         int32 _head_offset = AtomUtils::getCurrentFilePosition(fp);
-                        AtomUtils::seekFromCurrPos(fp, dataSize);
+                        for (uint32 window = 0; window < _numWindows; window++)
+                        {
+                            _stbl_fptr_vec[window] = _head_offset + (window * _stbl_buff_size * entrySize);
+                        }
+
+                        // One pass over the table to get the running totals at
+                        // the start of each window.  The entries themselves are
+                        // parsed on demand, one window at a time.
+                        if (!BuildWindowIndex(fp))
+                        {
+                            _success = false;
+                            _mp4ErrorCode = READ_TIME_TO_SAMPLE_ATOM_FAILED;
+                            return;
+                        }
+                        AtomUtils::seekFromCurrPos(fp, dataSize - (_entryCount * entrySize));
                         AtomUtils::seekFromStart(_fileptr, _head_offset);
                         return;
                     }
@@ -179,14 +217,26 @@ TimeToSampleAtom::TimeToSampleAtom(MP4_FF_FILE *fp,
                     _mp4ErrorCode = MEMORY_ALLOCATION_FAILED;
                     return;
                 }
+                PV_MP4_FF_ARRAY_NEW(NULL, uint32, (_entryCount), _pcumSampleVec);
+                PV_MP4_FF_ARRAY_NEW(NULL, uint64, (_entryCount), _pcumTimeVec);
+                if ((_pcumSampleVec == NULL) || (_pcumTimeVec == NULL))
+                {
+                    _success = false;
+                    _mp4ErrorCode = MEMORY_ALLOCATION_FAILED;
+                    return;
+                }
                 for (uint32 idx = 0; idx < _entryCount; idx++)  //initialization
                 {
                     _psampleCountVec[idx] = 0;
                     _psampleDeltaVec[idx] = 0;
+                    _pcumSampleVec[idx] = 0;
+                    _pcumTimeVec[idx] = 0;
                 }
 
                 uint32 number = 0;
                 uint32 delta = 0;
+                uint32 cumSamples = 0;
+                uint64 cumTime = 0;
                 for (_parsed_entry_cnt = 0; _parsed_entry_cnt < _entryCount; _parsed_entry_cnt++)
                 {
                     if (!AtomUtils::read32(fp, number))
@@ -201,6 +251,10 @@ TimeToSampleAtom::TimeToSampleAtom(MP4_FF_FILE *fp,
                     }
                     _psampleCountVec[_parsed_entry_cnt] = (number);
                     _psampleDeltaVec[_parsed_entry_cnt] = (delta);
+                    _pcumSampleVec[_parsed_entry_cnt] = cumSamples;
+                    _pcumTimeVec[_parsed_entry_cnt] = cumTime;
+                    cumSamples += number;
+                    cumTime += (uint64)delta * number;
                 }
             }
         }
@@ -217,6 +271,34 @@ TimeToSampleAtom::TimeToSampleAtom(MP4_FF_FILE *fp,
     }
 }
 
+bool TimeToSampleAtom::BuildWindowIndex(MP4_FF_FILE *fp)
+{
+    uint32 number, delta;
+    uint32 cumSamples = 0;
+    uint64 cumTime = 0;
+    for (uint32 i = 0; i < _entryCount; i++)
+    {
+        if ((i % _stbl_buff_size) == 0)
+        {
+            _pwindowSampleVec[i / _stbl_buff_size] = cumSamples;
+            _pwindowTimeVec[i / _stbl_buff_size] = cumTime;
+        }
+        if (!AtomUtils::read32(fp, number))
+        {
+            return false;
+        }
+        if (!AtomUtils::read32(fp, delta))
+        {
+            return false;
+        }
+        cumSamples += number;
+        cumTime += (uint64)delta * number;
+    }
+    _pwindowSampleVec[_numWindows] = cumSamples;
+    _pwindowTimeVec[_numWindows] = cumTime;
+    return true;
+}
+
 bool TimeToSampleAtom::ParseEntryUnit(uint32 entry_cnt)
 {
 
@@ -232,13 +314,6 @@ bool TimeToSampleAtom::ParseEntryUnit(uint32 entry_cnt)
         _curr_entry_point = _parsed_entry_cnt % _stbl_buff_size;
         _curr_buff_number = _parsed_entry_cnt / _stbl_buff_size;
 
-        if (_curr_buff_number  == _next_buff_number)
-        {
-            uint32 currFilePointer = AtomUtils::getCurrentFilePosition(_fileptr);
-            _stbl_fptr_vec[_curr_buff_number] = currFilePointer;
-            _next_buff_number++;
-        }
-
         if (!_curr_entry_point)
         {
             uint32 currFilePointer = _stbl_fptr_vec[_curr_buff_number];
@@ -255,6 +330,20 @@ bool TimeToSampleAtom::ParseEntryUnit(uint32 entry_cnt)
         }
         _psampleCountVec[_curr_entry_point] = (number);
         _psampleDeltaVec[_curr_entry_point] = (delta);
+
+        // entries are always parsed in order within a window, so the
+        // previous slot holds the previous entry.
+        if (!_curr_entry_point)
+        {
+            _pcumSampleVec[0] = _pwindowSampleVec[_curr_buff_number];
+            _pcumTimeVec[0] = _pwindowTimeVec[_curr_buff_number];
+        }
+        else
+        {
+            uint32 prev = _curr_entry_point - 1;
+            _pcumSampleVec[_curr_entry_point] = _pcumSampleVec[prev] + _psampleCountVec[prev];
+            _pcumTimeVec[_curr_entry_point] = _pcumTimeVec[prev] + ((uint64)_psampleDeltaVec[prev] * _psampleCountVec[prev]);
+        }
         _parsed_entry_cnt++;
     }
     return true;
@@ -269,6 +358,18 @@ TimeToSampleAtom::~TimeToSampleAtom()
     if (_psampleDeltaVec != NULL)
         PV_MP4_ARRAY_DELETE(NULL, _psampleDeltaVec);
 
+    if (_pcumSampleVec != NULL)
+        PV_MP4_ARRAY_DELETE(NULL, _pcumSampleVec);
+
+    if (_pcumTimeVec != NULL)
+        PV_MP4_ARRAY_DELETE(NULL, _pcumTimeVec);
+
+    if (_pwindowSampleVec != NULL)
+        PV_MP4_ARRAY_DELETE(NULL, _pwindowSampleVec);
+
+    if (_pwindowTimeVec != NULL)
+        PV_MP4_ARRAY_DELETE(NULL, _pwindowTimeVec);
+
     if (_stbl_fptr_vec != NULL)
         PV_MP4_ARRAY_DELETE(NULL, _stbl_fptr_vec);
 
@@ -328,6 +429,105 @@ TimeToSampleAtom::getSampleDeltaAt(int32 index)
     }
 }
 
+// Return the first entry whose first sample is at or after timestamp ts,
+// or _entryCount if there is none.
+uint32
+TimeToSampleAtom::findEntryForTimestamp(uint32 ts)
+{
+    uint32 lo = 0;
+    uint32 hi = _entryCount;
+
+    if (_parsing_mode == 1)
+    {
+        // find the first window that starts at or after ts.  The entry is
+        // in the window before it, or is the first entry of that window.
+        uint32 wlo = 0;
+        uint32 whi = _numWindows;
+        while (wlo < whi)
+        {
+            uint32 mid = wlo + ((whi - wlo) >> 1);
+            if (_pwindowTimeVec[mid] < ts)
+                wlo = mid + 1;
+            else
+                whi = mid;
+        }
+        if (wlo == 0)
+        {
+            return 0;
+        }
+        lo = (wlo - 1) * _stbl_buff_size;
+        if ((wlo * _stbl_buff_size) < hi)
+            hi = wlo * _stbl_buff_size;
+    }
+
+    while (lo < hi)
+    {
+        uint32 mid = lo + ((hi - lo) >> 1);
+        if (_parsing_mode == 1)
+            CheckAndParseEntry(mid);
+
+        if (_pcumTimeVec[mid%_stbl_buff_size] < ts)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// Return the entry that holds sample number num, i.e. the first entry where
+// the samples up to and including the entry add up to at least num, or
+// _entryCount if there is none.
+uint32
+TimeToSampleAtom::findEntryForSampleNumber(uint32 num)
+{
+    uint32 lo = 0;
+    uint32 hi = _entryCount;
+
+    if (_parsing_mode == 1)
+    {
+        // find the first window boundary with at least num samples before
+        // it.  The entry is in the window that ends at that boundary.
+        uint32 wlo = 0;
+        uint32 whi = _numWindows + 1;
+        while (wlo < whi)
+        {
+            uint32 mid = wlo + ((whi - wlo) >> 1);
+            if (_pwindowSampleVec[mid] < num)
+                wlo = mid + 1;
+            else
+                whi = mid;
+        }
+        if (wlo > _numWindows)
+        {
+            return _entryCount;
+        }
+        if (wlo > 0)
+        {
+            lo = (wlo - 1) * _stbl_buff_size;
+            if ((wlo * _stbl_buff_size) < hi)
+                hi = wlo * _stbl_buff_size;
+        }
+        else if (_stbl_buff_size < hi)
+        {
+            hi = _stbl_buff_size;
+        }
+    }
+
+    while (lo < hi)
+    {
+        uint32 mid = lo + ((hi - lo) >> 1);
+        if (_parsing_mode == 1)
+            CheckAndParseEntry(mid);
+
+        uint32 index = mid % _stbl_buff_size;
+        if ((_pcumSampleVec[index] + _psampleCountVec[index]) < num)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
 // Return the samples corresponding to the timestamp ts.  If there is not a sample
 // exactly at ts, the very next sample is used.
 // This atom maintains timestamp deltas between samples, i.e. delta[i] is the
@@ -338,9 +538,6 @@ TimeToSampleAtom::getSampleNumberFromTimestamp(uint32 ts, bool oAlwaysRetSampleC
 {
     // It is assumed that sample 0 has a ts of 0 - i.e. the first
     // entry in the table starts with the delta between sample 1 and sample 0
-    uint32 sampleCount = 0;
-    uint32 timeCount = 0;
-
     if ((_psampleDeltaVec == NULL) ||
             (_psampleCountVec == NULL) ||
             (_entryCount      == 0))
@@ -348,87 +545,54 @@ TimeToSampleAtom::getSampleNumberFromTimestamp(uint32 ts, bool oAlwaysRetSampleC
         return PV_ERROR;
     }
 
-    for (uint32 i = 0; i < _entryCount; i++)
+    uint32 i = findEntryForTimestamp(ts);
+    if (i < _entryCount)
     {
         if (_parsing_mode == 1)
             CheckAndParseEntry(i);
 
-        if (ts < timeCount)
-        { // found range that the sample is in - need to backtrack
-            if (_parsing_mode == 1)
-                CheckAndParseEntry(i - 1);
-
-            uint32 samples = _psampleCountVec[(i-1)%_stbl_buff_size];
-            sampleCount -= samples;
-            timeCount -= _psampleDeltaVec[(i-1)%_stbl_buff_size] * samples;
-            while (timeCount <= ts)
-            {
-                timeCount += _psampleDeltaVec[(i-1)%_stbl_buff_size];
-                sampleCount += 1;
-            }
-
-            if (timeCount > ts)
-            {
-                if (sampleCount > 0)
-                {
-                    sampleCount--;
-                }
-                return sampleCount;
-            }
-        }
-        else if (ts == timeCount)
+        if (_pcumTimeVec[i%_stbl_buff_size] == ts)
         { // Found sample at ts
-            return sampleCount;
-        }
-        else
-        { // Sample not yet found - advance
-            uint32 samples = _psampleCountVec[i%_stbl_buff_size]; //number of samples at this index
-            sampleCount += samples;
-            timeCount += _psampleDeltaVec[i%_stbl_buff_size] * samples;
+            return _pcumSampleVec[i%_stbl_buff_size];
         }
+
+        // found range that the sample is in - it is in the previous entry,
+        // which always exists since the first entry starts at ts=0.
+        if (_parsing_mode == 1)
+            CheckAndParseEntry(i - 1);
+
+        uint32 index = (i - 1) % _stbl_buff_size;
+        uint32 offset = (uint32)(ts - _pcumTimeVec[index]);
+        return (_pcumSampleVec[index] + (offset / _psampleDeltaVec[index]));
     }
 
     // Timestamp is in last run of samples (or possibly beyond)
-    // - need to backtrack to beginning of last run to find it
-    uint32 samples = _psampleCountVec[(_entryCount-1)%_stbl_buff_size];
-    uint32 delta = _psampleDeltaVec[(_entryCount-1)%_stbl_buff_size];
-    sampleCount -= samples;
-    timeCount -= delta * samples;
+    if (_parsing_mode == 1)
+        CheckAndParseEntry(_entryCount - 1);
 
-    for (uint32 count = 0; count < (samples - 1); count++)
-    {
-        timeCount += delta;
-        sampleCount += 1;
+    uint32 index = (_entryCount - 1) % _stbl_buff_size;
+    uint32 samples = _psampleCountVec[index];
+    uint32 delta = _psampleDeltaVec[index];
+    uint32 sampleCount = _pcumSampleVec[index];
+    uint64 offset = ts - _pcumTimeVec[index];
 
-        if (timeCount > ts)
-        {
-            if (sampleCount > 0)
-            {
-                sampleCount--;
-            }
-            return sampleCount;
-        }
-        else if (timeCount == ts)
-        {
-            return sampleCount;
-        }
+    if ((samples > 0) &&
+            (offset <= ((uint64)delta * (samples - 1))))
+    {
+        return (sampleCount + (uint32)(offset / delta));
     }
 
-
-    sampleCount += 1;
-    if (ts >= timeCount)
+    sampleCount += samples;
+    if (oAlwaysRetSampleCount)
+    {
+        return sampleCount;
+    }
+    else
     {
-        if (oAlwaysRetSampleCount)
+        if (_mediaType == MEDIA_TYPE_VISUAL)
         {
             return sampleCount;
         }
-        else
-        {
-            if (_mediaType == MEDIA_TYPE_VISUAL)
-            {
-                return sampleCount;
-            }
-        }
     }
 
     // Went past last sample in last run of samples - not a valid timestamp
@@ -451,25 +615,17 @@ int32 TimeToSampleAtom::getTimestampForSampleNumber(uint32 num)
     if (num == 0)
         return 0;
 
-    uint32 sampleCount = 0;
-    int32 ts = 0; // Timestamp value to return
-    for (uint32 i = 0; i < _entryCount; i++)
-    {
+    uint32 i = findEntryForSampleNumber(num);
+    if (i < _entryCount)
+    { // Sample num within entry i
         if (_parsing_mode == 1)
             CheckAndParseEntry(i);
 
-        if (num <= (sampleCount + _psampleCountVec[i%_stbl_buff_size]))
-        { // Sample num within current entry
-            int32 count = num - sampleCount;
-            ts += _psampleDeltaVec[i%_stbl_buff_size] * count;
-            PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "TimeToSampleAtom::getTimestampForSampleNumber- Time Stamp =%d", ts));
-            return ts;
-        }
-        else
-        {
-            sampleCount += _psampleCountVec[i%_stbl_buff_size];
-            ts += (_psampleDeltaVec[i%_stbl_buff_size] * _psampleCountVec[i%_stbl_buff_size]);
-        }
+        uint32 index = i % _stbl_buff_size;
+        uint32 count = num - _pcumSampleVec[index];
+        int32 ts = (int32)(_pcumTimeVec[index] + ((uint64)_psampleDeltaVec[index] * count));
+        PVMF_MP4FFPARSER_LOGMEDIASAMPELSTATEVARIABLES((0, "TimeToSampleAtom::getTimestampForSampleNumber- Time Stamp =%d", ts));
+        return ts;
     }
 
     // Went past end of list - not a valid sample number
@@ -494,20 +650,13 @@ TimeToSampleAtom::getTimeDeltaForSampleNumber(uint32 num)
     if (num == 0)
         return 0;
 
-    uint32 sampleCount = 0;
-    for (uint32 i = 0; i < _entryCount; i++)
-    {
+    uint32 i = findEntryForSampleNumber(num);
+    if (i < _entryCount)
+    { // Sample num within entry i
         if (_parsing_mode == 1)
             CheckAndParseEntry(i);
 
-        if (num <= (sampleCount + _psampleCountVec[i%_stbl_buff_size]))
-        { // Sample num within current entry
-            return (_psampleDeltaVec[i%_stbl_buff_size]);
-        }
-        else
-        {
-            sampleCount += _psampleCountVec[i%_stbl_buff_size];
-        }
+        return (_psampleDeltaVec[i%_stbl_buff_size]);
     }
 
     // Went past end of list - not a valid sample number
@@ -646,24 +795,29 @@ TimeToSampleAtom::resetStateVariables(uint32 sampleNum)
     }
 
 
-    for (uint32 i = 0; i < _entryCount; i++)
+    uint32 i = findEntryForSampleNumber(sampleNum);
+    bool found = (i < _entryCount);
+    if (!found)
     {
-        if (_parsing_mode)
-            CheckAndParseEntry(i);
+        // leave the state at the end of the table
+        i = _entryCount - 1;
+    }
 
-        _currPeekIndex++;
-        _currPeekSampleCount += _psampleCountVec[i%_stbl_buff_size];
-        _currPeekTimeDelta    = _psampleDeltaVec[i%_stbl_buff_size];
+    if (_parsing_mode)
+        CheckAndParseEntry(i);
 
-        _currGetIndex++;
-        _currGetSampleCount += _psampleCountVec[i%_stbl_buff_size];
-        _currGetTimeDelta    = _psampleDeltaVec[i%_stbl_buff_size];
+    uint32 index = i % _stbl_buff_size;
+    _currPeekIndex = i;
+    _currPeekSampleCount = _pcumSampleVec[index] + _psampleCountVec[index];
+    _currPeekTimeDelta    = _psampleDeltaVec[index];
 
-        if (sampleNum <= _currPeekSampleCount)
-        {
-            return (EVERYTHING_FINE);
-        }
+    _currGetIndex = i;
+    _currGetSampleCount = _currPeekSampleCount;
+    _currGetTimeDelta    = _currPeekTimeDelta;
 
+    if (found)
+    {
+        return (EVERYTHING_FINE);
     }
 
     // Went past end of list - not a valid sample number
@@ -682,6 +836,13 @@ void TimeToSampleAtom::CheckAndParseEntry(uint32 i)
 {
     if (i >= _parsed_entry_cnt)
     {
+        // the file position of every window is known up front, so go
+        // straight to the window of the entry.
+        uint32 entryLoc = i / _stbl_buff_size;
+        if (entryLoc != (_parsed_entry_cnt / _stbl_buff_size))
+        {
+            _parsed_entry_cnt = entryLoc * _stbl_buff_size;
+        }
         ParseEntryUnit(i);
     }
     else
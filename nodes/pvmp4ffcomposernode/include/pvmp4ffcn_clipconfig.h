@@ -95,7 +95,15 @@ typedef enum
      * Media Data is interleaved.
      * No temp files are used.
      */
-    PVMP4FFCN_MOVIE_FRAGMENT_MODE = 0x00000021
+    PVMP4FFCN_MOVIE_FRAGMENT_MODE = 0x00000021,
+
+    /**
+     * This mode authors 3GPP Progressive Downloadable output files in one pass:
+     * Meta Data is upfront, in space reserved ahead of the media data.
+     * Media Data is interleaved.
+     * No temp files are used.
+     */
+    PVMP4FFCN_3GPP_PROGRESSIVE_DOWNLOAD_DIRECT_MODE = 0x0000004B
 
 
 } PVMp4FFCN_AuthoringMode;
@@ -163,6 +171,17 @@ class PVMp4FFCNClipConfigInterface : public PVInterface
          */
         virtual PVMFStatus SetPresentationTimescale(uint32 aTimescale) = 0;
 
+        /**
+         * Method to set the expected duration of the clip, in
+         * PVMP4FFCN_3GPP_PROGRESSIVE_DOWNLOAD_DIRECT_MODE it sizes the space reserved for the
+         * meta data. If the clip is longer, the media data is moved when the clip is closed.
+         * This is an optional configuration API that should be called before Start() is called.
+         *
+         * @param aDuration Expected duration in milliseconds
+         * @return Completion status of this method.
+         */
+        virtual PVMFStatus SetMovieAtomReserveDuration(uint32 aDuration) = 0;
+
         /**
          * This method populates the version string. Version string contains
          * information about the version of the author SDK/app that is authoring
@@ -306,6 +306,7 @@ PVMp4FFComposerNode::PVMp4FFComposerNode(int32 aPriority)
         , iFileType(0)
         , iAuthoringMode(PVMP4FF_3GPP_DOWNLOAD_MODE)
         , iPresentationTimescale(1000)
+        , iMovieAtomReserveDuration(DEFAULT_MOVIE_ATOM_RESERVE_DURATION_IN_MS)
         , iMovieFragmentDuration(2000)
         , iRecordingYear(0)
         , iClockConverter(8000)
@@ -798,6 +799,18 @@ OSCL_EXPORT_REF PVMFStatus PVMp4FFComposerNode::SetPresentationTimescale(uint32
     return PVMFSuccess;
 }
 
+////////////////////////////////////////////////////////////////////////////
+OSCL_EXPORT_REF PVMFStatus PVMp4FFComposerNode::SetMovieAtomReserveDuration(uint32 aDuration)
+{
+    if (iInterfaceState != EPVMFNodeIdle &&
+            iInterfaceState != EPVMFNodeInitialized &&
+            iInterfaceState != EPVMFNodePrepared)
+        return PVMFErrInvalidState;
+
+    iMovieAtomReserveDuration = aDuration;
+    return PVMFSuccess;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 OSCL_EXPORT_REF PVMFStatus PVMp4FFComposerNode::SetVersion(const OSCL_wString& aVersion, const OSCL_String& aLangCode)
 {
@@ -1631,6 +1644,15 @@ void PVMp4FFComposerNode::DoStart(PVMp4FFCNCmd& aCmd)
                 iMpeg4File->setCreationDate(iCreationDate);
             }
             iMpeg4File->setMovieFragmentDuration(iMovieFragmentDuration);
+            if (iMaxDurationEnabled)
+            {
+                // the clip can not be longer than the maximum duration
+                iMpeg4File->setMovieAtomReserveDuration(iMaxTimeDuration);
+            }
+            else
+            {
+                iMpeg4File->setMovieAtomReserveDuration(iMovieAtomReserveDuration);
+            }
             iMpeg4File->setAlbumInfo(iAlbumTitle.iDataString, iAlbumTitle.iLangCode);
             iMpeg4File->setRecordingYear(iRecordingYear);
 
@@ -170,6 +170,7 @@ class PVMp4FFComposerNode : public PVMFNodeInterface,
         OSCL_IMPORT_REF PVMFStatus SetOutputFileDescriptor(const OsclFileHandle* aFileHandle);
         OSCL_IMPORT_REF PVMFStatus SetAuthoringMode(PVMp4FFCN_AuthoringMode aAuthoringMode = PVMP4FFCN_3GPP_DOWNLOAD_MODE);
         OSCL_IMPORT_REF PVMFStatus SetPresentationTimescale(uint32 aTimescale);
+        OSCL_IMPORT_REF PVMFStatus SetMovieAtomReserveDuration(uint32 aDuration);
         OSCL_IMPORT_REF PVMFStatus SetVersion(const OSCL_wString& aVersion, const OSCL_String& aLangCode);
         OSCL_IMPORT_REF PVMFStatus SetTitle(const OSCL_wString& aTitle, const OSCL_String& aLangCode);
         OSCL_IMPORT_REF PVMFStatus SetAuthor(const OSCL_wString& aAuthor, const OSCL_String& aLangCode);
@@ -362,6 +363,7 @@ class PVMp4FFComposerNode : public PVMFNodeInterface,
         int32 iFileType;
         uint32 iAuthoringMode;
         uint32 iPresentationTimescale;
+        uint32 iMovieAtomReserveDuration;
         uint32 iMovieFragmentDuration;
         Oscl_File* iFileObject;
 
@@ -53,6 +53,7 @@ typedef enum
 #define MIN_ASYNC_READ_BUFFER_SIZE 1024
 #define MAX_ASYNC_READ_BUFFER_SIZE 64*1024
 #define DEFAULT_FILE_HANDLE NULL
+#define DEFAULT_MEMORY_MAP_ENABLE false
 
 #define MIN_JITTER_BUFFER_DURATION_IN_MS       1000
 #define MAX_JITTER_BUFFER_DURATION_IN_MS       10000
@@ -183,6 +183,7 @@ PVMFMP4FFParserNode::PVMFMP4FFParserNode(int32 aPriority) :
     iPVLoggerEnableFlag = false;
     iPVLoggerStateEnableFlag = false;
     iNativeAccessMode = DEFAULT_NATIVE_ACCESS_MODE;
+    iMemoryMapEnable = DEFAULT_MEMORY_MAP_ENABLE;
 
     iStreamID = 0;
 
@@ -2504,7 +2505,8 @@ bool PVMFMP4FFParserNode::ParseMP4File(PVMFMP4FFParserNodeCmdQueue& aCmdQ,
                      dsFactory,
                      iFileHandle,
                      iParsingMode,
-                     &iFileServer);
+                     &iFileServer,
+                     iMemoryMapEnable);
 
     currticks = OsclTickCount::TickCount();
     uint32 EndTime = OsclTickCount::TicksToMsec(currticks);
@@ -4419,6 +4421,21 @@ bool PVMFMP4FFParserNode::RetrieveTrackData(PVMP4FFNodeTrackPortInfo& aTrackPort
         }
     }
 
+    // If the file is memory-mapped, the parser can return the samples as
+    // fragments of the file instead of copying them into the output buffer.
+    // Only do this for tracks whose samples are sent as a frag group anyway.
+    iGau.numMappedFrags = 0;
+    iGau.mappedFrags = NULL;
+    if (iMemoryMapEnable &&
+            (mediadatafraggroup.GetRep() != NULL) &&
+            (iCPMContentType != PVMF_CPM_FORMAT_OMA2) &&
+            !iThumbNailMode &&
+            (PVMF_DATA_SOURCE_DIRECTION_REVERSE != iPlayBackDirection) &&
+            ((aTrackPortInfo.iFormatTypeInteger != PVMF_MP4_PARSER_NODE_H264_MP4) || (numsamples == 1)))
+    {
+        iGau.mappedFrags = iMappedFrags;
+    }
+
     uint32 currticks = OsclTickCount::TickCount();
     uint32 StartTime = OsclTickCount::TicksToMsec(currticks);
 
@@ -4508,6 +4525,7 @@ bool PVMFMP4FFParserNode::RetrieveTrackData(PVMP4FFNodeTrackPortInfo& aTrackPort
     {
         retval = iMP4FileHandle->getNextBundledAccessUnits(trackid, &numsamples, &iGau);
     }
+    iGau.mappedFrags = NULL;
 
     if (retval == NO_SAMPLE_IN_CURRENT_MOOF && numsamples == 0)
     {
@@ -4836,11 +4854,13 @@ bool PVMFMP4FFParserNode::RetrieveTrackData(PVMP4FFNodeTrackPortInfo& aTrackPort
         }
         else
         {
+            // Mapped samples don't use the output buffer at all
+            uint32 bufferdatasize = (iGau.numMappedFrags > 0) ? 0 : actualdatasize;
             // Set buffer size
-            mediadataout->setMediaFragFilledLen(0, actualdatasize);
-            media_data_impl->setCapacity(actualdatasize);
+            mediadataout->setMediaFragFilledLen(0, bufferdatasize);
+            media_data_impl->setCapacity(bufferdatasize);
             // Return the unused space from mempool back
-            if (refCtrMemFragOut.getCapacity() > actualdatasize)
+            if (refCtrMemFragOut.getCapacity() > bufferdatasize)
             {
                 // Need to go to the resizable memory pool and free some memory
                 aTrackPortInfo.iMediaDataImplAlloc->ResizeMemoryFragment(mediaDataImplOut);
@@ -5274,6 +5294,23 @@ bool PVMFMP4FFParserNode::GenerateAACFrameFrags(PVMP4FFNodeTrackPortInfo& aTrack
     bool appended_data = false;
     uint32 ii = 0;
 
+    if (iGau.numMappedFrags > 0)
+    {
+        // The samples are fragments of the memory-mapped file, so append them as they are
+        for (ii = 0; ii < iGau.numMappedFrags; ii++)
+        {
+            if (iMappedFrags[ii].getMemFragSize() > 0)
+            {
+                aMediaFragGroup->appendMediaFragment(iMappedFrags[ii]);
+                appended_data = true;
+            }
+            iMappedFrags[ii] = OsclRefCounterMemFrag();
+        }
+        // nothing to split in the output buffer
+        samplesize = 0;
+        ii = 0;
+    }
+
     // While we still have data to append AND we haven't run out of media samples
     while ((samplesize > 0) && (ii < iGau.numMediaSamples))
     {
@@ -5344,7 +5381,16 @@ bool PVMFMP4FFParserNode::GenerateAVCNALGroup(PVMP4FFNodeTrackPortInfo& aTrackPo
     aMediaFragGroup->setMarkerInfo(markerInfo);
 
     OsclRefCounterMemFrag memFragIn;
-    aTrackPortInfo.iMediaData->getMediaFragment(0, memFragIn);
+    if (iGau.numMappedFrags == 1)
+    {
+        // The sample is a fragment of the memory-mapped file
+        memFragIn = iMappedFrags[0];
+        iMappedFrags[0] = OsclRefCounterMemFrag();
+    }
+    else
+    {
+        aTrackPortInfo.iMediaData->getMediaFragment(0, memFragIn);
+    }
     OsclRefCounter* refCntIn = memFragIn.getRefCounter();
 
     uint8* sample = (uint8*)(memFragIn.getMemFrag().ptr);
@@ -5972,6 +6018,12 @@ void PVMFMP4FFParserNode::CleanupFileSource()
     iExternalDownload = false;
     iThumbNailMode = false;
 
+    // release any samples still held from the memory-mapped file
+    for (uint32 i = 0; i < MAX_GAU_BUNDLE; i++)
+    {
+        iMappedFrags[i] = OsclRefCounterMemFrag();
+    }
+
     if (iMP4FileHandle)
     {
         if (iExternalDownload == true)
@@ -890,6 +890,8 @@ class PVMFMP4FFParserNode : public OsclTimerObject,
         bool MapMP4ErrorCodeToEventCode(int32 aMP4ErrCode, PVUuid& aEventUUID, int32& aEventCode);
 
         GAU iGau;
+        // samples returned as fragments of the memory-mapped file, see GAU::mappedFrags
+        OsclRefCounterMemFrag iMappedFrags[MAX_GAU_BUNDLE];
 
         bool iThumbNailMode;
 
@@ -1023,6 +1025,7 @@ class PVMFMP4FFParserNode : public OsclTimerObject,
         bool iPVLoggerEnableFlag;
         bool iPVLoggerStateEnableFlag;
         uint32 iNativeAccessMode;
+        bool iMemoryMapEnable;
 
         BaseKeys_SelectionType iBaseKey;
         uint32 iJitterBufferDurationInMs;
@@ -50,7 +50,8 @@ static const MP4ParserNodeKeyStringData MP4ParserNodeConfig_FileIO_Keys[] =
     {"logger-enable", PVMI_KVPTYPE_VALUE, PVMI_KVPVALTYPE_BOOL},
     {"logger-stats-enable", PVMI_KVPTYPE_VALUE, PVMI_KVPVALTYPE_BOOL},
     {"native-access-mode", PVMI_KVPTYPE_VALUE, PVMI_KVPVALTYPE_UINT32},
-    {"file-handle", PVMI_KVPTYPE_VALUE, PVMI_KVPVALTYPE_KSV}
+    {"file-handle", PVMI_KVPTYPE_VALUE, PVMI_KVPVALTYPE_KSV},
+    {"memory-map-enable", PVMI_KVPTYPE_VALUE, PVMI_KVPVALTYPE_BOOL}
 };
 
 //The base selection keys for file IO,leading tag needs to be x-pvmf\net
@@ -76,6 +77,7 @@ enum BaseFileIOKeys_IndexMapType
     PVLOGGER_STATS_ENABLE,
     NATIVE_ACCESS_MODE,
     FILE_HANDLE,
+    MEMORY_MAP_ENABLE,
 };
 
 enum BaseNetKeys_IndexMapType
@@ -921,6 +923,21 @@ PVMFStatus PVMFMP4FFParserNode::GetConfigParameter(PvmiKvp*& aParameters,
                     // Return capability
                 }
                 break;
+            case MEMORY_MAP_ENABLE:
+                if (reqattr == PVMI_KVPATTR_CUR)
+                {
+                    aParameters[0].value.bool_value = iMemoryMapEnable;
+                }
+                else if (reqattr == PVMI_KVPATTR_DEF)
+                {
+                    aParameters[0].value.bool_value = DEFAULT_MEMORY_MAP_ENABLE;
+                }
+                else
+                {
+                    // Return capability - no concept of capability for memory mapping
+                    // do nothing
+                }
+                break;
 
 
 
@@ -1114,6 +1131,15 @@ PVMFStatus PVMFMP4FFParserNode::VerifyAndSetConfigParameter(int index, PvmiKvp&
             }
             break;
 
+            case MEMORY_MAP_ENABLE:
+            {
+                if (set)
+                {
+                    iMemoryMapEnable = aParameter.value.bool_value;
+                }
+            }
+            break;
+
             default:
                 OSCL_ASSERT(0);
         }
@@ -21,6 +21,12 @@
 #define PDL_HTTP_USER_AGENT         _STRLIT_CHAR("PVPLAYER 04.07.00.01")
 #define PDL_HTTP_VERSION_NUMBER     0 // 0 => Http Version1.0 ; 1 => Http Version1.1
 
+// 1 => progressive streaming asks for "Connection: Keep-Alive" once the file size is known, and a seek
+// after a complete response sends the new GET request on the same connection if the server kept it open
+#ifndef PVPROTOCOLENGINE_PS_REUSE_CONNECTION
+#define PVPROTOCOLENGINE_PS_REUSE_CONNECTION 1
+#endif
+
 // macros for memory pool
 #define PVHTTPDOWNLOADOUTPUT_CONTENTDATA_POOLNUM 16
 #define PVHTTPSTREAMINGOUTPUT_CONTENTDATA_POOLNUM 1024
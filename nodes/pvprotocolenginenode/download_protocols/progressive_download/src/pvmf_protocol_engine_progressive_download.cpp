@@ -16,6 +16,7 @@
  * -------------------------------------------------------------------
  */
 #include "pvmf_protocol_engine_progressive_download.h"
+#include "pvmf_protocolengine_node_tunables.h"
 
 //////  ProgressiveDownloadState_HEAD implementation ////////////////////////////
 OSCL_EXPORT_REF void ProgressiveDownloadState_HEAD::setRequestBasics()
@@ -78,13 +79,16 @@ OSCL_EXPORT_REF bool ProgressiveDownloadState_GET::setHeaderFields()
     if (!ProtocolState::constructAuthenHeader(iCfgFile->GetUserId(), iCfgFile->GetUserAuth())) return false;
     if (!DownloadState::setHeaderFields()) return false;
 
-    // change "Connection" field
-    StrCSumPtrLen connectionKey = "Connection";
-    char *nullPtr = NULL; // remove "Connection" field
-    if (!iComposer->setField(connectionKey, nullPtr)) return false;
-    // reset "Connection: Close"
-    StrPtrLen  connectionValue = "Close";
-    if (!iComposer->setField(connectionKey, &connectionValue)) return false;
+    // change "Connection" field, unless the connection is kept for the next request
+    if (!needConnectionKeepAlive())
+    {
+        StrCSumPtrLen connectionKey = "Connection";
+        char *nullPtr = NULL; // remove "Connection" field
+        if (!iComposer->setField(connectionKey, nullPtr)) return false;
+        // reset "Connection: Close"
+        StrPtrLen  connectionValue = "Close";
+        if (!iComposer->setField(connectionKey, &connectionValue)) return false;
+    }
 
 
     return setExtensionFields(iCfgFile->getExtensionHeaderKeys(),
@@ -323,3 +327,10 @@ OSCL_EXPORT_REF int32 ProgressiveStreamingState_GET::checkParsingStatus(int32 pa
     return DownloadState::checkParsingStatus(parsingStatus);
 }
 
+
+OSCL_EXPORT_REF bool ProgressiveStreamingState_GET::needConnectionKeepAlive()
+{
+    // with the file size known, the end of each response comes from content-length
+    // rather than from the server closing the connection, so the connection can be reused on seek
+    return (PVPROTOCOLENGINE_PS_REUSE_CONNECTION && iCfgFile->GetOverallFileSize() > 0);
+}
@@ -77,6 +77,11 @@ class ProgressiveDownloadState_GET : public DownloadState
         OSCL_IMPORT_REF int32 processMicroStateGetResponsePreCheck();
         OSCL_IMPORT_REF virtual bool setHeaderFields();
         OSCL_IMPORT_REF bool setRangeHeaderFields();
+        // progressive download closes the connection after each response
+        virtual bool needConnectionKeepAlive()
+        {
+            return false;
+        }
         // From HttpParsingBasicObjectObserver
         OSCL_IMPORT_REF int32 OutputDataAvailable(OUTPUT_DATA_QUEUE *aOutputQueue, const bool isHttpHeader);
         OSCL_IMPORT_REF void updateOutputDataQueue(OUTPUT_DATA_QUEUE *aOutputQueue);
@@ -116,6 +121,7 @@ class ProgressiveStreamingState_GET : public ProgressiveDownloadState_GET
 
     protected:
         OSCL_IMPORT_REF int32 checkParsingStatus(int32 parsingStatus);
+        OSCL_IMPORT_REF bool needConnectionKeepAlive();
         void saveConfig()
         {
             ;
@@ -96,6 +96,10 @@ OSCL_EXPORT_REF uint32 ProgressiveStreamingContainer::getSeekOffset(PVMFProtocol
 
 OSCL_EXPORT_REF PVMFStatus ProgressiveStreamingContainer::doSeekBody(uint32 aNewOffset)
 {
+    // the connection can only carry the new GET request if the previous response is complete,
+    // otherwise the rest of it would have to be received first
+    bool reuseConnection = (iInterfacingObjectContainer->isDownloadStreamingDone() && canReuseConnection());
+
     // reset streaming done and session done flag to restart streaming
     ProtocolStateCompleteInfo aInfo;
     iInterfacingObjectContainer->setProtocolStateCompleteInfo(aInfo, true);
@@ -105,13 +109,40 @@ OSCL_EXPORT_REF PVMFStatus ProgressiveStreamingContainer::doSeekBody(uint32 aNew
     OsclSharedPtr<PVDlCfgFile> aCfgFile = iCfgFileContainer->getCfgFile();
     aCfgFile->SetCurrentFileSize(aNewOffset);
 
-    // Reconnect and send new GET request
+    // Flush out the input first, which picks up an EOS if the server has closed the connection meanwhile,
+    // then send new GET request on the same connection if it is still up, or reconnect
     iProtocol->seek(aNewOffset);
-    startDataFlowByCommand();
+    startDataFlowByCommand(false);
+    if (reuseConnection && iInterfacingObjectContainer->isSocketConnectionUp())
+    {
+        LOGINFODATAPATH((0, "ProgressiveStreamingContainer::doSeekBody(), send GET request on the kept-alive connection, offset=%d", aNewOffset));
+        iProtocol->sendRequest();
+    }
+    else
+    {
+        reconnectSocket();
+    }
 
     return PVMFPending;
 }
 
+OSCL_EXPORT_REF bool ProgressiveStreamingContainer::doEOS(const bool isTrueEOS)
+{
+    // download done, but keep the kept-alive connection for the GET request of a later seek.
+    // doStop() still disconnects it, and if the server closes it, the seek reconnects
+    if (isTrueEOS && canReuseConnection() && iInterfacingObjectContainer->isSocketConnectionUp())
+    {
+        LOGINFODATAPATH((0, "ProgressiveStreamingContainer::doEOS(), keep the connection open for seek"));
+        return true;
+    }
+    return ProgressiveDownloadContainer::doEOS(isTrueEOS);
+}
+
+OSCL_EXPORT_REF bool ProgressiveStreamingContainer::canReuseConnection()
+{
+    return (PVPROTOCOLENGINE_PS_REUSE_CONNECTION && iProtocol->isServerKeepAlive());
+}
+
 OSCL_EXPORT_REF bool ProgressiveStreamingContainer::completeRepositionRequest()
 {
     PVMFProtocolEngineNodeCommand *pCmd = iObserver->FindPendingCmd(PVPROTOCOLENGINE_NODE_CMD_DATASTREAM_REQUEST_REPOSITION);
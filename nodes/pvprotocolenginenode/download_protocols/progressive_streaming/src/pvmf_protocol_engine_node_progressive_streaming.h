@@ -33,6 +33,7 @@ class ProgressiveStreamingContainer : public ProgressiveDownloadContainer
         OSCL_IMPORT_REF virtual bool createProtocolObjects();
         OSCL_IMPORT_REF PVMFStatus doStop();
         OSCL_IMPORT_REF PVMFStatus doSeek(PVMFProtocolEngineNodeCommand& aCmd);
+        OSCL_IMPORT_REF bool doEOS(const bool isTrueEOS = true);
         OSCL_IMPORT_REF bool completeRepositionRequest();
         OSCL_IMPORT_REF bool doInfoUpdate(const uint32 downloadStatus);
         void enableInfoUpdate(const bool aEnabled = true)
@@ -49,6 +50,8 @@ class ProgressiveStreamingContainer : public ProgressiveDownloadContainer
         OSCL_IMPORT_REF PVMFStatus doSeekBody(uint32 aNewOffset);
         OSCL_IMPORT_REF void updateDownloadControl(const bool isDownloadComplete = false);
         OSCL_IMPORT_REF bool needToCheckResumeNotificationMaually();
+        // the server keeps the connection open after a complete response, so the next GET request can use it
+        OSCL_IMPORT_REF bool canReuseConnection();
 
     protected:
         bool iEnableInfoUpdate;
@@ -182,6 +182,7 @@ OSCL_EXPORT_REF int32 HttpParsingBasicObject::parseResponse(INPUT_DATA_QUEUE &aD
                 iHttpHeaderParsed = true;
                 iParser->getContentInfo(iContentInfo);
                 extractServerVersionNum();
+                extractConnectionKeepAlive();
 
                 // update BandWidthEstimationInfo
                 iBWEstInfo.update(mediaData, iHttpHeaderParsed);
@@ -300,6 +301,30 @@ void HttpParsingBasicObject::extractServerVersionNum()
     }
 }
 
+void HttpParsingBasicObject::extractConnectionKeepAlive()
+{
+    // HTTP/1.1 connections are persistent by default, HTTP/1.0 ones only with "Connection: Keep-Alive"
+    iServerKeepAlive = (iParser->getHTTPVersionNum() > 0);
+
+    StrCSumPtrLen connectionKey = "Connection";
+    StrPtrLen connectionValue;
+    if (!iParser->getField(connectionKey, connectionValue)) return;
+
+    const char *ptr = connectionValue.c_str();
+    for (int32 i = 0; i < connectionValue.length(); i++)
+    {
+        if (connectionValue.length() - i >= 5 && oscl_CIstrncmp(ptr + i, "close", 5) == 0)
+        {
+            iServerKeepAlive = false;
+            return;
+        }
+        if (connectionValue.length() - i >= 10 && oscl_CIstrncmp(ptr + i, "keep-alive", 10) == 0)
+        {
+            iServerKeepAlive = true;
+        }
+    }
+}
+
 bool HttpParsingBasicObject::saveOutputData(RefCountHTTPEntityUnit &entityUnit, OUTPUT_DATA_QUEUE &aOutputData, uint32 &aTotalEntityDataSize)
 {
     aTotalEntityDataSize = 0;
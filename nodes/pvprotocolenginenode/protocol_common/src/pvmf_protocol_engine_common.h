@@ -247,6 +247,10 @@ class ProtocolState : public HttpParsingBasicObjectObserver,
         {
             return (iParser == NULL ? 0 : iParser->getServerVersionNumber());
         }
+        virtual bool isServerKeepAlive()
+        {
+            return (iParser == NULL ? false : iParser->isServerKeepAlive());
+        }
         virtual void prepare()
         {
             ;    // prepare for the new state, especially store data from the previous state, for the current state
@@ -597,6 +601,10 @@ class HttpBasedProtocol : public ProtocolStateObserver,
         {
             return iCurrState->getServerVersionNumber();
         }
+        bool isServerKeepAlive()
+        {
+            return iCurrState->isServerKeepAlive();
+        }
         bool isSendingNewRequest()
         {
             return iCurrState->isSendingNewRequest();
@@ -668,6 +668,11 @@ class HttpParsingBasicObject
         {
             return iServerVersionNumber;
         }
+        // true if the server keeps the connection open after the current response
+        bool isServerKeepAlive() const
+        {
+            return iServerKeepAlive;
+        }
         OSCL_IMPORT_REF int32 isNewContentRangeInfoMatchingCurrentOne(const uint32 aPrevContentLength);
         bool isDownloadReallyHappen() const
         {
@@ -733,6 +738,7 @@ class HttpParsingBasicObject
             iContentInfo.clear();
             iBWEstInfo.clear();
             iHttpHeaderParsed = false;
+            iServerKeepAlive = false;
             iTotalDLHttpBodySize = 0;
             iLatestMediaDataTimestamp = 0;
         }
@@ -783,6 +789,8 @@ class HttpParsingBasicObject
         int32 checkParsingDone(const int32 parsingStatus);
         // extract the server version number from server field of a HTTP response
         void extractServerVersionNum();
+        // decide from the HTTP version and the connection field whether the server keeps the connection open
+        void extractConnectionKeepAlive();
         // called by getNextMediaData()
         bool isRedirectResponse();
 
@@ -801,6 +809,7 @@ class HttpParsingBasicObject
         HttpParsingBasicObjectObserver *iObserver;
         OUTPUT_DATA_QUEUE *iOutputQueue;
         uint32 iServerVersionNumber;
+        bool iServerKeepAlive;
         uint32 iTotalDLHttpBodySize;
         uint32 iNumEOSMessagesAfterRequest;// number of continuous EOS messages received after sending request
         uint32 iTotalDLSizeForPrevEOS; // for detecting download size change between two adjacent EOSs or start and first EOS
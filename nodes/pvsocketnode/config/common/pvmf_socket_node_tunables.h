@@ -94,6 +94,22 @@
 #define SNODE_UDP_MULTI_MIN_BYTES_PER_RECV (2*1024)
 #endif
 
+/*!
+// Define the per-packet limit for a multiple receive.  When the Oscl
+// socket layer receives packets in batches (PV_SOCKET_SERVER_RECVMMSG)
+// each packet gets a slot of this size, so a value above the network
+// MTU lets it drain many RTP packets per OS call.  A larger packet
+// may be truncated, and is reported with the "packet truncated" info event.
+// Zero means use the max UDP packet size, which never truncates but
+// allows only a couple of packets per batch.  Without batched receives
+// the limit is not used, since nothing would report the truncation.
+// This can be modified at compile-time by redefining the value
+// in an Oscl config file.
+*/
+#ifndef SNODE_UDP_MULTI_MAX_PACKET_SIZE
+#define SNODE_UDP_MULTI_MAX_PACKET_SIZE 2048
+#endif
+
 #endif// PVMF_SOCKET_NODE_TUNABLES_H_INCLUDED
 
 
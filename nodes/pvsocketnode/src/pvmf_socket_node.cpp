@@ -29,6 +29,7 @@
 #include "oscl_rand.h"
 #include "oscl_time.h"
 #include "pvmf_socket_node_tunables.h"
+#include "oscl_socket_tuneables.h"
 #include "oscl_bin_stream.h"
 // Use default DLL entry point for Symbian
 #include "oscl_dll.h"
@@ -1641,8 +1642,14 @@ PVMFStatus PVMFSocketNode::StartRecvOperation(SocketPortConfig& aSockConfig)
                 memSize = SNODE_UDP_MULTI_MAX_BYTES_PER_RECV + MAX_UDP_PACKET_SIZE;
                 //this is the amt of "free space" required to continue receiving
                 //additional packets. Use the max packet size to avoid truncated
-                //packets.
+                //packets, unless a smaller limit is configured for batched receives.
                 multiRecvLimitBytes = MAX_UDP_PACKET_SIZE;
+#if (PV_SOCKET_SERVER_RECVMMSG) && (SNODE_UDP_MULTI_MAX_PACKET_SIZE)
+                //only batched receives report truncated packets, the one
+                //packet per call loop keeps the max packet size.
+                if (SNODE_UDP_MULTI_MAX_PACKET_SIZE < multiRecvLimitBytes)
+                    multiRecvLimitBytes = SNODE_UDP_MULTI_MAX_PACKET_SIZE;
+#endif
 #else
                 //for single packet recvs.
                 memSize = MAX_UDP_PACKET_SIZE;
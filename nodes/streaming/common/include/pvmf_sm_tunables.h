@@ -157,6 +157,32 @@
 #define CONSECUTIVE_LOW_BUFFER_COUNT_THRESHOLD 100
 #define MIN_PERCENT_OCCUPANCY_THRESHOLD 10
 #define JITTER_BUFFER_DURATION_MULTIPLIER_THRESHOLD 1.5
+
+/*
+ * Adaptive playout delay related
+ * Set PVMF_JB_ADAPTIVE_DELAY to 1 to buffer only as long as the measured
+ * interarrival jitter needs, instead of the full jitter buffer duration.
+ * The configured duration is the upper limit of the target delay, and the
+ * rebuffering threshold is scaled down along with it.
+ */
+#ifndef PVMF_JB_ADAPTIVE_DELAY
+#define PVMF_JB_ADAPTIVE_DELAY 0
+#endif
+#define PVMF_JB_ADAPTIVE_DELAY_MIN_IN_MS                 200
+#define PVMF_JB_ADAPTIVE_DELAY_INITIAL_IN_MS             1000
+/* Number of packets to measure before the target is allowed to shrink */
+#define PVMF_JB_ADAPTIVE_DELAY_MIN_PACKETS               50
+/* Target = max(multiplier * jitter, peak delay spike) + margin */
+#define PVMF_JB_ADAPTIVE_DELAY_JITTER_MULTIPLIER         4
+#define PVMF_JB_ADAPTIVE_DELAY_MARGIN_IN_MS              100
+/* The target shrinks by at most this much per second */
+#define PVMF_JB_ADAPTIVE_DELAY_SHRINK_STEP_IN_MS         50
+/* The peak delay spike loses 1/2^shift of its value per second */
+#define PVMF_JB_ADAPTIVE_DELAY_PEAK_DECAY_SHIFT          3
+/* Growth applied on a packet that arrived after its playout time */
+#define PVMF_JB_ADAPTIVE_DELAY_LATE_PACKET_STEP_IN_MS    100
+/* No shrinking for this long after an underflow or a late packet */
+#define PVMF_JB_ADAPTIVE_DELAY_HOLD_OFF_IN_MS            10000
 #endif
 
 
@@ -2,6 +2,7 @@ LOCAL_PATH := $(call my-dir)
 include $(CLEAR_VARS)
 
 LOCAL_SRC_FILES := \
+        src/pvmf_jb_delay_controller.cpp \
         src/pvmf_jb_event_notifier.cpp \
         src/pvmf_jb_firewall_pkts_impl.cpp \
         src/pvmf_jb_jitterbuffermisc.cpp \
@@ -34,6 +35,7 @@ LOCAL_C_INCLUDES := \
 LOCAL_COPY_HEADERS_TO := $(PV_COPY_HEADERS_TO)
 
 LOCAL_COPY_HEADERS := \
+        include/pvmf_jb_delay_controller.h \
         include/pvmf_jb_event_notifier.h \
         include/pvmf_jb_jitterbuffermisc.h \
         include/pvmf_jitter_buffer.h \
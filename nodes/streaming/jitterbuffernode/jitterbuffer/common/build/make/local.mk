@@ -16,7 +16,8 @@ SRCDIR := ../../src
 INCSRCDIR := ../../include
 
 # compose final src list for actual build
-SRCS = pvmf_jb_event_notifier.cpp \
+SRCS = pvmf_jb_delay_controller.cpp \
+	 pvmf_jb_event_notifier.cpp \
 	 pvmf_jb_firewall_pkts_impl.cpp \
 	 pvmf_jb_jitterbuffermisc.cpp \
 	 pvmf_jb_session_duration_timer.cpp \
@@ -24,7 +25,8 @@ SRCS = pvmf_jb_event_notifier.cpp \
 	 pvmf_rtcp_proto_impl.cpp \
 	 pvmf_rtcp_timer.cpp
 
-HDRS = pvmf_jb_event_notifier.h \
+HDRS = pvmf_jb_delay_controller.h \
+	pvmf_jb_event_notifier.h \
 	pvmf_jb_jitterbuffermisc.h \
 	pvmf_jitter_buffer.h \
 	pvmf_jitter_buffer_common_types.h \
@@ -0,0 +1,142 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef PVMF_JB_DELAY_CONTROLLER_H_INCLUDED
+#define PVMF_JB_DELAY_CONTROLLER_H_INCLUDED
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+#ifndef PVMF_SM_TUNABLES_H_INCLUDED
+#include "pvmf_sm_tunables.h"
+#endif
+
+/**
+ * Playout delay controller of the jitter buffer.
+ * The interarrival jitter is estimated as in RFC 3550, in milliseconds, from
+ * the arrival time and the RTP timestamp of each packet. The target delay
+ * follows the jitter and the largest recent delay spike (which includes the
+ * reordering depth), grows at once when the network gets worse, on late
+ * packets and on underflows, and shrinks slowly when it gets better.
+ * The target never exceeds the configured jitter buffer duration.
+ * When PVMF_JB_ADAPTIVE_DELAY is 0 the statistics are still kept but the
+ * target is always the configured duration.
+ */
+class PVMFJBDelayController
+{
+    public:
+        PVMFJBDelayController();
+
+        /**
+         * Sets the maximum delay and starts over from the initial delay.
+         */
+        void Reset(uint32 aMaxDelayInMS);
+
+        /**
+         * Forgets the previous packet, e.g. after repositioning, so that the
+         * timestamp discontinuity is not taken for jitter.
+         */
+        void Resync()
+        {
+            iPrevValid = false;
+        }
+
+        /**
+         * Updates the estimates with a packet that was just received.
+         *
+         * @param aArrivalTimeInMS Arrival time of the packet
+         * @param aTimeStamp RTP timestamp of the packet
+         * @param aTimeScale RTP timescale
+         * @param aReordered True if a later packet was received before
+         */
+        void PacketArrived(uint32 aArrivalTimeInMS, uint32 aTimeStamp, uint32 aTimeScale, bool aReordered);
+
+        /**
+         * A packet arrived after it should have been played out.
+         */
+        void LatePacket();
+
+        /**
+         * The jitter buffer ran dry and has to rebuffer.
+         */
+        void Underflow();
+
+        uint32 GetTargetDelayInMS() const
+        {
+#if (PVMF_JB_ADAPTIVE_DELAY)
+            return iTargetDelayInMS;
+#else
+            return iMaxDelayInMS;
+#endif
+        }
+
+        /**
+         * Scales a threshold configured for the maximum delay down to the
+         * current target delay.
+         */
+        uint32 ScaleToTargetDelay(uint32 aValueInMS) const;
+
+        uint32 GetJitterInMS() const
+        {
+            return (iJitterQ4 + 8) >> 4;
+        }
+        uint32 GetNumReorderedPackets() const
+        {
+            return iNumReorderedPackets;
+        }
+        uint32 GetNumLatePackets() const
+        {
+            return iNumLatePackets;
+        }
+        uint32 GetNumTargetDelayIncreases() const
+        {
+            return iNumIncreases;
+        }
+        uint32 GetNumTargetDelayDecreases() const
+        {
+            return iNumDecreases;
+        }
+
+    private:
+        void Grow(uint32 aTargetInMS);
+
+        uint32 iMaxDelayInMS;
+        uint32 iTargetDelayInMS;
+
+        //Jitter estimate, in 1/16 ms
+        uint32 iJitterQ4;
+        //Largest recent delay spike
+        uint32 iPeakInMS;
+
+        bool   iPrevValid;
+        uint32 iPrevArrivalTimeInMS;
+        uint32 iPrevTimeStamp;
+        uint32 iNumPackets;
+
+        //Last time the target was allowed to shrink and the peak decayed
+        uint32 iLastTickInMS;
+        //Shrinking is held off until this time
+        uint32 iHoldOffUntilInMS;
+        bool   iHoldOff;
+
+        uint32 iNumReorderedPackets;
+        uint32 iNumLatePackets;
+        uint32 iNumIncreases;
+        uint32 iNumDecreases;
+};
+
+#endif // PVMF_JB_DELAY_CONTROLLER_H_INCLUDED
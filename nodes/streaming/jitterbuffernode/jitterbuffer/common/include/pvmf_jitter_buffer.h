@@ -79,6 +79,10 @@
 #include "pvmf_format_type.h"
 #endif
 
+#ifndef PVMF_JB_DELAY_CONTROLLER_H_INCLUDED
+#include "pvmf_jb_delay_controller.h"
+#endif
+
 class PVMFSMSharedBufferAllocWithReSize;
 
 
@@ -115,6 +119,14 @@ class PVMFJitterBufferStats
 
             maxTimeStampRetrievedWithoutRTPOffset = 0;
             ssrc = 0;
+
+            //Playout delay related
+            targetDelayInMS = 0;
+            interArrivalJitterInMS = 0;
+            numReorderedPackets = 0;
+            numLatePackets = 0;
+            numTargetDelayIncreases = 0;
+            numTargetDelayDecreases = 0;
         }
 
         //Packet info
@@ -142,6 +154,14 @@ class PVMFJitterBufferStats
 
         PVMFTimestamp maxTimeStampRetrievedWithoutRTPOffset;
         uint32 ssrc;
+
+        //Playout delay related, see PVMFJBDelayController
+        uint32 targetDelayInMS;
+        uint32 interArrivalJitterInMS;
+        uint32 numReorderedPackets;
+        uint32 numLatePackets;
+        uint32 numTargetDelayIncreases;
+        uint32 numTargetDelayDecreases;
 };
 
 class MediaCommandMsgHolder
@@ -1214,6 +1234,7 @@ class PVMFJitterBufferImpl : public PVMFJitterBuffer
         virtual bool CanRetrievePacket() = 0;
         virtual void DeterminePrevTimeStamp(uint32 aSeqNum) = 0;
         OSCL_IMPORT_REF virtual PVMFStatus PerformFlowControl(bool aIncomingMedia);
+        OSCL_IMPORT_REF void UpdatePlayoutDelayStats();
         uint32 iSeqNum;
         class JitterBufferMemPoolInfo
         {
@@ -1314,6 +1335,7 @@ class PVMFJitterBufferImpl : public PVMFJitterBuffer
         uint32 prevMinPercentOccupancy;
         uint32 consecutiveLowBufferCount;
         uint32 iNumUnderFlow;
+        PVMFJBDelayController iDelayController;
 
         bool   iMonitorReBufferingCallBkPending;
         bool   iWaitForOOOPacketCallBkPending;
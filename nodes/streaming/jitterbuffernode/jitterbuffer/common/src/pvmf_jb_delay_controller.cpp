@@ -0,0 +1,165 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef PVMF_JB_DELAY_CONTROLLER_H_INCLUDED
+#include "pvmf_jb_delay_controller.h"
+#endif
+
+PVMFJBDelayController::PVMFJBDelayController()
+{
+    Reset(0);
+}
+
+void PVMFJBDelayController::Reset(uint32 aMaxDelayInMS)
+{
+    iMaxDelayInMS = aMaxDelayInMS;
+    iTargetDelayInMS = OSCL_MIN(aMaxDelayInMS, (uint32)PVMF_JB_ADAPTIVE_DELAY_INITIAL_IN_MS);
+
+    iJitterQ4 = 0;
+    iPeakInMS = 0;
+
+    iPrevValid = false;
+    iPrevArrivalTimeInMS = 0;
+    iPrevTimeStamp = 0;
+    iNumPackets = 0;
+
+    iLastTickInMS = 0;
+    iHoldOffUntilInMS = 0;
+    iHoldOff = false;
+
+    iNumReorderedPackets = 0;
+    iNumLatePackets = 0;
+    iNumIncreases = 0;
+    iNumDecreases = 0;
+}
+
+void PVMFJBDelayController::PacketArrived(uint32 aArrivalTimeInMS, uint32 aTimeStamp, uint32 aTimeScale, bool aReordered)
+{
+    if (aReordered)
+    {
+        iNumReorderedPackets++;
+    }
+
+    if (aTimeScale == 0)
+    {
+        return;
+    }
+
+    if (!iPrevValid)
+    {
+        iPrevValid = true;
+        iPrevArrivalTimeInMS = aArrivalTimeInMS;
+        iPrevTimeStamp = aTimeStamp;
+        iLastTickInMS = aArrivalTimeInMS;
+        return;
+    }
+
+    /* D(i-1,i) = (RecvT(i) - RecvT(i-1)) - (RTP_TS(i) - RTP_TS(i-1)), in ms */
+    int32 arrivalDiff = (int32)(aArrivalTimeInMS - iPrevArrivalTimeInMS);
+    int32 tsDiff = (int32)(aTimeStamp - iPrevTimeStamp);
+    int32 tsDiffInMS = (int32)(((int64)tsDiff * 1000) / (int64)aTimeScale);
+    int32 diff = arrivalDiff - tsDiffInMS;
+    uint32 absDiff = (diff < 0) ? (uint32)(-diff) : (uint32)diff;
+
+    iPrevArrivalTimeInMS = aArrivalTimeInMS;
+    iPrevTimeStamp = aTimeStamp;
+
+    //Anything longer than the jitter buffer is a timestamp discontinuity
+    if ((iMaxDelayInMS > 0) && (absDiff > iMaxDelayInMS))
+    {
+        return;
+    }
+
+    /* J(i) = J(i-1) + (|D(i-1,i)| - J(i-1))/16 */
+    iJitterQ4 = iJitterQ4 + absDiff - ((iJitterQ4 + 8) >> 4);
+    if (absDiff > iPeakInMS)
+    {
+        iPeakInMS = absDiff;
+    }
+    iNumPackets++;
+
+    uint32 desired = PVMF_JB_ADAPTIVE_DELAY_JITTER_MULTIPLIER * GetJitterInMS();
+    if (iPeakInMS > desired)
+    {
+        desired = iPeakInMS;
+    }
+    desired += PVMF_JB_ADAPTIVE_DELAY_MARGIN_IN_MS;
+    if (desired < PVMF_JB_ADAPTIVE_DELAY_MIN_IN_MS)
+    {
+        desired = PVMF_JB_ADAPTIVE_DELAY_MIN_IN_MS;
+    }
+    Grow(desired);
+
+    if ((int32)(aArrivalTimeInMS - iLastTickInMS) < 1000)
+    {
+        return;
+    }
+    iLastTickInMS = aArrivalTimeInMS;
+    iPeakInMS -= iPeakInMS >> PVMF_JB_ADAPTIVE_DELAY_PEAK_DECAY_SHIFT;
+
+    if (iHoldOff && ((int32)(aArrivalTimeInMS - iHoldOffUntilInMS) >= 0))
+    {
+        iHoldOff = false;
+    }
+    if (!iHoldOff && (iNumPackets >= PVMF_JB_ADAPTIVE_DELAY_MIN_PACKETS) && (desired < iTargetDelayInMS))
+    {
+        uint32 target = desired;
+        if (iTargetDelayInMS > desired + PVMF_JB_ADAPTIVE_DELAY_SHRINK_STEP_IN_MS)
+        {
+            target = iTargetDelayInMS - PVMF_JB_ADAPTIVE_DELAY_SHRINK_STEP_IN_MS;
+        }
+        iTargetDelayInMS = target;
+        iNumDecreases++;
+    }
+}
+
+void PVMFJBDelayController::LatePacket()
+{
+    iNumLatePackets++;
+    Grow(iTargetDelayInMS + PVMF_JB_ADAPTIVE_DELAY_LATE_PACKET_STEP_IN_MS);
+    iHoldOff = true;
+    iHoldOffUntilInMS = iPrevArrivalTimeInMS + PVMF_JB_ADAPTIVE_DELAY_HOLD_OFF_IN_MS;
+}
+
+void PVMFJBDelayController::Underflow()
+{
+    Grow(2 * iTargetDelayInMS);
+    iHoldOff = true;
+    iHoldOffUntilInMS = iPrevArrivalTimeInMS + PVMF_JB_ADAPTIVE_DELAY_HOLD_OFF_IN_MS;
+}
+
+uint32 PVMFJBDelayController::ScaleToTargetDelay(uint32 aValueInMS) const
+{
+    if (iMaxDelayInMS == 0)
+    {
+        return aValueInMS;
+    }
+    return (uint32)(((uint64)aValueInMS * GetTargetDelayInMS()) / iMaxDelayInMS);
+}
+
+void PVMFJBDelayController::Grow(uint32 aTargetInMS)
+{
+    if (aTargetInMS > iMaxDelayInMS)
+    {
+        aTargetInMS = iMaxDelayInMS;
+    }
+    if (aTargetInMS > iTargetDelayInMS)
+    {
+        iTargetDelayInMS = aTargetInMS;
+        iNumIncreases++;
+    }
+}
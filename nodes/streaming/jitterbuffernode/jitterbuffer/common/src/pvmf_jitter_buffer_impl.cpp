@@ -61,6 +61,7 @@ void PVMFJitterBufferImpl::ResetParams(bool aReleaseMemory)
     iSessionDurationExpired = false;
     iDurationInMilliSeconds = 0;
     iRebufferingThresholdInMilliSeconds = 0;
+    iDelayController.Reset(0);
 
     iMonotonicTimeStamp = 0;
     iFirstSeqNum = 0;
@@ -161,6 +162,7 @@ OSCL_EXPORT_REF void PVMFJitterBufferImpl::SetRebufferingThresholdInMilliSeconds
 OSCL_EXPORT_REF void PVMFJitterBufferImpl::SetDurationInMilliSeconds(uint32 aDuration)
 {
     iDurationInMilliSeconds = aDuration;
+    iDelayController.Reset(aDuration);
 }
 
 OSCL_EXPORT_REF void PVMFJitterBufferImpl::PrepareForRepositioning()
@@ -169,6 +171,7 @@ OSCL_EXPORT_REF void PVMFJitterBufferImpl::PrepareForRepositioning()
     iEOSSignalled = false;
     iEOSSent = false;
     irDelayEstablished = false;
+    iDelayController.Resync();
 }
 
 OSCL_EXPORT_REF PVMFJitterBufferDataState PVMFJitterBufferImpl::GetState() const
@@ -487,6 +490,18 @@ OSCL_EXPORT_REF void PVMFJitterBufferImpl::ResetJitterBuffer()
     iMonotonicTimeStamp = 0;
     iPrevTSOut = 0;
     iMaxAdjustedRTPTS = 0;
+    iDelayController.Reset(iDurationInMilliSeconds);
+}
+
+OSCL_EXPORT_REF void PVMFJitterBufferImpl::UpdatePlayoutDelayStats()
+{
+    PVMFJitterBufferStats& jbStats = getJitterBufferStats();
+    jbStats.targetDelayInMS = iDelayController.GetTargetDelayInMS();
+    jbStats.interArrivalJitterInMS = iDelayController.GetJitterInMS();
+    jbStats.numReorderedPackets = iDelayController.GetNumReorderedPackets();
+    jbStats.numLatePackets = iDelayController.GetNumLatePackets();
+    jbStats.numTargetDelayIncreases = iDelayController.GetNumTargetDelayIncreases();
+    jbStats.numTargetDelayDecreases = iDelayController.GetNumTargetDelayDecreases();
 }
 
 OSCL_EXPORT_REF PVMFTimestamp PVMFJitterBufferImpl::peekNextElementTimeStamp()
@@ -894,7 +909,7 @@ OSCL_EXPORT_REF bool PVMFJitterBufferImpl::RequestEventCallBack(JB_NOTIFY_CALLBA
         case JB_BUFFERING_DURATION_COMPLETE:
         {
             PVMFJBEventNotificationRequestInfo eventRequestInfo(CLOCK_NOTIFICATION_INTF_TYPE_NONDECREASING, this, NULL);
-            retval = irJBEventNotifier.RequestCallBack(eventRequestInfo, iDurationInMilliSeconds, iJitterBufferDurationCallBkId);
+            retval = irJBEventNotifier.RequestCallBack(eventRequestInfo, iDelayController.GetTargetDelayInMS(), iJitterBufferDurationCallBkId);
             if (retval)
             {
                 iJitterBufferDurationCallBkPending = true;
@@ -53,6 +53,17 @@ const int32 iEstimatedServerKeepAheadInMilliSeconds = 2000;
 #define RTP_HEADER_M_BIT_OFFSET         7
 #define RTP_HEADER_PT_MASK              0x7F
 
+/* Read big endian RTP header fields straight from the packet */
+static inline uint16 RTPReadUint16(const uint8* aPtr)
+{
+    return (uint16)((aPtr[0] << 8) | aPtr[1]);
+}
+
+static inline uint32 RTPReadUint32(const uint8* aPtr)
+{
+    return (((uint32)aPtr[0] << 24) | ((uint32)aPtr[1] << 16) | ((uint32)aPtr[2] << 8) | (uint32)aPtr[3]);
+}
+
 OSCL_EXPORT_REF PVMFJitterBuffer* PVMFRTPJitterBufferImpl::New(const PVMFJitterBufferConstructParams& aCreationData)
 {
     PVMFRTPJitterBufferImpl* ptr = OSCL_NEW(PVMFRTPJitterBufferImpl, (aCreationData));
@@ -424,7 +435,8 @@ void PVMFRTPJitterBufferImpl::SetBurstThreshold(float aBurstThreshold)
 
 bool PVMFRTPJitterBufferImpl::IsDelayEstablished(uint32& aClockDiff)
 {
-    aClockDiff = iDurationInMilliSeconds;
+    const uint32 playoutDelayInMS = iDelayController.GetTargetDelayInMS();
+    aClockDiff = playoutDelayInMS;
     if (GetState() == PVMF_JITTER_BUFFER_IN_TRANSITION)
     {
         PVMF_JB_LOGCLOCK((0, "PVMFJitterBufferNode::IsDelayEstablished - Jitter Buffer In Transition - Preparing for Seek"));
@@ -475,6 +487,8 @@ bool PVMFRTPJitterBufferImpl::IsDelayEstablished(uint32& aClockDiff)
                 aClockDiff = 0;
                 irDelayEstablished = false;
                 irJitterDelayPercent = 0;
+                iDelayController.Underflow();
+                UpdatePlayoutDelayStats();
                 /* Start timer */
                 PVMFAsyncEvent jbEvent(PVMFInfoEvent, PVMFInfoUnderflow, NULL, NULL);
                 ReportJBInfoEvent(jbEvent);
@@ -570,7 +584,7 @@ bool PVMFRTPJitterBufferImpl::IsDelayEstablished(uint32& aClockDiff)
         }
         else
         {
-            if (diff32ms >= iDurationInMilliSeconds)
+            if (diff32ms >= playoutDelayInMS)
             {
                 if (iBufferAlloc)
                 {
@@ -646,15 +660,17 @@ bool PVMFRTPJitterBufferImpl::IsDelayEstablished(uint32& aClockDiff)
                 * status events, in case we go into rebuffering or if we are in buffering
                 * state.
                 */
-                irJitterDelayPercent = ((diff32ms * 100) / iDurationInMilliSeconds);
+                irJitterDelayPercent = ((diff32ms * 100) / playoutDelayInMS);
                 if (irDelayEstablished == true)
                 {
-                    if (diff32ms <= iRebufferingThresholdInMilliSeconds)
+                    if (diff32ms <= iDelayController.ScaleToTargetDelay(iRebufferingThresholdInMilliSeconds))
                     {
                         /* Implies that we are going into rebuffering */
                         if (!iEOSSignalled)
                         {
                             irDelayEstablished = false;
+                            iDelayController.Underflow();
+                            UpdatePlayoutDelayStats();
                             PVMFAsyncEvent jbEvent(PVMFInfoEvent, PVMFInfoUnderflow, NULL, NULL);
                             ReportJBInfoEvent(jbEvent);
                             LOGCLIENTANDESTIMATEDSERVCLK_REBUFF;
@@ -776,24 +792,15 @@ PVMFJBPacketParsingAndStatUpdationStatus PVMFRTPJitterBufferImpl::ParsePacketHea
         rtpHeader++;
 
         /* Parse sequence number */
-        uint16 seqNum16 = 0;
-        oscl_memcpy((char *)&seqNum16, rtpHeader, sizeof(seqNum16));
-        big_endian_to_host((char *)&seqNum16, sizeof(seqNum16));
-        seqNum = (uint32)seqNum16;
+        seqNum = (uint32)RTPReadUint16(rtpHeader);
         rtpHeader += 2;
 
         /* Parse rtp time stamp */
-        uint32 ts32 = 0;
-        oscl_memcpy((char *)&ts32, rtpHeader, sizeof(ts32));
-        big_endian_to_host((char *)&ts32, sizeof(ts32));
-        rtpTimeStamp = (PVMFTimestamp)ts32;
+        rtpTimeStamp = (PVMFTimestamp)RTPReadUint32(rtpHeader);
         rtpHeader += 4;
 
         /* Parse SSRC */
-        uint32 ssrc32 = 0;
-        oscl_memcpy((char *)&ssrc32, rtpHeader, sizeof(ssrc32));
-        big_endian_to_host((char *)&ssrc32, sizeof(ssrc32));
-        SSRC = ssrc32;
+        SSRC = RTPReadUint32(rtpHeader);
         rtpHeader += 4;
 
         rtpPacketLen -= RTP_FIXED_HEADER_SIZE;
@@ -814,10 +821,7 @@ PVMFJBPacketParsingAndStatUpdationStatus PVMFRTPJitterBufferImpl::ParsePacketHea
         if (xbit)
         {
             rtpHeader += 2;
-            uint16 len16 = 0;
-            oscl_memcpy((char *)&len16, rtpHeader, sizeof(len16));
-            big_endian_to_host((char *)&len16, sizeof(len16));
-            uint32 extensionHeaderLen = (uint32)len16;
+            uint32 extensionHeaderLen = (uint32)RTPReadUint16(rtpHeader);
             rtpPacketLen -= 4;
             if ((extensionHeaderLen*4) > rtpPacketLen)
             {
@@ -856,6 +860,36 @@ PVMFJBPacketParsingAndStatUpdationStatus PVMFRTPJitterBufferImpl::ParsePacketHea
         markerInfo = rtpPacketContainer->getMarkerInfo();
     }
 
+    //Validate the packet for Ts, Seq num etc... <only if seq num is locked>
+    //This is done before a media msg is allocated for the packet, so that late
+    //packets do not cost an allocation
+    if (seqNumLock)
+    {
+        //First packet is always considered to be valid
+        if (iFirstSeqNum != seqNum)
+        {
+            PVMFJitterBufferStats& jbStats = getJitterBufferStats();
+
+            if (iBroadCastSession == true)
+            {
+                /*
+                 * This can happen when using prerecorded transport streams that loop
+                 * If this happens, just signal an unexpected data event
+                 */
+                if (rtpTimeStamp < jbStats.maxTimeStampRegistered)
+                {
+                    return PVMF_JB_ERR_UNEXPECTED_PKT;
+                }
+            }
+            if (!IsSeqTsValidForPkt(seqNum, rtpTimeStamp, jbStats))
+            {
+                iDelayController.LatePacket();
+                UpdatePlayoutDelayStats();
+                return PVMF_JB_ERR_LATE_PACKET;
+            }
+        }
+    }
+
     if (iInPlaceProcessing == false)
     {
         OsclSharedPtr<PVMFMediaDataImpl> mediaDataOut;
@@ -866,11 +900,11 @@ PVMFJBPacketParsingAndStatUpdationStatus PVMFRTPJitterBufferImpl::ParsePacketHea
             return PVMF_JB_ERR_INSUFFICIENT_MEM_TO_PACKETIZE;
         }
 
-        OsclRefCounterMemFrag memFragOut(rtpPacket);
-        memFragOut.getMemFrag().ptr = rtpHeaderOffset;
-        memFragOut.getMemFrag().len = rtpPacketLenExcludingHeader;
+        //The payload is passed on as a slice of the received buffer
+        rtpPacket.getMemFrag().ptr = rtpHeaderOffset;
+        rtpPacket.getMemFrag().len = rtpPacketLenExcludingHeader;
 
-        mediaDataOut->appendMediaFragment(memFragOut);
+        mediaDataOut->appendMediaFragment(rtpPacket);
         mediaDataOut->setMarkerInfo(markerInfo);
 
         bool retVal = CreateMediaData(aOutDataPacket, mediaDataOut);
@@ -906,30 +940,6 @@ PVMFJBPacketParsingAndStatUpdationStatus PVMFRTPJitterBufferImpl::ParsePacketHea
                                SSRC, seqNum, rtpTimeStamp, rtpPacketLenExcludingHeader));
 
 
-    //Validate the packet for Ts, Seq num etc... <only if seq num is locked>
-    if (seqNumLock)
-    {
-        //First packet is always considered to be valid
-        if (iFirstSeqNum != seqNum)
-        {
-            PVMFJitterBufferStats& jbStats = getJitterBufferStats();
-
-            if (iBroadCastSession == true)
-            {
-                /*
-                 * This can happen when using prerecorded transport streams that loop
-                 * If this happens, just signal an unexpected data event
-                 */
-                if (rtpTimeStamp < jbStats.maxTimeStampRegistered)
-                {
-                    return PVMF_JB_ERR_UNEXPECTED_PKT;
-                }
-            }
-            if (!IsSeqTsValidForPkt(seqNum, rtpTimeStamp, jbStats))
-                return PVMF_JB_ERR_LATE_PACKET;
-        }
-    }
-
     if (iInPlaceProcessing)
     {
         UpdatePacketArrivalStats(rtpPacketContainer);
@@ -1004,6 +1014,14 @@ void PVMFRTPJitterBufferImpl::UpdatePacketArrivalStats(PVMFSharedMediaDataPtr& a
     /* Update variables */
     iPrevPacketTS = rtpTimeStamp;
     iPrevPacketRecvTime = currPacketRecvTime32;
+
+    /* Playout delay, from the jitter in milliseconds */
+    PVMFJitterBufferStats& jbStats = getJitterBufferStats();
+    uint16 delta = 0;
+    bool reordered = (jbStats.totalNumPacketsRegistered > 0) &&
+                     IsSequenceNumEarlier(OSCL_STATIC_CAST(uint16, aArrivedPacket->getSeqNum()), OSCL_STATIC_CAST(uint16, jbStats.maxSeqNumRegistered), delta);
+    iDelayController.PacketArrived(currPacketRecvTime32, rtpTimeStamp, (iRTPTimeScale ? iRTPTimeScale : iTimeScale), reordered);
+    UpdatePlayoutDelayStats();
 }
 
 bool PVMFRTPJitterBufferImpl::CanRetrievePacket()
@@ -1076,7 +1094,7 @@ bool PVMFRTPJitterBufferImpl::CanRetrievePacket()
             else
             {
                 CancelEventCallBack(JB_MONITOR_REBUFFERING);
-                RequestEventCallBack(JB_MONITOR_REBUFFERING, (clockDiff - iRebufferingThresholdInMilliSeconds));
+                RequestEventCallBack(JB_MONITOR_REBUFFERING, (clockDiff - iDelayController.ScaleToTargetDelay(iRebufferingThresholdInMilliSeconds)));
                 return false;
             }
         }
@@ -1203,7 +1221,7 @@ bool PVMFRTPJitterBufferImpl::CanRetrievePacket(PVMFSharedMediaMsgPtr& aMediaOut
             {
                 if (!IsCallbackPending(JB_MONITOR_REBUFFERING, NULL) && !iEOSSent)
                 {
-                    RequestEventCallBack(JB_MONITOR_REBUFFERING, (clockDiff - iRebufferingThresholdInMilliSeconds));
+                    RequestEventCallBack(JB_MONITOR_REBUFFERING, (clockDiff - iDelayController.ScaleToTargetDelay(iRebufferingThresholdInMilliSeconds)));
                 }
                 return false;
             }
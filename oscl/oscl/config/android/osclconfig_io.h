@@ -52,9 +52,11 @@
 #include <signal.h>
 #include <netdb.h>
 #include <sys/mman.h>
+#include <unistd.h>
 #include <sys/types.h>
 #include <errno.h>
 #include <sys/vfs.h>
+#include <sys/epoll.h>
 #include <dirent.h>
 //#include <glob.h>
 #if (OSCL_HAS_ANSI_STDLIB_SUPPORT)
@@ -71,11 +73,14 @@
 #define OSCL_FILE_BUFFER_MAX_SIZE   32768
 #define OSCL_HAS_PV_FILE_CACHE  0
 #define OSCL_HAS_LARGE_FILE_SUPPORT 1
+#define OSCL_HAS_MMAP_SUPPORT 1
 
 //For Sockets
 #define OSCL_HAS_SYMBIAN_SOCKET_SERVER 0
 #define OSCL_HAS_SYMBIAN_DNS_SERVER 0
 #define OSCL_HAS_BERKELEY_SOCKETS 1
+#define OSCL_HAS_EPOLL 1
+#define OSCL_HAS_RECVMMSG 0
 #define OSCL_HAS_SOCKET_SUPPORT 1
 
 //basic socket types
@@ -197,6 +202,39 @@ nbytes=recvfrom(s,(void*)(buf),(size_t)(len),0,(struct sockaddr*)p,paddrlen);\
     ok=(nhandles!=(-1));\
     if (!ok)err=errno
 
+//wrappers for epoll calls, used by the PV socket server in
+//edge-triggered mode.
+typedef struct epoll_event TOsclEpollEvent;
+
+#define OsclEpollCreate(efd,ok,err)\
+    efd=epoll_create(256);\
+    ok=(efd!=(-1));\
+    if (!ok)err=errno
+
+#define OsclEpollClose(efd)\
+    close(efd)
+
+#define OsclEpollAdd(efd,s,ok,err)\
+    do {\
+    struct epoll_event _epev;\
+    _epev.events=(EPOLLIN|EPOLLOUT|EPOLLPRI|EPOLLET);\
+    _epev.data.fd=s;\
+    ok=(epoll_ctl(efd,EPOLL_CTL_ADD,s,&_epev)!=(-1)||errno==EEXIST);\
+    if (!ok)err=errno;\
+    } while (0)
+
+#define OsclEpollWait(efd,events,maxevents,timeoutmsec,ok,err,nhandles)\
+    nhandles=epoll_wait(efd,events,maxevents,timeoutmsec);\
+    ok=(nhandles!=(-1)||errno==EINTR);\
+    if (nhandles<0){nhandles=0;if (!ok)err=errno;}
+
+//epoll event decoding.  unix reports socket errors and hangup to
+//both readers and writers, and OOB data in the except set.
+#define OsclEpollEventSocket(ev) ((ev).data.fd)
+#define OsclEpollEventReadable(ev) (((ev).events&(EPOLLIN|EPOLLHUP|EPOLLERR))!=0)
+#define OsclEpollEventWritable(ev) (((ev).events&(EPOLLOUT|EPOLLHUP|EPOLLERR))!=0)
+#define OsclEpollEventExcept(ev) (((ev).events&EPOLLPRI)!=0)
+
 //there's not really any socket startup needed on unix, but
 //you need to define a signal handler for SIGPIPE to avoid
 //broken pipe crashes.
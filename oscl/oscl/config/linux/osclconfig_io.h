@@ -49,6 +49,10 @@
 #include <netdb.h>
 #include <sys/types.h>
 #include <sys/vfs.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include <glob.h>
 
 
@@ -60,11 +64,14 @@
 #define OSCL_FILE_BUFFER_MAX_SIZE   32768
 #define OSCL_HAS_PV_FILE_CACHE  1
 #define OSCL_HAS_LARGE_FILE_SUPPORT 1
+#define OSCL_HAS_MMAP_SUPPORT 1
 
 //For Sockets
 #define OSCL_HAS_SYMBIAN_SOCKET_SERVER 0
 #define OSCL_HAS_SYMBIAN_DNS_SERVER 0
 #define OSCL_HAS_BERKELEY_SOCKETS 1
+#define OSCL_HAS_EPOLL 1
+#define OSCL_HAS_RECVMMSG 1
 #define OSCL_HAS_SOCKET_SUPPORT 1
 #define OSCL_HAS_SELECTABLE_PIPES 1
 
@@ -183,6 +190,61 @@ typedef socklen_t TOsclSockAddrLen;
     ok=(nhandles!=(-1));\
     if (!ok)err=errno
 
+//wrappers for batched datagram receive.
+typedef struct mmsghdr TOsclMMsgHdr;
+typedef struct iovec TOsclIOVec;
+
+#define OsclInitMMsg(msg,iov,buf,len,paddr)\
+    iov.iov_base=(void*)(buf);\
+    iov.iov_len=(size_t)(len);\
+    memset(&msg,0,sizeof(msg));\
+    msg.msg_hdr.msg_iov=&iov;\
+    msg.msg_hdr.msg_iovlen=1;\
+    msg.msg_hdr.msg_name=(void*)(paddr);\
+    msg.msg_hdr.msg_namelen=sizeof(*(paddr))
+
+#define OsclMMsgLen(msg) ((int)(msg).msg_len)
+#define OsclMMsgAddrLen(msg) ((msg).msg_hdr.msg_namelen)
+#define OsclMMsgTruncated(msg) (((msg).msg_hdr.msg_flags&MSG_TRUNC)!=0)
+
+#define OsclRecvMMsg(s,msgs,vlen,ok,err,nmsgs,wouldblock)\
+    nmsgs=recvmmsg(s,msgs,(unsigned int)(vlen),MSG_DONTWAIT,NULL);\
+    ok=(nmsgs!=(-1));\
+    if (!ok){err=errno;wouldblock=(err==EAGAIN||err==EWOULDBLOCK);}
+
+//wrappers for epoll calls, used by the PV socket server in
+//edge-triggered mode.
+typedef struct epoll_event TOsclEpollEvent;
+
+#define OsclEpollCreate(efd,ok,err)\
+    efd=epoll_create(256);\
+    ok=(efd!=(-1));\
+    if (!ok)err=errno
+
+#define OsclEpollClose(efd)\
+    close(efd)
+
+#define OsclEpollAdd(efd,s,ok,err)\
+    do {\
+    struct epoll_event _epev;\
+    _epev.events=(EPOLLIN|EPOLLOUT|EPOLLPRI|EPOLLET);\
+    _epev.data.fd=s;\
+    ok=(epoll_ctl(efd,EPOLL_CTL_ADD,s,&_epev)!=(-1)||errno==EEXIST);\
+    if (!ok)err=errno;\
+    } while (0)
+
+#define OsclEpollWait(efd,events,maxevents,timeoutmsec,ok,err,nhandles)\
+    nhandles=epoll_wait(efd,events,maxevents,timeoutmsec);\
+    ok=(nhandles!=(-1)||errno==EINTR);\
+    if (nhandles<0){nhandles=0;if (!ok)err=errno;}
+
+//epoll event decoding.  unix reports socket errors and hangup to
+//both readers and writers, and OOB data in the except set.
+#define OsclEpollEventSocket(ev) ((ev).data.fd)
+#define OsclEpollEventReadable(ev) (((ev).events&(EPOLLIN|EPOLLHUP|EPOLLERR))!=0)
+#define OsclEpollEventWritable(ev) (((ev).events&(EPOLLOUT|EPOLLHUP|EPOLLERR))!=0)
+#define OsclEpollEventExcept(ev) (((ev).events&EPOLLPRI)!=0)
+
 //there's not really any socket startup needed on unix, but
 //you need to define a signal handler for SIGPIPE to avoid
 //broken pipe crashes.
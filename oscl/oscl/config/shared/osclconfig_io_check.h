@@ -77,6 +77,12 @@ Otherwise it should be set to 0.
 #error "ERROR: OSCL_HAS_LARGE_FILE_SUPPORT has to be defined to either 1 or 0"
 #endif
 
+/**
+OSCL_HAS_MMAP_SUPPORT macro should be set to 1 if the target platform
+can map a file into memory for reading (mmap, munmap, sysconf).
+Otherwise it may be left undefined or set to 0.
+*/
+
 /**
 type TOsclFileOffset should be defined as the type used for file size
 and offsets on the target platform.
@@ -409,6 +415,78 @@ to the select error.
 #endif
 #endif
 
+/**
+OSCL_HAS_EPOLL macro should be set to 1 if the target platform
+supports the Linux epoll interface for socket readiness notification.
+Otherwise it may be left undefined or set to 0.
+When set to 1, the type TOsclEpollEvent and the macros
+OsclEpollCreate(efd,ok,err), OsclEpollClose(efd),
+OsclEpollAdd(efd,s,ok,err) (edge-triggered registration for read,
+write and except activity),
+OsclEpollWait(efd,events,maxevents,timeoutmsec,ok,err,nhandles),
+and the event decoding macros OsclEpollEventSocket(ev),
+OsclEpollEventReadable(ev), OsclEpollEventWritable(ev) and
+OsclEpollEventExcept(ev) must be defined.
+*/
+#if OSCL_HAS_EPOLL
+#ifndef OsclEpollCreate
+#error "ERROR: OsclEpollCreate(efd,ok,err) has to be defined"
+#endif
+#ifndef OsclEpollClose
+#error "ERROR: OsclEpollClose(efd) has to be defined"
+#endif
+#ifndef OsclEpollAdd
+#error "ERROR: OsclEpollAdd(efd,s,ok,err) has to be defined"
+#endif
+#ifndef OsclEpollWait
+#error "ERROR: OsclEpollWait(efd,events,maxevents,timeoutmsec,ok,err,nhandles) has to be defined"
+#endif
+#ifndef OsclEpollEventSocket
+#error "ERROR: OsclEpollEventSocket(ev) has to be defined"
+#endif
+#ifndef OsclEpollEventReadable
+#error "ERROR: OsclEpollEventReadable(ev) has to be defined"
+#endif
+#ifndef OsclEpollEventWritable
+#error "ERROR: OsclEpollEventWritable(ev) has to be defined"
+#endif
+#ifndef OsclEpollEventExcept
+#error "ERROR: OsclEpollEventExcept(ev) has to be defined"
+#endif
+#endif
+
+/**
+OSCL_HAS_RECVMMSG macro should be set to 1 if the target platform
+can receive several datagrams in one call (recvmmsg).
+Otherwise it may be left undefined or set to 0.
+When set to 1, the types TOsclMMsgHdr and TOsclIOVec and the macros
+OsclInitMMsg(msg,iov,buf,len,paddr) (set up one receive slot of 'len'
+bytes at 'buf' with the source address going to 'paddr'),
+OsclMMsgLen(msg), OsclMMsgAddrLen(msg), OsclMMsgTruncated(msg) (true
+when the datagram was larger than its slot) and
+OsclRecvMMsg(s,msgs,vlen,ok,err,nmsgs,wouldblock) must be defined.
+OsclRecvMMsg must not block, and follows the same 'ok', 'err' and
+'wouldblock' conventions as OsclRecvFrom, with 'nmsgs' set to the
+number of datagrams received.
+*/
+#if OSCL_HAS_RECVMMSG
+#ifndef OsclInitMMsg
+#error "ERROR: OsclInitMMsg(msg,iov,buf,len,paddr) has to be defined"
+#endif
+#ifndef OsclMMsgLen
+#error "ERROR: OsclMMsgLen(msg) has to be defined"
+#endif
+#ifndef OsclMMsgAddrLen
+#error "ERROR: OsclMMsgAddrLen(msg) has to be defined"
+#endif
+#ifndef OsclMMsgTruncated
+#error "ERROR: OsclMMsgTruncated(msg) has to be defined"
+#endif
+#ifndef OsclRecvMMsg
+#error "ERROR: OsclRecvMMsg(s,msgs,vlen,ok,err,nmsgs,wouldblock) has to be defined"
+#endif
+#endif
+
 /**
 For platforms with Berkeley type sockets,
 OsclSocketStartup(ok) must be defined to
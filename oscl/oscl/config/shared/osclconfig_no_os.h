@@ -53,6 +53,7 @@
 #define OSCL_HAS_SYMBIAN_SCHEDULER 0
 #define OSCL_HAS_SEM_TIMEDWAIT_SUPPORT 0
 #define OSCL_HAS_PTHREAD_SUPPORT 0
+#define OSCL_HAS_ATOMIC_SUPPORT 0
 
 //osclconfig_io
 #define OSCL_HAS_SYMBIAN_COMPATIBLE_IO_FUNCTION 0
@@ -65,6 +65,46 @@ Otherwise it should be set to 0.
 #error "ERROR: OSCL_HAS_PTHREAD_SUPPORT has to be defined to either 1 or 0"
 #endif
 
+/**
+OSCL_HAS_ATOMIC_SUPPORT macro should be set to 1 if
+the target platform supports atomic compare-and-swap operations.
+Otherwise it should be set to 0.
+*/
+#ifndef OSCL_HAS_ATOMIC_SUPPORT
+#error "ERROR: OSCL_HAS_ATOMIC_SUPPORT has to be defined to either 1 or 0"
+#endif
+
+/**
+When OSCL_HAS_ATOMIC_SUPPORT is 1, the following macros must be defined.
+Each one must act as a full memory barrier.
+
+OsclAtomicCompareAndSwap(ptr,oldval,newval) should atomically replace
+the value at ptr with newval if it equals oldval, and evaluate to true
+if the replacement was done.
+Example:
+#define OsclAtomicCompareAndSwap(ptr,oldval,newval) __sync_bool_compare_and_swap(ptr,oldval,newval)
+
+OsclAtomicAdd(ptr,val) should atomically add val to the integer at ptr
+and evaluate to the new value.
+Example:
+#define OsclAtomicAdd(ptr,val) __sync_add_and_fetch(ptr,val)
+
+OsclAtomicMemoryBarrier() should issue a full memory barrier.
+Example:
+#define OsclAtomicMemoryBarrier() __sync_synchronize()
+*/
+#if OSCL_HAS_ATOMIC_SUPPORT
+#ifndef OsclAtomicCompareAndSwap
+#error "ERROR: OsclAtomicCompareAndSwap has to be defined"
+#endif
+#ifndef OsclAtomicAdd
+#error "ERROR: OsclAtomicAdd has to be defined"
+#endif
+#ifndef OsclAtomicMemoryBarrier
+#error "ERROR: OsclAtomicMemoryBarrier has to be defined"
+#endif
+#endif
+
 /**
 type TOsclThreadId should be defined as the type used as
 a thread ID
@@ -56,4 +56,11 @@ typedef pthread_mutex_t TOsclMutexObject;
 typedef sem_t TOsclSemaphoreObject;
 typedef pthread_cond_t TOsclConditionObject;
 
+//atomic operations, using the gcc builtins.
+//these are full memory barriers.
+#define OSCL_HAS_ATOMIC_SUPPORT 1
+#define OsclAtomicCompareAndSwap(ptr,oldval,newval) __sync_bool_compare_and_swap(ptr,oldval,newval)
+#define OsclAtomicAdd(ptr,val) __sync_add_and_fetch(ptr,val)
+#define OsclAtomicMemoryBarrier() __sync_synchronize()
+
 #endif
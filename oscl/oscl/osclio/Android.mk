@@ -14,6 +14,7 @@ LOCAL_SRC_FILES := \
  	src/oscl_file_dir_utils.cpp \
  	src/oscl_file_find.cpp \
  	src/oscl_file_io.cpp \
+ 	src/oscl_file_map.cpp \
  	src/oscl_file_native.cpp \
  	src/oscl_file_server.cpp \
  	src/oscl_file_stats.cpp \
@@ -65,6 +66,7 @@ LOCAL_COPY_HEADERS := \
  	src/oscl_file_server.h \
  	src/oscl_socket.h \
  	src/oscl_socket_types.h \
+ 	src/oscl_socket_tuneables.h \
  	src/oscl_dns.h \
  	src/oscl_file_types.h
 
@@ -24,6 +24,7 @@ SRCS :=	oscl_dns.cpp \
 	oscl_file_dir_utils.cpp \
 	oscl_file_find.cpp \
 	oscl_file_io.cpp \
+	oscl_file_map.cpp \
 	oscl_file_native.cpp \
 	oscl_file_server.cpp \
 	oscl_file_stats.cpp \
@@ -57,6 +58,7 @@ HDRS := oscl_file_dir_utils.h \
 	oscl_file_server.h \
 	oscl_socket.h \
 	oscl_socket_types.h \
+	oscl_socket_tuneables.h \
 	oscl_dns.h \
 	oscl_file_types.h
 
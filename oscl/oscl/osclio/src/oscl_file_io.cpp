@@ -29,6 +29,8 @@
 #include "oscl_string_containers.h"
 #include "oscl_file_stats.h"
 #include "oscl_file_async_read.h"
+#include "oscl_file_map.h"
+#include "oscl_refcounter_memfrag.h"
 
 #ifndef OSCL_COMBINED_DLL
 OSCL_DLL_ENTRY_POINT_DEFAULT()
@@ -59,6 +61,8 @@ void Oscl_File::Construct()
     iPVCacheSize = 0;
     iAsyncReadBufferSize = 0;
     iAsyncFile = NULL;
+    iMemoryMapEnable = false;
+    iFileMap = NULL;
 
     //Create the native file I/O implementation
     int32 err;
@@ -167,6 +171,29 @@ OSCL_EXPORT_REF void Oscl_File::SetAsyncReadBufferSize(uint32 aSize)
 
 }
 
+OSCL_EXPORT_REF void Oscl_File::SetMemoryMapEnable(bool aEnable)
+{
+    //just save the value now-- it will take effect on the next open.
+    iMemoryMapEnable = aEnable;
+}
+
+OSCL_EXPORT_REF bool Oscl_File::GetMappedFragment(TOsclFileOffset aOffset, uint32 aLen, OsclRefCounterMemFrag& aFrag)
+{
+    if (!iIsOpen || !iFileMap)
+        return false;
+
+    uint8* data = iFileMap->Data(aOffset, aLen);
+    if (!data)
+        return false;
+
+    OsclMemoryFragment memfrag;
+    memfrag.ptr = data;
+    memfrag.len = aLen;
+    iFileMap->addRef();
+    aFrag = OsclRefCounterMemFrag(memfrag, iFileMap, aLen);
+    return true;
+}
+
 OSCL_EXPORT_REF void Oscl_File::SetLoggingEnable(bool aEnable)
 {
     if (aEnable)
@@ -250,11 +277,30 @@ int32 Oscl_File::OpenFileCacheOrAsyncBuffer(const char *filename
         , uint32 mode
         , const OsclNativeFileParams& params
         , Oscl_FileServer& fileserv)
-//open pv cache or async file implementation for the given open mode.
+//open file map, pv cache or async file implementation for the given open mode.
 //if cache is not enabled, then cleanup any old implementation.
 {
+    bool readOnly = (mode == MODE_READ || mode == MODE_READ + MODE_BINARY);
+
+    //map the file when read-only mode and iMemoryMapEnable is set.
+    //if the file can't be mapped, go on with the other options.
+    if (readOnly && iMemoryMapEnable)
+    {
+        iFileMap = OsclFileMap::New(*iNativeFile);
+        if (iFileMap)
+        {
+            if (iFileCache)
+                OSCL_DELETE(iFileCache);
+            iFileCache = NULL;
+            if (iAsyncFile)
+                OsclAsyncFile::Delete(iAsyncFile);
+            iAsyncFile = NULL;
+            return 0;
+        }
+    }
+
     //use async buffer when read-only mode and iAsyncReadBufferSize is > 0
-    bool asyncEnable = ((mode == MODE_READ || mode == MODE_READ + MODE_BINARY) && iAsyncReadBufferSize > 0);
+    bool asyncEnable = (readOnly && iAsyncReadBufferSize > 0);
 
     //use cache when *not* using async file and iPVCacheSize is > 0
     bool cacheEnable = !asyncEnable && (iPVCacheSize > 0);
@@ -451,7 +497,13 @@ OSCL_EXPORT_REF int32 Oscl_File::Close()
 
     if (iIsOpen)
     {
-        if (iFileCache)
+        if (iFileMap)
+        {
+            //the mapping is deleted when the last fragment is released.
+            iFileMap->removeRef();
+            iFileMap = NULL;
+        }
+        else if (iFileCache)
             iFileCache->Close();
         else if (iAsyncFile)
             iAsyncFile->Close();
@@ -499,7 +551,9 @@ OSCL_EXPORT_REF uint32 Oscl_File::Read(OsclAny *buffer, uint32 size, uint32 nume
 
     if (iIsOpen)
     {
-        if (iFileCache)
+        if (iFileMap)
+            result = iFileMap->Read(buffer, size, numelements);
+        else if (iFileCache)
             result = iFileCache->Read(buffer, size, numelements);
         else if (iAsyncFile)
             result = iAsyncFile->Read(buffer, size, numelements);
@@ -572,7 +626,9 @@ OSCL_EXPORT_REF int32 Oscl_File::Seek(TOsclFileOffset offset, seek_type origin)
 
     if (iIsOpen)
     {
-        if (iFileCache)
+        if (iFileMap)
+            result = iFileMap->Seek(offset, origin);
+        else if (iFileCache)
             result = iFileCache->Seek(offset, origin);
         else if (iAsyncFile)
             result = iAsyncFile->Seek(offset, origin);
@@ -609,7 +665,9 @@ OSCL_EXPORT_REF TOsclFileOffset Oscl_File::Tell()
 
     if (iIsOpen)
     {
-        if (iFileCache)
+        if (iFileMap)
+            result = iFileMap->Tell();
+        else if (iFileCache)
             result = iFileCache->Tell();
         else if (iAsyncFile)
             result = iAsyncFile->Tell();
@@ -681,7 +739,9 @@ OSCL_EXPORT_REF int32 Oscl_File::EndOfFile()
     int32 result = (-1);
     if (iIsOpen)
     {
-        if (iFileCache)
+        if (iFileMap)
+            result = iFileMap->EndOfFile();
+        else if (iFileCache)
             result = iFileCache->EndOfFile();
         else if (iAsyncFile)
             result = iAsyncFile->EndOfFile();
@@ -717,7 +777,9 @@ OSCL_EXPORT_REF TOsclFileOffset Oscl_File::Size()
 
     if (iIsOpen)
     {
-        if (iFileCache)
+        if (iFileMap)
+            result = iFileMap->Size();
+        else if (iFileCache)
             result = iFileCache->FileSize();
         else if (iAsyncFile)
             result = iAsyncFile->Size();
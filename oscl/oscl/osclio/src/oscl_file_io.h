@@ -65,6 +65,8 @@ class OsclNativeFile;
 class OsclFileStats;
 class OsclNativeFileParams;
 class OsclAsyncFile;
+class OsclFileMap;
+class OsclRefCounterMemFrag;
 #define TOsclFileOffsetInt32 int32
 
 class Oscl_File : public HeapBase
@@ -209,6 +211,54 @@ class Oscl_File : public HeapBase
          */
         OSCL_IMPORT_REF void SetAsyncReadBufferSize(uint32 aSize);
 
+        /**
+         * SetMemoryMapEnable configures read-only memory mapping of the file,
+         *   when available.  A mapped file is read straight from the mapping
+         *   and can hand out fragments of itself with GetMappedFragment,
+         *   without copying the data.
+         *
+         *   Mapping is only used for read-only open modes.  It takes
+         *   priority over the PV cache and the asynchronous read buffer.
+         *   If the file can't be mapped, for instance because it is too
+         *   large for the address space, the file is opened as usual.
+         *
+         *   Only map files that don't change while they are open.  The
+         *   file size is fixed when the file is opened, so data appended
+         *   later can't be read, and if the file is truncated, reading
+         *   the lost part of the mapping raises SIGBUS.  This applies to
+         *   fragments from GetMappedFragment as well.
+         *
+         *   This should be called before opening the file.  If used when
+         *   the file is open, the option will not take effect until the
+         *   next Open.
+         *
+         * @param aEnable: true to enable, false to disable mapping.
+         */
+        OSCL_IMPORT_REF void SetMemoryMapEnable(bool aEnable);
+
+        /**
+         * Get a fragment of a memory-mapped file, without copying the data.
+         *
+         *   The fragment holds a reference to the mapping, so it stays
+         *   valid after the file is closed.  The fragment memory is
+         *   read-only.  The file position is not changed.
+         *
+         * @param aOffset: file offset of the fragment.
+         * @param aLen: length of the fragment in bytes.
+         * @param aFrag: returns the fragment.
+         * @return true if successful, false if the file isn't mapped
+         *   or the range is past the end of the file.
+         */
+        OSCL_IMPORT_REF bool GetMappedFragment(TOsclFileOffset aOffset, uint32 aLen, OsclRefCounterMemFrag& aFrag);
+
+        /**
+         * @return true if the file is open and memory-mapped.
+         */
+        bool IsMemoryMapped()
+        {
+            return (iFileMap != NULL);
+        }
+
         /**
          * SetFileHandle adds an open file handle to the Oscl_File object.
          *   The Oscl_File object will use that handle to access the file.
@@ -439,6 +489,10 @@ class Oscl_File : public HeapBase
         uint32 iAsyncReadBufferSize;
         OsclAsyncFile* iAsyncFile;
 
+        //For memory map feature
+        bool iMemoryMapEnable;
+        OsclFileMap* iFileMap;
+
         // These are wrappers to call the Native OS File IO calls with
         // stats and logging.
 
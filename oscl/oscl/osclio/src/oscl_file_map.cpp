@@ -0,0 +1,126 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*! \file oscl_file_map.cpp
+    \brief This file contains the read-only file mapping used by Oscl_File
+*/
+
+#include "oscl_file_map.h"
+#include "oscl_file_native.h"
+#include "oscl_mem.h"
+
+OsclFileMap* OsclFileMap::New(OsclNativeFile& aFile)
+{
+    OsclAny* base = NULL;
+    TOsclFileOffset mapLen = 0;
+    uint8* data = NULL;
+    TOsclFileOffset size = 0;
+    if (aFile.Map(base, mapLen, data, size) != 0)
+        return NULL;
+
+    OsclFileMap* self = NULL;
+    int32 err;
+    OSCL_TRY(err, self = OSCL_NEW(OsclFileMap, ()););
+    if (err != OsclErrNone || !self)
+    {
+        OsclNativeFile::Unmap(base, mapLen);
+        return NULL;
+    }
+    self->iBase = base;
+    self->iMapLen = mapLen;
+    self->iData = data;
+    self->iSize = size;
+    return self;
+}
+
+OsclFileMap::OsclFileMap()
+{
+    iBase = NULL;
+    iMapLen = 0;
+    iData = NULL;
+    iSize = 0;
+    iPosition = 0;
+    iLock.Create();
+    iRefCount = 1;
+}
+
+OsclFileMap::~OsclFileMap()
+{
+    OsclNativeFile::Unmap(iBase, iMapLen);
+    iLock.Close();
+}
+
+void OsclFileMap::addRef()
+{
+    iLock.Lock();
+    iRefCount++;
+    iLock.Unlock();
+}
+
+void OsclFileMap::removeRef()
+{
+    iLock.Lock();
+    uint32 count = --iRefCount;
+    iLock.Unlock();
+    if (count == 0)
+        OSCL_DELETE(this);
+}
+
+uint32 OsclFileMap::getCount()
+{
+    return iRefCount;
+}
+
+uint32 OsclFileMap::Read(OsclAny* aBuffer, uint32 aSize, uint32 aNumElements)
+{
+    //like fread, a partial element at the end of the file is read
+    //but not counted.
+    if (!aSize || !aNumElements || !aBuffer)
+        return 0;
+    TOsclFileOffset bytes = (TOsclFileOffset)aSize * aNumElements;
+    if (iPosition >= iSize)
+        return 0;
+    if (bytes > iSize - iPosition)
+        bytes = iSize - iPosition;
+    oscl_memcpy(aBuffer, iData + iPosition, (uint32)bytes);
+    iPosition += bytes;
+    return (uint32)(bytes / aSize);
+}
+
+int32 OsclFileMap::Seek(TOsclFileOffset aOffset, Oscl_File::seek_type aOrigin)
+{
+    TOsclFileOffset pos;
+    switch (aOrigin)
+    {
+        case Oscl_File::SEEKSET:
+            pos = aOffset;
+            break;
+        case Oscl_File::SEEKCUR:
+            pos = iPosition + aOffset;
+            break;
+        case Oscl_File::SEEKEND:
+            pos = iSize + aOffset;
+            break;
+        default:
+            return -1;
+    }
+    if (pos < 0)
+        return -1;
+    iPosition = pos;
+    return 0;
+}
+
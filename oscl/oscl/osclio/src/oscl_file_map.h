@@ -0,0 +1,134 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// -*- c++ -*-
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+//                     O S C L _ F I L E  _ M A P
+
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+/*! \addtogroup osclio OSCL IO
+ *
+ * @{
+ */
+
+
+/*! \file oscl_file_map.h
+    \brief The file oscl_file_map.h defines the class OsclFileMap
+
+*/
+
+#ifndef OSCL_FILE_MAP_H_INCLUDED
+#define OSCL_FILE_MAP_H_INCLUDED
+
+#ifndef OSCLCONFIG_IO_H_INCLUDED
+#include "osclconfig_io.h"
+#endif
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+
+#ifndef OSCL_REFCOUNTER_H_INCLUDED
+#include "oscl_refcounter.h"
+#endif
+
+#ifndef OSCL_MUTEX_H_INCLUDED
+#include "oscl_mutex.h"
+#endif
+
+#include "oscl_file_io.h"
+
+class OsclNativeFile;
+
+/**
+ * OsclFileMap is a read-only memory mapping of a whole file.
+ *
+ * The mapping is reference counted.  Oscl_File holds one reference while
+ * the file is open, and each fragment returned by Oscl_File::GetMappedFragment
+ * holds another, so fragments stay valid after the file is closed.  The
+ * mapping is released when the last reference is removed.
+ *
+ * The size is the file size when the mapping was made, and the file must
+ * not change while it is mapped.  Data appended later is not seen, and
+ * reading a mapped page past the end of a truncated file raises SIGBUS.
+ */
+class OsclFileMap : public OsclRefCounter
+{
+    public:
+        /**
+         * Map an open native file.
+         * @return the mapping with a reference count of 1, or NULL if the
+         *   file can't be mapped.
+         */
+        static OsclFileMap* New(OsclNativeFile& aFile);
+
+        //From OsclRefCounter
+        void addRef();
+        void removeRef();
+        uint32 getCount();
+
+        uint32 Read(OsclAny* aBuffer, uint32 aSize, uint32 aNumElements);
+
+        int32 Seek(TOsclFileOffset aOffset, Oscl_File::seek_type aOrigin);
+
+        TOsclFileOffset Tell()
+        {
+            return iPosition;
+        }
+
+        int32 EndOfFile()
+        {
+            return (iPosition >= iSize) ? 1 : 0;
+        }
+
+        TOsclFileOffset Size()
+        {
+            return iSize;
+        }
+
+        /**
+         * Get a pointer into the mapping.
+         * @return the data at aOffset, or NULL if aOffset+aLen is
+         *   past the end of the file.
+         */
+        uint8* Data(TOsclFileOffset aOffset, uint32 aLen)
+        {
+            if (aOffset < 0 || aOffset > iSize || (TOsclFileOffset)aLen > iSize - aOffset)
+                return NULL;
+            return iData + aOffset;
+        }
+
+    private:
+        OsclFileMap();
+        ~OsclFileMap();
+
+        OsclAny* iBase;
+        TOsclFileOffset iMapLen;
+        uint8* iData;
+        TOsclFileOffset iSize;
+        TOsclFileOffset iPosition;
+
+        OsclMutex iLock;
+        uint32 iRefCount;
+};
+
+#endif // OSCL_FILE_MAP_H_INCLUDED
+
+/*! @} */
+
@@ -402,6 +402,70 @@ TOsclFileOffset OsclNativeFile::Tell()
 
 
 
+int32 OsclNativeFile::Map(OsclAny*& aBase, TOsclFileOffset& aMapLen, uint8*& aData, TOsclFileOffset& aSize)
+{
+#if (OSCL_HAS_MMAP_SUPPORT)
+    int fd = -1;
+    TOsclFileOffset offset = 0;
+    TOsclFileOffset size = 0;
+#ifdef ENABLE_SHAREDFD_PLAYBACK
+    if (iSharedFd >= 0)
+    {
+        fd = iSharedFd;
+        offset = iSharedFileOffset;
+        size = iSharedFileSize;
+    }
+    else
+#endif
+        if (iFile)
+        {
+            fd = fileno(iFile);
+            size = Size();
+        }
+    if (fd < 0 || size <= 0)
+        return -1;
+
+    //the mapping has to start on a page boundary.
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pageSize <= 0)
+        return -1;
+    TOsclFileOffset delta = offset % pageSize;
+    TOsclFileOffset mapLen = size + delta;
+
+    //the file may be too large for the address space.
+    if ((TOsclFileOffset)(size_t)mapLen != mapLen)
+        return -1;
+
+    OsclAny* base = mmap(NULL, (size_t)mapLen, PROT_READ, MAP_SHARED, fd, offset - delta);
+    if (base == MAP_FAILED)
+        return -1;
+
+    aBase = base;
+    aMapLen = mapLen;
+    aData = (uint8*)base + delta;
+    aSize = size;
+    return 0;
+#else
+    OSCL_UNUSED_ARG(aBase);
+    OSCL_UNUSED_ARG(aMapLen);
+    OSCL_UNUSED_ARG(aData);
+    OSCL_UNUSED_ARG(aSize);
+    return -1;
+#endif
+}
+
+void OsclNativeFile::Unmap(OsclAny* aBase, TOsclFileOffset aMapLen)
+{
+#if (OSCL_HAS_MMAP_SUPPORT)
+    if (aBase)
+        munmap(aBase, (size_t)aMapLen);
+#else
+    OSCL_UNUSED_ARG(aBase);
+    OSCL_UNUSED_ARG(aMapLen);
+#endif
+}
+
+
 int32 OsclNativeFile::Flush()
 {
 #ifdef ENABLE_SHAREDFD_PLAYBACK
@@ -121,6 +121,22 @@ class OsclNativeFile : public HeapBase
         **/
         void ReadAsyncCancel();
 
+        /*!
+        ** Map the whole file into memory for reading.
+        **
+        ** @param aBase: returns the base of the mapping, for Unmap.
+        ** @param aMapLen: returns the length of the mapping, for Unmap.
+        ** @param aData: returns a pointer to the first byte of the file.
+        ** @param aSize: returns the file size.
+        ** @returns: 0 for success, or -1 if the file can't be mapped.
+        **/
+        int32 Map(OsclAny*& aBase, TOsclFileOffset& aMapLen, uint8*& aData, TOsclFileOffset& aSize);
+        /*!
+        ** Release a mapping created by Map.  The mapping stays valid
+        ** after the file is closed, until it is unmapped.
+        **/
+        static void Unmap(OsclAny* aBase, TOsclFileOffset aMapLen);
+
     private:
         int32 OpenFileOrSharedFd(const char *filename, const char *openmode);
 
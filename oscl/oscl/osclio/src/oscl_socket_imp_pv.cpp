@@ -74,6 +74,12 @@ int32 OsclSocketI::Close()
         //call the platform socket close routine...
         bool ok;
         OsclCloseSocket(iSocket, ok, sockerr);
+#if (PV_SOCKET_SERVER_EPOLL)
+        //the handle may be re-used for a new socket, so have the server
+        //forget any readiness it saved for this one.
+        if (iSocketServ && iSocketServ->IsServConnected())
+            iSocketServ->iSockServRequestList.SocketClosed(iSocket);
+#endif
 #else
         sockerr = PVSOCK_ERR_NOT_IMPLEMENTED;
 #endif
@@ -418,6 +424,9 @@ void OsclSocketI::InitSocket(bool valid)
 {
     iSocketValid = valid;
     iSocketConnected = false;
+#if (PV_SOCKET_SERVER_EPOLL)
+    iEpollRegistered = false;
+#endif
 }
 
 #endif //pv socket server
@@ -21,6 +21,7 @@
 #define OSCL_SOCKET_IMP_PV_H_INCLUDED
 
 #include "oscl_socket_imp_base.h"
+#include "oscl_socket_tuneables.h"
 
 /*! Socket implementation for PV socket server
 */
@@ -116,6 +117,15 @@ class OsclSocketI: public OsclSocketIBase
         void ProcessRecvFrom(OsclSocketServRequestQElem*);
         void ProcessSend(OsclSocketServRequestQElem*);
         void ProcessRecv(OsclSocketServRequestQElem*);
+#if (PV_SOCKET_SERVER_RECVMMSG)
+        bool ProcessRecvFromBatch(OsclSocketRequest*, int32&, int&);
+#endif
+
+#if (PV_SOCKET_SERVER_EPOLL)
+        //set by the server once the OS-level socket has been
+        //registered with its epoll set.
+        bool iEpollRegistered;
+#endif
 
     private:
         bool iSocketValid;
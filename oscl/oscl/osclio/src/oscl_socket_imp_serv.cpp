@@ -75,7 +75,31 @@ void OsclSocketI::ProcessConnect(OsclSocketServRequestQElem* aElem)
         //check for completion by examining
         //writeset and exceptset
         bool ok, success, fail;
-#if (PV_SOCKET_SERVER_SELECT)
+#if (PV_SOCKET_SERVER_EPOLL)
+        //unix reports connect completion in the write set, with
+        //the result in the getsockopt error.
+        success = fail = false;
+        if (iSocketServ->IsSelected(iSocket, OSCL_EXCEPTSET_FLAG))
+        {
+            fail = true;
+            OsclGetAsyncSockErr(iSocket, ok, sockerr);
+        }
+        else if (iSocketServ->IsSelected(iSocket, OSCL_WRITESET_FLAG))
+        {
+            OsclGetAsyncSockErr(iSocket, ok, sockerr);
+            if (ok && sockerr == 0)
+                success = true;
+            else
+                fail = true;
+        }
+        //a failed connect consumes the activity.  after a successful
+        //connect the socket really is writable, so leave that for the
+        //next send, which only waits on the flag.
+        if (fail)
+            iSocketServ->ClearSelected(iSocket, OSCL_WRITESET_FLAG | OSCL_EXCEPTSET_FLAG);
+        else if (success)
+            iSocketServ->ClearSelected(iSocket, OSCL_EXCEPTSET_FLAG);
+#elif (PV_SOCKET_SERVER_SELECT)
         OsclConnectComplete(iSocket,
                             iSocketServ->iWriteset,
                             iSocketServ->iExceptset,
@@ -162,6 +186,8 @@ void OsclSocketI::ProcessConnect(OsclSocketServRequestQElem* aElem)
                 //we expect a non-blocking socket to return an error...
                 //start monitoring the writeset and exceptset.
                 aElem->iSelect = (OSCL_WRITESET_FLAG | OSCL_EXCEPTSET_FLAG);
+                //any activity reported before the connect started is stale.
+                iSocketServ->ClearSelected(iSocket, OSCL_WRITESET_FLAG | OSCL_EXCEPTSET_FLAG);
             }
             else
             {
@@ -261,7 +287,7 @@ void OsclSocketI::ProcessAccept(OsclSocketServRequestQElem* aElem)
         }
     }
 #if (PV_SOCKET_SERVER_SELECT)
-    else if (FD_ISSET(iSocket, &iSocketServ->iExceptset))
+    else if (iSocketServ->IsSelected(iSocket, OSCL_EXCEPTSET_FLAG))
     {
         ADD_STATS(req->iParam->iFxn, EOsclSocket_Except);
 
@@ -270,7 +296,7 @@ void OsclSocketI::ProcessAccept(OsclSocketServRequestQElem* aElem)
         complete = OSCL_REQUEST_ERR_GENERAL;
         iscomplete = true;
     }
-    else if (FD_ISSET(iSocket, &iSocketServ->iReadset))
+    else if (iSocketServ->IsSelected(iSocket, OSCL_READSET_FLAG))
     {
         //socket is readable, we can do an accept call now.
         ADD_STATS(req->iParam->iFxn, EOsclSocket_Readable);
@@ -286,7 +312,12 @@ void OsclSocketI::ProcessAccept(OsclSocketServRequestQElem* aElem)
         {
             if (wouldblock)
             {
-#if (PV_SOCKET_SERVER_SELECT)
+#if (PV_SOCKET_SERVER_EPOLL)
+                //edge-triggered readiness is stale, keep waiting
+                //for the socket to be readable.
+                iSocketServ->ClearSelected(iSocket, OSCL_READSET_FLAG);
+                ADD_STATS(req->iParam->iFxn, EOsclSocket_ServPoll);
+#elif (PV_SOCKET_SERVER_SELECT)
                 //we don't expect wouldblock when socket is readable.
                 complete = OSCL_REQUEST_ERR_GENERAL;
                 iscomplete = true;
@@ -381,7 +412,7 @@ void OsclSocketI::ProcessSend(OsclSocketServRequestQElem* aElem)
         }
     }
 #if (PV_SOCKET_SERVER_SELECT)
-    else if (FD_ISSET(iSocket, &iSocketServ->iWriteset))
+    else if (iSocketServ->IsSelected(iSocket, OSCL_WRITESET_FLAG))
     {
         //socket is writable, send data
         ADD_STATS(req->iParam->iFxn, EOsclSocket_Writable);
@@ -408,6 +439,7 @@ void OsclSocketI::ProcessSend(OsclSocketServRequestQElem* aElem)
             {
                 //non-blocking sockets return this when there's no receiver.
                 //just keep waiting.
+                iSocketServ->ClearSelected(iSocket, OSCL_WRITESET_FLAG);
                 ADD_STATS(req->iParam->iFxn, EOsclSocket_ServPoll);
             }
             else
@@ -499,7 +531,7 @@ void OsclSocketI::ProcessSendTo(OsclSocketServRequestQElem* aElem)
         }
     }
 #if (PV_SOCKET_SERVER_SELECT)
-    else if (FD_ISSET(iSocket, &iSocketServ->iWriteset))
+    else if (iSocketServ->IsSelected(iSocket, OSCL_WRITESET_FLAG))
     {
         //socket is writable, send data
         ADD_STATS(req->iParam->iFxn, EOsclSocket_Writable);
@@ -529,6 +561,7 @@ void OsclSocketI::ProcessSendTo(OsclSocketServRequestQElem* aElem)
             {
                 //nonblocking socket returns this error
                 //just keep waiting
+                iSocketServ->ClearSelected(iSocket, OSCL_WRITESET_FLAG);
                 ADD_STATS(req->iParam->iFxn, EOsclSocket_ServPoll);
             }
             else
@@ -620,7 +653,7 @@ void OsclSocketI::ProcessRecv(OsclSocketServRequestQElem* aElem)
         }
     }
 #if (PV_SOCKET_SERVER_SELECT)
-    else if (FD_ISSET(iSocket, &iSocketServ->iReadset))
+    else if (iSocketServ->IsSelected(iSocket, OSCL_READSET_FLAG))
     {
         //socket is readable, get data.
         ADD_STATS(req->iParam->iFxn, EOsclSocket_Readable);
@@ -648,6 +681,7 @@ void OsclSocketI::ProcessRecv(OsclSocketServRequestQElem* aElem)
                 //nonblocking sockets return this when there's no
                 //data.
                 //keep waiting for data.
+                iSocketServ->ClearSelected(iSocket, OSCL_READSET_FLAG);
                 ADD_STATS(req->iParam->iFxn, EOsclSocket_ServPoll);
             }
             else
@@ -729,7 +763,7 @@ void OsclSocketI::ProcessRecvFrom(OsclSocketServRequestQElem* aElem)
         }
     }
 #if (PV_SOCKET_SERVER_SELECT)
-    else if (FD_ISSET(iSocket, &iSocketServ->iReadset))
+    else if (iSocketServ->IsSelected(iSocket, OSCL_READSET_FLAG))
     {
         //socket is readable, get data.
         ADD_STATS(req->iParam->iFxn, EOsclSocket_Readable);
@@ -738,96 +772,107 @@ void OsclSocketI::ProcessRecvFrom(OsclSocketServRequestQElem* aElem)
         //try the read
 #endif
 
-        //we loop through multiple "recvfrom" calls and stop when
-        //either a byte limit is reached or else no more data is available
-        //without waiting.
-        bool loop;
-        uint32 loopcount;
-        for (loop = true, loopcount = 0; loop; loopcount++)
-        {
-            loop = false;
-
-            RecvFromParam* param = (RecvFromParam*)req->iParam;
-            int nbytes;
-            bool ok, wouldblock;
-            TOsclSockAddr sourceaddr;
-            TOsclSockAddrLen sourceaddrlen = sizeof(sourceaddr);
-            ADD_STATS(req->iParam->iFxn, EOsclSocket_OS);
-            OsclRecvFrom(iSocket,
-                         param->iBufRecv.iPtr + param->iBufRecv.iLen,
-                         param->iBufRecv.iMaxLen - param->iBufRecv.iLen,
-                         &sourceaddr,
-                         &sourceaddrlen,
-                         ok,
-                         sockerr,
-                         nbytes,
-                         wouldblock);
-
-            //Check for completion or error.
-            if (!ok)
+#if (PV_SOCKET_SERVER_RECVMMSG)
+        if (((RecvFromParam*)req->iParam)->iMultiMaxLen > 0)
+        {
+            //receive the packets in batches.
+            iscomplete = ProcessRecvFromBatch(req, complete, sockerr);
+        }
+        else
+#endif
+        {
+            //we loop through multiple "recvfrom" calls and stop when
+            //either a byte limit is reached or else no more data is available
+            //without waiting.
+            bool loop;
+            uint32 loopcount;
+            for (loop = true, loopcount = 0; loop; loopcount++)
             {
-                if (wouldblock)
+                loop = false;
+
+                RecvFromParam* param = (RecvFromParam*)req->iParam;
+                int nbytes;
+                bool ok, wouldblock;
+                TOsclSockAddr sourceaddr;
+                TOsclSockAddrLen sourceaddrlen = sizeof(sourceaddr);
+                ADD_STATS(req->iParam->iFxn, EOsclSocket_OS);
+                OsclRecvFrom(iSocket,
+                             param->iBufRecv.iPtr + param->iBufRecv.iLen,
+                             param->iBufRecv.iMaxLen - param->iBufRecv.iLen,
+                             &sourceaddr,
+                             &sourceaddrlen,
+                             ok,
+                             sockerr,
+                             nbytes,
+                             wouldblock);
+
+                //Check for completion or error.
+                if (!ok)
                 {
-                    //nonblocking sockets will return an error when
-                    //there's no data.
-                    if (loopcount == 0)
+                    if (wouldblock)
                     {
-                        //keep waiting for data.
-                        ADD_STATS(req->iParam->iFxn, EOsclSocket_ServPoll);
+                        //nonblocking sockets will return an error when
+                        //there's no data.
+                        iSocketServ->ClearSelected(iSocket, OSCL_READSET_FLAG);
+                        if (loopcount == 0)
+                        {
+                            //keep waiting for data.
+                            ADD_STATS(req->iParam->iFxn, EOsclSocket_ServPoll);
+                        }
+                        else
+                        {
+                            //if we already got some data, don't wait for more.
+                            complete = OSCL_REQUEST_ERR_NONE;
+                            iscomplete = true;
+                        }
                     }
                     else
                     {
-                        //if we already got some data, don't wait for more.
-                        complete = OSCL_REQUEST_ERR_NONE;
+                        //recvfrom error
+                        complete = OSCL_REQUEST_ERR_GENERAL;
                         iscomplete = true;
                     }
                 }
-                else
+                else if (nbytes > 0)
                 {
-                    //recvfrom error
-                    complete = OSCL_REQUEST_ERR_GENERAL;
-                    iscomplete = true;
-                }
-            }
-            else if (nbytes > 0)
-            {
-                //got some data.
-                ADD_STATSP(req->iParam->iFxn, EOsclSocket_DataRecv, nbytes);
+                    //got some data.
+                    ADD_STATSP(req->iParam->iFxn, EOsclSocket_DataRecv, nbytes);
 
-                param->iBufRecv.iLen += nbytes;
-                if (param->iPacketLen)
-                    param->iPacketLen->push_back(nbytes);
+                    param->iBufRecv.iLen += nbytes;
+                    if (param->iPacketLen)
+                        param->iPacketLen->push_back(nbytes);
 
-                if (sourceaddrlen > 0)
-                {
-                    //convert the source address.
-                    MakeAddr(sourceaddr, param->iAddr);
-                    if (param->iPacketSource)
-                        param->iPacketSource->push_back(param->iAddr);
-                }
+                    if (sourceaddrlen > 0)
+                    {
+                        //convert the source address.
+                        MakeAddr(sourceaddr, param->iAddr);
+                        if (param->iPacketSource)
+                            param->iPacketSource->push_back(param->iAddr);
+                    }
 
-                //see whether to try and recv another packet
-                //when multi-packet recv is enabled, keep receiving
-                //as long as the free space is >= the multi recv limit.
-                if (param->iMultiMaxLen > 0
-                        && (param->iBufRecv.iMaxLen - param->iBufRecv.iLen) >= param->iMultiMaxLen)
-                {
-                    loop = true;
+                    //see whether to try and recv another packet
+                    //when multi-packet recv is enabled, keep receiving
+                    //as long as the free space is >= the multi recv limit.
+                    if (param->iMultiMaxLen > 0
+                            && (param->iBufRecv.iMaxLen - param->iBufRecv.iLen) >= param->iMultiMaxLen)
+                    {
+                        loop = true;
+                    }
+                    else
+                    {
+                        complete = OSCL_REQUEST_ERR_NONE;
+                        iscomplete = true;
+                    }
                 }
                 else
                 {
-                    complete = OSCL_REQUEST_ERR_NONE;
+                    //this usually means connection was closed.
+                    complete = OSCL_REQUEST_ERR_GENERAL;
                     iscomplete = true;
+                    //(sockerr will be zero in this case)
                 }
-            }
-            else
-            {
-                //this usually means connection was closed.
-                complete = OSCL_REQUEST_ERR_GENERAL;
-                iscomplete = true;
-                //(sockerr will be zero in this case)
-            }
-        }//for loop
+            }//for loop
+        }
     }
 #if (PV_SOCKET_SERVER_SELECT)
     else
@@ -850,6 +895,141 @@ void OsclSocketI::ProcessRecvFrom(OsclSocketServRequestQElem* aElem)
     }
 }
 
+#if (PV_SOCKET_SERVER_RECVMMSG)
+/**
+ * Receive a multi-packet RecvFrom request with as few OS calls
+ * as possible.
+ *
+ * Each OS call receives up to PV_SOCKET_SERVER_RECVMMSG_MAX_PACKETS
+ * datagrams into slots of iMultiMaxLen bytes, with all the remaining
+ * space in the last slot.  The packets are then packed together
+ * at the end of the receive buffer, so the buffer, packet lengths and
+ * packet sources are the same as for the one-packet-per-call loop.
+ * A packet larger than iMultiMaxLen may be truncated to its slot; the
+ * request then completes with an error, with the data kept in the buffer.
+ *
+ * @return true if the request is complete, with the result in
+ *    aComplete and aSockErr.
+ */
+bool OsclSocketI::ProcessRecvFromBatch(OsclSocketRequest* req, int32& aComplete, int& aSockErr)
+{
+    RecvFromParam* param = (RecvFromParam*)req->iParam;
+
+    TOsclMMsgHdr msgs[PV_SOCKET_SERVER_RECVMMSG_MAX_PACKETS];
+    TOsclIOVec iov[PV_SOCKET_SERVER_RECVMMSG_MAX_PACKETS];
+    TOsclSockAddr sourceaddr[PV_SOCKET_SERVER_RECVMMSG_MAX_PACKETS];
+    uint32 slotoffset[PV_SOCKET_SERVER_RECVMMSG_MAX_PACKETS];
+
+    for (uint32 loopcount = 0; ; loopcount++)
+    {
+        //lay out the receive slots.  a slot gets the multi recv limit only
+        //when there will still be room for another packet after it.
+        uint32 offset = param->iBufRecv.iLen;
+        uint32 freelen = param->iBufRecv.iMaxLen - param->iBufRecv.iLen;
+        uint32 nslots = 0;
+        while (freelen > 0 && nslots < PV_SOCKET_SERVER_RECVMMSG_MAX_PACKETS)
+        {
+            uint32 len = freelen;
+            if (nslots + 1 < PV_SOCKET_SERVER_RECVMMSG_MAX_PACKETS
+                    && freelen >= 2 * param->iMultiMaxLen)
+            {
+                len = param->iMultiMaxLen;
+            }
+            slotoffset[nslots] = offset;
+            OsclInitMMsg(msgs[nslots], iov[nslots], param->iBufRecv.iPtr + offset, len, &sourceaddr[nslots]);
+            offset += len;
+            freelen -= len;
+            nslots++;
+        }
+
+        int nmsgs;
+        bool ok, wouldblock;
+        ADD_STATS(req->iParam->iFxn, EOsclSocket_OS);
+        OsclRecvMMsg(iSocket, msgs, nslots, ok, aSockErr, nmsgs, wouldblock);
+
+        if (!ok)
+        {
+            if (wouldblock)
+            {
+                //nonblocking sockets will return an error when
+                //there's no data.
+                iSocketServ->ClearSelected(iSocket, OSCL_READSET_FLAG);
+                if (loopcount == 0)
+                {
+                    //keep waiting for data.
+                    ADD_STATS(req->iParam->iFxn, EOsclSocket_ServPoll);
+                    return false;
+                }
+                //if we already got some data, don't wait for more.
+                aComplete = OSCL_REQUEST_ERR_NONE;
+                return true;
+            }
+            //recvfrom error
+            aComplete = OSCL_REQUEST_ERR_GENERAL;
+            return true;
+        }
+
+        bool truncated = false;
+        for (int i = 0; i < nmsgs; i++)
+        {
+            int nbytes = OsclMMsgLen(msgs[i]);
+            if (nbytes <= 0)
+            {
+                //this usually means connection was closed.
+                aComplete = OSCL_REQUEST_ERR_GENERAL;
+                return true;
+            }
+
+            //got some data.
+            ADD_STATSP(req->iParam->iFxn, EOsclSocket_DataRecv, nbytes);
+
+            //pack it after the prior packet.
+            if (slotoffset[i] != param->iBufRecv.iLen)
+            {
+                oscl_memmove(param->iBufRecv.iPtr + param->iBufRecv.iLen
+                             , param->iBufRecv.iPtr + slotoffset[i]
+                             , nbytes);
+            }
+            param->iBufRecv.iLen += nbytes;
+            if (param->iPacketLen)
+                param->iPacketLen->push_back(nbytes);
+
+            if (OsclMMsgAddrLen(msgs[i]) > 0)
+            {
+                //convert the source address.
+                MakeAddr(sourceaddr[i], param->iAddr);
+                if (param->iPacketSource)
+                    param->iPacketSource->push_back(param->iAddr);
+            }
+
+            if (OsclMMsgTruncated(msgs[i]))
+            {
+                LOGSERV((0, "OsclSocketI::ProcessRecvFromBatch (0x%x) packet %d truncated to %d bytes", this, i, nbytes));
+                truncated = true;
+            }
+        }
+
+        if (truncated)
+        {
+            //a packet was larger than its slot.  Complete with an error
+            //but keep the data, so the caller can report the truncated packet.
+            //(sockerr will be zero in this case)
+            aComplete = OSCL_REQUEST_ERR_GENERAL;
+            return true;
+        }
+
+        //keep receiving only when all the slots were filled and there's
+        //still room for another packet.
+        if (nmsgs < (int)nslots
+                || (param->iBufRecv.iMaxLen - param->iBufRecv.iLen) < param->iMultiMaxLen)
+        {
+            aComplete = OSCL_REQUEST_ERR_NONE;
+            return true;
+        }
+    }
+}
+#endif //PV_SOCKET_SERVER_RECVMMSG
+
 #endif //PV_SOCKET_SERVER
 
 
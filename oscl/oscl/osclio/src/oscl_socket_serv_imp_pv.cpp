@@ -77,6 +77,9 @@ void OsclSocketServI::LoopbackSocket::Init(OsclSocketServI* aContainer)
 //to wakeup a blocking select call.
 {
     iContainer = aContainer;
+#if PV_SOCKET_SERVER_EPOLL
+    iEpollRegistered = false;
+#endif
 #if PV_OSCL_SOCKET_STATS_LOGGING
     iStats.Construct(NULL, this);
 #endif
@@ -206,7 +209,7 @@ void OsclSocketServI::LoopbackSocket::Read()
         return;
 
     //read all queued data on the socket
-    if (FD_ISSET(iSocket, &iContainer->iReadset))
+    if (iContainer->IsSelected(iSocket, OSCL_READSET_FLAG))
     {
         char tmpBuf[2] = {0, 0};
         int nbytes, err;
@@ -226,6 +229,7 @@ void OsclSocketServI::LoopbackSocket::Read()
                          wouldblock);
             recv = (ok && nbytes > 0);
         }
+        iContainer->ClearSelected(iSocket, OSCL_READSET_FLAG);
     }
 }
 
@@ -239,7 +243,12 @@ void OsclSocketServI::LoopbackSocket::ProcessSelect(TOsclSocket& maxsocket)
     //Monitor this socket whenever we will be doing a select.
     if (maxsocket)
     {
+#if PV_SOCKET_SERVER_EPOLL
+        if (!iEpollRegistered)
+            iEpollRegistered = iContainer->EpollRegister(iSocket);
+#else
         FD_SET(iSocket, &iContainer->iReadset);
+#endif
         if (iSocket > maxsocket)
             maxsocket = iSocket;
     }
@@ -653,6 +662,12 @@ void OsclSocketServI::ProcessSocketRequests()
     iSockServRequestList.Unlock();
     END_SERVI_STATS2(EServiProc_Queue);
 
+#if PV_SOCKET_SERVER_EPOLL
+    OSCL_UNUSED_ARG(nhandles);
+    ProcessEpollRequests(aNhandles, aNfds);
+    return;
+#endif
+
     if (iSockServRequestList.iActiveRequests.empty())
     {
         //nothing to do!
@@ -694,55 +709,7 @@ void OsclSocketServI::ProcessSocketRequests()
             //These routines will start the request, or else process
             //the results of prior select call, and also set the select
             //flags for the next call.
-
-            switch (elem->iSocketRequest->Fxn())
-            {
-                case EPVSocketShutdown:
-                    START_SERVI_STATS2(EServiProcLoop_Shutdown);
-                    elem->iSocketRequest->iSocketI->ProcessShutdown(elem);
-                    END_SERVI_STATS2(EServiProcLoop_Shutdown);
-                    break;
-
-                case EPVSocketConnect:
-                    START_SERVI_STATS2(EServiProcLoop_Connect);
-                    elem->iSocketRequest->iSocketI->ProcessConnect(elem);
-                    END_SERVI_STATS2(EServiProcLoop_Connect);
-                    break;
-
-                case EPVSocketAccept:
-                    START_SERVI_STATS2(EServiProcLoop_Accept);
-                    elem->iSocketRequest->iSocketI->ProcessAccept(elem);
-                    END_SERVI_STATS2(EServiProcLoop_Accept);
-                    break;
-
-                case EPVSocketSend:
-                    START_SERVI_STATS2(EServiProcLoop_Send);
-                    elem->iSocketRequest->iSocketI->ProcessSend(elem);
-                    END_SERVI_STATS2(EServiProcLoop_Send);
-                    break;
-
-                case EPVSocketSendTo:
-                    START_SERVI_STATS2(EServiProcLoop_SendTo);
-                    elem->iSocketRequest->iSocketI->ProcessSendTo(elem);
-                    END_SERVI_STATS2(EServiProcLoop_SendTo);
-                    break;
-
-                case EPVSocketRecv:
-                    START_SERVI_STATS2(EServiProcLoop_Recv);
-                    elem->iSocketRequest->iSocketI->ProcessRecv(elem);
-                    END_SERVI_STATS2(EServiProcLoop_Recv);
-                    break;
-
-                case EPVSocketRecvFrom:
-                    START_SERVI_STATS2(EServiProcLoop_RecvFrom);
-                    elem->iSocketRequest->iSocketI->ProcessRecvFrom(elem);
-                    END_SERVI_STATS2(EServiProcLoop_RecvFrom);
-                    break;
-
-                default:
-                    OSCL_ASSERT(0);
-                    break;
-            }
+            ProcessRequest(elem);
         }
     }
     END_SERVI_STATS2(EServiProc_Loop);
@@ -830,6 +797,175 @@ void OsclSocketServI::ProcessSocketRequests()
 
 }
 
+/**
+ * Start or continue one active socket request.
+ */
+void OsclSocketServI::ProcessRequest(OsclSocketServRequestQElem* elem)
+{
+    switch (elem->iSocketRequest->Fxn())
+    {
+        case EPVSocketShutdown:
+            START_SERVI_STATS2(EServiProcLoop_Shutdown);
+            elem->iSocketRequest->iSocketI->ProcessShutdown(elem);
+            END_SERVI_STATS2(EServiProcLoop_Shutdown);
+            break;
+
+        case EPVSocketConnect:
+            START_SERVI_STATS2(EServiProcLoop_Connect);
+            elem->iSocketRequest->iSocketI->ProcessConnect(elem);
+            END_SERVI_STATS2(EServiProcLoop_Connect);
+            break;
+
+        case EPVSocketAccept:
+            START_SERVI_STATS2(EServiProcLoop_Accept);
+            elem->iSocketRequest->iSocketI->ProcessAccept(elem);
+            END_SERVI_STATS2(EServiProcLoop_Accept);
+            break;
+
+        case EPVSocketSend:
+            START_SERVI_STATS2(EServiProcLoop_Send);
+            elem->iSocketRequest->iSocketI->ProcessSend(elem);
+            END_SERVI_STATS2(EServiProcLoop_Send);
+            break;
+
+        case EPVSocketSendTo:
+            START_SERVI_STATS2(EServiProcLoop_SendTo);
+            elem->iSocketRequest->iSocketI->ProcessSendTo(elem);
+            END_SERVI_STATS2(EServiProcLoop_SendTo);
+            break;
+
+        case EPVSocketRecv:
+            START_SERVI_STATS2(EServiProcLoop_Recv);
+            elem->iSocketRequest->iSocketI->ProcessRecv(elem);
+            END_SERVI_STATS2(EServiProcLoop_Recv);
+            break;
+
+        case EPVSocketRecvFrom:
+            START_SERVI_STATS2(EServiProcLoop_RecvFrom);
+            elem->iSocketRequest->iSocketI->ProcessRecvFrom(elem);
+            END_SERVI_STATS2(EServiProcLoop_RecvFrom);
+            break;
+
+        default:
+            OSCL_ASSERT(0);
+            break;
+    }
+}
+
+#if PV_SOCKET_SERVER_EPOLL
+/**
+ * Process socket requests in epoll mode.
+ *
+ * This is called under the server thread or server AO, after new
+ * requests have been picked up.  Only the requests on the run list
+ * are examined: new and canceled requests, and requests on sockets
+ * that epoll reported activity for.  A request that has to wait is
+ * put on the waiting list for its socket.
+ *
+ * @param aNhandles(output): number of requests that can make progress
+ *    without waiting.
+ * @param aNfds(output): greater than 1 when there is anything to wait on.
+ */
+void OsclSocketServI::ProcessEpollRequests(int& aNhandles, int &aNfds)
+{
+    OsclSocketServRequestList& list = iSockServRequestList;
+
+    //wake up the requests on the sockets with new activity.
+    for (uint32 i = 0; i < iEpollActive.size(); i++)
+        list.RunWaitingRequests(iEpollActive[i]);
+    iEpollActive.clear();
+
+    //when the server is going away, every request must be completed.
+    if (!IsServConnected())
+        list.RunAllWaitingRequests();
+
+    START_SERVI_STATS2(EServiProc_Loop);
+    uint32 nrun = list.iRunRequests.size();
+    for (uint32 i = 0; i < nrun; i++)
+    {
+        uint32 slot = list.iRunRequests[i];
+        OsclSocketServRequestQElem* elem = &list.iActiveRequests[slot];
+        elem->iEpollState = OsclSocketServRequestQElem::EIdle;
+
+        if (elem->iCancel)
+        {
+            //Request was canceled
+            START_SERVI_STATS2(EServiProcLoop_Cancel);
+            elem->iSocketRequest->Complete(elem, OSCL_REQUEST_ERR_CANCEL);
+            END_SERVI_STATS2(EServiProcLoop_Cancel);
+        }
+        else if (!IsServConnected())
+        {
+            //Server died or was closed.
+            START_SERVI_STATS2(EServiProcLoop_Closed);
+            elem->iSocketRequest->Complete(elem, OSCL_REQUEST_ERR_GENERAL
+                                           , (iServError) ? iServError : PVSOCK_ERR_SERV_NOT_CONNECTED);
+            END_SERVI_STATS2(EServiProcLoop_Closed);
+        }
+        else if (elem->iSelect
+                 && !IsSelected(elem->iSocketRequest->iSocketI->Socket(), elem->iSelect))
+        {
+            //the socket activity was not the kind this request is
+            //waiting for-- just keep waiting.
+            ;
+        }
+        else
+        {
+            ProcessRequest(elem);
+        }
+
+        if (!elem->iSocketRequest)
+        {
+            //request is complete and the slot can be re-used.
+            list.iFreeSlots.push_back(slot);
+            continue;
+        }
+
+        TOsclSocket osock = elem->iSocketRequest->iSocketI->Socket();
+        if (elem->iSelect)
+        {
+            //Register the socket on first use.  The registration persists
+            //until the socket is closed.
+            OsclSocketI* socketI = elem->iSocketRequest->iSocketI;
+            if (!socketI->iEpollRegistered)
+            {
+                LOGSERV((0, "OsclSocketServI::ProcessEpollRequests Registering %d", osock));
+                socketI->iEpollRegistered = EpollRegister(osock);
+            }
+        }
+
+        //Activity that was already reported won't be reported again,
+        //so keep running this request, and don't let the next wait block,
+        //as long as the request can proceed.
+        if (!elem->iSelect || IsSelected(osock, elem->iSelect))
+        {
+            list.AddRunRequest(slot);
+            aNhandles++;
+        }
+        else
+        {
+            list.AddWaitingRequest(slot, osock);
+        }
+    }
+    list.iRunRequests.erase(list.iRunRequests.begin(), list.iRunRequests.begin() + nrun);
+    END_SERVI_STATS2(EServiProc_Loop);
+
+    if (!list.Empty())
+    {
+        //the epoll wait doesn't use the handle count, it only matters
+        //that there is something to wait on.
+        TOsclSocket maxsocket = 1;
+#if PV_SOCKET_SERVER_SELECT_LOOPBACK_SOCKET
+        //also monitor the loopback socket if we're going to wait.
+        iLoopbackSocket.ProcessSelect(maxsocket);
+#endif
+        aNfds = (int)maxsocket + 1;
+    }
+
+    LOGSERV((0, "OsclSocketServI::ProcessEpollRequests Run %d Waiting %d", list.iRunRequests.size(), list.iNumWaiting));
+}
+#endif //PV_SOCKET_SERVER_EPOLL
+
 void OsclSocketServI::ServerEntry()
 //Server entry processing
 {
@@ -845,6 +981,10 @@ void OsclSocketServI::ServerEntry()
     FD_ZERO(&iWriteset);
     FD_ZERO(&iExceptset);
 #endif
+#if PV_SOCKET_SERVER_EPOLL
+    iEpollReady.clear();
+    iEpollActive.clear();
+#endif
 }
 
 void OsclSocketServI::ServerExit()
@@ -884,6 +1024,9 @@ void OsclSocketServI::ConstructServImp()
     iStart.Create();
     iExit.Create();
 #endif
+#if PV_SOCKET_SERVER_EPOLL
+    iEpollFd = (-1);
+#endif
 }
 
 void OsclSocketServI::CleanupServImp()
@@ -892,8 +1035,88 @@ void OsclSocketServI::CleanupServImp()
     iStart.Close();
     iExit.Close();
 #endif
+#if PV_SOCKET_SERVER_EPOLL
+    EpollClose();
+#endif
+}
+
+#if PV_SOCKET_SERVER_EPOLL
+void OsclSocketServI::EpollCreate(bool& ok)
+//Create the epoll set.  It is kept until the server is destroyed,
+//so socket registrations survive a server re-connect.
+{
+    ok = true;
+    if (iEpollFd == (-1))
+    {
+        int err;
+        OsclEpollCreate(iEpollFd, ok, err);
+        if (!ok)
+        {
+            iServError = err;
+            iEpollFd = (-1);
+        }
+    }
+}
+
+void OsclSocketServI::EpollClose()
+{
+    if (iEpollFd != (-1))
+    {
+        OsclEpollClose(iEpollFd);
+        iEpollFd = (-1);
+    }
 }
 
+bool OsclSocketServI::EpollRegister(TOsclSocket aSocket)
+//Add a socket to the epoll set, monitoring all activity in edge-triggered mode.
+//Returns true if the socket is now registered.
+{
+    bool ok;
+    int err = 0;
+    OsclEpollAdd(iEpollFd, aSocket, ok, err);
+
+    //make sure there's a readiness entry for this socket, and that it
+    //starts out clear.
+    while (iEpollReady.size() <= (uint32)aSocket)
+        iEpollReady.push_back(0);
+    iEpollReady[aSocket] = 0;
+
+    if (!ok)
+    {
+        //treat the socket as ready so the next operation will either
+        //report an error, or will would-block and retry the registration.
+        LOGSERV((0, "OsclSocketServI::EpollRegister Error %d on %d", err, aSocket));
+        OSCL_UNUSED_ARG(err);
+        iEpollReady[aSocket] = (OSCL_READSET_FLAG | OSCL_WRITESET_FLAG | OSCL_EXCEPTSET_FLAG);
+    }
+    return ok;
+}
+
+void OsclSocketServI::EpollWait(int32 aTimeoutMsec, bool& ok, int& aNhandles)
+//Wait on the epoll set and save the reported activity as select flags.
+{
+    OsclEpollWait(iEpollFd, iEpollEvents, PV_SOCKET_SERVER_EPOLL_MAX_EVENTS, aTimeoutMsec, ok, iServError, aNhandles);
+
+    for (int i = 0; i < aNhandles; i++)
+    {
+        TOsclSocket osock = OsclEpollEventSocket(iEpollEvents[i]);
+        uint8 flags = 0;
+        if (OsclEpollEventReadable(iEpollEvents[i]))
+            flags |= OSCL_READSET_FLAG;
+        if (OsclEpollEventWritable(iEpollEvents[i]))
+            flags |= OSCL_WRITESET_FLAG;
+        if (OsclEpollEventExcept(iEpollEvents[i]))
+            flags |= OSCL_EXCEPTSET_FLAG;
+
+        while (iEpollReady.size() <= (uint32)osock)
+            iEpollReady.push_back(0);
+        iEpollReady[osock] |= flags;
+        iEpollActive.push_back(osock);
+        LOGSERV((0, "OsclSocketServI::EpollWait Socket %d flags 0x%x", osock, flags));
+    }
+}
+#endif //PV_SOCKET_SERVER_EPOLL
+
 #if(PV_SOCKET_SERVER_IS_THREAD)
 //socket server thread routine
 static TOsclThreadFuncRet OSCL_THREAD_DECL sockthreadmain(TOsclThreadFuncArg arg);
@@ -901,6 +1124,14 @@ static TOsclThreadFuncRet OSCL_THREAD_DECL sockthreadmain(TOsclThreadFuncArg arg
 
 int32 OsclSocketServI::StartServImp()
 {
+#if PV_SOCKET_SERVER_EPOLL
+    //create the epoll set.
+    bool epollok;
+    EpollCreate(epollok);
+    if (!epollok)
+        return OsclErrGeneral;
+#endif
+
 #if(PV_SOCKET_SERVER_IS_THREAD)
 
     //setup the loopback socket and/or polling interval.
@@ -1023,8 +1254,10 @@ void OsclSocketServI::InThread()
     //process requests.
     iStart.Signal();
 
+#if !PV_SOCKET_SERVER_EPOLL
     //create select timeout structure
     timeval timeout;
+#endif
 
     bool ok;
     int nfds;
@@ -1038,6 +1271,21 @@ void OsclSocketServI::InThread()
         //Make the select call if needed.
         if (nfds > 1)
         {
+#if PV_SOCKET_SERVER_EPOLL
+            //Wait on the epoll set.  Don't block when some request can already
+            //make progress.
+            int32 timeoutMsec;
+            if (nhandles)
+                timeoutMsec = 0;
+            else if (iSelectPollIntervalMsec == 0)
+                timeoutMsec = (-1);//wait forever
+            else
+                timeoutMsec = iSelectPollIntervalMsec;//poll
+
+            LOGSERV((0, "OsclSocketServI::InThread Calling epoll wait, timeout %d", timeoutMsec));
+            EpollWait(timeoutMsec, ok, nhandles);
+            LOGSERV((0, "OsclSocketServI::InThread Epoll wait returned"));
+#else
             //Set the fixed timeout.  The select call may update this value
             //so it needs to be set on each call.
             timeout.tv_sec = 0;
@@ -1056,6 +1304,7 @@ void OsclSocketServI::InThread()
             LOGSERV((0, "OsclSocketServI::InThread Calling select, timeout %d", iSelectPollIntervalMsec));
             OsclSocketSelect(nfds, iReadset, iWriteset, iExceptset, timeout, ok, iServError, nhandles);
             LOGSERV((0, "OsclSocketServI::InThread Select call returned"));
+#endif
             if (!ok)
             {
                 //select error.
@@ -1228,13 +1477,21 @@ for (uint32 i = 0; i < 2; i++)
     if (iNfds > 1)
     {
         START_SERVI_STATS(EServiRun_Select);
+        bool ok;
+#if PV_SOCKET_SERVER_EPOLL
+        //poll the epoll set, and count the requests that could already
+        //make progress as activity.
+        int nready = iNhandles;
+        EpollWait(0, ok, iNhandles);
+        iNhandles += nready;
+#else
         //use a delay of zero since we're essentially polling for socket activity.
         //note the select call may update this value so it must be set prior to each call.
         timeval timeout;
         timeout.tv_sec = 0;
         timeout.tv_usec = 0;
-        bool ok;
         OsclSocketSelect(iNfds, iReadset, iWriteset, iExceptset, timeout, ok, iServError, iNhandles);
+#endif
         END_SERVI_STATS(EServiRun_Select);
         if (!ok)
         {
@@ -1257,7 +1514,7 @@ for (uint32 i = 0; i < 2; i++)
 
 //Re-schedule
 START_SERVI_STATS(EServiRun_Reschedule);
-if (!iSockServRequestList.iActiveRequests.empty())
+if (!iSockServRequestList.Empty())
 {
     if (iNhandles)
     {
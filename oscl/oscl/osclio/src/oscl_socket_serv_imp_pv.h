@@ -36,6 +36,12 @@
 
 class PVServiStats;
 
+/** A bitmask for socket select operations
+*/
+#define OSCL_READSET_FLAG 0x04
+#define OSCL_WRITESET_FLAG 0x02
+#define OSCL_EXCEPTSET_FLAG 0x01
+
 /** PV socket server implementation
 */
 #if (PV_SOCKET_SERVER_IS_THREAD)
@@ -77,6 +83,9 @@ class OsclSocketServI: public OsclTimerObject, public OsclSocketServIBase
                 void Init(OsclSocketServI* aContainer);
                 void Cleanup();
                 void Write();
+#if PV_SOCKET_SERVER_EPOLL
+                bool iEpollRegistered;
+#endif
 #if PV_OSCL_SOCKET_STATS_LOGGING
                 OsclSocketStats iStats;
 #endif
@@ -128,9 +137,60 @@ class OsclSocketServI: public OsclTimerObject, public OsclSocketServIBase
         //select flags.
         fd_set iReadset, iWriteset, iExceptset;
         void ProcessSocketRequests(int &, int &n);
+
+#if PV_SOCKET_SERVER_EPOLL
+        //edge-triggered epoll set.  Readiness reported by epoll is
+        //saved per socket handle in iEpollReady (as select flags) and
+        //is cleared when an operation on the socket would block, when
+        //a connect consumes it, and when the socket is closed or
+        //registered.
+        TOsclSocket iEpollFd;
+        TOsclEpollEvent iEpollEvents[PV_SOCKET_SERVER_EPOLL_MAX_EVENTS];
+        Oscl_Vector<uint8, OsclMemAllocator> iEpollReady;
+        //sockets with activity reported by the last wait.
+        Oscl_Vector<TOsclSocket, OsclMemAllocator> iEpollActive;
+        void ProcessEpollRequests(int &, int &n);
+        void EpollCreate(bool &ok);
+        void EpollClose();
+        bool EpollRegister(TOsclSocket aSocket);
+        void EpollWait(int32 aTimeoutMsec, bool &ok, int &aNhandles);
+#endif
+
 #else
         void ProcessSocketRequests();
 #endif
+        void ProcessRequest(OsclSocketServRequestQElem*);
+
+#if PV_SOCKET_SERVER_SELECT
+        //check whether the last select or epoll call reported
+        //activity for any of the given flags on the given socket.
+        bool IsSelected(TOsclSocket aSocket, uint8 aFlags)
+        {
+#if PV_SOCKET_SERVER_EPOLL
+            return (aSocket >= 0
+                    && (uint32)aSocket < iEpollReady.size()
+                    && (iEpollReady[aSocket] & aFlags) != 0);
+#else
+            return (((aFlags & OSCL_READSET_FLAG) && FD_ISSET(aSocket, &iReadset))
+                    || ((aFlags & OSCL_WRITESET_FLAG) && FD_ISSET(aSocket, &iWriteset))
+                    || ((aFlags & OSCL_EXCEPTSET_FLAG) && FD_ISSET(aSocket, &iExceptset)));
+#endif
+        }
+#endif
+
+        //forget activity on a socket after an operation would block.
+        //only needed in edge-triggered mode, where the activity will not
+        //be reported again until the socket state changes.
+        void ClearSelected(TOsclSocket aSocket, uint8 aFlags)
+        {
+#if PV_SOCKET_SERVER_EPOLL
+            if (aSocket >= 0 && (uint32)aSocket < iEpollReady.size())
+                iEpollReady[aSocket] &= ~aFlags;
+#else
+            OSCL_UNUSED_ARG(aSocket);
+            OSCL_UNUSED_ARG(aFlags);
+#endif
+        }
 
         friend class OsclSocketServRequestList;
         friend class LoopbackSocket;
@@ -146,12 +206,6 @@ class OsclSocketServI: public OsclTimerObject, public OsclSocketServIBase
 
 };
 
-/** A bitmask for socket select operations
-*/
-#define OSCL_READSET_FLAG 0x04
-#define OSCL_WRITESET_FLAG 0x02
-#define OSCL_EXCEPTSET_FLAG 0x01
-
 
 #endif
 
@@ -40,6 +40,9 @@
 OsclSocketServRequestList::OsclSocketServRequestList()
 {
     iContainer = NULL;
+#if PV_SOCKET_SERVER_EPOLL
+    iNumWaiting = 0;
+#endif
 }
 
 
@@ -99,11 +102,39 @@ void OsclSocketServRequestList::GetNewRequests()
 {
     Oscl_Vector<OsclSocketRequest*, OsclMemAllocator>::iterator it;
 
+#if PV_SOCKET_SERVER_EPOLL
+    //forget any readiness saved for sockets that were closed, before
+    //picking up requests that may be on a new socket with the same handle.
+    for (uint32 j = 0; j < iClosedSockets.size(); j++)
+    {
+        iContainer->ClearSelected(iClosedSockets[j]
+                                  , (OSCL_READSET_FLAG | OSCL_WRITESET_FLAG | OSCL_EXCEPTSET_FLAG));
+    }
+    iClosedSockets.clear();
+#endif
+
     //go through the new requests list and move them to the active requests list.
     for (it = iAddRequests.begin(); it != iAddRequests.end(); it++)
     {
         OsclSocketServRequestQElem elem(*it);
+#if PV_SOCKET_SERVER_EPOLL
+        //re-use a free slot if there is one.
+        uint32 slot;
+        if (!iFreeSlots.empty())
+        {
+            slot = iFreeSlots.back();
+            iFreeSlots.pop_back();
+            iActiveRequests[slot] = elem;
+        }
+        else
+        {
+            slot = iActiveRequests.size();
+            iActiveRequests.push_back(elem);
+        }
+        AddRunRequest(slot);
+#else
         iActiveRequests.push_back(elem);
+#endif
     }
     iAddRequests.clear();
 
@@ -116,6 +147,14 @@ void OsclSocketServRequestList::GetNewRequests()
             if (iActiveRequests[i].iSocketRequest == *it)
             {
                 iActiveRequests[i].iCancel = true;
+#if PV_SOCKET_SERVER_EPOLL
+                //make sure the cancel gets processed on the next pass.
+                if (iActiveRequests[i].iEpollState == OsclSocketServRequestQElem::EWaiting)
+                {
+                    RemoveWaitingRequest(i);
+                    AddRunRequest(i);
+                }
+#endif
                 break;
             }
         }
@@ -123,6 +162,84 @@ void OsclSocketServRequestList::GetNewRequests()
     iCancelRequests.clear();
 }
 
+#if PV_SOCKET_SERVER_EPOLL
+void OsclSocketServRequestList::SocketClosed(int32 aSocket)
+//called from the app thread when an OS-level socket is closed.
+{
+    Lock();
+    iClosedSockets.push_back(aSocket);
+    Unlock();
+}
+
+void OsclSocketServRequestList::AddRunRequest(uint32 aSlot)
+//put a request on the list to process on the next pass.
+{
+    OsclSocketServRequestQElem& elem = iActiveRequests[aSlot];
+    OSCL_ASSERT(elem.iEpollState == OsclSocketServRequestQElem::EIdle);
+    elem.iEpollState = OsclSocketServRequestQElem::ERun;
+    iRunRequests.push_back(aSlot);
+}
+
+void OsclSocketServRequestList::AddWaitingRequest(uint32 aSlot, int32 aSocket)
+//put a request on the waiting list for the given socket.
+{
+    while (iWaitingRequests.size() <= (uint32)aSocket)
+        iWaitingRequests.push_back(-1);
+
+    OsclSocketServRequestQElem& elem = iActiveRequests[aSlot];
+    OSCL_ASSERT(elem.iEpollState == OsclSocketServRequestQElem::EIdle);
+    elem.iEpollState = OsclSocketServRequestQElem::EWaiting;
+    elem.iEpollSocket = aSocket;
+    elem.iEpollNext = iWaitingRequests[aSocket];
+    iWaitingRequests[aSocket] = (int32)aSlot;
+    iNumWaiting++;
+}
+
+void OsclSocketServRequestList::RemoveWaitingRequest(uint32 aSlot)
+//take a request off the waiting list for its socket.
+{
+    OsclSocketServRequestQElem& elem = iActiveRequests[aSlot];
+    OSCL_ASSERT(elem.iEpollState == OsclSocketServRequestQElem::EWaiting);
+
+    //there are only a few requests per socket, so just walk the list.
+    int32* link = &iWaitingRequests[elem.iEpollSocket];
+    while (*link != (int32)aSlot)
+        link = &iActiveRequests[*link].iEpollNext;
+    *link = elem.iEpollNext;
+
+    elem.iEpollState = OsclSocketServRequestQElem::EIdle;
+    elem.iEpollNext = (-1);
+    iNumWaiting--;
+}
+
+void OsclSocketServRequestList::RunWaitingRequests(int32 aSocket)
+//move all requests waiting on the given socket to the run list.
+{
+    if (aSocket < 0 || (uint32)aSocket >= iWaitingRequests.size())
+        return;
+
+    int32 slot = iWaitingRequests[aSocket];
+    iWaitingRequests[aSocket] = (-1);
+    while (slot >= 0)
+    {
+        OsclSocketServRequestQElem& elem = iActiveRequests[slot];
+        int32 next = elem.iEpollNext;
+        elem.iEpollState = OsclSocketServRequestQElem::EIdle;
+        elem.iEpollNext = (-1);
+        iNumWaiting--;
+        AddRunRequest(slot);
+        slot = next;
+    }
+}
+
+void OsclSocketServRequestList::RunAllWaitingRequests()
+//move every waiting request to the run list.
+{
+    for (uint32 i = 0; i < iWaitingRequests.size(); i++)
+        RunWaitingRequests(i);
+}
+#endif
+
 void OsclSocketServRequestList::Wakeup()
 //wakeup the server
 {
@@ -152,6 +269,17 @@ void OsclSocketServRequestList::Close()
     iAddRequests.destroy();
     iCancelRequests.clear();
     iCancelRequests.destroy();
+#if PV_SOCKET_SERVER_EPOLL
+    iFreeSlots.clear();
+    iFreeSlots.destroy();
+    iRunRequests.clear();
+    iRunRequests.destroy();
+    iWaitingRequests.clear();
+    iWaitingRequests.destroy();
+    iNumWaiting = 0;
+    iClosedSockets.clear();
+    iClosedSockets.destroy();
+#endif
 #if(PV_SOCKET_SERVER_IS_THREAD)
     iCrit.Close();
     iSem.Close();
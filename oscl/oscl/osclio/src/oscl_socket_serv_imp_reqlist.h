@@ -41,11 +41,31 @@ class OsclSocketServRequestQElem
                 : iSocketRequest(r)
                 , iSelect(0)
                 , iCancel(false)
+#if PV_SOCKET_SERVER_EPOLL
+                , iEpollState(EIdle)
+                , iEpollSocket(-1)
+                , iEpollNext(-1)
+#endif
         {}
 
         OsclSocketRequest* iSocketRequest;
         uint8 iSelect;
         bool iCancel;
+
+#if PV_SOCKET_SERVER_EPOLL
+        //epoll mode: which list this request is on, and for a waiting
+        //request, the socket handle it waits on and the next slot
+        //waiting on the same socket.
+        enum TEpollState
+        {
+            EIdle
+            , ERun
+            , EWaiting
+        };
+        uint8 iEpollState;
+        int32 iEpollSocket;
+        int32 iEpollNext;
+#endif
 };
 
 /** PV socket server request queue
@@ -64,6 +84,17 @@ class OsclSocketServRequestList
         {
             aElem->iSocketRequest = NULL;
         }
+        bool Empty()
+        {
+#if PV_SOCKET_SERVER_EPOLL
+            return (iRunRequests.empty() && iNumWaiting == 0);
+#else
+            return iActiveRequests.empty();
+#endif
+        }
+#if PV_SOCKET_SERVER_EPOLL
+        void SocketClosed(int32 aSocket);
+#endif
 
     private:
         //a queue of the active sockets.
@@ -86,6 +117,29 @@ class OsclSocketServRequestList
         void Lock();
         void Unlock();
 
+#if PV_SOCKET_SERVER_EPOLL
+        //In epoll mode, completed requests leave a free slot in iActiveRequests
+        //instead of being erased, so the slot numbers held in the lists below
+        //stay valid.  The server only examines the requests on the run list;
+        //requests that are waiting on socket activity are kept on a list per
+        //socket handle until epoll reports activity for that socket.
+        Oscl_Vector<uint32, OsclMemAllocator> iFreeSlots;
+        Oscl_Vector<uint32, OsclMemAllocator> iRunRequests;
+        Oscl_Vector<int32, OsclMemAllocator> iWaitingRequests;
+        uint32 iNumWaiting;
+
+        //socket handles closed by the app since the last pass.  Their
+        //saved readiness is cleared before any new request is picked up,
+        //so a re-used handle doesn't inherit it.  Protected by the lock.
+        Oscl_Vector<int32, OsclMemAllocator> iClosedSockets;
+
+        void AddRunRequest(uint32 aSlot);
+        void AddWaitingRequest(uint32 aSlot, int32 aSocket);
+        void RemoveWaitingRequest(uint32 aSlot);
+        void RunWaitingRequests(int32 aSocket);
+        void RunAllWaitingRequests();
+#endif
+
         friend class OsclSocketServI;
 };
 
@@ -81,6 +81,51 @@
 #endif
 #endif
 
+/*!
+** PV_SOCKET_SERVER_EPOLL replaces the "select" call with an edge-triggered
+** epoll wait.  Each socket is registered once, the first time a request
+** needs to monitor it, and readiness is remembered per socket until an
+** operation would block, so each pass only does I/O on sockets that are
+** known to be ready and there is no FD_SETSIZE limit.
+** This option requires PV_SOCKET_SERVER_SELECT and platform epoll support
+** (OSCL_HAS_EPOLL), and is forced to "0" otherwise.
+*/
+#ifndef PV_SOCKET_SERVER_EPOLL
+#define PV_SOCKET_SERVER_EPOLL 0
+#endif
+#if !(PV_SOCKET_SERVER_SELECT) || !(OSCL_HAS_EPOLL)
+#undef PV_SOCKET_SERVER_EPOLL
+#define PV_SOCKET_SERVER_EPOLL 0
+#endif
+
+/*!
+** PV_SOCKET_SERVER_EPOLL_MAX_EVENTS sets the maximum number of epoll events
+** collected per wait call.  Any further events are picked up on the next call.
+*/
+#ifndef PV_SOCKET_SERVER_EPOLL_MAX_EVENTS
+#define PV_SOCKET_SERVER_EPOLL_MAX_EVENTS 64
+#endif
+
+/*!
+** PV_SOCKET_SERVER_RECVMMSG enables batched datagram receive for
+** multi-packet RecvFrom requests (non-zero aMultiMaxLen).  Up to
+** PV_SOCKET_SERVER_RECVMMSG_MAX_PACKETS datagrams are received per OS call
+** into slots of aMultiMaxLen bytes, then packed together in the caller's
+** buffer, so the result is the same as for the one-packet-per-call loop.
+** Requires platform support (OSCL_HAS_RECVMMSG), and is forced to "0" otherwise.
+*/
+#ifndef PV_SOCKET_SERVER_RECVMMSG
+#define PV_SOCKET_SERVER_RECVMMSG OSCL_HAS_RECVMMSG
+#endif
+#if !(OSCL_HAS_RECVMMSG)
+#undef PV_SOCKET_SERVER_RECVMMSG
+#define PV_SOCKET_SERVER_RECVMMSG 0
+#endif
+
+#ifndef PV_SOCKET_SERVER_RECVMMSG_MAX_PACKETS
+#define PV_SOCKET_SERVER_RECVMMSG_MAX_PACKETS 16
+#endif
+
 /*!
 ** PV_SOCKET_SERVER_THREAD_PRIORITY sets the priority of the PV socket
 ** server thread.
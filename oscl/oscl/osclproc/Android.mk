@@ -7,6 +7,7 @@ LOCAL_SRC_FILES := \
  	src/oscl_scheduler_ao.cpp \
  	src/oscl_scheduler_readyq.cpp \
  	src/oscl_scheduler_threadcontext.cpp \
+ 	src/oscl_scheduler_pool.cpp \
  	src/oscl_double_list.cpp \
  	src/oscl_timer.cpp \
  	src/oscl_timerbase.cpp \
@@ -43,6 +44,8 @@ LOCAL_COPY_HEADERS := \
  	src/oscl_scheduler_threadcontext.h \
  	src/oscl_scheduler_types.h \
  	src/oscl_scheduler_tuneables.h \
+ 	src/oscl_scheduler_pool.h \
+ 	src/oscl_scheduler_profile.h \
  	src/oscl_double_list.h \
  	src/oscl_double_list.inl \
  	src/oscl_timer.h \
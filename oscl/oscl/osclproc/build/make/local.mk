@@ -16,6 +16,7 @@ SRCS := oscl_execschedulerbase.cpp \
         oscl_scheduler_ao.cpp \
         oscl_scheduler_readyq.cpp \
         oscl_scheduler_threadcontext.cpp \
+        oscl_scheduler_pool.cpp \
         oscl_double_list.cpp \
         oscl_timer.cpp \
         oscl_timerbase.cpp \
@@ -33,6 +34,8 @@ HDRS := oscl_aostatus.h \
         oscl_scheduler_threadcontext.h \
         oscl_scheduler_types.h \
         oscl_scheduler_tuneables.h \
+        oscl_scheduler_pool.h \
+        oscl_scheduler_profile.h \
         oscl_double_list.h \
         oscl_double_list.inl \
         oscl_timer.h \
@@ -170,6 +170,28 @@ OSCL_EXPORT_REF void OsclScheduler::Cleanup()
 #define UPDATE_LEAVE_CODE(stats,err)if (err!=OsclErrNone)stats->iLeave=err
 #endif
 
+#if !(PV_SCHED_ENABLE_AO_PROFILE)
+#define UPDATE_QUEUED_TIME(stats,delta)
+#define UPDATE_RUNL_HISTOGRAM(stats,delta)
+#else
+//histogram bucket for a time in ticks, see OSCL_SCHED_PROFILE_NUM_BUCKETS.
+static inline uint32 ProfileBucket(uint32 aTicks)
+{
+    uint32 bucket = 0;
+    while (aTicks && bucket < OSCL_SCHED_PROFILE_NUM_BUCKETS - 1)
+    {
+        aTicks >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+#define UPDATE_QUEUED_TIME(stats,delta)\
+        stats->i64TotalTicksQueued+=delta;\
+        if(delta>stats->iMaxTicksQueued) stats->iMaxTicksQueued=delta;\
+        stats->iQueuedHistogram[ProfileBucket(delta)]++
+#define UPDATE_RUNL_HISTOGRAM(stats,delta) stats->iRunHistogram[ProfileBucket(delta)]++
+#endif
+
 #if (PV_SCHED_ENABLE_LOOP_STATS)
 #define DECLARE_LOOP_STATS int64 loopdelta = 0; PVTICK looptime;
 
@@ -436,6 +458,47 @@ void OsclExecSchedulerCommonBase::UninstallScheduler()
     LOGNOTICE((0, "PVSCHED:Scheduler '%s', Thread 0x%x: Uninstalled", iName.Str(), PVThreadContext::Id()));
 }
 
+#if(PV_SCHED_ENABLE_POOL)
+void OsclExecSchedulerCommonBase::EnterPoolThread()
+//Make this scheduler current in the calling thread.  The scheduler
+//must already be installed, and must not be current in any other thread.
+{
+    if (!IsInstalled())
+        OsclError::Leave(OsclErrNotInstalled);
+    //make sure no scheduler is installed in this thread.
+    if (GetScheduler())
+        OsclError::Leave(OsclErrAlreadyInstalled);
+
+    //Run calls are trapped with the error trap of this thread.
+    OsclErrorTrapImp* trap = OsclErrorTrap::GetErrorTrapImp();
+    if (!trap)
+        OsclError::Leave(OsclErrNotInstalled);//error trap not installed.
+
+    //the AO thread context checks compare against this thread ID.
+    int32 result = OsclThread::GetId(iThreadContext.iThreadId);
+    if (result != OsclProcStatus::SUCCESS_ERROR)
+        OsclError::Leave(OsclErrSystemCallFailed);
+
+    //nothing can leave after this point, so the scheduler is never left
+    //half current in this thread.
+    iErrorTrapImp = trap;
+    iThreadContext.iHasThreadId = true;
+    SetScheduler(this);
+}
+
+void OsclExecSchedulerCommonBase::ExitPoolThread()
+//Release this scheduler from the calling thread, if it is current.
+{
+    if (GetScheduler() == this)
+    {
+        //until the scheduler is entered again, no thread is its own
+        //thread, so requests are completed with the ready queue lock.
+        iThreadContext.iHasThreadId = false;
+        SetScheduler(NULL);
+    }
+}
+#endif //PV_SCHED_ENABLE_POOL
+
 OSCL_EXPORT_REF OsclExecScheduler* OsclExecScheduler::Current()
 //static routine to get current scheduler.
 {
@@ -942,6 +1005,51 @@ OSCL_EXPORT_REF void OsclExecScheduler::RegisterForCallback(OsclSchedulerObserve
     iReadyQ.RegisterForCallback(aCallback, aCallbackContext);
 }
 
+OSCL_EXPORT_REF void OsclExecScheduler::GetProfile(OsclSchedulerProfile& aProfile)
+//get a snapshot of the AO stats and ready queue depths.
+{
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+    //the stats are only updated in the scheduler thread, so they
+    //must be read there too.
+    if (!IsInstalled() || GetScheduler() != this)
+        OsclError::Leave(OsclErrNotInstalled);
+
+    aProfile.iTickFrequency = OsclTickCount::TickCountFrequency();
+    iReadyQ.GetProfile(aProfile);
+
+    aProfile.iAO.clear();
+    QUE_ITER_BEGIN(PVActiveStats, iPVStatQ)
+    {
+        //skip entries that were combined into another one,
+        //and AOs that never ran.
+        if (item
+                && item->iNumInstances > 0
+                && (item->iNumRun + item->iNumCancel) > 0)
+        {
+            //there may be multiple entries per AO, report them as one.
+            uint32 i;
+            for (i = 0; i < aProfile.iAO.size(); i++)
+            {
+                if (oscl_strncmp(aProfile.iAO[i].iName, item->iAOName.get_cstr(), OSCL_SCHED_PROFILE_NAMELEN) == 0)
+                    break;
+            }
+            if (i == aProfile.iAO.size())
+            {
+                OsclSchedulerAOProfile entry;
+                oscl_strncpy(entry.iName, item->iAOName.get_cstr(), OSCL_SCHED_PROFILE_NAMELEN);
+                entry.iPriority = item->iPriority;
+                aProfile.iAO.push_back(entry);
+            }
+            item->AddToProfile(aProfile.iAO[i]);
+        }
+    }
+    QUE_ITER_END(iPVStatQ)
+#else
+    OSCL_UNUSED_ARG(aProfile);
+    OsclError::Leave(OsclErrNotSupported);
+#endif
+}
+
 ////////////////////////////////////////
 // Queue Management
 ////////////////////////////////////////
@@ -1228,6 +1336,13 @@ void OsclExecSchedulerCommonBase::CallRunExec(PVActiveBase *pvactive)
 
     SET_TICK(iTime);
 
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+    //time from request completion until now.
+    uint32 queued = (uint32)iTime - pvactive->iPVReadyQLink.iTimeQueuedTicks;
+    UPDATE_QUEUED_TIME(iPVStats, queued);
+    iReadyQ.SampleProfile();
+#endif
+
     //Call the Run under a trap harness.
     //Pass the ErrorTrapImp pointer to reduce overhead of the Try call.
     //We already did a null ptr check on iErrorTrapImp so it's safe to de-ref here.
@@ -1237,6 +1352,7 @@ void OsclExecSchedulerCommonBase::CallRunExec(PVActiveBase *pvactive)
     //end stats
     DIFF_TICK(iTime, iDelta);
     UPDATE_RUNL_TIME(iPVStats, iDelta);
+    UPDATE_RUNL_HISTOGRAM(iPVStats, (uint32)iDelta);
     UPDATE_LEAVE_CODE(iPVStats, err);
 
 #if(PV_SCHED_ENABLE_PERF_LOGGING)
@@ -1360,6 +1476,10 @@ PVActiveBase* OsclExecSchedulerCommonBase::WaitForReadyAO()
             //from its current location on the top of the timer queue.
 
             pvtimer->iStatus = OSCL_REQUEST_ERR_NONE;
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+            //the timer became ready at its time to run.
+            pvtimer->iPVReadyQLink.iTimeQueuedTicks = pvtimer->iPVReadyQLink.iTimeToRunTicks;
+#endif
 
             START_LOOP_STATS(iOtherExecStats[EOtherExecStats_QueueTime]);
             iExecTimerQ.Pop(pvtimer);
@@ -201,6 +201,16 @@ class OsclExecSchedulerCommonBase
         void UninstallScheduler();
         friend class OsclScheduler;
 
+#if(PV_SCHED_ENABLE_POOL)
+        //Make this scheduler current in the calling thread, or
+        //release it from the calling thread.  Used by the
+        //scheduler pool to move an installed scheduler between
+        //pool threads.
+        void EnterPoolThread();
+        void ExitPoolThread();
+        friend class OsclExecSchedulerPool;
+#endif
+
     protected:
         void Error(int32 anError) const;
 
@@ -373,11 +383,27 @@ class OsclExecScheduler: public OsclExecSchedulerCommonBase
          */
         OSCL_IMPORT_REF void RegisterForCallback(OsclSchedulerObserver* aCallback, OsclAny* aCallbackContext);
 
+        /**
+         * Get a snapshot of the scheduler profile: Run time and queued time
+         * histograms for each AO, and the ready queue depth for each
+         * priority band.  Must be called in the scheduler thread.
+         *
+         * @param aProfile: (output param) the profile.  Any AO entries
+         *    already in the profile are replaced.
+         *
+         * Note: This call leaves with OsclErrNotSupported unless the
+         *  scheduler is built with PV_SCHED_ENABLE_AO_PROFILE.
+         */
+        OSCL_IMPORT_REF void GetProfile(OsclSchedulerProfile& aProfile);
+
 
     private:
         static OsclExecScheduler *NewL(const char *name, Oscl_DefAlloc *a, int nreserve);
         ~OsclExecScheduler();
         friend class OsclScheduler;
+#if(PV_SCHED_ENABLE_POOL)
+        friend class OsclExecSchedulerPool;
+#endif
 
 
         OsclExecScheduler(Oscl_DefAlloc*);
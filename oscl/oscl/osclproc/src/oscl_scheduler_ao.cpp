@@ -71,6 +71,12 @@ PVActiveStats::PVActiveStats(OsclExecSchedulerCommonBase* aScheduler, const char
     iNumCancel = 0;
     iNumInstances = 1;
     iPriority = (aActiveBase) ? aActiveBase->iPVReadyQLink.iAOPriority : 0;
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+    oscl_memset(iRunHistogram, 0, sizeof(iRunHistogram));
+    iMaxTicksQueued = 0;
+    i64TotalTicksQueued = 0;
+    oscl_memset(iQueuedHistogram, 0, sizeof(iQueuedHistogram));
+#endif
 }
 PVActiveStats::~PVActiveStats()
 {
@@ -91,7 +97,44 @@ void PVActiveStats::Combine(PVActiveStats& aStats)
     if (aStats.iLeave != OsclErrNone)
         iLeave = aStats.iLeave;
     iNumInstances++;
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+    for (uint32 i = 0; i < OSCL_SCHED_PROFILE_NUM_BUCKETS; i++)
+    {
+        iRunHistogram[i] += aStats.iRunHistogram[i];
+        iQueuedHistogram[i] += aStats.iQueuedHistogram[i];
+    }
+    if (aStats.iMaxTicksQueued > iMaxTicksQueued)
+        iMaxTicksQueued = aStats.iMaxTicksQueued;
+    i64TotalTicksQueued += aStats.i64TotalTicksQueued;
+#endif
 }
+
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+void PVActiveStats::AddToProfile(OsclSchedulerAOProfile& aProfile)
+//add this entry to a profile entry with the same AO name.
+{
+    aProfile.iNumInstances += iNumInstances;
+    aProfile.iNumRun += iNumRun;
+    aProfile.iNumRunError += iNumRunError;
+    aProfile.iNumCancel += iNumCancel;
+    if (iLeave != OsclErrNone)
+        aProfile.iLeave = iLeave;
+    if ((uint32)iMaxTicksInRun > aProfile.iMaxTicksInRun)
+        aProfile.iMaxTicksInRun = iMaxTicksInRun;
+    if (i64Valid)
+        aProfile.iTotalTicksInRun += i64TotalTicksInRun;
+    else
+        aProfile.iTotalTicksInRun += iTotalTicksInRun;
+    if (iMaxTicksQueued > aProfile.iMaxTicksQueued)
+        aProfile.iMaxTicksQueued = iMaxTicksQueued;
+    aProfile.iTotalTicksQueued += i64TotalTicksQueued;
+    for (uint32 i = 0; i < OSCL_SCHED_PROFILE_NUM_BUCKETS; i++)
+    {
+        aProfile.iRunHistogram[i] += iRunHistogram[i];
+        aProfile.iQueuedHistogram[i] += iQueuedHistogram[i];
+    }
+}
+#endif
 #endif //#if(PV_SCHED_ENABLE_AO_STATS)
 
 
@@ -52,6 +52,10 @@
 #include "oscl_string_containers.h"
 #endif
 
+#ifndef OSCL_SCHEDULER_PROFILE_H_INCLUDED
+#include "oscl_scheduler_profile.h"
+#endif
+
 /*
  * Macro for zeroizing the memory of a newly created object
  *
@@ -107,6 +111,15 @@ class PVActiveStats
         uint32 iNumInstances;//number of scheduler instances of this AO.
         int32 iPriority;//scheduler priority
 
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+        void AddToProfile(OsclSchedulerAOProfile&);
+
+        uint32 iRunHistogram[OSCL_SCHED_PROFILE_NUM_BUCKETS];//Run times
+        uint32 iMaxTicksQueued;//max time from request completion to Run
+        int64 i64TotalTicksQueued;
+        uint32 iQueuedHistogram[OSCL_SCHED_PROFILE_NUM_BUCKETS];//queued times
+#endif
+
         friend class PVActiveBase;
         friend class OsclExecScheduler;
         friend class OsclExecSchedulerCommonBase;
@@ -0,0 +1,637 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+
+#include "oscl_scheduler_pool.h"
+
+#if(PV_SCHED_ENABLE_POOL)
+
+#include "oscl_init.h"
+#include "oscl_error.h"
+#include "oscl_tickcount.h"
+#include "pvlogger.h"
+
+/////////////////////////////////////
+// Logger Macros
+/////////////////////////////////////
+
+//LOGERROR is for pool errors.
+#define LOGERROR(m) PVLOGGER_LOGMSG(PVLOGMSG_INST_REL,iLogger,PVLOGMSG_ERR,m);
+
+//LOGNOTICE is for pool start/stop and group add/remove notices.
+#define LOGNOTICE(m) PVLOGGER_LOGMSG(PVLOGMSG_INST_HLDBG,iLogger,PVLOGMSG_NOTICE,m);
+
+/*
+* Group states.  A group is idle, queued, or running, and only the thread
+* that dequeues a group may run it, so a group never runs in two threads
+* at once.  Idle to queued happens in the ready callback, on timer expiry,
+* or when the group is removed.  Queued to running happens when a pool
+* thread takes the group from a thread queue.  Running to idle or queued
+* happens at the end of a Run slice.  All state changes are made under the
+* pool lock.  The thread queue locks are only held briefly, and are always
+* taken after the pool lock when both are held.
+*
+* A ready callback can come from any thread, while the ready queue lock of
+* the group scheduler is held.  So the pool registers for the callback
+* before it makes the group idle, never while it holds the pool lock, and
+* a callback that comes in while the group is running just sets iWakeup.
+*/
+
+/////////////////////////////////////
+// OsclSchedulerGroup
+/////////////////////////////////////
+
+OsclSchedulerGroup::OsclSchedulerGroup()
+{
+    iState = EIdle;
+    iScheduler = NULL;
+    iObserver = NULL;
+    iContext = NULL;
+    iStarted = false;
+    iWakeup = false;
+    iRemove = false;
+    iThreadIndex = 0;
+    iNext = NULL;
+    iPrev = NULL;
+    iTimerLink.iOwner = this;
+}
+
+/////////////////////////////////////
+// OsclSchedulerPoolThread
+/////////////////////////////////////
+
+/**
+ * A pool thread, with its queue of ready groups.  The owning thread takes
+ * groups from the front of the queue.  Other threads take groups from the
+ * back of the queue, which is the group that would otherwise wait the
+ * longest.
+ */
+class OsclSchedulerPoolThread
+{
+    public:
+        OsclSchedulerPoolThread(OsclExecSchedulerPool* aPool, uint32 aIndex)
+                : iPool(aPool)
+                , iIndex(aIndex)
+                , iStatus(OsclErrNone)
+                , iHead(NULL)
+                , iTail(NULL)
+        {
+            iLock.Create();
+            iExit.Create();
+        }
+
+        ~OsclSchedulerPoolThread()
+        {
+            iLock.Close();
+            iExit.Close();
+        }
+
+        void PushBack(OsclSchedulerGroup* aGroup)
+        {
+            iLock.Lock();
+            aGroup->iNext = NULL;
+            aGroup->iPrev = iTail;
+            if (iTail)
+                iTail->iNext = aGroup;
+            else
+                iHead = aGroup;
+            iTail = aGroup;
+            iLock.Unlock();
+        }
+
+        OsclSchedulerGroup* PopFront()
+        {
+            iLock.Lock();
+            OsclSchedulerGroup* group = iHead;
+            if (group)
+            {
+                iHead = group->iNext;
+                if (iHead)
+                    iHead->iPrev = NULL;
+                else
+                    iTail = NULL;
+                group->iNext = NULL;
+            }
+            iLock.Unlock();
+            return group;
+        }
+
+        //thread entry, and startup failure.
+        void Run()
+        {
+            iPool->ThreadLoop(this);
+        }
+        void StartFailed()
+        {
+            iPool->iThreadStart.Signal();
+        }
+
+        OsclSchedulerGroup* PopBack()
+        {
+            iLock.Lock();
+            OsclSchedulerGroup* group = iTail;
+            if (group)
+            {
+                iTail = group->iPrev;
+                if (iTail)
+                    iTail->iNext = NULL;
+                else
+                    iHead = NULL;
+                group->iPrev = NULL;
+            }
+            iLock.Unlock();
+            return group;
+        }
+
+        OsclExecSchedulerPool* iPool;
+        uint32 iIndex;
+        int32 iStatus;//thread startup status.
+        OsclSemaphore iExit;//signaled on thread exit.
+
+    private:
+        OsclMutex iLock;
+        OsclSchedulerGroup* iHead;
+        OsclSchedulerGroup* iTail;
+};
+
+static TOsclThreadFuncRet OSCL_THREAD_DECL poolthreadmain(TOsclThreadFuncArg arg)
+//pool thread.
+{
+    OsclSchedulerPoolThread* thread = (OsclSchedulerPoolThread*)arg;
+
+    //init everything but the scheduler.  each group brings its own
+    //scheduler.
+    OsclSelect select;
+    select.iOsclScheduler = false;
+    OsclInit::Init(thread->iStatus, &select);
+
+    if (thread->iStatus == OsclErrNone)
+    {
+        int32 err;
+        OSCL_TRY(err, thread->Run(););
+        OSCL_UNUSED_ARG(err);
+
+        OsclInit::Cleanup(err, &select);
+    }
+    else
+    {
+        thread->StartFailed();
+    }
+
+    thread->iExit.Signal();
+    return 0;
+}
+
+/////////////////////////////////////
+// OsclExecSchedulerPool
+/////////////////////////////////////
+
+OSCL_EXPORT_REF OsclExecSchedulerPool::OsclExecSchedulerPool()
+{
+    iObserver = NULL;
+    iStop = false;
+    iNextThread = 0;
+    iNumStarted = 0;
+    iLogger = NULL;
+}
+
+OSCL_EXPORT_REF OsclExecSchedulerPool::~OsclExecSchedulerPool()
+{
+    Stop();
+}
+
+OSCL_EXPORT_REF int32 OsclExecSchedulerPool::Start(uint32 aNumThreads, OsclSchedulerPoolObserver* aObserver)
+{
+    if (!iThreads.empty())
+        return OsclErrInvalidState;//already started
+    if (aNumThreads == 0)
+        return OsclErrArgument;
+
+    iLogger = PVLogger::GetLoggerObject("OsclSchedulerPool");
+
+    iCrit.Create();
+    iWork.Create();
+    iThreadStart.Create();
+
+    iObserver = aObserver;
+    iStop = false;
+    iNextThread = 0;
+    iNumStarted = 0;
+
+    //create all the thread objects before starting any thread,
+    //since the threads look at each other's queues.
+    iThreads.reserve(aNumThreads);
+    for (uint32 i = 0; i < aNumThreads; i++)
+    {
+        OsclSchedulerPoolThread* thread = OSCL_NEW(OsclSchedulerPoolThread, (this, i));
+        iThreads.push_back(thread);
+    }
+
+    int32 status = OsclErrNone;
+    for (uint32 i = 0; i < aNumThreads && status == OsclErrNone; i++)
+    {
+        OsclThread thread;
+        OsclProcStatus::eOsclProcError err = thread.Create((TOsclThreadFuncPtr)poolthreadmain,
+                                             0,
+                                             (TOsclThreadFuncArg)iThreads[i]);
+        if (err != OsclProcStatus::SUCCESS_ERROR)
+        {
+            status = OsclErrGeneral;
+            break;
+        }
+        iNumStarted++;
+
+        //wait til thread starts
+        iThreadStart.Wait();
+        status = iThreads[i]->iStatus;
+    }
+
+    if (status != OsclErrNone)
+    {
+        LOGERROR((0, "OsclSchedulerPool: Start failed, status %d", status));
+        Stop();
+        return status;
+    }
+
+    LOGNOTICE((0, "OsclSchedulerPool: Started %d threads", aNumThreads));
+    return OsclErrNone;
+}
+
+OSCL_EXPORT_REF void OsclExecSchedulerPool::Stop()
+{
+    if (iThreads.empty())
+        return;//not started
+
+    //remove any remaining groups.
+    for (;;)
+    {
+        OsclSchedulerGroup* group = NULL;
+        iCrit.Lock();
+        if (!iGroups.empty())
+            group = iGroups.back();
+        iCrit.Unlock();
+        if (!group)
+            break;
+        RemoveGroup(group);
+    }
+
+    //stop the threads and wait til they exit.
+    iCrit.Lock();
+    iStop = true;
+    iCrit.Unlock();
+    for (uint32 i = 0; i < iNumStarted; i++)
+        iWork.Signal();
+    for (uint32 i = 0; i < iNumStarted; i++)
+        iThreads[i]->iExit.Wait();
+
+    for (uint32 i = 0; i < iThreads.size(); i++)
+        OSCL_DELETE(iThreads[i]);
+    iThreads.clear();
+    iNumStarted = 0;
+
+    iThreadStart.Close();
+    iWork.Close();
+    iCrit.Close();
+
+    LOGNOTICE((0, "OsclSchedulerPool: Stopped"));
+}
+
+OSCL_EXPORT_REF OsclSchedulerGroup* OsclExecSchedulerPool::AddGroup(const char* aName, OsclSchedulerGroupObserver* aObserver, OsclAny* aContext)
+{
+    if (iThreads.empty() || !aObserver)
+        return NULL;
+
+    OsclSchedulerGroup* group = OSCL_NEW(OsclSchedulerGroup, ());
+    group->iName.Set(aName);
+    group->iObserver = aObserver;
+    group->iContext = aContext;
+    group->iRemoved.Create();
+
+    iCrit.Lock();
+    //spread new groups over the threads.
+    group->iThreadIndex = iNextThread;
+    iNextThread = (iNextThread + 1) % iThreads.size();
+    iGroups.push_back(group);
+    //queue the group so a thread will start it.
+    QueueGroup(group);
+    iCrit.Unlock();
+
+    LOGNOTICE((0, "OsclSchedulerPool: Group '%s' added", group->iName.Str()));
+    return group;
+}
+
+OSCL_EXPORT_REF void OsclExecSchedulerPool::RemoveGroup(OsclSchedulerGroup* aGroup)
+{
+    if (!aGroup)
+        return;
+
+    //flag the group for removal.  an idle group is queued now, otherwise
+    //the thread that has it will queue it again after the current Run slice.
+    iCrit.Lock();
+    aGroup->iRemove = true;
+    if (aGroup->iState == OsclSchedulerGroup::EIdle)
+    {
+        if (aGroup->iTimerLink.IsQueued())
+            iTimers.Remove(&aGroup->iTimerLink);
+        QueueGroup(aGroup);
+    }
+    iCrit.Unlock();
+
+    //wait til a pool thread stops the group.
+    aGroup->iRemoved.Wait();
+
+    iCrit.Lock();
+    for (uint32 i = 0; i < iGroups.size(); i++)
+    {
+        if (iGroups[i] == aGroup)
+        {
+            iGroups.erase(iGroups.begin() + i);
+            break;
+        }
+    }
+    iCrit.Unlock();
+
+    LOGNOTICE((0, "OsclSchedulerPool: Group '%s' removed", aGroup->iName.Str()));
+
+    aGroup->iRemoved.Close();
+    OSCL_DELETE(aGroup);
+}
+
+void OsclExecSchedulerPool::OsclSchedulerTimerCallback(OsclAny* aContext, uint32 aDelayMsec)
+{
+    //timer callbacks only happen in the group's own thread, while the group
+    //is running, so there's nothing to do.  the next timer is picked up at
+    //the end of the Run slice.
+    OSCL_UNUSED_ARG(aContext);
+    OSCL_UNUSED_ARG(aDelayMsec);
+}
+
+void OsclExecSchedulerPool::OsclSchedulerReadyCallback(OsclAny* aContext)
+{
+    //an AO in the group is ready to run.  this may be called from any thread.
+    OsclSchedulerGroup* group = (OsclSchedulerGroup*)aContext;
+    iCrit.Lock();
+    switch (group->iState)
+    {
+        case OsclSchedulerGroup::EIdle:
+            if (group->iTimerLink.IsQueued())
+                iTimers.Remove(&group->iTimerLink);
+            QueueGroup(group);
+            break;
+        case OsclSchedulerGroup::ERunning:
+            //the group is finishing a Run slice.  let it know it
+            //needs to run again.
+            group->iWakeup = true;
+            break;
+        default:
+            break;
+    }
+    iCrit.Unlock();
+}
+
+void OsclExecSchedulerPool::QueueGroup(OsclSchedulerGroup* aGroup)
+//Queue a group to the thread that last ran it.
+//Called under the pool lock.
+{
+    aGroup->iState = OsclSchedulerGroup::EQueued;
+    iThreads[aGroup->iThreadIndex]->PushBack(aGroup);
+    iWork.Signal();
+}
+
+bool OsclExecSchedulerPool::ExpireTimers(uint32& aWaitMsec)
+//Queue all groups whose timers are due.  Return the time until the next
+//timer in aWaitMsec, or 0 if there isn't one.
+//Return true when the pool is stopping.
+{
+    aWaitMsec = 0;
+
+    iCrit.Lock();
+    uint32 timenow = OsclTickCount::TickCount();
+    for (OsclTimerWheelLink* link = iTimers.Top(); link; link = iTimers.Top())
+    {
+        //calculate time to run <= timenow, taking possible rollover into account
+        uint32 deltaTicks = link->iTime - timenow;
+        if (deltaTicks != 0 && deltaTicks <= 0x7fffffff)
+        {
+            aWaitMsec = OsclTickCount::TicksToMsec(deltaTicks);
+            if (aWaitMsec == 0)
+                aWaitMsec = 1;
+            break;
+        }
+        iTimers.Remove(link);
+        QueueGroup((OsclSchedulerGroup*)link->iOwner);
+    }
+    bool stop = iStop;
+    iCrit.Unlock();
+
+    return stop;
+}
+
+OsclSchedulerGroup* OsclExecSchedulerPool::StealGroup(uint32 aThreadIndex)
+//Take a ready group from the queue of another thread.
+{
+    uint32 numthreads = iThreads.size();
+    for (uint32 i = 1; i < numthreads; i++)
+    {
+        OsclSchedulerGroup* group = iThreads[(aThreadIndex + i) % numthreads]->PopBack();
+        if (group)
+            return group;
+    }
+    return NULL;
+}
+
+void OsclExecSchedulerPool::ThreadLoop(OsclSchedulerPoolThread* aThread)
+//Main loop of a pool thread.
+{
+    if (iObserver)
+        iObserver->OsclSchedulerPoolThreadStart(aThread->iIndex);
+
+    iThreadStart.Signal();
+
+    for (;;)
+    {
+        uint32 waitMsec;
+        bool stop = ExpireTimers(waitMsec);
+
+        //run a group from this thread's queue, or from another thread.
+        OsclSchedulerGroup* group = aThread->PopFront();
+        if (!group)
+            group = StealGroup(aThread->iIndex);
+        if (group)
+        {
+            RunGroup(aThread, group);
+            continue;
+        }
+
+        if (stop)
+            break;
+
+        //nothing to do-- wait for a group to be queued or the next timer.
+        if (waitMsec > 0)
+            iWork.Wait(waitMsec);
+        else
+            iWork.Wait();
+    }
+
+    if (iObserver)
+        iObserver->OsclSchedulerPoolThreadStop(aThread->iIndex);
+}
+
+void OsclExecSchedulerPool::RunGroup(OsclSchedulerPoolThread* aThread, OsclSchedulerGroup* aGroup)
+//Run a group that was taken from a thread queue.
+{
+    iCrit.Lock();
+    aGroup->iState = OsclSchedulerGroup::ERunning;
+    aGroup->iWakeup = false;
+    aGroup->iThreadIndex = aThread->iIndex;
+    bool remove = aGroup->iRemove;
+    iCrit.Unlock();
+
+    if (remove)
+    {
+        StopGroup(aGroup);
+        return;
+    }
+
+    //run the group in this thread.
+    int32 ready = 0;
+    uint32 delay = 0;
+    int32 err;
+    OSCL_TRY(err, RunSlice(aGroup, ready, delay););
+    if (err != OsclErrNone)
+    {
+        //a Run or RunError call left.  the group carries on-- any AO
+        //that is still ready will be picked up by the callback below.
+        LOGERROR((0, "OsclSchedulerPool: Group '%s' Run leave %d", aGroup->iName.Str(), err));
+        ready = 0;
+        delay = 0;
+    }
+    if (aGroup->iScheduler)
+        aGroup->iScheduler->ExitPoolThread();
+
+    if (err != OsclErrNone
+            && !aGroup->iStarted)
+    {
+        //the group scheduler could not be created or installed, so no AO
+        //of the group will ever run.  report it, then the group stays idle
+        //until it is removed.
+        int32 error;
+        OSCL_TRY(error, aGroup->iObserver->OsclSchedulerGroupStartFailed(aGroup->iContext, err););
+        if (error != OsclErrNone)
+            LOGERROR((0, "OsclSchedulerPool: Group '%s' StartFailed leave %d", aGroup->iName.Str(), error));
+    }
+
+    //register for a callback when the group has nothing ready.  the callback
+    //may come right away, in which case it sets iWakeup.
+    if (aGroup->iStarted
+            && ready == 0)
+    {
+        aGroup->iScheduler->RegisterForCallback(this, aGroup);
+    }
+
+    iCrit.Lock();
+    if (ready > 0
+            || aGroup->iWakeup
+            || aGroup->iRemove)
+    {
+        QueueGroup(aGroup);
+    }
+    else
+    {
+        aGroup->iState = OsclSchedulerGroup::EIdle;
+        if (delay > 0)
+        {
+            aGroup->iTimerLink.iTime = OsclTickCount::TickCount() + OsclTickCount::MsecToTicks(delay);
+            iTimers.Add(&aGroup->iTimerLink);
+            //wake up a waiting thread if this is the new earliest timer.
+            if (iTimers.Top() == &aGroup->iTimerLink)
+                iWork.Signal();
+        }
+    }
+    iCrit.Unlock();
+}
+
+void OsclExecSchedulerPool::RunSlice(OsclSchedulerGroup* aGroup, int32& aReady, uint32& aDelayMsec)
+//Run one slice of a group in this thread.  May leave.
+{
+    if (!aGroup->iStarted)
+    {
+        //first run-- create the group scheduler, install it in
+        //this thread, then let the group create its AOs.
+        if (!aGroup->iScheduler)
+            aGroup->iScheduler = OsclExecScheduler::NewL((const char*)aGroup->iName.Str(), NULL, 10);
+        aGroup->iScheduler->InstallScheduler();
+        aGroup->iStarted = true;
+        aGroup->iObserver->OsclSchedulerGroupStart(aGroup->iContext);
+    }
+    else
+    {
+        aGroup->iScheduler->EnterPoolThread();
+    }
+
+    //clear any callback left over from an earlier slice.
+    aGroup->iScheduler->RegisterForCallback(NULL, NULL);
+
+    aGroup->iScheduler->RunSchedulerNonBlocking(PV_SCHED_POOL_SLICE, aReady, aDelayMsec);
+}
+
+void OsclExecSchedulerPool::StopGroup(OsclSchedulerGroup* aGroup)
+//Stop and delete the group scheduler, then release the RemoveGroup caller.
+{
+    OsclExecScheduler* sched = aGroup->iScheduler;
+    if (sched)
+    {
+        bool uninstalled = !aGroup->iStarted;
+        if (aGroup->iStarted)
+        {
+            int32 err;
+            OSCL_TRY(err, sched->EnterPoolThread(););
+            if (err == OsclErrNone)
+            {
+                sched->RegisterForCallback(NULL, NULL);
+
+                OSCL_TRY(err, aGroup->iObserver->OsclSchedulerGroupStop(aGroup->iContext););
+                if (err != OsclErrNone)
+                    LOGERROR((0, "OsclSchedulerPool: Group '%s' Stop leave %d", aGroup->iName.Str(), err));
+
+                OSCL_TRY(err, sched->UninstallScheduler(););
+                uninstalled = (err == OsclErrNone);
+                if (!uninstalled)
+                {
+                    LOGERROR((0, "OsclSchedulerPool: Group '%s' Uninstall leave %d", aGroup->iName.Str(), err));
+                    sched->ExitPoolThread();
+                }
+            }
+        }
+
+        //an installed scheduler can't be deleted, so it is leaked if
+        //uninstall failed.
+        if (uninstalled)
+        {
+            Oscl_DefAlloc *alloc = sched->iAlloc;
+            sched->~OsclExecScheduler();
+            alloc->deallocate(sched);
+        }
+        aGroup->iScheduler = NULL;
+    }
+
+    //the group belongs to the RemoveGroup caller after this.
+    aGroup->iRemoved.Signal();
+}
+
+#endif //PV_SCHED_ENABLE_POOL
+
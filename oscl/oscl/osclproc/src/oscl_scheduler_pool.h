@@ -0,0 +1,254 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*! \addtogroup osclproc OSCL Proc
+ *
+ * @{
+ */
+
+
+
+/** \file oscl_scheduler_pool.h
+    \brief Scheduler pool, to run groups of AOs on a shared set of threads.
+*/
+
+
+#ifndef OSCL_SCHEDULER_POOL_H_INCLUDED
+#define OSCL_SCHEDULER_POOL_H_INCLUDED
+
+#ifndef OSCL_SCHEDULER_H_INCLUDED
+#include "oscl_scheduler.h"
+#endif
+
+#ifndef OSCL_SCHEDULER_TUNEABLES_H_INCLUDED
+#include "oscl_scheduler_tuneables.h"
+#endif
+
+#if(PV_SCHED_ENABLE_POOL)
+
+#ifndef OSCL_THREAD_H_INCLUDED
+#include "oscl_thread.h"
+#endif
+
+#ifndef OSCL_TIMER_WHEEL_H_INCLUDED
+#include "oscl_timer_wheel.h"
+#endif
+
+#ifndef OSCL_VECTOR_H_INCLUDED
+#include "oscl_vector.h"
+#endif
+
+/**
+ * OsclSchedulerGroupObserver is implemented by the owner of a scheduler
+ * group.  The calls are made in a pool thread, with the group's scheduler
+ * installed, so this is where the AOs of the group are created and
+ * destroyed.
+ */
+class OsclSchedulerGroupObserver
+{
+    public:
+        /**
+         * Called once, before any AO of the group runs.  AOs that are
+         * added to the scheduler here, or later from the Run calls of the
+         * group's AOs, belong to the group.
+         */
+        virtual void OsclSchedulerGroupStart(OsclAny* aContext) = 0;
+
+        /**
+         * Called instead of OsclSchedulerGroupStart when the group's
+         * scheduler cannot be created or installed.  No AO of the group
+         * will run, but the group must still be removed.  The call is made
+         * in a pool thread with no scheduler installed.
+         *
+         * @param aError: the leave code.
+         */
+        virtual void OsclSchedulerGroupStartFailed(OsclAny* aContext, int32 aError) = 0;
+
+        /**
+         * Called once, when a started group is removed.  All AOs of the group
+         * must be removed from the scheduler here.
+         */
+        virtual void OsclSchedulerGroupStop(OsclAny* aContext) = 0;
+
+        virtual ~OsclSchedulerGroupObserver() {}
+};
+
+/**
+ * OsclSchedulerPoolObserver is an optional observer for the pool threads.
+ * The calls are made in each pool thread after Oscl is initialized in the
+ * thread and before it is cleaned up, so it can be used to set up any
+ * per-thread state that the groups rely on, such as the TLS-based
+ * registries.
+ */
+class OsclSchedulerPoolObserver
+{
+    public:
+        virtual void OsclSchedulerPoolThreadStart(uint32 aThreadIndex) = 0;
+        virtual void OsclSchedulerPoolThreadStop(uint32 aThreadIndex) = 0;
+
+        virtual ~OsclSchedulerPoolObserver() {}
+};
+
+class OsclExecSchedulerPool;
+class OsclSchedulerPoolThread;
+
+/**
+ * A scheduler group, for internal use by the pool.
+ */
+class OsclSchedulerGroup
+{
+    private:
+        OsclSchedulerGroup();
+
+        enum TState
+        {
+            EIdle //waiting for an AO to become ready.
+            , EQueued //in the queue of a pool thread.
+            , ERunning //running in a pool thread.
+        };
+        TState iState;
+
+        OsclExecScheduler* iScheduler;
+        OsclSchedulerGroupObserver* iObserver;
+        OsclAny* iContext;
+        OsclNameString<PVSCHEDNAMELEN> iName;
+
+        bool iStarted;//set once the group scheduler is installed.
+        bool iWakeup;//set when an AO becomes ready during a Run.
+        bool iRemove;//set when the group is being removed.
+        OsclSemaphore iRemoved;//signaled when the group is stopped.
+
+        //the pool thread that last ran this group.
+        uint32 iThreadIndex;
+
+        //link for the thread queue.
+        OsclSchedulerGroup* iNext;
+        OsclSchedulerGroup* iPrev;
+
+        //link for the pool timer wheel, when a timer is pending.
+        OsclTimerWheelLink iTimerLink;
+
+        friend class OsclExecSchedulerPool;
+        friend class OsclSchedulerPoolThread;
+};
+
+/**
+ * OsclExecSchedulerPool runs scheduler groups on a fixed set of threads.
+ *
+ * Each group has its own OsclExecScheduler, and the AOs of a group only
+ * ever run in one thread at a time, so code that is written for the
+ * single-threaded scheduler, such as a PVMF node or a complete engine
+ * session, runs unchanged inside a group.  Different groups run in
+ * parallel.
+ *
+ * A ready group is queued to the thread that last ran it.  A thread with
+ * nothing to run takes a group from the queue of another thread.
+ *
+ * Since a group may run in a different thread each time, the AOs of a group
+ * must not rely on thread-local state other than the scheduler and the
+ * error trap.  Calls into the AOs of a group from outside the group follow
+ * the same rules as calls from another thread to a single-threaded
+ * scheduler.
+ */
+class OsclExecSchedulerPool: public OsclSchedulerObserver
+{
+    public:
+        OSCL_IMPORT_REF OsclExecSchedulerPool();
+        OSCL_IMPORT_REF ~OsclExecSchedulerPool();
+
+        /**
+         * Start the pool threads.
+         *
+         * @param aNumThreads: number of pool threads.
+         * @param aObserver: optional observer for thread startup and cleanup.
+         * @return OsclErrNone or an error code.
+         */
+        OSCL_IMPORT_REF int32 Start(uint32 aNumThreads, OsclSchedulerPoolObserver* aObserver = NULL);
+
+        /**
+         * Remove any remaining groups and stop the pool threads.
+         * This call blocks until the threads have exited.  It must not be
+         * called from a pool thread.
+         */
+        OSCL_IMPORT_REF void Stop();
+
+        /**
+         * Add a scheduler group.  The group scheduler is installed in a pool
+         * thread, then the observer's OsclSchedulerGroupStart is called.
+         *
+         * @param aName: scheduler name for the group.
+         * @param aObserver: group observer.
+         * @param aContext: context for the observer calls.
+         * @return the group, or NULL if the pool is not started.
+         */
+        OSCL_IMPORT_REF OsclSchedulerGroup* AddGroup(const char* aName, OsclSchedulerGroupObserver* aObserver, OsclAny* aContext);
+
+        /**
+         * Remove a scheduler group.  The observer's OsclSchedulerGroupStop
+         * is called in a pool thread, then the group scheduler is
+         * uninstalled and deleted.  This call blocks until the group is
+         * deleted.  It must not be called from a pool thread.
+         */
+        OSCL_IMPORT_REF void RemoveGroup(OsclSchedulerGroup* aGroup);
+
+    private:
+        //From OsclSchedulerObserver
+        void OsclSchedulerTimerCallback(OsclAny* aContext, uint32 aDelayMsec);
+        void OsclSchedulerReadyCallback(OsclAny* aContext);
+
+        void QueueGroup(OsclSchedulerGroup* aGroup);
+        bool ExpireTimers(uint32& aWaitMsec);
+        OsclSchedulerGroup* StealGroup(uint32 aThreadIndex);
+        void RunGroup(OsclSchedulerPoolThread* aThread, OsclSchedulerGroup* aGroup);
+        void RunSlice(OsclSchedulerGroup* aGroup, int32& aReady, uint32& aDelayMsec);
+        void StopGroup(OsclSchedulerGroup* aGroup);
+        void ThreadLoop(OsclSchedulerPoolThread* aThread);
+
+        //pool lock, for the group state, the timer wheel, and the group list.
+        OsclMutex iCrit;
+
+        //signaled when a group is queued, or the earliest timer changes.
+        OsclSemaphore iWork;
+
+        //signaled by each thread on startup.
+        OsclSemaphore iThreadStart;
+
+        Oscl_Vector<OsclSchedulerPoolThread*, OsclMemAllocator> iThreads;
+        uint32 iNumStarted;
+        OsclSchedulerPoolObserver* iObserver;
+        bool iStop;
+
+        //idle groups with a pending timer.
+        OsclTimerWheel<> iTimers;
+
+        //all groups.
+        Oscl_Vector<OsclSchedulerGroup*, OsclMemAllocator> iGroups;
+
+        //thread for the next added group.
+        uint32 iNextThread;
+
+        PVLogger* iLogger;
+
+        friend class OsclSchedulerPoolThread;
+};
+
+#endif //PV_SCHED_ENABLE_POOL
+
+#endif
+
+
+/*! @} */
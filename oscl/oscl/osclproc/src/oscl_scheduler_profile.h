@@ -0,0 +1,137 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+/*! \addtogroup osclproc OSCL Proc
+ *
+ * @{
+ */
+
+
+/** \file oscl_scheduler_profile.h
+    \brief Scheduler profile snapshot types.
+*/
+
+
+#ifndef OSCL_SCHEDULER_PROFILE_H_INCLUDED
+#define OSCL_SCHEDULER_PROFILE_H_INCLUDED
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+
+#ifndef OSCL_VECTOR_H_INCLUDED
+#include "oscl_vector.h"
+#endif
+
+#ifndef OSCL_MEM_H_INCLUDED
+#include "oscl_mem.h"
+#endif
+
+/** Number of histogram buckets.  Bucket 0 counts times of 0 ticks,
+    bucket n counts times from 2^(n-1) to 2^n - 1 ticks, and the last
+    bucket also counts all longer times.
+*/
+#define OSCL_SCHED_PROFILE_NUM_BUCKETS 16
+
+/** Max length of an AO name in the profile.  Same as PVEXECNAMELEN.
+*/
+#define OSCL_SCHED_PROFILE_NAMELEN 30
+
+/** Ready queue priority bands.  Each band holds the AOs with a priority
+    from the named OsclActiveObject priority up to the next one.
+*/
+enum TOsclSchedProfileBand
+{
+    EOsclSchedProfileBand_Idle //below EPriorityLow
+    , EOsclSchedProfileBand_Low //EPriorityLow and up
+    , EOsclSchedProfileBand_Nominal //EPriorityNominal and up
+    , EOsclSchedProfileBand_High //EPriorityHigh and up
+    , EOsclSchedProfileBand_Highest //EPriorityHighest and up
+    , EOsclSchedProfileBand_Last
+};
+
+/** Profile of one AO, or of all AOs with the same name.
+    All times are in ticks, see OsclSchedulerProfile::iTickFrequency.
+*/
+class OsclSchedulerAOProfile
+{
+    public:
+        OsclSchedulerAOProfile()
+        {
+            oscl_memset(this, 0, sizeof(OsclSchedulerAOProfile));
+        }
+
+        char iName[OSCL_SCHED_PROFILE_NAMELEN + 1];//AO name
+        int32 iPriority;//scheduler priority
+        uint32 iNumInstances;//number of AO instances with this name
+
+        uint32 iNumRun;//how many Run calls
+        uint32 iNumRunError;//how many RunError calls
+        uint32 iNumCancel;//how many DoCancel calls
+        int32 iLeave;//last leave code from a Run call
+
+        //time spent in Run
+        uint32 iMaxTicksInRun;
+        int64 iTotalTicksInRun;
+        uint32 iRunHistogram[OSCL_SCHED_PROFILE_NUM_BUCKETS];
+
+        //time from request completion to the start of Run
+        uint32 iMaxTicksQueued;
+        int64 iTotalTicksQueued;
+        uint32 iQueuedHistogram[OSCL_SCHED_PROFILE_NUM_BUCKETS];
+};
+
+/** Ready queue depth for one priority band.
+*/
+class OsclSchedulerBandProfile
+{
+    public:
+        OsclSchedulerBandProfile()
+        {
+            iDepth = 0;
+            iMaxDepth = 0;
+            iTotalDepth = 0;
+        }
+
+        uint32 iDepth;//current number of ready AOs
+        uint32 iMaxDepth;//largest number of ready AOs
+        int64 iTotalDepth;//sum of the depth seen at each Run call
+};
+
+/** Scheduler profile snapshot, filled in by OsclExecScheduler::GetProfile.
+    Counts and times add up from the time the scheduler was installed,
+    so the activity in an interval is the difference of two snapshots.
+*/
+class OsclSchedulerProfile
+{
+    public:
+        OsclSchedulerProfile()
+        {
+            iTickFrequency = 0;
+            iNumSamples = 0;
+        }
+
+        uint32 iTickFrequency;//ticks per second
+        uint32 iNumSamples;//number of Run calls the depth was sampled at
+        OsclSchedulerBandProfile iBand[EOsclSchedProfileBand_Last];
+        Oscl_Vector<OsclSchedulerAOProfile, OsclMemAllocator> iAO;
+};
+
+#endif
+
+
+/*! @} */
@@ -64,6 +64,16 @@ int OsclTimerCompare::compare(TOsclReady& a, TOsclReady& b)
     return OsclReadyCompare::compare(a, b);
 }
 
+#if PV_SCHED_TIMER_WHEEL
+//evalute "priority of a is less than priority of b"
+int OsclTimerWheelCompare::compare(OsclTimerWheelLink& a, OsclTimerWheelLink& b)
+{
+    TOsclReady pva = (TOsclReady)a.iOwner;
+    TOsclReady pvb = (TOsclReady)b.iOwner;
+    return OsclTimerCompare::compare(pva, pvb);
+}
+#endif
+
 //evalute "priority of a is less than priority of b"
 int OsclReadyCompare::compare(TOsclReady& a, TOsclReady& b)
 {
@@ -98,6 +108,13 @@ void OsclReadyQ::Construct(int nreserve)
     if (nreserve > 0)
         c.reserve(nreserve);
     iCallback = NULL;
+#if PV_SCHED_LOCKFREE_READYQ
+    iPendingHead = NULL;
+    iWaiting = 0;
+#endif
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+    iProfileSamples = 0;
+#endif
 }
 
 void OsclReadyQ::ThreadLogon()
@@ -112,11 +129,314 @@ void OsclReadyQ::ThreadLogoff()
     iCrit.Close();
 }
 
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+uint32 OsclReadyQ::ProfileBand(int32 aPriority)
+//map an AO priority to a profile band.
+{
+    if (aPriority >= OsclActiveObject::EPriorityHighest)
+        return EOsclSchedProfileBand_Highest;
+    if (aPriority >= OsclActiveObject::EPriorityHigh)
+        return EOsclSchedProfileBand_High;
+    if (aPriority >= OsclActiveObject::EPriorityNominal)
+        return EOsclSchedProfileBand_Nominal;
+    if (aPriority >= OsclActiveObject::EPriorityLow)
+        return EOsclSchedProfileBand_Low;
+    return EOsclSchedProfileBand_Idle;
+}
+
+void OsclReadyQ::ProfileAdd(TOsclReady a)
+{
+    OsclSchedulerBandProfile& band = iProfileBand[ProfileBand(a->iPVReadyQLink.iAOPriority)];
+    band.iDepth++;
+    if (band.iDepth > band.iMaxDepth)
+        band.iMaxDepth = band.iDepth;
+}
+
+void OsclReadyQ::ProfileRemove(TOsclReady a)
+{
+    iProfileBand[ProfileBand(a->iPVReadyQLink.iAOPriority)].iDepth--;
+}
+
+void OsclReadyQ::SampleProfile()
+//add the current depth of each band to the totals.  called for each Run.
+{
+    iProfileSamples++;
+    for (uint32 i = 0; i < EOsclSchedProfileBand_Last; i++)
+        iProfileBand[i].iTotalDepth += iProfileBand[i].iDepth;
+}
+
+void OsclReadyQ::GetProfile(OsclSchedulerProfile& aProfile)
+{
+    aProfile.iNumSamples = iProfileSamples;
+    for (uint32 i = 0; i < EOsclSchedProfileBand_Last; i++)
+        aProfile.iBand[i] = iProfileBand[i];
+}
+#endif //PV_SCHED_ENABLE_AO_PROFILE
+
 //
 //Note: all semaphore errors are fatal, since they can cause
 // scheduler to spin or hang.
 //
 
+#if PV_SCHED_LOCKFREE_READYQ
+
+//
+//Lock-free mode.  PendComplete may be called from any thread.  It claims
+//the AO by setting its queue pointer to the pending list, then pushes the AO
+//onto the pending list.  All other calls are made from the scheduler thread,
+//and merge the pending list into the pri queue before using it, so the
+//pri queue itself needs no lock.
+//
+
+void OsclReadyQ::MergePending()
+//move completed requests into the pri queue, in completion order.
+{
+    //detach the whole list.
+    PVActiveBase* head;
+    do
+    {
+        head = iPendingHead;
+    }
+    while (head
+            && !OsclAtomicCompareAndSwap(&iPendingHead, head, (PVActiveBase*)NULL));
+
+    if (!head)
+        return;
+
+    //the list is newest-first, so reverse it.
+    PVActiveBase* fifo = NULL;
+    while (head)
+    {
+        PVActiveBase* next = head->iPVReadyQLink.iPendingNext;
+        head->iPVReadyQLink.iPendingNext = fifo;
+        fifo = head;
+        head = next;
+    }
+
+    //assign the sequence numbers now, so FIFO order within a priority
+    //follows the completion order.
+    while (fifo)
+    {
+        PVActiveBase* next = fifo->iPVReadyQLink.iPendingNext;
+        fifo->iPVReadyQLink.iPendingNext = NULL;
+        fifo->iPVReadyQLink.iIsIn = this;
+        fifo->iPVReadyQLink.iSeqNum = ++iSeqNumCounter;//for the FIFO sort
+        push(fifo);
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+        ProfileAdd(fifo);
+#endif
+        fifo = next;
+    }
+}
+
+OsclProcStatus::eOsclProcError OsclReadyQ::WaitPending(bool aTimed, uint32 aTimeoutVal)
+//block until some request is completed, or timeout is reached.
+{
+    //announce the wait, then re-check the list in case a request was
+    //completed before the announcement was visible.
+    iWaiting = 1;
+    OsclAtomicMemoryBarrier();
+
+    if (iPendingHead)
+    {
+        //no need to wait.  if a completing thread already took the
+        //wakeup, it will signal the sem, so consume that signal here.
+        if (!OsclAtomicCompareAndSwap(&iWaiting, 1, 0))
+            return iSem.Wait();
+        return OsclProcStatus::SUCCESS_ERROR;
+    }
+
+    OsclProcStatus::eOsclProcError status = (aTimed) ? iSem.Wait(aTimeoutVal) : iSem.Wait();
+
+    if (status == OsclProcStatus::WAIT_TIMEOUT_ERROR)
+    {
+        //a request may have completed right as the timeout was reached.
+        //consume its signal so the sem count stays at zero.
+        if (!OsclAtomicCompareAndSwap(&iWaiting, 1, 0))
+            status = iSem.Wait();
+    }
+    return status;
+}
+
+void OsclReadyQ::ReadyCallback()
+//make scheduler observer callback.
+{
+    //lock when updating callback pointer.
+    iCrit.Lock();
+    if (iCallback)
+    {
+        iCallback->OsclSchedulerReadyCallback(iCallbackContext);
+        iCallback = NULL;
+    }
+    iCrit.Unlock();
+}
+
+PVActiveBase* OsclReadyQ::WaitAndPopTop()
+//block until an AO is ready and pop the highest pri AO.
+{
+    for (;;)
+    {
+        PVActiveBase* elem = PopTop();
+        if (elem)
+            return elem;
+
+        if (WaitPending(false, 0) != OsclProcStatus::SUCCESS_ERROR)
+        {
+            OsclError::Leave(OsclErrSystemCallFailed);
+            return NULL;
+        }
+    }
+}
+
+PVActiveBase* OsclReadyQ::WaitAndPopTop(uint32 aTimeoutVal)
+//block until an AO is ready or timeout is reached.
+{
+    PVActiveBase* elem = PopTop();
+    if (elem)
+        return elem;
+
+    switch (WaitPending(true, aTimeoutVal))
+    {
+        case OsclProcStatus::WAIT_TIMEOUT_ERROR:
+            //timeout reached, no AO ready.
+            return NULL;
+
+        case OsclProcStatus::SUCCESS_ERROR:
+            //an AO is ready-- pop it.
+            return PopTop();
+
+        default:
+            OsclError::Leave(OsclErrSystemCallFailed);
+            return NULL;
+    }
+}
+
+bool OsclReadyQ::IsIn(TOsclReady b)
+//tell if elemement is in this q
+{
+    MergePending();
+    return (b->iPVReadyQLink.iIsIn == this);
+}
+
+PVActiveBase* OsclReadyQ::PopTop()
+//deque and return highest pri element.
+{
+    MergePending();
+
+    PVActiveBase*elem = (size() > 0) ? top() : NULL;
+    if (elem)
+    {
+        elem->iPVReadyQLink.iIsIn = NULL;
+        pop();
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+        ProfileRemove(elem);
+#endif
+    }
+    return elem;
+}
+
+PVActiveBase* OsclReadyQ::Top()
+//return highest pri element without removing.
+{
+    MergePending();
+    return (size() > 0) ? top() : NULL;
+}
+
+void OsclReadyQ::Remove(TOsclReady a)
+//remove the given element
+{
+    MergePending();
+
+    a->iPVReadyQLink.iIsIn = NULL;
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+    if (remove(a) > 0)
+        ProfileRemove(a);
+#else
+    remove(a);
+#endif
+}
+
+int32 OsclReadyQ::PendComplete(PVActiveBase *pvbase, int32 aReason)
+//Complete an AO request
+{
+    //claim the AO.  this also makes sure it is not already queued.
+    if (!OsclAtomicCompareAndSwap(&pvbase->iPVReadyQLink.iIsIn, (OsclAny*)NULL, (OsclAny*)&iPendingHead))
+        return OsclErrInvalidState;//EExecAlreadyAdded
+
+    //make sure the AO has a request active
+    if (!pvbase->iBusy
+            || pvbase->iStatus != OSCL_REQUEST_PENDING)
+    {
+        pvbase->iPVReadyQLink.iIsIn = NULL;
+        return OsclErrCorrupt;//EExecStrayEvent;
+    }
+
+    //update the AO status before it becomes visible to the scheduler.
+    pvbase->iStatus = aReason;
+    pvbase->iPVReadyQLink.iTimeQueuedTicks = OsclTickCount::TickCount();
+
+    //Add to pending list
+    PVActiveBase* head;
+    do
+    {
+        head = iPendingHead;
+        pvbase->iPVReadyQLink.iPendingNext = head;
+    }
+    while (!OsclAtomicCompareAndSwap(&iPendingHead, head, pvbase));
+
+    //wake up the scheduler if it's waiting.
+    if (iWaiting
+            && OsclAtomicCompareAndSwap(&iWaiting, 1, 0))
+    {
+        if (iSem.Signal() != OsclProcStatus::SUCCESS_ERROR)
+            return OsclErrSystemCallFailed;
+    }
+
+    //make scheduler callback if needed.
+    if (iCallback)
+        ReadyCallback();
+
+    return OsclErrNone;
+}
+
+int32 OsclReadyQ::WaitForRequestComplete(PVActiveBase* pvbase)
+//Wait on a particular request to complete
+{
+    //Some other request may complete first, so check for
+    //completion after each wakeup.
+    while (!IsIn(pvbase))
+    {
+        if (WaitPending(false, 0) != OsclProcStatus::SUCCESS_ERROR)
+            return OsclErrSystemCallFailed;
+    }
+    return OsclErrNone;
+}
+
+void OsclReadyQ::RegisterForCallback(OsclSchedulerObserver* aCallback, OsclAny* aCallbackContext)
+{
+    //Use the Q lock to avoid thread contention over
+    //callback pointer.
+    iCrit.Lock();
+
+    //save the new pointers, then check the queue.  the barrier makes sure
+    //that a completing thread either sees the pointer or its completion
+    //is seen here.
+    iCallback = aCallback;
+    iCallbackContext = aCallbackContext;
+    OsclAtomicMemoryBarrier();
+
+    //Callback right away if ready Q is non-empty.
+    if ((size() || iPendingHead) && aCallback)
+    {
+        iCallback = NULL;
+        aCallback->OsclSchedulerReadyCallback(aCallbackContext);
+    }
+    iCrit.Unlock();
+}
+
+#else
+
+
 PVActiveBase* OsclReadyQ::WaitAndPopTop()
 //block until an AO is ready and pop the highest pri AO.
 {
@@ -171,6 +491,9 @@ PVActiveBase* OsclReadyQ::PopTop()
         elem->iPVReadyQLink.iIsIn = NULL;
 
         pop();
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+        ProfileRemove(elem);
+#endif
 
         //this call won't block-- it will just decrement the sem.
         if (iSem.Wait() != OsclProcStatus::SUCCESS_ERROR)
@@ -194,6 +517,9 @@ PVActiveBase* OsclReadyQ::PopTopAfterWait()
     {
         elem->iPVReadyQLink.iIsIn = NULL;
         pop();
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+        ProfileRemove(elem);
+#endif
     }
     else
     {//there should always be an element available after a sem wait.
@@ -225,6 +551,9 @@ void OsclReadyQ::Remove(TOsclReady a)
 
     if (nfound > 0)
     {
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+        ProfileRemove(a);
+#endif
         //this call won't block-- it will just decrement the sem.
         if (iSem.Wait() != OsclProcStatus::SUCCESS_ERROR)
             OsclError::Leave(OsclErrSystemCallFailed);
@@ -257,6 +586,9 @@ int32 OsclReadyQ::PendComplete(PVActiveBase *pvbase, int32 aReason)
         pvbase->iPVReadyQLink.iTimeQueuedTicks = OsclTickCount::TickCount();
         pvbase->iPVReadyQLink.iSeqNum = ++iSeqNumCounter;//for the FIFO sort
         push(pvbase);
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+        ProfileAdd(pvbase);
+#endif
 
         //increment the sem
         if (iSem.Signal() != OsclProcStatus::SUCCESS_ERROR)
@@ -337,6 +669,8 @@ void OsclReadyQ::RegisterForCallback(OsclSchedulerObserver* aCallback, OsclAny*
     iCrit.Unlock();
 }
 
+#endif //PV_SCHED_LOCKFREE_READYQ
+
 void OsclReadyQ::TimerCallback(uint32 aDelayMicrosec)
 //Inform scheduler observer of a change in the shortest timer interval
 {
@@ -355,6 +689,60 @@ void OsclReadyQ::TimerCallback(uint32 aDelayMicrosec)
 ////////////////////////////////////////
 //OsclTimerQ
 ////////////////////////////////////////
+#if PV_SCHED_TIMER_WHEEL
+void OsclTimerQ::Construct(int)
+{
+    iSeqNumCounter = 0;
+}
+
+bool OsclTimerQ::IsIn(TOsclReady b)
+//tell if element is in this q
+{
+    return (b->iPVReadyQLink.iIsIn == this);
+}
+
+PVActiveBase* OsclTimerQ::PopTop()
+//deque and return highest pri element.
+{
+    PVActiveBase*elem = Top();
+    if (elem)
+        Pop(elem);
+
+    return elem;
+}
+
+PVActiveBase* OsclTimerQ::Top()
+//return highest pri element without removing.
+{
+    OsclTimerWheelLink* link = OsclTimerWheelBase::Top();
+    return (link) ? (PVActiveBase*)link->iOwner : NULL;
+}
+
+void OsclTimerQ::Pop(TOsclReady b)
+//remove queue top.
+{
+    Remove(b);
+}
+
+void OsclTimerQ::Remove(TOsclReady a)
+{
+    a->iPVReadyQLink.iIsIn = NULL;
+    if (a->iPVReadyQLink.iTimerLink.IsQueued())
+        OsclTimerWheelBase::Remove(&a->iPVReadyQLink.iTimerLink);
+}
+
+void OsclTimerQ::Add(TOsclReady b)
+{
+    b->iPVReadyQLink.iIsIn = this;
+    b->iPVReadyQLink.iTimeQueuedTicks = OsclTickCount::TickCount();
+    b->iPVReadyQLink.iSeqNum = ++iSeqNumCounter;//for the FIFO sort
+
+    b->iPVReadyQLink.iTimerLink.iTime = b->iPVReadyQLink.iTimeToRunTicks;
+    b->iPVReadyQLink.iTimerLink.iOwner = b;
+    OsclTimerWheelBase::Add(&b->iPVReadyQLink.iTimerLink);
+}
+
+#else
 void OsclTimerQ::Construct(int nreserve)
 {
     iSeqNumCounter = 0;
@@ -405,11 +793,5 @@ void OsclTimerQ::Add(TOsclReady b)
 
     push(b);
 }
-
-
-
-
-
-
-
+#endif //PV_SCHED_TIMER_WHEEL
 
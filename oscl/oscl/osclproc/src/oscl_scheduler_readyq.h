@@ -41,6 +41,11 @@
 #ifndef OSCL_PRIQUEUE_H_INCLUDED
 #include "oscl_priqueue.h"
 #endif
+#if PV_SCHED_TIMER_WHEEL
+#ifndef OSCL_TIMER_WHEEL_H_INCLUDED
+#include "oscl_timer_wheel.h"
+#endif
+#endif
 #ifndef OSCL_BASE_ALLOC_H_INCLUDED
 #include "oscl_base_alloc.h"
 #endif
@@ -56,6 +61,9 @@
 #ifndef OSCL_STRING_CONTAINERS_H_INCLUDED
 #include "oscl_string_containers.h"
 #endif
+#ifndef OSCL_SCHEDULER_PROFILE_H_INCLUDED
+#include "oscl_scheduler_profile.h"
+#endif
 
 class PVActiveBase;
 
@@ -81,6 +89,13 @@ class OsclTimerCompare
     public:
         static int compare(TOsclReady& a, TOsclReady& b) ;
 };
+#if PV_SCHED_TIMER_WHEEL
+class OsclTimerWheelCompare
+{
+    public:
+        static int compare(OsclTimerWheelLink& a, OsclTimerWheelLink& b) ;
+};
+#endif
 
 /** This is a thread-safe priority queue for holding the
     active objects that are ready to run.
@@ -103,6 +118,9 @@ class OsclReadyQ
 
         uint32 Depth()
         {
+#if PV_SCHED_LOCKFREE_READYQ
+            MergePending();
+#endif
             return size();
         }
 
@@ -123,14 +141,50 @@ class OsclReadyQ
             return iCallback;
         }
 
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+        //For the scheduler profile.  These are only called from the
+        //scheduler thread.
+        static uint32 ProfileBand(int32 aPriority);
+        void SampleProfile();
+        void GetProfile(OsclSchedulerProfile&);
+#endif
+
     private:
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+        //update the depth of the AO's priority band.  called whenever
+        //an AO is pushed onto or removed from the pri queue.
+        void ProfileAdd(TOsclReady);
+        void ProfileRemove(TOsclReady);
+
+        uint32 iProfileSamples;
+        OsclSchedulerBandProfile iProfileBand[EOsclSchedProfileBand_Last];
+#endif
+
+#if !PV_SCHED_LOCKFREE_READYQ
         TOsclReady PopTopAfterWait();
+#endif
+
+#if PV_SCHED_LOCKFREE_READYQ
+        //move completed requests from the pending list into the pri queue.
+        void MergePending();
+        //block until a request is completed or timeout is reached.
+        OsclProcStatus::eOsclProcError WaitPending(bool aTimed, uint32 aTimeoutVal);
+        void ReadyCallback();
+
+        //list of requests completed since the last merge, newest first.
+        //producers push with compare-and-swap, scheduler detaches the whole list.
+        TOsclReady volatile iPendingHead;
+
+        //set while the scheduler is blocked on the semaphore.
+        volatile int32 iWaiting;
+#endif
 
         //mutex for thread protection
         OsclNoYieldMutex iCrit;
 
         //this semaphore tracks the queue size.  it is used to
         //regulate the scheduling loop when running in blocking mode.
+        //in lock-free mode, it is only a wakeup signal for the blocked scheduler.
         OsclSemaphore iSem;
 
         //a sequence number needed to maintain FIFO sorting order in oscl pri queue.
@@ -143,9 +197,14 @@ class OsclReadyQ
 
 /*
 ** A non-thread-safe queue for holding pending timers.
+** With PV_SCHED_TIMER_WHEEL, this is a timer wheel instead of a priority queue.
 */
 class OsclTimerQ
+#if PV_SCHED_TIMER_WHEEL
+        : public OsclTimerWheel<OsclTimerWheelCompare>
+#else
         : public OsclPriorityQueue<TOsclReady, OsclReadyAlloc, Oscl_Vector<TOsclReady, OsclReadyAlloc>, OsclTimerCompare>
+#endif
 {
     public:
         void Construct(int);
@@ -172,6 +231,9 @@ class TReadyQueLink
             iTimeToRunTicks = 0;
             iSeqNum = 0;
             iIsIn = NULL;
+#if PV_SCHED_LOCKFREE_READYQ
+            iPendingNext = NULL;
+#endif
         }
 
         int32 iAOPriority;//scheduling priority
@@ -179,6 +241,12 @@ class TReadyQueLink
         uint32 iTimeQueuedTicks;//the time when the AO was queued, in ticks.
         uint32 iSeqNum;//sequence number for oscl pri queue.
         OsclAny* iIsIn;//pointer to the queue we're in, cast as a void*
+#if PV_SCHED_LOCKFREE_READYQ
+        PVActiveBase* iPendingNext;//link for the ready queue pending list.
+#endif
+#if PV_SCHED_TIMER_WHEEL
+        OsclTimerWheelLink iTimerLink;//link for the timer wheel.
+#endif
 
 };
 
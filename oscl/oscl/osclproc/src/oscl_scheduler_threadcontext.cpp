@@ -27,6 +27,7 @@
 OSCL_EXPORT_REF PVThreadContext::PVThreadContext()
 {
     iOpen = false;
+    iHasThreadId = false;
     iScheduler = NULL;
 }
 
@@ -53,6 +54,13 @@ OSCL_EXPORT_REF bool PVThreadContext::IsSameThreadContext()
     if (result != OsclProcStatus::SUCCESS_ERROR)
         OsclError::Leave(OsclErrSystemCallFailed);
 
+#if(PV_SCHED_ENABLE_POOL)
+    //a pool scheduler moves between threads, so compare against
+    //the thread the scheduler is currently running in.
+    if (iScheduler)
+        return iScheduler->iThreadContext.iHasThreadId
+               && OsclThread::CompareId(id, iScheduler->iThreadContext.iThreadId);
+#endif
     return OsclThread::CompareId(id, iThreadId);
 }
 
@@ -62,6 +70,7 @@ OSCL_EXPORT_REF void PVThreadContext::EnterThreadContext()
     int32 result = OsclThread::GetId(iThreadId);
     if (result != OsclProcStatus::SUCCESS_ERROR)
         OsclError::Leave(OsclErrSystemCallFailed);
+    iHasThreadId = true;
 
 
     //Set current thread scheduler.
@@ -79,6 +88,7 @@ OSCL_EXPORT_REF void PVThreadContext::EnterThreadContext()
 OSCL_EXPORT_REF void PVThreadContext::ExitThreadContext()
 {
     iScheduler = NULL;
+    iHasThreadId = false;
     iOpen = false;
 }
 
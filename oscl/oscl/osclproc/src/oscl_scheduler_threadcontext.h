@@ -114,6 +114,12 @@ class PVThreadContext
         */
         TOsclThreadId iThreadId;
 
+        /**
+        //false while iThreadId is not valid, e.g. while a pool
+        //scheduler is between two threads.
+        */
+        bool iHasThreadId;
+
         friend class PVActiveBase;
         friend class OsclActiveObject;
         friend class OsclTimerObject;
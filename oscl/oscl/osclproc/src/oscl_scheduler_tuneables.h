@@ -46,6 +46,20 @@
 #endif
 #endif
 
+//Set PV_SCHED_ENABLE_AO_PROFILE to 1 to add a Run time histogram and the
+//time from request completion to Run to the AO stats, and to track the
+//ready queue depth for each priority band.  The data can be read at any time
+//with OsclExecScheduler::GetProfile.  It adds no tick count calls to the
+//AO stats, only counter updates, so it can be left on in release builds.
+//Requires PV_SCHED_ENABLE_AO_STATS, which is forced to 1.
+#ifndef PV_SCHED_ENABLE_AO_PROFILE
+#define PV_SCHED_ENABLE_AO_PROFILE PV_SCHED_ENABLE_AO_STATS
+#endif
+#if (PV_SCHED_ENABLE_AO_PROFILE)
+#undef PV_SCHED_ENABLE_AO_STATS
+#define PV_SCHED_ENABLE_AO_STATS 1
+#endif
+
 //Enable this to track time spent in scheduling loop in addition to Run times.
 //This data gathering is fairly expensive so should only be used
 //for debug and profiling.
@@ -109,6 +123,46 @@
 //swap in the symbian native behavior.
 #define PV_SCHED_FAIR_SCHEDULING 1
 
+//Set PV_SCHED_LOCKFREE_READYQ to 1 to complete requests without taking the
+//ready queue lock.  Completions are pushed onto a lock-free list and merged
+//into the priority queue by the scheduler thread, so the ready queue must
+//only be read or updated from the scheduler thread, apart from PendComplete.
+//The request semaphore is only signaled when the scheduler is waiting.
+//Requires atomic operation support, and is forced to 0 otherwise.
+#ifndef PV_SCHED_LOCKFREE_READYQ
+#define PV_SCHED_LOCKFREE_READYQ 0
+#endif
+#if !(OSCL_HAS_ATOMIC_SUPPORT)
+#undef PV_SCHED_LOCKFREE_READYQ
+#define PV_SCHED_LOCKFREE_READYQ 0
+#endif
+
+//Set PV_SCHED_TIMER_WHEEL to 1 to hold pending timers in a hierarchical
+//timer wheel instead of a priority queue.  This makes adding and canceling
+//a timer O(1), which helps when there are many active timers.
+#ifndef PV_SCHED_TIMER_WHEEL
+#define PV_SCHED_TIMER_WHEEL 0
+#endif
+
+//Set PV_SCHED_ENABLE_POOL to 1 to build OsclExecSchedulerPool, which runs
+//groups of AOs on a shared pool of threads.  Each group has its own
+//scheduler, which only ever runs on one pool thread at a time.
+//Requires thread support, and is forced to 0 otherwise.
+//Off by default until it has been through a multi-group stress run.
+#ifndef PV_SCHED_ENABLE_POOL
+#define PV_SCHED_ENABLE_POOL 0
+#endif
+#if !(OSCL_HAS_THREAD_SUPPORT)
+#undef PV_SCHED_ENABLE_POOL
+#define PV_SCHED_ENABLE_POOL 0
+#endif
+
+//PV_SCHED_POOL_SLICE sets the maximum number of Run calls a pool thread
+//makes for one group before it goes on to the next ready group.
+#ifndef PV_SCHED_POOL_SLICE
+#define PV_SCHED_POOL_SLICE 16
+#endif
+
 //OSCL_PERF_SUMMARY_LOGGING is a master switch to configure scheduler
 //for full performance data gathering with minimal summary logging at
 //the end.  The data gathering is fairly expensive so should only be
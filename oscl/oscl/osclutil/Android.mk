@@ -14,7 +14,8 @@ LOCAL_SRC_FILES := \
         src/oscl_rand.cpp \
         src/oscl_string_uri.cpp \
         src/oscl_string_xml.cpp \
-        src/oscl_priqueue.cpp
+        src/oscl_priqueue.cpp \
+        src/oscl_timer_wheel.cpp
 
 
 LOCAL_MODULE := libosclutil
@@ -54,6 +55,7 @@ LOCAL_COPY_HEADERS := \
         src/oscl_math.h \
         src/oscl_math.inl \
         src/oscl_string_uri.h \
-        src/oscl_string_xml.h
+        src/oscl_string_xml.h \
+        src/oscl_timer_wheel.h
 
 include $(BUILD_STATIC_LIBRARY)
@@ -25,7 +25,8 @@ SRCS :=  oscl_bin_stream.cpp \
 	oscl_rand.cpp \
 	oscl_string_uri.cpp \
 	oscl_string_xml.cpp \
-	oscl_priqueue.cpp
+	oscl_priqueue.cpp \
+	oscl_timer_wheel.cpp
 
 
 HDRS :=  oscl_bin_stream.h \
@@ -47,7 +48,8 @@ HDRS :=  oscl_bin_stream.h \
 	oscl_math.h \
 	oscl_math.inl \
 	oscl_string_uri.h \
-	oscl_string_xml.h
+	oscl_string_xml.h \
+	oscl_timer_wheel.h
 
 include $(MK)/library.mk
 
@@ -0,0 +1,213 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+
+/*!
+ * \file oscl_timer_wheel.cpp
+ * \brief Implements a hierarchical timer wheel.
+ *
+ *
+ */
+
+#include "oscl_timer_wheel.h"
+
+/*
+* Each timer is placed relative to the wheel position iBase.  A timer goes
+* on the level of the highest digit in which its time differs from iBase,
+* in the slot given by its own digit at that level.  So every timer on a
+* level expires before all timers on the levels above, and slots on a level
+* are in time order, starting from the iBase digit.  To find the earliest
+* timer, the wheel moves iBase up to the first non-empty slot on the lowest
+* non-empty level and re-inserts the timers of that slot, which moves them
+* down one or more levels, until the earliest timers are on level 0.  All
+* timers in a level 0 slot have the same time, except for timers that were
+* already due when added, which go in the iBase slot.
+*/
+
+OSCL_EXPORT_REF OsclTimerWheelBase::OsclTimerWheelBase()
+{
+    for (uint32 i = 0; i < OSCL_TIMER_WHEEL_LEVELS * OSCL_TIMER_WHEEL_SLOTS; i++)
+        iSlots[i] = NULL;
+    for (uint32 level = 0; level < OSCL_TIMER_WHEEL_LEVELS; level++)
+    {
+        for (uint32 j = 0; j < OSCL_TIMER_WHEEL_SLOTS / 32; j++)
+            iBitmap[level][j] = 0;
+    }
+    iBase = 0;
+    iCount = 0;
+    iTop = NULL;
+}
+
+OSCL_EXPORT_REF void OsclTimerWheelBase::Add(OsclTimerWheelLink* aLink)
+{
+    OSCL_ASSERT(aLink);
+    OSCL_ASSERT(!aLink->IsQueued());
+
+    //re-sync the wheel position whenever the wheel is empty, so it
+    //can't fall too far behind the timers.
+    if (iCount == 0)
+        iBase = aLink->iTime;
+
+    Insert(aLink);
+    iCount++;
+
+    //update the cached top.
+    if (iTop
+            && compare_LT(iTop, aLink))
+    {
+        iTop = aLink;
+    }
+}
+
+OSCL_EXPORT_REF void OsclTimerWheelBase::Remove(OsclTimerWheelLink* aLink)
+{
+    OSCL_ASSERT(aLink);
+    OSCL_ASSERT(aLink->IsQueued());
+
+    int32 slot = aLink->iSlot;
+    if (aLink->iPrev)
+        aLink->iPrev->iNext = aLink->iNext;
+    else
+        iSlots[slot] = aLink->iNext;
+    if (aLink->iNext)
+        aLink->iNext->iPrev = aLink->iPrev;
+
+    if (!iSlots[slot])
+    {
+        uint32 index = slot & (OSCL_TIMER_WHEEL_SLOTS - 1);
+        iBitmap[slot / OSCL_TIMER_WHEEL_SLOTS][index >> 5] &= ~(1 << (index & 31));
+    }
+
+    aLink->iNext = NULL;
+    aLink->iPrev = NULL;
+    aLink->iSlot = -1;
+    iCount--;
+
+    if (aLink == iTop)
+        iTop = NULL;
+}
+
+OSCL_EXPORT_REF OsclTimerWheelLink* OsclTimerWheelBase::Top()
+{
+    if (iTop)
+        return iTop;
+
+    if (iCount == 0)
+        return NULL;
+
+    //cascade until the earliest timers are on level 0.
+    int32 slot = FirstSlot(0);
+    while (slot < 0)
+    {
+        for (int32 level = 1; level < OSCL_TIMER_WHEEL_LEVELS; level++)
+        {
+            slot = FirstSlot(level);
+            if (slot >= 0)
+            {
+                Cascade(level, slot);
+                break;
+            }
+        }
+        OSCL_ASSERT(slot >= 0);
+        slot = FirstSlot(0);
+    }
+
+    //move the wheel position up to this slot.
+    iBase = (iBase & ~(OSCL_TIMER_WHEEL_SLOTS - 1)) | slot;
+
+    //find the earliest timer in the slot.
+    OsclTimerWheelLink* top = iSlots[slot];
+    for (OsclTimerWheelLink* link = top->iNext; link; link = link->iNext)
+    {
+        if (compare_LT(top, link))
+            top = link;
+    }
+    iTop = top;
+    return iTop;
+}
+
+void OsclTimerWheelBase::Insert(OsclTimerWheelLink* aLink)
+{
+    //a timer that is already due goes in the current slot.
+    uint32 time = aLink->iTime;
+    if ((uint32)(time - iBase) > 0x7fffffff)
+        time = iBase;
+
+    //find the highest digit that differs from the wheel position.
+    uint32 diff = time ^ iBase;
+    int32 level = OSCL_TIMER_WHEEL_LEVELS - 1;
+    while (level > 0 && Digit(diff, level) == 0)
+        level--;
+
+    uint32 index = Digit(time, level);
+    int32 slot = level * OSCL_TIMER_WHEEL_SLOTS + index;
+
+    aLink->iSlot = slot;
+    aLink->iPrev = NULL;
+    aLink->iNext = iSlots[slot];
+    if (aLink->iNext)
+        aLink->iNext->iPrev = aLink;
+    iSlots[slot] = aLink;
+
+    iBitmap[level][index >> 5] |= (1 << (index & 31));
+}
+
+void OsclTimerWheelBase::Cascade(int32 aLevel, int32 aSlot)
+//move the wheel position up to the start of the given slot, then re-insert
+//its timers on the lower levels.
+{
+    uint32 shift = aLevel * OSCL_TIMER_WHEEL_SLOT_BITS;
+    uint32 highmask = (shift + OSCL_TIMER_WHEEL_SLOT_BITS >= 32) ? 0 : ~((1 << (shift + OSCL_TIMER_WHEEL_SLOT_BITS)) - 1);
+    iBase = (iBase & highmask) | (aSlot << shift);
+
+    int32 slot = aLevel * OSCL_TIMER_WHEEL_SLOTS + aSlot;
+    OsclTimerWheelLink* link = iSlots[slot];
+    iSlots[slot] = NULL;
+    iBitmap[aLevel][aSlot >> 5] &= ~(1 << (aSlot & 31));
+
+    while (link)
+    {
+        OsclTimerWheelLink* next = link->iNext;
+        Insert(link);
+        link = next;
+    }
+}
+
+int32 OsclTimerWheelBase::FirstSlot(int32 aLevel)
+//return the first non-empty slot on a level, starting from the
+//wheel position and wrapping around, or -1 if the level is empty.
+{
+    uint32 start = Digit(iBase, aLevel);
+    for (uint32 n = 0; n < OSCL_TIMER_WHEEL_SLOTS;)
+    {
+        uint32 index = (start + n) & (OSCL_TIMER_WHEEL_SLOTS - 1);
+        uint32 bits = iBitmap[aLevel][index >> 5] >> (index & 31);
+        if (bits)
+        {
+            while (!(bits & 1))
+            {
+                bits >>= 1;
+                index++;
+            }
+            return index;
+        }
+        //skip to the next bitmap word.
+        n += 32 - (index & 31);
+    }
+    return -1;
+}
+
@@ -0,0 +1,228 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+// -*- c++ -*-
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+//       O S C L _ T I M E R _ W H E E L   ( T I M E R   W H E E L )
+
+// = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+/*! \addtogroup osclutil OSCL Util
+ *
+ * @{
+ */
+
+
+#ifndef OSCL_TIMER_WHEEL_H_INCLUDED
+#define OSCL_TIMER_WHEEL_H_INCLUDED
+
+
+
+/*!
+ * \file oscl_timer_wheel.h
+ * \brief Implements a hierarchical timer wheel.
+ *
+ * The timer wheel keeps pending timers sorted by expiry time, with
+ * O(1) insertion and removal, and amortized O(1) access to the earliest
+ * timer.  Timers are linked into the wheel with an intrusive link, so
+ * the wheel itself never allocates memory.
+ *
+ * Expiry times are 32-bit values in any unit, and may roll over.
+ * Times more than half the 32-bit range in the past of the wheel's
+ * current position are treated as in the future.
+ *
+ */
+
+#ifndef OSCL_BASE_H_INCLUDED
+#include "oscl_base.h"
+#endif
+
+#ifndef OSCL_ASSERT_H_INCLUDED
+#include "oscl_assert.h"
+#endif
+
+
+/**
+ * Number of bits of the expiry time handled by each wheel level.
+ */
+#define OSCL_TIMER_WHEEL_SLOT_BITS 6
+/**
+ * Number of slots per wheel level.
+ */
+#define OSCL_TIMER_WHEEL_SLOTS (1 << OSCL_TIMER_WHEEL_SLOT_BITS)
+/**
+ * Number of wheel levels.  This is enough levels to cover 32-bit times.
+ */
+#define OSCL_TIMER_WHEEL_LEVELS ((32 + OSCL_TIMER_WHEEL_SLOT_BITS - 1) / OSCL_TIMER_WHEEL_SLOT_BITS)
+
+/**
+ * OsclTimerWheelLink is the link that a timer uses to sit in the wheel.
+ * The owner sets iTime and iOwner before adding the link to the wheel.
+ */
+class OsclTimerWheelLink
+{
+    public:
+        OsclTimerWheelLink()
+        {
+            iNext = NULL;
+            iPrev = NULL;
+            iTime = 0;
+            iSlot = -1;
+            iOwner = NULL;
+        }
+
+        //Tell if this link is in a wheel.
+        bool IsQueued() const
+        {
+            return (iSlot >= 0);
+        }
+
+        OsclTimerWheelLink* iNext;
+        OsclTimerWheelLink* iPrev;
+        uint32 iTime;//expiry time.
+        int32 iSlot;//index of the slot we're in, or -1.
+        OsclAny* iOwner;//the object that owns this link.
+};
+
+/**
+ * Default comparison for OsclTimerWheel.
+ * Evaluates "a expires later than b", taking rollover into account.
+ */
+class OsclTimerWheelCompareTime
+{
+    public:
+        int compare(OsclTimerWheelLink& a, OsclTimerWheelLink& b) const
+        {
+            return ((uint32)(b.iTime - a.iTime) > 0x7fffffff);
+        }
+};
+
+/**
+ * OsclTimerWheelBase is a non-templatized base class for OsclTimerWheel.
+ * This class is not intended for direct instantiation except by
+ * OsclTimerWheel.
+ */
+class OsclTimerWheelBase
+{
+    public:
+        /**
+         * Add a timer.  The link must not be in any wheel.
+         */
+        OSCL_IMPORT_REF void Add(OsclTimerWheelLink* aLink);
+
+        /**
+         * Remove a timer.  The link must be in this wheel.
+         */
+        OSCL_IMPORT_REF void Remove(OsclTimerWheelLink* aLink);
+
+        /**
+         * Return the earliest timer without removing it,
+         * or NULL if the wheel is empty.
+         */
+        OSCL_IMPORT_REF OsclTimerWheelLink* Top();
+
+        /**
+         * Remove and return the earliest timer,
+         * or NULL if the wheel is empty.
+         */
+        OsclTimerWheelLink* PopTop()
+        {
+            OsclTimerWheelLink* top = Top();
+            if (top)
+                Remove(top);
+            return top;
+        }
+
+        uint32 Size() const
+        {
+            return iCount;
+        }
+
+        bool Empty() const
+        {
+            return (iCount == 0);
+        }
+
+    protected:
+        OSCL_IMPORT_REF OsclTimerWheelBase();
+
+        virtual ~OsclTimerWheelBase()
+        {}
+
+        /**
+         * Return "a has lower priority than b".
+         */
+        virtual int compare_LT(OsclTimerWheelLink* a, OsclTimerWheelLink* b) const = 0;
+
+    private:
+        void Insert(OsclTimerWheelLink* aLink);
+        void Cascade(int32 aLevel, int32 aSlot);
+        int32 FirstSlot(int32 aLevel);
+
+        uint32 Digit(uint32 aTime, int32 aLevel) const
+        {
+            return (aTime >> (aLevel * OSCL_TIMER_WHEEL_SLOT_BITS)) & (OSCL_TIMER_WHEEL_SLOTS - 1);
+        }
+
+        //slot lists, one set for each level.
+        OsclTimerWheelLink* iSlots[OSCL_TIMER_WHEEL_LEVELS * OSCL_TIMER_WHEEL_SLOTS];
+
+        //one bit for each non-empty slot.
+        uint32 iBitmap[OSCL_TIMER_WHEEL_LEVELS][OSCL_TIMER_WHEEL_SLOTS / 32];
+
+        //the wheel position.  all timers expire at or after this time,
+        //except for timers that were already due when added.
+        uint32 iBase;
+
+        uint32 iCount;
+
+        //cached earliest timer, or NULL if not known.
+        OsclTimerWheelLink* iTop;
+};
+
+/**
+ * OsclTimerWheel is a hierarchical timer wheel.
+ * Compare::compare(a,b) must return "a has lower priority than b".  It is
+ * only used to order timers within one wheel slot, so it must agree with
+ * the expiry time order, and may add a tie-break for equal times.
+ */
+template < class Compare = OsclTimerWheelCompareTime >
+class OsclTimerWheel : public OsclTimerWheelBase
+{
+    public:
+        OsclTimerWheel(): OsclTimerWheelBase()
+        {}
+
+        virtual ~OsclTimerWheel()
+        {}
+
+    protected:
+        Compare comp;
+
+        //from OsclTimerWheelBase
+        int compare_LT(OsclTimerWheelLink* a, OsclTimerWheelLink* b) const
+        {
+            OSCL_ASSERT(a);
+            OSCL_ASSERT(b);
+            return comp.compare(*a, *b);
+        }
+};
+
+#endif
+
+/*! @} */
@@ -17,7 +17,8 @@ SRCS :=
 HDRS := pvlogger_stderr_appender.h \
 	pvlogger_file_appender.h \
 	pvlogger_mem_appender.h \
-	pvlogger_time_and_id_layout.h
+	pvlogger_time_and_id_layout.h \
+	pvlogger_async_appender.h
 
 
 include $(MK)/library.mk
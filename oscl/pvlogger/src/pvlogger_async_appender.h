@@ -0,0 +1,1018 @@
+/* ------------------------------------------------------------------
+ * Copyright (C) 1998-2009 PacketVideo
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+ * express or implied.
+ * See the License for the specific language governing permissions
+ * and limitations under the License.
+ * -------------------------------------------------------------------
+ */
+#ifndef PVLOGGER_ASYNC_APPENDER_H_INCLUDED
+#define PVLOGGER_ASYNC_APPENDER_H_INCLUDED
+
+#ifndef OSCL_MEM_AUTO_PTR_H_INCLUDED
+#include "oscl_mem_auto_ptr.h"
+#endif
+#ifndef OSCL_FILE_IO_H_INCLUDED
+#include "oscl_file_io.h"
+#endif
+#ifndef OSCL_MAP_H_INCLUDED
+#include "oscl_map.h"
+#endif
+#ifndef OSCL_SNPRINTF_H_INCLUDED
+#include "oscl_snprintf.h"
+#endif
+#ifndef OSCL_STRING_UTILS_H_INCLUDED
+#include "oscl_string_utils.h"
+#endif
+#ifndef OSCL_THREAD_H_INCLUDED
+#include "oscl_thread.h"
+#endif
+#ifndef OSCL_SEMAPHORE_H_INCLUDED
+#include "oscl_semaphore.h"
+#endif
+#ifndef OSCL_TICKCOUNT_H_INCLUDED
+#include "oscl_tickcount.h"
+#endif
+#ifndef PVLOGGERACCESSORIES_H_INCLUDED
+#include "pvlogger_accessories.h"
+#endif
+
+/**
+ * AsyncFileAppender
+ *
+ * The logging thread only copies the format string pointer and the arguments
+ * into a ring buffer of its own; a background thread formats them and writes
+ * the file. Nothing is formatted, locked or written on the logging thread, so
+ * datapath logging can stay on without changing the timing of the media threads.
+ * When a ring is full the message is dropped and counted, the logging thread
+ * never waits. A thread keeps its ring until it has not logged for
+ * PVLOGGER_ASYNC_IDLE_MSEC, then the ring is given to the next new thread.
+ *
+ * The format string must stay valid after the call, which is the case for the
+ * string literals used with the PVLOGGER_LOGMSG macros. %s arguments are copied.
+ * The arguments are read the way oscl_vsnprintf reads them, so the text output
+ * matches TextFileAppender with TimeAndIdLayout, except that the time and thread
+ * id are the ones of the logging call.
+ *
+ * In binary mode the file holds the records undecoded, see
+ * PVLOGGER_ASYNC_BINARY_MAGIC for the layout.
+ *
+ * Needs thread and atomic support (OSCL_HAS_THREAD_SUPPORT, OSCL_HAS_ATOMIC_SUPPORT).
+ */
+
+//ring buffer size per logging thread, in bytes, a power of 2
+#ifndef PVLOGGER_ASYNC_RING_SIZE
+#define PVLOGGER_ASYNC_RING_SIZE 0x10000
+#endif
+
+//number of rings, messages of a thread that finds them all in use are dropped
+#ifndef PVLOGGER_ASYNC_MAX_THREADS
+#define PVLOGGER_ASYNC_MAX_THREADS 16
+#endif
+
+//a ring that has been empty and unused this long is freed for another thread
+#ifndef PVLOGGER_ASYNC_IDLE_MSEC
+#define PVLOGGER_ASYNC_IDLE_MSEC 1000
+#endif
+
+//largest record, longer %s arguments and buffers are cut
+#ifndef PVLOGGER_ASYNC_MAX_RECORD
+#define PVLOGGER_ASYNC_MAX_RECORD 512
+#endif
+
+//the writer thread wakes up this often, or when a ring is half full
+#ifndef PVLOGGER_ASYNC_POLL_MSEC
+#define PVLOGGER_ASYNC_POLL_MSEC 20
+#endif
+
+#ifndef PVLOGGER_ASYNC_OUTPUT_BUFFER_SIZE
+#define PVLOGGER_ASYNC_OUTPUT_BUFFER_SIZE 0x4000
+#endif
+
+/**
+ * Binary file layout, all values in the byte order of the logging device:
+ *
+ *  file header (12 bytes):
+ *      uint32  PVLOGGER_ASYNC_BINARY_MAGIC
+ *      uint32  0x01020304, to find the byte order
+ *      uint8   PVLOGGER_ASYNC_BINARY_VERSION
+ *      uint8   sizeof(long)
+ *      uint8   sizeof(void*)
+ *      uint8   0
+ *
+ *  records, a 20 byte header followed by len bytes:
+ *      uint8   type (PVLOGGER_ASYNC_REC_xxx)
+ *      uint8   flags, 1 if the arguments were cut
+ *      uint16  len
+ *      uint32  id (format id, or number of dropped messages)
+ *      int32   msgID
+ *      uint32  time in msec since the appender was created
+ *      uint32  thread id
+ *
+ *  PVLOGGER_ASYNC_REC_FORMAT:  the format string of id, sent before its first message
+ *  PVLOGGER_ASYNC_REC_MESSAGE: the arguments of the format string id, each one a
+ *      PVLOGGER_ASYNC_ARG_xxx byte followed by an int, a long, a pointer or a
+ *      uint16 length and the characters of a string
+ *  PVLOGGER_ASYNC_REC_BUFFER:  the bytes of a buffer logged with PVLOGGER_LOGBIN
+ *  PVLOGGER_ASYNC_REC_DROPPED: id messages were dropped since the last one
+ */
+#define PVLOGGER_ASYNC_BINARY_MAGIC 0x414c5650 // "PVLA"
+#define PVLOGGER_ASYNC_BINARY_VERSION 1
+
+#define PVLOGGER_ASYNC_REC_PAD      0
+#define PVLOGGER_ASYNC_REC_FORMAT   1
+#define PVLOGGER_ASYNC_REC_MESSAGE  2
+#define PVLOGGER_ASYNC_REC_BUFFER   3
+#define PVLOGGER_ASYNC_REC_DROPPED  4
+
+#define PVLOGGER_ASYNC_ARG_INT      1
+#define PVLOGGER_ASYNC_ARG_LONG     2
+#define PVLOGGER_ASYNC_ARG_PTR      3
+#define PVLOGGER_ASYNC_ARG_STRING   4
+
+#if (OSCL_HAS_THREAD_SUPPORT && OSCL_HAS_ATOMIC_SUPPORT)
+
+class AsyncFileAppender : public PVLoggerAppender
+{
+    public:
+        typedef PVLoggerAppender::message_id_type message_id_type;
+
+        static AsyncFileAppender* CreateAppender(const OSCL_TCHAR * filename, bool binary = false)
+        {
+            AsyncFileAppender * appender = OSCL_NEW(AsyncFileAppender, ());
+            if (NULL == appender) return NULL;
+
+            OSCLMemAutoPtr<AsyncFileAppender> holdAppender(appender);
+
+            if (0 != appender->_fs.Connect()) return NULL;
+
+            //set log file object options
+            //this has its own cache so there's no reason to use pv cache.
+            appender->_logFile.SetPVCacheSize(0);
+            //make sure there's no logging on this file or we get infinite loop!
+            appender->_logFile.SetLoggingEnable(false);
+            appender->_logFile.SetSummaryStatsLoggingEnable(false);
+            //end of log file object options.
+
+            uint32 mode = Oscl_File::MODE_READWRITE | (binary ? Oscl_File::MODE_BINARY : Oscl_File::MODE_TEXT);
+            if (0 != appender->_logFile.Open(filename, mode, appender->_fs))
+            {
+                return NULL;
+            }
+
+            appender->_binary = binary;
+            appender->_out = (uint8*)OSCL_MALLOC(PVLOGGER_ASYNC_OUTPUT_BUFFER_SIZE);
+            if (NULL == appender->_out) return NULL;
+
+            if (binary)
+            {
+                uint8 header[12];
+                uint32 magic = PVLOGGER_ASYNC_BINARY_MAGIC;
+                uint32 byteOrder = 0x01020304;
+                oscl_memcpy(header, &magic, 4);
+                oscl_memcpy(header + 4, &byteOrder, 4);
+                header[8] = PVLOGGER_ASYNC_BINARY_VERSION;
+                header[9] = sizeof(long);
+                header[10] = sizeof(OsclAny*);
+                header[11] = 0;
+                appender->Output(header, sizeof(header));
+            }
+
+            appender->_wakeSem.Create();
+            appender->_exitSem.Create();
+            appender->_semCreated = true;
+
+            OsclThread thread;
+            if (thread.Create((TOsclThreadFuncPtr)ThreadMain, 0, (TOsclThreadFuncArg)appender) != OsclProcStatus::SUCCESS_ERROR)
+            {
+                return NULL;
+            }
+            appender->_threadRunning = true;
+
+            return holdAppender.release();
+        }
+
+        virtual ~AsyncFileAppender()
+        {
+            //the loggers must not use the appender any more, write what is left
+            if (_threadRunning)
+            {
+                _stop = 1;
+                _wakeSem.Signal();
+                _exitSem.Wait();
+            }
+            if (_semCreated)
+            {
+                _wakeSem.Close();
+                _exitSem.Close();
+            }
+
+            for (int32 i = 0; i < PVLOGGER_ASYNC_MAX_THREADS; i++)
+            {
+                if (_rings[i].buf)
+                {
+                    OSCL_FREE(_rings[i].buf);
+                }
+            }
+            if (_out)
+            {
+                OSCL_FREE(_out);
+            }
+            _logFile.Close();
+            _fs.Close();
+        }
+
+        void AppendString(message_id_type msgID, const char *fmt, va_list va)
+        {
+            Ring* ring = GetRing();
+            if (NULL == ring) return;
+
+            uint8 record[PVLOGGER_ASYNC_MAX_RECORD];
+            RecordHeader hdr;
+            hdr.type = PVLOGGER_ASYNC_REC_MESSAGE;
+            hdr.flags = 0;
+            hdr.msgID = msgID;
+            hdr.ticks = OsclTickCount::TickCount();
+            hdr.fmt = fmt;
+
+            //other appenders of the logger read the same arguments
+            va_list args;
+            va_copy(args, va);
+
+            //read the arguments the way oscl_vsnprintf does
+            uint32 pos = sizeof(RecordHeader);
+            const char* p = fmt;
+            while (*p && !hdr.flags)
+            {
+                if (*p++ != '%') continue;
+
+                while (*p == '0' || *p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '\'') p++;
+
+                if (*p == '*')
+                {
+                    p++;
+                    PutInt(record, pos, hdr.flags, va_arg(args, int));
+                }
+                else
+                {
+                    while (*p >= '0' && *p <= '9') p++;
+                }
+
+                if (*p == '.')
+                {
+                    p++;
+                    if (*p == '*')
+                    {
+                        p++;
+                        PutInt(record, pos, hdr.flags, va_arg(args, int));
+                    }
+                    else
+                    {
+                        while (*p >= '0' && *p <= '9') p++;
+                    }
+                }
+
+                bool isLong = false;
+                if (*p == 'h')
+                {
+                    p++;
+                }
+                else if (*p == 'l')
+                {
+                    //oscl_vsnprintf reads %ll as %l
+                    isLong = true;
+                    p++;
+                    if (*p == 'l') p++;
+                }
+
+                switch (*p)
+                {
+                    case 'c':
+                        PutInt(record, pos, hdr.flags, va_arg(args, int));
+                        break;
+                    case 'd':
+                    case 'i':
+                    case 'u':
+                    case 'o':
+                    case 'x':
+                    case 'X':
+                        if (isLong)
+                            PutLong(record, pos, hdr.flags, va_arg(args, long));
+                        else
+                            PutInt(record, pos, hdr.flags, va_arg(args, int));
+                        break;
+                    case 'D':
+                    case 'U':
+                    case 'O':
+                        PutLong(record, pos, hdr.flags, va_arg(args, long));
+                        break;
+                    case 'p':
+                        PutPtr(record, pos, hdr.flags, va_arg(args, OsclAny*));
+                        break;
+                    case 's':
+                        PutString(record, pos, hdr.flags, va_arg(args, const char*));
+                        break;
+                    case '\0':
+                        continue;
+                    default:
+                        //%% and unknown conversions take no argument
+                        break;
+                }
+                p++;
+            }
+
+            va_end(args);
+
+            hdr.size = pos;
+            oscl_memcpy(record, &hdr, sizeof(RecordHeader));
+            Push(ring, record, pos);
+            ReleaseRing(ring);
+        }
+
+        void AppendBuffers(message_id_type msgID, int32 numPairs, va_list va)
+        {
+            Ring* ring = GetRing();
+            if (NULL == ring) return;
+
+            uint8 record[PVLOGGER_ASYNC_MAX_RECORD];
+            RecordHeader hdr;
+            hdr.type = PVLOGGER_ASYNC_REC_BUFFER;
+            hdr.msgID = msgID;
+            hdr.ticks = OsclTickCount::TickCount();
+            hdr.fmt = NULL;
+
+            va_list args;
+            va_copy(args, va);
+
+            for (int32 i = 0; i < numPairs; i++)
+            {
+                int32 length = va_arg(args, int32);
+                uint8* buffer = va_arg(args, uint8*);
+
+                hdr.flags = 0;
+                if (length > (int32)(PVLOGGER_ASYNC_MAX_RECORD - sizeof(RecordHeader)))
+                {
+                    length = PVLOGGER_ASYNC_MAX_RECORD - sizeof(RecordHeader);
+                    hdr.flags = 1;
+                }
+                hdr.size = sizeof(RecordHeader) + length;
+                oscl_memcpy(record, &hdr, sizeof(RecordHeader));
+                oscl_memcpy(record + sizeof(RecordHeader), buffer, length);
+                Push(ring, record, hdr.size);
+            }
+            va_end(args);
+            ReleaseRing(ring);
+        }
+
+        //number of messages dropped because a ring was full
+        uint32 GetDroppedCount()
+        {
+            return _dropped;
+        }
+
+    private:
+        typedef struct
+        {
+            uint16 size;        //rounded up to 8 bytes in the ring
+            uint8 type;
+            uint8 flags;
+            int32 msgID;
+            uint32 ticks;
+            const char* fmt;
+        } RecordHeader;
+
+        //ring states, a ring is only written while it is busy
+        enum
+        {
+            RING_FREE,
+            RING_IDLE,
+            RING_BUSY
+        };
+
+        typedef struct
+        {
+            //written by the logging thread only
+            volatile uint32 tail;
+            //written by the writer thread only
+            volatile uint32 head;
+            TOsclThreadId threadId;
+            uint8* buf;
+            volatile int32 state;
+            //used by the writer thread only, to find unused rings
+            uint32 lastTail;
+            uint32 lastTicks;
+        } Ring;
+
+        AsyncFileAppender()
+        {
+            _binary = false;
+            _out = NULL;
+            _outLen = 0;
+            _stop = 0;
+            _numRings = 0;
+            _dropped = 0;
+            _droppedReported = 0;
+            _semCreated = false;
+            _threadRunning = false;
+            _tickBase = OsclTickCount::TickCount();
+            oscl_memset(_rings, 0, sizeof(_rings));
+        }
+
+        //ring of the calling thread, taken on its first message. The ring is
+        //busy until ReleaseRing, so the writer thread can't free it meanwhile.
+        Ring* GetRing()
+        {
+            TOsclThreadId id;
+            OsclThread::GetId(id);
+
+            for (;;)
+            {
+                int32 numRings = OSCL_MIN(_numRings, PVLOGGER_ASYNC_MAX_THREADS);
+                int32 i;
+                for (i = 0; i < numRings; i++)
+                {
+                    Ring* ring = &_rings[i];
+                    if (!OsclThread::CompareId(ring->threadId, id)) continue;
+
+                    //the writer thread, or a thread that read the id before the
+                    //ring changed owner, may hold the ring for a moment
+                    while (RING_FREE != ring->state)
+                    {
+                        if (OsclAtomicCompareAndSwap(&ring->state, RING_IDLE, RING_BUSY))
+                        {
+                            if (OsclThread::CompareId(ring->threadId, id)) return ring;
+                            ReleaseRing(ring);
+                            break;
+                        }
+                    }
+                }
+
+                for (i = 0; i < numRings; i++)
+                {
+                    Ring* ring = &_rings[i];
+                    if (RING_FREE == ring->state &&
+                            OsclAtomicCompareAndSwap(&ring->state, RING_FREE, RING_BUSY))
+                    {
+                        //the buffer of a freed ring is kept for the next thread
+                        ring->threadId = id;
+                        if (NULL == ring->buf)
+                        {
+                            ring->buf = (uint8*)OSCL_MALLOC(PVLOGGER_ASYNC_RING_SIZE);
+                        }
+                        if (NULL == ring->buf)
+                        {
+                            ring->state = RING_FREE;
+                            OsclAtomicAdd(&_dropped, 1);
+                            return NULL;
+                        }
+                        return ring;
+                    }
+                }
+
+                if (_numRings >= PVLOGGER_ASYNC_MAX_THREADS)
+                {
+                    OsclAtomicAdd(&_dropped, 1);
+                    return NULL;
+                }
+                //no free ring, add one
+                OsclAtomicAdd(&_numRings, 1);
+            }
+        }
+
+        void ReleaseRing(Ring* ring)
+        {
+            //the records and owner must be visible before the ring is idle
+            OsclAtomicMemoryBarrier();
+            ring->state = RING_IDLE;
+        }
+
+        void Push(Ring* ring, const uint8* record, uint32 size)
+        {
+            const uint32 mask = PVLOGGER_ASYNC_RING_SIZE - 1;
+            uint32 space = (size + 7) & ~7;
+            uint32 tail = ring->tail;
+            uint32 head = ring->head;
+
+            //records are never split, pad to the start of the ring
+            uint32 toEnd = PVLOGGER_ASYNC_RING_SIZE - (tail & mask);
+            uint32 pad = (toEnd < space) ? toEnd : 0;
+
+            if ((tail - head) + pad + space > PVLOGGER_ASYNC_RING_SIZE)
+            {
+                OsclAtomicAdd(&_dropped, 1);
+                return;
+            }
+
+            if (pad)
+            {
+                RecordHeader padHdr;
+                padHdr.size = pad;
+                padHdr.type = PVLOGGER_ASYNC_REC_PAD;
+                oscl_memcpy(ring->buf + (tail & mask), &padHdr, 4);
+                tail += pad;
+            }
+            oscl_memcpy(ring->buf + (tail & mask), record, size);
+
+            //the record must be visible before the new tail
+            OsclAtomicMemoryBarrier();
+            ring->tail = tail + space;
+
+            if ((tail + space - head) >= PVLOGGER_ASYNC_RING_SIZE / 2 &&
+                    (tail - pad - head) < PVLOGGER_ASYNC_RING_SIZE / 2)
+            {
+                _wakeSem.Signal();
+            }
+        }
+
+        static TOsclThreadFuncRet OSCL_THREAD_DECL ThreadMain(TOsclThreadFuncArg arg)
+        {
+            AsyncFileAppender* self = (AsyncFileAppender*)arg;
+
+            for (;;)
+            {
+                bool stop = (self->_stop != 0);
+                self->Drain();
+                self->FlushOutput();
+                if (stop)
+                {
+                    break;
+                }
+                self->_wakeSem.Wait(PVLOGGER_ASYNC_POLL_MSEC);
+            }
+
+            self->_exitSem.Signal();
+            return 0;
+        }
+
+        void Drain()
+        {
+            const uint32 mask = PVLOGGER_ASYNC_RING_SIZE - 1;
+            int32 numRings = OSCL_MIN(_numRings, PVLOGGER_ASYNC_MAX_THREADS);
+            uint32 now = OsclTickCount::TickCount();
+
+            for (int32 i = 0; i < numRings; i++)
+            {
+                Ring* ring = &_rings[i];
+                if (RING_FREE == ring->state || !ring->buf) continue;
+
+                uint32 head = ring->head;
+                uint32 tail = ring->tail;
+                OsclAtomicMemoryBarrier();
+
+                while (head != tail)
+                {
+                    RecordHeader hdr;
+                    uint8* record = ring->buf + (head & mask);
+                    oscl_memcpy(&hdr, record, sizeof(uint16));
+                    if (PVLOGGER_ASYNC_REC_PAD != record[2])
+                    {
+                        oscl_memcpy(&hdr, record, sizeof(RecordHeader));
+                        WriteRecord(hdr, record, (uint32)ring->threadId);
+                        hdr.size = (hdr.size + 7) & ~7;
+                    }
+                    head += hdr.size;
+                }
+
+                //done reading before the logging thread may reuse the space
+                OsclAtomicMemoryBarrier();
+                ring->head = head;
+
+                if (tail != ring->lastTail)
+                {
+                    ring->lastTail = tail;
+                    ring->lastTicks = now;
+                }
+                else if (OsclTickCount::TicksToMsec(now - ring->lastTicks) >= PVLOGGER_ASYNC_IDLE_MSEC &&
+                         OsclAtomicCompareAndSwap(&ring->state, RING_IDLE, RING_BUSY))
+                {
+                    //the thread stopped logging, or has exited. free the ring
+                    //if nothing was added since it was drained.
+                    ring->state = (ring->tail == head) ? RING_FREE : RING_IDLE;
+                }
+            }
+
+            uint32 dropped = _dropped;
+            if (dropped != _droppedReported)
+            {
+                WriteDropped(dropped - _droppedReported);
+                _droppedReported = dropped;
+            }
+        }
+
+        void WriteRecord(RecordHeader& hdr, const uint8* record, uint32 threadId)
+        {
+            uint32 msec = OsclTickCount::TicksToMsec(hdr.ticks - _tickBase);
+            const uint8* data = record + sizeof(RecordHeader);
+            uint32 len = hdr.size - sizeof(RecordHeader);
+
+            if (_binary)
+            {
+                uint32 id = 0;
+                if (PVLOGGER_ASYNC_REC_MESSAGE == hdr.type)
+                {
+                    id = GetFormatId(hdr.fmt, threadId);
+                }
+                OutputBinaryHeader(hdr.type, hdr.flags, len, id, hdr.msgID, msec, threadId);
+                Output(data, len);
+                return;
+            }
+
+            char prefix[64];
+            int32 prefixLen = oscl_snprintf(prefix, sizeof(prefix), "PVLOG:TID(0x%x):Time=%d:", threadId, msec);
+
+            if (PVLOGGER_ASYNC_REC_MESSAGE == hdr.type)
+            {
+                Output(prefix, prefixLen);
+                FormatMessage(hdr.fmt, data, len, hdr.flags != 0);
+                Output("\r\n", 2);
+            }
+            else
+            {
+                //same layout as TextFileAppender::AppendBuffers
+                for (uint32 i = 0; i < len; i += 10)
+                {
+                    uint8 bytes[10];
+                    oscl_memset(bytes, 0, sizeof(bytes));
+                    oscl_memcpy(bytes, data + i, OSCL_MIN(len - i, (uint32)10));
+
+                    char line[64];
+                    int32 lineLen = oscl_snprintf(line, sizeof(line), "  %x %x %x %x %x %x %x %x %x %x",
+                                                  bytes[0], bytes[1], bytes[2], bytes[3], bytes[4],
+                                                  bytes[5], bytes[6], bytes[7], bytes[8], bytes[9]);
+                    Output(prefix, prefixLen);
+                    Output(line, lineLen);
+                    Output("\r\n", 2);
+                }
+            }
+        }
+
+        void WriteDropped(uint32 count)
+        {
+            if (_binary)
+            {
+                OutputBinaryHeader(PVLOGGER_ASYNC_REC_DROPPED, 0, 0, count, 0, 0, 0);
+            }
+            else
+            {
+                char line[64];
+                int32 lineLen = oscl_snprintf(line, sizeof(line), "PVLOG:AsyncFileAppender: %d messages dropped\r\n", count);
+                Output(line, lineLen);
+            }
+        }
+
+        //format strings are sent once, the messages refer to them by id
+        uint32 GetFormatId(const char* fmt, uint32 threadId)
+        {
+            Oscl_Map<const char*, uint32, OsclMemAllocator>::iterator it = _formatIds.find(fmt);
+            if (it != _formatIds.end())
+            {
+                return (*it).second;
+            }
+
+            uint32 id = _formatIds.size() + 1;
+            int32 err = 0;
+            OSCL_TRY(err, _formatIds[fmt] = id;);
+            if (err != 0)
+            {
+                return 0;
+            }
+
+            uint32 len = oscl_strlen(fmt);
+            OutputBinaryHeader(PVLOGGER_ASYNC_REC_FORMAT, 0, len, id, 0, 0, threadId);
+            Output(fmt, len);
+            return id;
+        }
+
+        void FormatMessage(const char* fmt, const uint8* args, uint32 argsLen, bool cut)
+        {
+            uint32 pos = 0;
+            const char* p = fmt;
+            while (*p)
+            {
+                //text up to the next conversion
+                const char* start = p;
+                while (*p && *p != '%') p++;
+                Output(start, (uint32)(p - start));
+                if (!*p) break;
+
+                //same parsing as AppendString
+                start = p++;
+                int32 stars[2];
+                int32 numStars = 0;
+                uint8 kind = 0;
+
+                while (*p == '0' || *p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '\'') p++;
+                if (*p == '*')
+                {
+                    p++;
+                    numStars++;
+                }
+                else
+                {
+                    while (*p >= '0' && *p <= '9') p++;
+                }
+                if (*p == '.')
+                {
+                    p++;
+                    if (*p == '*')
+                    {
+                        p++;
+                        numStars++;
+                    }
+                    else
+                    {
+                        while (*p >= '0' && *p <= '9') p++;
+                    }
+                }
+                bool isLong = false;
+                if (*p == 'h')
+                {
+                    p++;
+                }
+                else if (*p == 'l')
+                {
+                    isLong = true;
+                    p++;
+                    if (*p == 'l') p++;
+                }
+                switch (*p)
+                {
+                    case 'c':
+                        kind = PVLOGGER_ASYNC_ARG_INT;
+                        break;
+                    case 'd':
+                    case 'i':
+                    case 'u':
+                    case 'o':
+                    case 'x':
+                    case 'X':
+                        kind = isLong ? PVLOGGER_ASYNC_ARG_LONG : PVLOGGER_ASYNC_ARG_INT;
+                        break;
+                    case 'D':
+                    case 'U':
+                    case 'O':
+                        kind = PVLOGGER_ASYNC_ARG_LONG;
+                        break;
+                    case 'p':
+                        kind = PVLOGGER_ASYNC_ARG_PTR;
+                        break;
+                    case 's':
+                        kind = PVLOGGER_ASYNC_ARG_STRING;
+                        break;
+                    default:
+                        break;
+                }
+                if (*p) p++;
+
+                char spec[32];
+                uint32 specLen = (uint32)(p - start);
+                if (specLen >= sizeof(spec))
+                {
+                    Output(start, specLen);
+                    continue;
+                }
+                oscl_memcpy(spec, start, specLen);
+                spec[specLen] = '\0';
+
+                //the arguments of the conversion
+                bool ok = true;
+                for (int32 i = 0; i < numStars && ok; i++)
+                {
+                    ok = GetInt(args, argsLen, pos, stars[i]);
+                }
+
+                int32 intArg = 0;
+                long longArg = 0;
+                OsclAny* ptrArg = NULL;
+                char strArg[PVLOGGER_ASYNC_MAX_RECORD];
+                if (ok)
+                {
+                    switch (kind)
+                    {
+                        case PVLOGGER_ASYNC_ARG_INT:
+                            ok = GetInt(args, argsLen, pos, intArg);
+                            break;
+                        case PVLOGGER_ASYNC_ARG_LONG:
+                            ok = GetLong(args, argsLen, pos, longArg);
+                            break;
+                        case PVLOGGER_ASYNC_ARG_PTR:
+                            ok = GetPtr(args, argsLen, pos, ptrArg);
+                            break;
+                        case PVLOGGER_ASYNC_ARG_STRING:
+                            ok = GetString(args, argsLen, pos, strArg);
+                            break;
+                        default:
+                            break;
+                    }
+                }
+                if (!ok)
+                {
+                    //the rest of the arguments did not fit in the record
+                    if (cut) Output("...", 3);
+                    break;
+                }
+
+                char text[PVLOGGER_ASYNC_MAX_RECORD];
+                int32 textLen = 0;
+                switch (kind)
+                {
+                    case PVLOGGER_ASYNC_ARG_LONG:
+                        textLen = FormatOne(text, sizeof(text), spec, numStars, stars, longArg);
+                        break;
+                    case PVLOGGER_ASYNC_ARG_PTR:
+                        textLen = FormatOne(text, sizeof(text), spec, numStars, stars, ptrArg);
+                        break;
+                    case PVLOGGER_ASYNC_ARG_STRING:
+                        textLen = FormatOne(text, sizeof(text), spec, numStars, stars, (const char*)strArg);
+                        break;
+                    default:
+                        textLen = FormatOne(text, sizeof(text), spec, numStars, stars, intArg);
+                        break;
+                }
+                if (textLen > 0)
+                {
+                    Output(text, OSCL_MIN((uint32)textLen, (uint32)(sizeof(text) - 1)));
+                }
+            }
+        }
+
+        template<class T>
+        static int32 FormatOne(char* buf, uint32 size, const char* spec, int32 numStars, int32* stars, T value)
+        {
+            if (0 == numStars) return oscl_snprintf(buf, size, spec, value);
+            if (1 == numStars) return oscl_snprintf(buf, size, spec, stars[0], value);
+            return oscl_snprintf(buf, size, spec, stars[0], stars[1], value);
+        }
+
+        static void PutInt(uint8* record, uint32& pos, uint8& cut, int32 value)
+        {
+            if (pos + 1 + sizeof(int32) > PVLOGGER_ASYNC_MAX_RECORD)
+            {
+                cut = 1;
+                return;
+            }
+            record[pos++] = PVLOGGER_ASYNC_ARG_INT;
+            oscl_memcpy(record + pos, &value, sizeof(int32));
+            pos += sizeof(int32);
+        }
+
+        static void PutLong(uint8* record, uint32& pos, uint8& cut, long value)
+        {
+            if (pos + 1 + sizeof(long) > PVLOGGER_ASYNC_MAX_RECORD)
+            {
+                cut = 1;
+                return;
+            }
+            record[pos++] = PVLOGGER_ASYNC_ARG_LONG;
+            oscl_memcpy(record + pos, &value, sizeof(long));
+            pos += sizeof(long);
+        }
+
+        static void PutPtr(uint8* record, uint32& pos, uint8& cut, OsclAny* value)
+        {
+            if (pos + 1 + sizeof(OsclAny*) > PVLOGGER_ASYNC_MAX_RECORD)
+            {
+                cut = 1;
+                return;
+            }
+            record[pos++] = PVLOGGER_ASYNC_ARG_PTR;
+            oscl_memcpy(record + pos, &value, sizeof(OsclAny*));
+            pos += sizeof(OsclAny*);
+        }
+
+        static void PutString(uint8* record, uint32& pos, uint8& cut, const char* value)
+        {
+            if (pos + 1 + sizeof(uint16) > PVLOGGER_ASYNC_MAX_RECORD)
+            {
+                cut = 1;
+                return;
+            }
+            if (NULL == value)
+            {
+                value = "(null)";
+            }
+
+            //the string is cut to the space left, the next argument won't fit anyway
+            uint16 len = 0;
+            uint32 maxLen = PVLOGGER_ASYNC_MAX_RECORD - pos - 1 - sizeof(uint16);
+            while (len < maxLen && value[len])
+            {
+                len++;
+            }
+            record[pos++] = PVLOGGER_ASYNC_ARG_STRING;
+            oscl_memcpy(record + pos, &len, sizeof(uint16));
+            pos += sizeof(uint16);
+            oscl_memcpy(record + pos, value, len);
+            pos += len;
+        }
+
+        static bool GetInt(const uint8* args, uint32 len, uint32& pos, int32& value)
+        {
+            if (pos + 1 + sizeof(int32) > len || PVLOGGER_ASYNC_ARG_INT != args[pos]) return false;
+            oscl_memcpy(&value, args + pos + 1, sizeof(int32));
+            pos += 1 + sizeof(int32);
+            return true;
+        }
+
+        static bool GetLong(const uint8* args, uint32 len, uint32& pos, long& value)
+        {
+            if (pos + 1 + sizeof(long) > len || PVLOGGER_ASYNC_ARG_LONG != args[pos]) return false;
+            oscl_memcpy(&value, args + pos + 1, sizeof(long));
+            pos += 1 + sizeof(long);
+            return true;
+        }
+
+        static bool GetPtr(const uint8* args, uint32 len, uint32& pos, OsclAny*& value)
+        {
+            if (pos + 1 + sizeof(OsclAny*) > len || PVLOGGER_ASYNC_ARG_PTR != args[pos]) return false;
+            oscl_memcpy(&value, args + pos + 1, sizeof(OsclAny*));
+            pos += 1 + sizeof(OsclAny*);
+            return true;
+        }
+
+        //value has room for PVLOGGER_ASYNC_MAX_RECORD characters
+        static bool GetString(const uint8* args, uint32 len, uint32& pos, char* value)
+        {
+            uint16 strLen;
+            if (pos + 1 + sizeof(uint16) > len || PVLOGGER_ASYNC_ARG_STRING != args[pos]) return false;
+            oscl_memcpy(&strLen, args + pos + 1, sizeof(uint16));
+            if (pos + 1 + sizeof(uint16) + strLen > len) return false;
+            oscl_memcpy(value, args + pos + 1 + sizeof(uint16), strLen);
+            value[strLen] = '\0';
+            pos += 1 + sizeof(uint16) + strLen;
+            return true;
+        }
+
+        void OutputBinaryHeader(uint8 type, uint8 flags, uint32 len, uint32 id, int32 msgID, uint32 msec, uint32 threadId)
+        {
+            uint8 header[20];
+            uint16 len16 = (uint16)len;
+            header[0] = type;
+            header[1] = flags;
+            oscl_memcpy(header + 2, &len16, 2);
+            oscl_memcpy(header + 4, &id, 4);
+            oscl_memcpy(header + 8, &msgID, 4);
+            oscl_memcpy(header + 12, &msec, 4);
+            oscl_memcpy(header + 16, &threadId, 4);
+            Output(header, sizeof(header));
+        }
+
+        void Output(const OsclAny* data, uint32 len)
+        {
+            if (_outLen + len > PVLOGGER_ASYNC_OUTPUT_BUFFER_SIZE)
+            {
+                FlushOutput();
+            }
+            if (len > PVLOGGER_ASYNC_OUTPUT_BUFFER_SIZE)
+            {
+                _logFile.Write(data, sizeof(uint8), len);
+                return;
+            }
+            oscl_memcpy(_out + _outLen, data, len);
+            _outLen += len;
+        }
+
+        void FlushOutput()
+        {
+            if (_outLen)
+            {
+                _logFile.Write(_out, sizeof(uint8), _outLen);
+                _logFile.Flush();
+                _outLen = 0;
+            }
+        }
+
+        Oscl_FileServer _fs;
+        Oscl_File _logFile;
+        bool _binary;
+
+        //written by the writer thread only
+        uint8* _out;
+        uint32 _outLen;
+        uint32 _tickBase;
+        uint32 _droppedReported;
+        Oscl_Map<const char*, uint32, OsclMemAllocator> _formatIds;
+
+        Ring _rings[PVLOGGER_ASYNC_MAX_THREADS];
+        volatile int32 _numRings;
+        volatile uint32 _dropped;
+        volatile int32 _stop;
+
+        OsclSemaphore _wakeSem;
+        OsclSemaphore _exitSem;
+        bool _semCreated;
+        bool _threadRunning;
+};
+
+#endif // OSCL_HAS_THREAD_SUPPORT && OSCL_HAS_ATOMIC_SUPPORT
+
+#endif // PVLOGGER_ASYNC_APPENDER_H_INCLUDED
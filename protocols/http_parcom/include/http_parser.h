@@ -112,6 +112,8 @@ class HTTPParser
         OSCL_IMPORT_REF uint32 getNumberOfFieldsByKey(const StrCSumPtrLen &aNewFieldName);
         // get the status code, 1xx, 2xx, 3xx, 4xx, 5xx
         OSCL_IMPORT_REF uint32 getHTTPStatusCode();
+        // get the minor HTTP version of the response, 0 => HTTP/1.0, 1 => HTTP/1.1
+        OSCL_IMPORT_REF uint32 getHTTPVersionNum();
         /////////////////////////////////////////////////////////////////////////////////////////////
 
         // reset the parser to parse a new HTTP response
@@ -98,6 +98,12 @@ OSCL_EXPORT_REF uint32 HTTPParser::getHTTPStatusCode()
     return iHeader->getStatusCode();
 }
 
+////////////////////////////////////////////////////////////////////////////////////
+OSCL_EXPORT_REF uint32 HTTPParser::getHTTPVersionNum()
+{
+    return iHeader->getHttpVersionNum();
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 OSCL_EXPORT_REF void HTTPParser::getContentInfo(HTTPContentInfo &aContentInfo)
 {
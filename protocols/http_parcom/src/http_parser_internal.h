@@ -292,6 +292,10 @@ class HTTPParserHeaderObject : public HTTPParserBaseObject
         {
             return iStatusCode;
         }
+        uint32 getHttpVersionNum() const
+        {
+            return iHttpVersionNum;
+        }
         uint32 getNumFields()
         {
             return (iKeyValueStore == NULL ? 0 : iKeyValueStore->getNumberOfKeyValuePairs());
@@ -55,6 +55,7 @@ class Level0PduParcom : public H223PduParcomBase
         unsigned Remove0();
         void Remove0Octet(uint8 cur_byte, int num_bits_from_octet);
         void AppendBit(int c);
+        void AppendBits(unsigned num_bits, unsigned bits);
         void AppendBits0(unsigned num_bits, int bits);
 
         int iPmNext;
@@ -22,6 +22,18 @@
 #define HDLC    0x7e
 #define NUM_ZERO_BIT_INSERTION_BUFFERS 32
 
+/* Bit i is set if bits i to i+4 of x are all 1's */
+static inline unsigned RunOf5Ones(unsigned x)
+{
+    return x & (x >> 1) & (x >> 2) & (x >> 3) & (x >> 4);
+}
+
+/* Bit i is set if bits i to i+5 of x are all 1's */
+static inline unsigned RunOf6Ones(unsigned x)
+{
+    return RunOf5Ones(x) & (x >> 5);
+}
+
 Level0PduParcom::Level0PduParcom()
 {
     iLogger = PVLogger::GetLoggerObject("3g324m.h223.Level0");
@@ -175,6 +187,20 @@ uint16 Level0PduParcom::Insert0Octet(uint8 octet, uint16 num_bits_from_octet, ui
     iTxCheck0 = iTxCheck0 | (octet << iTxCheck0Pos);
     iTxCheck0Pos += num_bits_from_octet;
     int bits_consumed = 0;
+
+    // If none of the 5 bit windows checked below has 5 1's, all but the last 4 bits go out as they are
+    if (iTxCheck0Pos >= 5)
+    {
+        unsigned num_checks = iTxCheck0Pos - 4;
+        unsigned mask = (1 << num_checks) - 1;
+        if ((RunOf5Ones(iTxCheck0) & mask) == 0)
+        {
+            write_pos += AppendTxBits0(num_checks, iTxCheck0 & mask, write_pos);
+            iTxCheck0 >>= num_checks;
+            iTxCheck0Pos = 4;
+            return (uint16)(write_pos - out_buffer);
+        }
+    }
     while (iTxCheck0Pos >= 5)
     {
         if ((iTxCheck0 & 0x1F) == 0x1F)
@@ -217,6 +243,20 @@ void Level0PduParcom::SearchForHdlcFlag(uint8* bsbuf, int bsbsz)
     {
         uint8 cur_byte = bsbuf[bytenum];
         uint8 cur_bit = 0;
+
+        // The flag check is made each time 8 bits are held, that is iNumRecvBits + 1 times for this octet.
+        // If none of them can see 6 1's, the oldest iNumRecvBits + 1 bits go to the pdu as they are.
+        unsigned window = iRecvBits | (cur_byte << iNumRecvBits);
+        unsigned num_checks = iNumRecvBits + 1;
+        unsigned mask = (1 << num_checks) - 1;
+        if (((RunOf6Ones(window) >> 1) & mask) == 0)
+        {
+            AppendBits(num_checks, window & mask);
+            iRecvBits = window >> num_checks;
+            iNumRecvBits = 7;
+            continue;
+        }
+
         for (int bitnum = 0; bitnum < 8; bitnum++)
         {
             cur_bit = (uint8)(cur_byte & 0x1);
@@ -264,6 +304,28 @@ void Level0PduParcom::AppendBit(int c)
     }
 }
 
+/* Appends up to 8 bits to the received bitstream, flushing a complete octet to iPdu the way AppendBit does */
+void Level0PduParcom::AppendBits(unsigned num_bits, unsigned bits)
+{
+    unsigned bits_to_octet = 8 - iRecvBytePos;
+    if (num_bits < bits_to_octet)
+    {
+        iRecvByte |= (bits << iRecvBytePos);
+        iRecvBytePos += num_bits;
+        return;
+    }
+
+    iRecvByte |= ((bits & ((1 << bits_to_octet) - 1)) << iRecvBytePos);
+    iRecvBytePos = 8;
+    if (iPduPos == iPduEndPos)
+    {
+        Remove0();
+    }
+    *iPduPos++ = (uint8)iRecvByte;
+    iRecvByte = bits >> bits_to_octet;
+    iRecvBytePos = num_bits - bits_to_octet;
+}
+
 /* Appends bits to the zero bit removed incoming bitstream */
 void Level0PduParcom::AppendBits0(unsigned num_bits, int bits)
 {
@@ -328,6 +390,22 @@ unsigned Level0PduParcom::Remove0()
 void Level0PduParcom::Remove0Octet(uint8 cur_byte, int num_bits_from_octet)
 {
     uint8 cur_bit = 0;
+
+    // The check for 5 1's is made each time 6 bits are held, that is iRecvByte0Pos + 3 times for a whole
+    // octet.  If none of them finds 5 1's, the oldest iRecvByte0Pos + 3 bits are written out as they are.
+    if (num_bits_from_octet == 8)
+    {
+        unsigned window = iRecvByte0 | (cur_byte << iRecvByte0Pos);
+        unsigned num_checks = iRecvByte0Pos + 3;
+        unsigned mask = (1 << num_checks) - 1;
+        if ((RunOf5Ones(window) & mask) == 0)
+        {
+            AppendBits0(num_checks, window & mask);
+            iRecvByte0 = window >> num_checks;
+            iRecvByte0Pos = 5;
+            return;
+        }
+    }
     for (int bitnum = 0; bitnum < num_bits_from_octet; bitnum++)
     {
         cur_bit = (uint8)(cur_byte & 0x1);
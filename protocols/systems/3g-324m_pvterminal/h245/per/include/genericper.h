@@ -27,6 +27,20 @@
 
 #define EPASS (void (*)(uint8*,PS_OutStream))
 
+/* Set H245_PER_DECODE_ARENA to 1 to decode each received message into  */
+/*   a bump arena.  The whole message is then freed with FreePerArena() */
+/*   instead of the Delete_ routines.  Set it to 0 to decode into the   */
+/*   heap and free with the Delete_ routines, as before.                */
+#ifndef H245_PER_DECODE_ARENA
+#define H245_PER_DECODE_ARENA 1
+#endif
+
+/* Arena blocks are allocated in increments of this many bytes.  A     */
+/*   TerminalCapabilitySet usually fits in one or two blocks.         */
+#ifndef H245_PER_ARENA_BLOCK_SIZE
+#define H245_PER_ARENA_BLOCK_SIZE 2048
+#endif
+
 
 /*=========================================================*/
 /*========== STRUCTURE DEFINITIONS (Generic PER) ==========*/
@@ -72,10 +86,20 @@ typedef struct _UnknownSigMap    /* Unknown SigMap */
 
 typedef S_UnknownSigMap *PS_UnknownSigMap;
 
+typedef struct _PerArenaBlock    /* Decode Arena Block */
+{
+    struct _PerArenaBlock* next;   /* Next block of the arena */
+    uint32 size;                   /* Usable bytes in the block */
+    uint32 used;                   /* Bytes handed out so far */
+} S_PerArenaBlock;
+
+typedef S_PerArenaBlock *PS_PerArena;  /* The current block */
+
 typedef struct _InStream    /* Input Stream */
 {
     uint8* data;           /* Current byte in stream */
     uint8 bitIndex;        /* Next bit within the byte */
+    PS_PerArena arena;     /* Decoded data goes here (NULL: heap) */
 } S_InStream;
 
 typedef S_InStream *PS_InStream;
@@ -96,6 +120,7 @@ typedef S_OutStream *PS_OutStream;
 /*=========================================================*/
 /* ------------- LOW LEVEL STREAM -------------- */
 uint8 ReadBits(uint32 number, PS_InStream stream);
+uint32 ReadBitField(uint32 number, PS_InStream stream);
 void  ReadRemainingBits(PS_InStream stream);
 void  ReadOctets(uint32 number, uint8* octets, uint8 reorder, PS_InStream stream);
 
@@ -144,12 +169,25 @@ uint32 SkipUnreadExtensions(PS_UnknownSigMap, PS_InStream stream);
 /* Returns the number of exts skipped. */
 void SkipOneOctet(PS_InStream stream);
 
+/* ------------- DECODE ARENA ----------------*/
+PS_PerArena NewPerArena(void);
+/* Creates an arena with one empty block */
+OsclAny* PerArenaAlloc(uint32 size, PS_InStream stream);
+/* Allocates from stream->arena, which may move */
+/*   to a new block.  Leaves if out of memory.  */
+void FreePerArena(PS_PerArena arena);
+/* Frees every block of the arena */
+OsclAny* PerDecodeAlloc(uint32 size, PS_InStream stream);
+/* Allocates decoded data from the arena of the */
+/*   stream, or the heap if it has none.        */
+
 /*=========================================================*/
 /*============ ENCODING ROUTINES (Generic PER) ============*/
 /*=========================================================*/
 
 /* ------------- LOW LEVEL STREAM -------------- */
 void WriteBits(uint32 number, uint8 bits, PS_OutStream stream);
+void WriteBitField(uint32 number, uint32 bits, PS_OutStream stream);
 void WriteRemainingBits(PS_OutStream stream);
 void WriteOctets(uint32 number, uint8* octets, uint8 reorder, PS_OutStream stream);
 PS_OutStream NewOutStream(void);
@@ -61,9 +61,9 @@ class PER
 
     private:
         bool Decode(int& nBytes, uint8* pBuffer, uint16& GetSize, uint8*& pData,
-                    uint8& MsgType1, uint8& MsgType2);
+                    uint8& MsgType1, uint8& MsgType2, PS_PerArena& pArena);
         void MultiSysCtrlMessage_encode(uint16*, uint8* *, uint8*, uint8, uint8);
-        int MultiSysCtrlMessage_decode(uint8*, uint16*, uint8*  *, uint8*, uint8*);
+        int MultiSysCtrlMessage_decode(PS_InStream, uint16*, uint8*  *, uint8*, uint8*);
         void RequestMessage_encode(uint8*, uint8, PS_OutStream);
         void ResponseMessage_encode(uint8*, uint8, PS_OutStream);
         void CommandMessage_encode(uint8*, uint8, PS_OutStream);
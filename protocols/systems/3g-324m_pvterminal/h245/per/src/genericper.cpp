@@ -46,7 +46,75 @@
 #define STREAM_ADDITION 64      /* Output stream grows in increments */
 /*   of this many bytes.             */
 
-const uint8 MaskBit[] = { 0xff, 0x7f, 0x3f, 0x1f, 0x0f, 0x07, 0x03, 0x01 };
+/* Number of significant bits in 0...15 */
+static const uint8 NibbleBits[] = { 0, 1, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4 };
+
+/* Arena allocations are rounded up to this many bytes */
+#define PER_ARENA_ALIGN 8
+#define PER_ARENA_ROUND(x) (((x) + PER_ARENA_ALIGN - 1) & ~(PER_ARENA_ALIGN - 1))
+#define PER_ARENA_HEADER_SIZE PER_ARENA_ROUND(sizeof(S_PerArenaBlock))
+
+// =========================================================
+// RangeBits()
+//
+// Returns the size of the bit-field holding a constrained
+// whole number, for ranges 2...256 (X.691 Section 10.5.7.1).
+// =========================================================
+static uint8 RangeBits(uint32 range)
+{
+    uint32 largest = range - 1;
+
+    if (largest >> 4)
+    {
+        return (uint8)(4 + NibbleBits[largest >> 4]);
+    }
+    return NibbleBits[largest];
+}
+
+// =========================================================
+// ReadField()
+//
+// Reads up to 25 bits from the input stream.  Only the
+// octets holding the field are read, a whole window at a
+// time, so the stream never runs past the message.
+// =========================================================
+static uint32 ReadField(uint32 number, PS_InStream stream)
+{
+    uint32 end = stream->bitIndex + number;
+    uint32 nbytes = (end + 7) >> 3;
+    uint32 window = 0;
+    uint32 i;
+
+    for (i = 0; i < nbytes; ++i)
+    {
+        window = (window << 8) | stream->data[i];
+    }
+    stream->data += end >> 3;
+    stream->bitIndex = (uint8)(end & 7);
+
+    return (window >> ((nbytes << 3) - end)) & ((1 << number) - 1);
+}
+
+// =========================================================
+// ReadAlignedValue()
+//
+// Reads an unsigned value of 1 to 4 octets, most
+// significant octet first, after octet alignment.
+// =========================================================
+static uint32 ReadAlignedValue(uint32 nbytes, PS_InStream stream)
+{
+    uint32 value = 0;
+    uint32 i;
+
+    ReadRemainingBits(stream);
+    for (i = 0; i < nbytes; ++i)
+    {
+        value = (value << 8) | stream->data[i];
+    }
+    stream->data += nbytes;
+
+    return value;
+}
 
 /***********************************************************/
 /*=========================================================*/
@@ -97,36 +165,28 @@ void ErrorMessageAndLeave(const char *msg)
 // =========================================================
 uint8 ReadBits(uint32 number, PS_InStream stream)
 {
-    uint8 x;
-    uint8 NextBit, BitSize;
-
     if (number > 8)
     {
         ErrorMessageAndLeave("ReadBits(): Max number (8) exceeded");
     }
 
-    BitSize = (uint8)(stream->bitIndex + number);
-    x = (uint8)(stream->data[0] & MaskBit[(int)stream->bitIndex ]);
-    if (BitSize > 8)
-    {
-        NextBit = (uint8)(BitSize - 8);
-        x <<= NextBit;
-        ++stream->data;
-        x |= ((stream->data[0]) & ~MaskBit[(int)stream->bitIndex ]) >> (8 - NextBit);
-    }
-    else if (BitSize < 8)
-    {
-        NextBit = BitSize;
-        x >>= (8 - NextBit);
-    }
-    else
+    return((uint8) ReadField(number, stream));
+}
+
+// =========================================================
+// ReadBitField()
+//
+// This function reads a field of up to 24 bits from the
+// input stream.
+// =========================================================
+uint32 ReadBitField(uint32 number, PS_InStream stream)
+{
+    if (number > 24)
     {
-        NextBit = 0;
-        ++stream->data;
+        ErrorMessageAndLeave("ReadBitField(): Max number (24) exceeded");
     }
 
-    stream->bitIndex = NextBit;
-    return(x);
+    return(ReadField(number, stream));
 }
 
 // =========================================================
@@ -233,23 +293,15 @@ uint32  GetInteger(uint32 lower, uint32 upper, PS_InStream stream)
 
     if (range == 0)     /* Special case: int32EGER(0..4294967295) */
     {
-        nbytes = (uint8)(ReadBits(2, stream) + 1);
-        ReadOctets(nbytes, (uint8*)&value, 1, stream);
-        return(value);
+        nbytes = (uint8)(ReadField(2, stream) + 1);
+        return(ReadAlignedValue(nbytes, stream));
     }
     else if (range == 1)            /* 0-bits */
         return(lower);
     else if (range < 256)           /* Bit-field cases */
     {
-        if (range <= 2) nbits = 1;
-        else if (range <= 4) nbits = 2;
-        else if (range <= 8) nbits = 3;
-        else if (range <= 16) nbits = 4;
-        else if (range <= 32) nbits = 5;
-        else if (range <= 64) nbits = 6;
-        else if (range <= 128) nbits = 7;
-        else nbits = 8;
-        value = ReadBits(nbits, stream);
+        nbits = RangeBits(range);
+        value = ReadField(nbits, stream);
         if (lower + value > upper)
         {
             ErrorMessageAndLeave("GetInteger(): Integer exceeds range");
@@ -260,8 +312,8 @@ uint32  GetInteger(uint32 lower, uint32 upper, PS_InStream stream)
     {
         if (range == 256) nbytes = 1;
         else if (range <= 65536) nbytes = 2;
-        else nbytes = (uint8)(ReadBits(2, stream) + 1);
-        ReadOctets(nbytes, (uint8*)&value, 1, stream);
+        else nbytes = (uint8)(ReadField(2, stream) + 1);
+        value = ReadAlignedValue(nbytes, stream);
         if (lower + value > upper)
         {
             ErrorMessageAndLeave("GetInteger(): exceeds range");
@@ -300,15 +352,8 @@ int32   GetSignedInteger(int32 lower, int32 upper, PS_InStream stream)
         return(lower);
     else if (range < 256)           /* Bit-field cases */
     {
-        if (range <= 2) nbits = 1;
-        else if (range <= 4) nbits = 2;
-        else if (range <= 8) nbits = 3;
-        else if (range <= 16) nbits = 4;
-        else if (range <= 32) nbits = 5;
-        else if (range <= 64) nbits = 6;
-        else if (range <= 128) nbits = 7;
-        else nbits = 8;
-        value = ReadBits(nbits, stream);
+        nbits = RangeBits(range);
+        value = ReadField(nbits, stream);
         if (lower + value > upper)
         {
             ErrorMessageAndLeave("GetSignedInteger(): Integer exceeds range");
@@ -319,8 +364,8 @@ int32   GetSignedInteger(int32 lower, int32 upper, PS_InStream stream)
     {
         if (range == 256) nbytes = 1;
         else if (range <= 65536) nbytes = 2;
-        else nbytes = (uint8)(ReadBits(2, stream) + 1);
-        ReadOctets(nbytes, (uint8*)&value, 1, stream);
+        else nbytes = (uint8)(ReadField(2, stream) + 1);
+        value = ReadAlignedValue(nbytes, stream);
         if (lower + value > upper)
         {
             ErrorMessageAndLeave("GetSignedInteger(): GetInteger exceeds range");
@@ -343,7 +388,11 @@ uint32  GetUnboundedInteger(PS_InStream stream)
     uint32 nbytes, value = 0;
 
     nbytes = GetLengthDet(stream);               // Length Det (10.9)
-    ReadOctets(nbytes, (uint8*)&value, 1, stream);  // Value (10.4)
+    if (nbytes > 4)
+    {
+        ErrorMessageAndLeave("GetUnboundedInteger: Value exceeds 4 octets!");
+    }
+    value = ReadAlignedValue(nbytes, stream);   // Value (10.4)
 
     // Check for negative value
     if ((nbytes == 1 && value >= 0x7f) ||
@@ -368,7 +417,7 @@ uint32  GetExtendedInteger(uint32 lower, uint32 upper, PS_InStream stream)
 {
     uint32 extension_bit, value;
 
-    extension_bit = ReadBits(1, stream);
+    extension_bit = ReadField(1, stream);
     if (extension_bit)
     {
         value = GetUnboundedInteger(stream);
@@ -396,7 +445,7 @@ void GetOctetString(uint8 unbounded, uint32 min, uint32 max,
         x->size = (uint16) GetLengthDet(stream);
         if (x->size)
         {
-            x->data = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+            x->data = (uint8*) PerDecodeAlloc(x->size * sizeof(uint8), stream);
             ReadOctets(x->size, x->data, 0, stream);
         }
         else
@@ -417,19 +466,20 @@ void GetOctetString(uint8 unbounded, uint32 min, uint32 max,
             x->size = (uint16) min;
             if (x->size)
             {
-                x->data = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+                x->data = (uint8*) PerDecodeAlloc(x->size * sizeof(uint8), stream);
                 if (x->size > 2)
                 {
                     ReadOctets(x->size, x->data, 0, stream);
                 }
                 else if (x->size == 2)
                 {
-                    x->data[0] = ReadBits(8, stream);
-                    x->data[1] = ReadBits(8, stream);
+                    uint32 field = ReadField(16, stream);
+                    x->data[0] = (uint8)(field >> 8);
+                    x->data[1] = (uint8) field;
                 }
                 else if (x->size == 1)
                 {
-                    x->data[0] = ReadBits(8, stream);
+                    x->data[0] = (uint8) ReadField(8, stream);
                 }
             }
             else
@@ -442,7 +492,7 @@ void GetOctetString(uint8 unbounded, uint32 min, uint32 max,
             x->size = (uint16) GetInteger(min, max, stream);
             if (x->size)
             {
-                x->data = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+                x->data = (uint8*) PerDecodeAlloc(x->size * sizeof(uint8), stream);
                 ReadOctets(x->size, x->data, 0, stream);
             }
             else
@@ -470,7 +520,7 @@ void GetBitString(uint8 unbounded, uint32 min, uint32 max,
     {
         count = GetLengthDet(stream);
         x->size = (uint16) count;
-        temp = x->data = (uint8*) OSCL_DEFAULT_MALLOC((1 + x->size / 8) * sizeof(uint8));
+        temp = x->data = (uint8*) PerDecodeAlloc((1 + x->size / 8) * sizeof(uint8), stream);
         while (count >= 8)
         {
             temp[0] = ReadBits(8, stream);
@@ -491,7 +541,7 @@ void GetBitString(uint8 unbounded, uint32 min, uint32 max,
         {
             count = min;
             x->size = (uint16) count;
-            temp = x->data = (uint8*) OSCL_DEFAULT_MALLOC((1 + x->size / 8) * sizeof(uint8));
+            temp = x->data = (uint8*) PerDecodeAlloc((1 + x->size / 8) * sizeof(uint8), stream);
             if (x->size > 16)
             {
                 ReadRemainingBits(stream);  /* Octet align */
@@ -508,7 +558,7 @@ void GetBitString(uint8 unbounded, uint32 min, uint32 max,
         {
             count = GetInteger(min, max, stream);
             x->size = (uint16) count;
-            temp = x->data = (uint8*) OSCL_DEFAULT_MALLOC((1 + x->size / 8) * sizeof(uint8));
+            temp = x->data = (uint8*) PerDecodeAlloc((1 + x->size / 8) * sizeof(uint8), stream);
             ReadRemainingBits(stream);
             while (count >= 8)
             {
@@ -547,7 +597,7 @@ void GetCharString(const char *stringName,
             oscl_strncmp(from, "0123456789#*ABCD!", oscl_strlen("0123456789#*ABCD!")) == 0)
     {
         x->size = 2;
-        x->data = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+        x->data = (uint8*) PerDecodeAlloc(x->size * sizeof(uint8), stream);
         x->data[0] = ReadBits(8, stream);     // Read single character,
         // Normal ascii value, not octet aligned
         x->data[1] = 0;  // NULL terminate
@@ -555,7 +605,7 @@ void GetCharString(const char *stringName,
     else if (oscl_strncmp(stringName, "GeneralString", oscl_strlen("GeneralString")) == 0)   // Validate GeneralString case  (RAN-ALPHA)
     {
         x->size = (uint16)(1 + GetLengthDet(stream)); // (leave extra space for NULL)
-        x->data = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+        x->data = (uint8*) PerDecodeAlloc(x->size * sizeof(uint8), stream);
         ReadOctets(x->size - 1, x->data, 1, stream);
         x->data[x->size-1] = 0;  // NULL terminate
     }
@@ -579,7 +629,7 @@ void GetObjectID(PS_OBJECTIDENT x, PS_InStream stream)
     x->size = (uint16) GetLengthDet(stream);
     if (x->size)
     {
-        x->data = (uint8*) OSCL_DEFAULT_MALLOC(x->size * sizeof(uint8));
+        x->data = (uint8*) PerDecodeAlloc(x->size * sizeof(uint8), stream);
         ReadOctets(x->size, x->data, 0, stream);
     }
     else
@@ -602,20 +652,22 @@ void GetObjectID(PS_OBJECTIDENT x, PS_InStream stream)
 uint32 GetLengthDet(PS_InStream stream)
 {
     uint32 length;
-    uint8 byte1, byte2;
+    uint8 byte1;
     uint8 mask1 = 0x80;   /* 10000000 */
     uint8 mask2 = 0x40;   /* 01000000 */
     uint8 mask3 = 0x3f;   /* 00111111 */
 
-    ReadOctets(1, (uint8*)&byte1, 0, stream);  /* Get first byte */
+    ReadRemainingBits(stream);  /* Octet alignment */
+    byte1 = stream->data[0];    /* Get first byte */
     if (!(byte1&mask1))       /* 0xxxxxxx ==>Single octet case */
     {
         length = (uint32) byte1;
+        stream->data += 1;
     }
     else if (!(byte1&mask2))  /* 10xxxxxx ==>Dual octet case */
     {
-        ReadOctets(1, (uint8*)&byte2, 0, stream); /* Second byte */
-        length = (((uint32)(byte1 & mask3)) << 8) + (int32)byte2;
+        length = (((uint32)(byte1 & mask3)) << 8) | stream->data[1];
+        stream->data += 2;
     }
     else
     {
@@ -638,7 +690,7 @@ uint32 GetNormSmallLength(PS_InStream stream)
     uint8 value = 0;
     uint8 mask = 0x40;  /* 01000000 */
 
-    value = ReadBits(7, stream);
+    value = (uint8) ReadField(7, stream);
     if (value&mask)
     {
         ErrorMessageAndLeave("GetNormSmallLength(): Range exceeded.");
@@ -660,7 +712,7 @@ uint32 GetNormSmallValue(PS_InStream stream)
     uint8 value = 0;
     uint8 mask = 0x40;  /* 01000000 */
 
-    value = ReadBits(7, stream);
+    value = (uint8) ReadField(7, stream);
     if (value&mask)
     {
         ErrorMessageAndLeave("GetNormSmallValue(): range exceeded.");
@@ -739,7 +791,7 @@ uint16 GetChoiceIndex(uint32 rootnum, uint8 extmarker, PS_InStream stream)
     extension = 0;
     if (extmarker)          /* Get extension bit */
     {
-        extension = ReadBits(1, stream);
+        extension = (uint8) ReadField(1, stream);
     }
 
     if (!extension)      /* ---Item in root--- */
@@ -881,6 +933,114 @@ void SkipOneOctet(PS_InStream stream)
     ReadOctets(1, &temp, 0, stream);
 }
 
+/* --------------------------------------------- */
+/* --------------- DECODE ARENA -----------------*/
+/* --------------------------------------------- */
+
+// =========================================================
+// NewPerBlock()
+//
+// Allocates an arena block with room for size bytes.
+// =========================================================
+static PS_PerArena NewPerBlock(uint32 size)
+{
+    PS_PerArena block;
+
+    block = (PS_PerArena) OSCL_DEFAULT_MALLOC(PER_ARENA_HEADER_SIZE + size);
+    if (block == NULL)
+    {
+        ErrorMessageAndLeave("NewPerBlock(): Out of memory.");
+        return(NULL);
+    }
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+
+    return(block);
+}
+
+// =========================================================
+// NewPerArena()
+//
+// This function creates a decode arena.  Set stream->arena
+// to it before decoding, and all of the decoded message is
+// allocated from it.
+// =========================================================
+PS_PerArena NewPerArena(void)
+{
+    return(NewPerBlock(H245_PER_ARENA_BLOCK_SIZE));
+}
+
+// =========================================================
+// PerArenaAlloc()
+//
+// This function allocates size bytes from the arena of the
+// stream.  When the current block is full a new one is put
+// in front of it.  Allocations larger than half a block get
+// a block of their own, behind the current one, so the space
+// left in the current block is not lost.
+// =========================================================
+OsclAny* PerArenaAlloc(uint32 size, PS_InStream stream)
+{
+    PS_PerArena block = stream->arena;
+    uint8* ptr;
+
+    size = PER_ARENA_ROUND(size);
+    if (block->size - block->used < size)
+    {
+        if (size > H245_PER_ARENA_BLOCK_SIZE / 2)
+        {
+            PS_PerArena large = NewPerBlock(size);
+            large->next = block->next;
+            large->used = size;
+            block->next = large;
+            return((uint8*)large + PER_ARENA_HEADER_SIZE);
+        }
+
+        block = NewPerBlock(H245_PER_ARENA_BLOCK_SIZE);
+        block->next = stream->arena;
+        stream->arena = block;
+    }
+
+    ptr = (uint8*)block + PER_ARENA_HEADER_SIZE + block->used;
+    block->used += size;
+    return(ptr);
+}
+
+// =========================================================
+// FreePerArena()
+//
+// This function frees an arena and everything allocated
+// from it, one free per block.
+// =========================================================
+void FreePerArena(PS_PerArena arena)
+{
+    PS_PerArena next;
+
+    while (arena)
+    {
+        next = arena->next;
+        OSCL_DEFAULT_FREE(arena);
+        arena = next;
+    }
+}
+
+// =========================================================
+// PerDecodeAlloc()
+//
+// This function allocates memory for decoded data.  It comes
+// from the arena of the stream if there is one, otherwise
+// from the heap, to be freed by the Delete_ routines.
+// =========================================================
+OsclAny* PerDecodeAlloc(uint32 size, PS_InStream stream)
+{
+    if (stream->arena)
+    {
+        return(PerArenaAlloc(size, stream));
+    }
+    return(OSCL_DEFAULT_MALLOC(size));
+}
+
 /***********************************************************/
 /*=========================================================*/
 /*============ ENCODING ROUTINES (Generic PER) ============*/
@@ -893,40 +1053,88 @@ void SkipOneOctet(PS_InStream stream)
 /* --------------------------------------------- */
 
 // =========================================================
-// WriteBits()
+// WriteField()
 //
-// This function writes some number of bits to the
-// output stream.
+// Writes up to 25 bits to the output stream.  The field is
+// merged with the byte under construction in one window,
+// and the complete octets are then stored.
 // =========================================================
-void WriteBits(uint32 number, uint8 bits, PS_OutStream stream)
+static void WriteField(uint32 number, uint32 bits, PS_OutStream stream)
 {
-    uint8 BitSize;
-    uint8 temp;
-
-    BitSize = (uint8)((stream->bitIndex) + number);
-    temp = (uint8)(bits << (8 - number));
-    (stream->buildByte) |= (temp >> (stream->bitIndex));
+    uint32 end, window;
 
-    if (BitSize > 8)                          /* Appended size > 8 bits */
+    if (number == 0)
     {
-        stream->bitIndex = 8;
-        WriteRemainingBits(stream);
-        stream->buildByte = (uint8)((bits) << (16 - BitSize));
-        stream->bitIndex = (uint16)(BitSize - 8);
         return;
     }
-    else if (BitSize < 8)                 /* Appended size < 8 bits */
+
+    end = stream->bitIndex + number;
+    window = ((uint32)stream->buildByte << 24) |
+             ((bits & ((1 << number) - 1)) << (32 - end));
+
+    while (stream->byteIndex + (end >> 3) > stream->size)
     {
-        stream->bitIndex = BitSize;
-        return;
+        ExpandOutStream(stream);
     }
-    else                                     /* Appended size == 8 bits */
+    while (end >= 8)
     {
-        stream->bitIndex = 8;
-        WriteRemainingBits(stream);
-        return;
+        stream->data[stream->byteIndex] = (uint8)(window >> 24);
+        ++stream->byteIndex;
+        window <<= 8;
+        end -= 8;
+    }
+
+    stream->buildByte = (uint8)(window >> 24);
+    stream->bitIndex = (uint16) end;
+}
+
+// =========================================================
+// WriteAlignedValue()
+//
+// Writes an unsigned value of 1 to 4 octets, most
+// significant octet first, after octet alignment.
+// =========================================================
+static void WriteAlignedValue(uint32 nbytes, uint32 value, PS_OutStream stream)
+{
+    uint32 i;
+
+    WriteRemainingBits(stream);
+    while (stream->byteIndex + nbytes > stream->size)
+    {
+        ExpandOutStream(stream);
+    }
+    for (i = nbytes; i > 0; --i)
+    {
+        stream->data[stream->byteIndex] = (uint8)(value >> ((i - 1) << 3));
+        ++stream->byteIndex;
+    }
+}
+
+// =========================================================
+// WriteBits()
+//
+// This function writes some number of bits to the
+// output stream.
+// =========================================================
+void WriteBits(uint32 number, uint8 bits, PS_OutStream stream)
+{
+    WriteField(number, bits, stream);
+}
+
+// =========================================================
+// WriteBitField()
+//
+// This function writes a field of up to 24 bits to the
+// output stream.
+// =========================================================
+void WriteBitField(uint32 number, uint32 bits, PS_OutStream stream)
+{
+    if (number > 24)
+    {
+        ErrorMessageAndLeave("WriteBitField(): Max number (24) exceeded");
     }
 
+    WriteField(number, bits, stream);
 }
 
 // =========================================================
@@ -1115,33 +1323,26 @@ void PutInteger(uint32 lower, uint32 upper, uint32 value, PS_OutStream stream)
         else if (offset < 16777216) nbytes = 3;
         else nbytes = 4;
         code_nbytes = (uint8)(nbytes - 1);
-        WriteBits(2, code_nbytes, stream);              /* Send #octets */
-        WriteOctets(nbytes, (uint8*)&offset, 1, stream);  /* Offset value */
+        WriteField(2, code_nbytes, stream);             /* Send #octets */
+        WriteAlignedValue(nbytes, offset, stream);      /* Offset value */
         return;
     }
     else if (range == 1)            /* 0-bits */
         return;
     else if (range < 256)           /* Bit-field cases */
     {
-        if (range <= 2) nbits = 1;
-        else if (range <= 4) nbits = 2;
-        else if (range <= 8) nbits = 3;
-        else if (range <= 16) nbits = 4;
-        else if (range <= 32) nbits = 5;
-        else if (range <= 64) nbits = 6;
-        else if (range <= 128) nbits = 7;
-        else nbits = 8;
-        WriteBits(nbits, (uint8)offset, stream);
+        nbits = RangeBits(range);
+        WriteField(nbits, offset, stream);
         return;
     }
     else if (range == 256)          /* One octet */
     {
-        WriteOctets(1, (uint8*)(&offset), 1, stream);
+        WriteAlignedValue(1, offset, stream);
         return;
     }
     else                            /* range<=65536; Two octet */
     {
-        WriteOctets(2, (uint8*)(&offset), 1, stream);
+        WriteAlignedValue(2, offset, stream);
         return;
     }
 }
@@ -1188,33 +1389,26 @@ void PutSignedInteger(int32 lower, int32 upper, int32 value, PS_OutStream stream
         else if (offset < 16777216) nbytes = 3;
         else nbytes = 4;
         code_nbytes = (uint8)(nbytes - 1);
-        WriteBits(2, code_nbytes, stream);              /* Send #octets */
-        WriteOctets(nbytes, (uint8*)&offset, 1, stream);  /* Offset value */
+        WriteField(2, code_nbytes, stream);             /* Send #octets */
+        WriteAlignedValue(nbytes, offset, stream);      /* Offset value */
         return;
     }
     else if (range == 1)            /* 0-bits */
         return;
     else if (range < 256)           /* Bit-field cases */
     {
-        if (range <= 2) nbits = 1;
-        else if (range <= 4) nbits = 2;
-        else if (range <= 8) nbits = 3;
-        else if (range <= 16) nbits = 4;
-        else if (range <= 32) nbits = 5;
-        else if (range <= 64) nbits = 6;
-        else if (range <= 128) nbits = 7;
-        else nbits = 8;
-        WriteBits(nbits, (uint8)offset, stream);
+        nbits = RangeBits(range);
+        WriteField(nbits, offset, stream);
         return;
     }
     else if (range == 256)          /* One octet */
     {
-        WriteOctets(1, (uint8*)(&offset), 1, stream);
+        WriteAlignedValue(1, offset, stream);
         return;
     }
     else                            /* range<=65536; Two octet */
     {
-        WriteOctets(2, (uint8*)(&offset), 1, stream);
+        WriteAlignedValue(2, offset, stream);
         return;
     }
 }
@@ -1244,7 +1438,7 @@ void PutUnboundedInteger(uint32 value, PS_OutStream stream)
 
     /* Send length det, followed by 2's complement encoding */
     PutLengthDet(nbytes, stream);
-    WriteOctets(nbytes, (uint8*)(&value), 1, stream);
+    WriteAlignedValue(nbytes, value, stream);
 }
 
 // =========================================================
@@ -1304,8 +1498,7 @@ void PutOctetString(uint8 unbounded, uint32 min, uint32 max,
             }
             else if (x->size == 2)
             {
-                WriteBits(8, x->data[0], stream);
-                WriteBits(8, x->data[1], stream);
+                WriteField(16, ((uint32)x->data[0] << 8) | x->data[1], stream);
             }
             else if (x->size == 1)
             {
@@ -1611,19 +1804,15 @@ void PutNormSmallLength(uint32 value, PS_OutStream stream)
 // =========================================================
 void PutLengthDet(uint32 value, PS_OutStream stream)
 {
-    uint8 byte;
-    uint16 bytes;
-    uint16 mask = 0x8000;   /* 10000000 00000000 */
+    uint32 mask = 0x8000;   /* 10000000 00000000 */
 
     if (value < 128)       /* One octet with leading '0' */
     {
-        byte = (uint8) value;
-        WriteOctets(1, &byte, 0, stream);
+        WriteAlignedValue(1, value, stream);
     }
     else if (value < 16384)   /* Two octets with leading '10' */
     {
-        bytes = (uint16)(value | mask);
-        WriteOctets(2, (uint8*)&bytes, 0, stream);
+        WriteAlignedValue(2, value | mask, stream);
     }
     else
     {
@@ -1687,6 +1876,7 @@ PS_InStream ConvertOutstreamToInstream(PS_OutStream outstream)
     instream = (PS_InStream) OSCL_DEFAULT_MALLOC(sizeof(S_InStream));
     instream->data = outstream->data;
     instream->bitIndex = 0;
+    instream->arena = NULL;
 
     OSCL_DEFAULT_FREE(outstream);
     return(instream);
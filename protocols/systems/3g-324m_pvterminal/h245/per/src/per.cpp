@@ -138,14 +138,22 @@ OSCL_EXPORT_REF void PER::Reset()
 class DecodedMsgDestructDealloc : public OsclDestructDealloc
 {
     public:
-        DecodedMsgDestructDealloc(uint8 amsgtype1, uint8 amsgtype2, uint8* apdata) :
-                msgtype1(amsgtype1), msgtype2(amsgtype2), pdata(apdata)
+        DecodedMsgDestructDealloc(uint8 amsgtype1, uint8 amsgtype2, uint8* apdata,
+                                  PS_PerArena aarena) :
+                msgtype1(amsgtype1), msgtype2(amsgtype2), pdata(apdata), arena(aarena)
         {}
 
         virtual void destruct_and_dealloc(OsclAny *ptr)
         {
-            // delete message
-            PER::DeleteMessage(msgtype1, msgtype2, pdata);
+            // delete message, all at once if it was decoded into an arena
+            if (arena)
+            {
+                FreePerArena(arena);
+            }
+            else
+            {
+                PER::DeleteMessage(msgtype1, msgtype2, pdata);
+            }
             // destruct ref counter
             ((OsclRefCounterDA*)ptr)->~OsclRefCounterDA();
             // destruct this
@@ -158,6 +166,7 @@ class DecodedMsgDestructDealloc : public OsclDestructDealloc
         uint8 msgtype1;
         uint8 msgtype2;
         uint8 *pdata;
+        PS_PerArena arena;
 };
 
 // ========================================================
@@ -170,6 +179,7 @@ OSCL_EXPORT_REF void PER::Decode(uint8* pBuffer, uint32 size)
     uint8       MsgType2 = 0;
     uint16      GetSize = 0;
     uint8*      pData = NULL;
+    PS_PerArena pArena = NULL;
     uint8*      pBufferTop = NULL;
     int         nBytes = 0;
 
@@ -189,7 +199,7 @@ OSCL_EXPORT_REF void PER::Decode(uint8* pBuffer, uint32 size)
         // ------------------------------------
         // Decode the current message to pData
         // ------------------------------------
-        if (!Decode(nBytes, pBuffer, GetSize, pData, MsgType1, MsgType2))
+        if (!Decode(nBytes, pBuffer, GetSize, pData, MsgType1, MsgType2, pArena))
         {
             return;
         }
@@ -211,12 +221,16 @@ OSCL_EXPORT_REF void PER::Decode(uint8* pBuffer, uint32 size)
         {
             // pass message up via smart pointer.  Some messages are held by user.
             uint8 *space = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(OsclRefCounterDA) + sizeof(DecodedMsgDestructDealloc));
-            DecodedMsgDestructDealloc *destructor = new(space + sizeof(OsclRefCounterDA)) DecodedMsgDestructDealloc(MsgType1, MsgType2, pData);
+            DecodedMsgDestructDealloc *destructor = new(space + sizeof(OsclRefCounterDA)) DecodedMsgDestructDealloc(MsgType1, MsgType2, pData, pArena);
             OsclRefCounter *decodedMsgRefCnter    = new(space)                          OsclRefCounterDA(space, destructor);
             OsclSharedPtr<uint8> decodedMsgPtr(pData, decodedMsgRefCnter);
 
             MySe->MessageRecv(MsgType1, MsgType2, decodedMsgPtr, pBuffer, nBytes);
         }
+        else
+        {
+            FreePerArena(pArena);
+        }
 
         // Skip to the next message in pBuffer
         decodeSizeLeft -= nBytes;
@@ -233,16 +247,37 @@ OSCL_EXPORT_REF void PER::Decode(uint8* pBuffer, uint32 size)
 }
 
 
+// ========================================================
+// Decode()
+//
+// Decodes one message.  With H245_PER_DECODE_ARENA the
+// message is decoded into an arena, returned in pArena,
+// which holds all of it.  Otherwise pArena is NULL and the
+// message must be freed with DeleteMessage().
+// ========================================================
 bool PER::Decode(int& nBytes, uint8* pBuffer, uint16& GetSize, uint8*& pData,
-                 uint8& MsgType1, uint8& MsgType2)
+                 uint8& MsgType1, uint8& MsgType2, PS_PerArena& pArena)
 {
     int32 leave_status = 0;
-    OSCL_TRY(leave_status, nBytes = MultiSysCtrlMessage_decode(pBuffer, &GetSize,
+    S_InStream stream;
+
+    stream.data = pBuffer;
+    stream.bitIndex = 0;
+    stream.arena = NULL;
+#if H245_PER_DECODE_ARENA
+    OSCL_TRY(leave_status, stream.arena = NewPerArena();
+             nBytes = MultiSysCtrlMessage_decode(&stream, &GetSize,
+                                                 &pData, &MsgType1, &MsgType2));
+#else
+    OSCL_TRY(leave_status, nBytes = MultiSysCtrlMessage_decode(&stream, &GetSize,
                                     &pData, &MsgType1, &MsgType2));
+#endif
     OSCL_FIRST_CATCH_ANY(leave_status,
                          PVLOGGER_LOGMSG(PVLOGMSG_INST_LLDBG, MyLogger, PVLOGMSG_ERR, (0, "PER::Decode - caught LEAVE during decode"));
+                         FreePerArena(stream.arena);
                          return false;
                         );
+    pArena = stream.arena;
     return true;
 }
 // ========================================================
@@ -761,17 +796,14 @@ void PER::IndicationMessage_encode(uint8* pDataIn,
 // MultiSysCtrlMessage_decode()
 //
 // ========================================================
-int PER::MultiSysCtrlMessage_decode(uint8*  pDataIn,
+int PER::MultiSysCtrlMessage_decode(PS_InStream stream,
                                     uint16* pGetSize,
                                     uint8*  *ppDataOut,
                                     uint8*  pType1,
                                     uint8*  pType2)
 {
-    PS_InStream stream;
+    uint8* pDataIn = stream->data;
 
-    stream = (PS_InStream) OSCL_DEFAULT_MALLOC(sizeof(S_InStream));
-    stream->bitIndex = 0;
-    stream->data = pDataIn;
     *pType1 = (uint8)GetChoiceIndex(4, 1, stream);
     switch (*pType1)
     {
@@ -796,7 +828,6 @@ int PER::MultiSysCtrlMessage_decode(uint8*  pDataIn,
     }
     ReadRemainingBits(stream);
     *pGetSize = (uint16)(stream->data - pDataIn);
-    OSCL_DEFAULT_FREE(stream);
     return *pGetSize;
 }
 
@@ -810,47 +841,47 @@ void PER::RequestMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream st
     switch (*pType2)
     {
         case 0:
-            *ppDataOut = (uint8*) OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            *ppDataOut = (uint8*) PerDecodeAlloc(sizeof(S_NonStandardMessage), stream);
             Decode_NonStandardMessage((PS_NonStandardMessage) *ppDataOut, stream);
             break;
         case 1:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MasterSlaveDetermination));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MasterSlaveDetermination), stream);
             Decode_MasterSlaveDetermination((PS_MasterSlaveDetermination) *ppDataOut, stream);
             break;
         case 2:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCapabilitySet));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_TerminalCapabilitySet), stream);
             Decode_TerminalCapabilitySet((PS_TerminalCapabilitySet) *ppDataOut, stream);
             break;
         case 3:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_OpenLogicalChannel));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_OpenLogicalChannel), stream);
             Decode_OpenLogicalChannel((PS_OpenLogicalChannel) *ppDataOut, stream);
             break;
         case 4:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_CloseLogicalChannel));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_CloseLogicalChannel), stream);
             Decode_CloseLogicalChannel((PS_CloseLogicalChannel) *ppDataOut, stream);
             break;
         case 5:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestChannelClose));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RequestChannelClose), stream);
             Decode_RequestChannelClose((PS_RequestChannelClose) *ppDataOut, stream);
             break;
         case 6:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultiplexEntrySend));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MultiplexEntrySend), stream);
             Decode_MultiplexEntrySend((PS_MultiplexEntrySend) *ppDataOut, stream);
             break;
         case 7:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestMultiplexEntry));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RequestMultiplexEntry), stream);
             Decode_RequestMultiplexEntry((PS_RequestMultiplexEntry) *ppDataOut, stream);
             break;
         case 8:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestMode));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RequestMode), stream);
             Decode_RequestMode((PS_RequestMode) *ppDataOut, stream);
             break;
         case 9:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RoundTripDelayRequest));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RoundTripDelayRequest), stream);
             Decode_RoundTripDelayRequest((PS_RoundTripDelayRequest) *ppDataOut, stream);
             break;
         case 10:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MaintenanceLoopRequest));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MaintenanceLoopRequest), stream);
             Decode_MaintenanceLoopRequest((PS_MaintenanceLoopRequest) *ppDataOut, stream);
             break;
             /* ------------------------------- */
@@ -858,25 +889,25 @@ void PER::RequestMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream st
             /* ------------------------------- */
         case 11:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_CommunicationModeRequest));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_CommunicationModeRequest), stream);
             Decode_CommunicationModeRequest((PS_CommunicationModeRequest) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 12:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceRequest));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_ConferenceRequest), stream);
             Decode_ConferenceRequest((PS_ConferenceRequest) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 13:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultilinkRequest));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MultilinkRequest), stream);
             Decode_MultilinkRequest((PS_MultilinkRequest) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 14:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_LogicalChannelRateRequest));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_LogicalChannelRateRequest), stream);
             Decode_LogicalChannelRateRequest((PS_LogicalChannelRateRequest) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
@@ -896,79 +927,79 @@ void PER::ResponseMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream s
     switch (*pType2)
     {
         case 0:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_NonStandardMessage), stream);
             Decode_NonStandardMessage((PS_NonStandardMessage) *ppDataOut, stream);
             break;
         case 1:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MasterSlaveDeterminationAck));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MasterSlaveDeterminationAck), stream);
             Decode_MasterSlaveDeterminationAck((PS_MasterSlaveDeterminationAck) *ppDataOut, stream);
             break;
         case 2:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MasterSlaveDeterminationReject));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MasterSlaveDeterminationReject), stream);
             Decode_MasterSlaveDeterminationReject((PS_MasterSlaveDeterminationReject) *ppDataOut, stream);
             break;
         case 3:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCapabilitySetAck));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_TerminalCapabilitySetAck), stream);
             Decode_TerminalCapabilitySetAck((PS_TerminalCapabilitySetAck) *ppDataOut, stream);
             break;
         case 4:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCapabilitySetReject));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_TerminalCapabilitySetReject), stream);
             Decode_TerminalCapabilitySetReject((PS_TerminalCapabilitySetReject) *ppDataOut, stream);
             break;
         case 5:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_OpenLogicalChannelAck));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_OpenLogicalChannelAck), stream);
             Decode_OpenLogicalChannelAck((PS_OpenLogicalChannelAck) *ppDataOut, stream);
             break;
         case 6:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_OpenLogicalChannelReject));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_OpenLogicalChannelReject), stream);
             Decode_OpenLogicalChannelReject((PS_OpenLogicalChannelReject) *ppDataOut, stream);
             break;
         case 7:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_CloseLogicalChannelAck));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_CloseLogicalChannelAck), stream);
             Decode_CloseLogicalChannelAck((PS_CloseLogicalChannelAck) *ppDataOut, stream);
             break;
         case 8:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestChannelCloseAck));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RequestChannelCloseAck), stream);
             Decode_RequestChannelCloseAck((PS_RequestChannelCloseAck) *ppDataOut, stream);
             break;
         case 9:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestChannelCloseReject));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RequestChannelCloseReject), stream);
             Decode_RequestChannelCloseReject((PS_RequestChannelCloseReject) *ppDataOut, stream);
             break;
         case 10:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultiplexEntrySendAck));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MultiplexEntrySendAck), stream);
             Decode_MultiplexEntrySendAck((PS_MultiplexEntrySendAck) *ppDataOut, stream);
             break;
         case 11:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultiplexEntrySendReject));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MultiplexEntrySendReject), stream);
             Decode_MultiplexEntrySendReject((PS_MultiplexEntrySendReject) *ppDataOut, stream);
             break;
         case 12:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestMultiplexEntryAck));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RequestMultiplexEntryAck), stream);
             Decode_RequestMultiplexEntryAck((PS_RequestMultiplexEntryAck) *ppDataOut, stream);
             break;
         case 13:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestMultiplexEntryReject));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RequestMultiplexEntryReject), stream);
             Decode_RequestMultiplexEntryReject((PS_RequestMultiplexEntryReject) *ppDataOut, stream);
             break;
         case 14:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestModeAck));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RequestModeAck), stream);
             Decode_RequestModeAck((PS_RequestModeAck) *ppDataOut, stream);
             break;
         case 15:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestModeReject));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RequestModeReject), stream);
             Decode_RequestModeReject((PS_RequestModeReject) *ppDataOut, stream);
             break;
         case 16:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RoundTripDelayResponse));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RoundTripDelayResponse), stream);
             Decode_RoundTripDelayResponse((PS_RoundTripDelayResponse) *ppDataOut, stream);
             break;
         case 17:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MaintenanceLoopAck));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MaintenanceLoopAck), stream);
             Decode_MaintenanceLoopAck((PS_MaintenanceLoopAck) *ppDataOut, stream);
             break;
         case 18:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MaintenanceLoopReject));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MaintenanceLoopReject), stream);
             Decode_MaintenanceLoopReject((PS_MaintenanceLoopReject) *ppDataOut, stream);
             break;
             /* ------------------------------- */
@@ -976,31 +1007,31 @@ void PER::ResponseMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream s
             /* ------------------------------- */
         case 19:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_CommunicationModeResponse));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_CommunicationModeResponse), stream);
             Decode_CommunicationModeResponse((PS_CommunicationModeResponse) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 20:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceResponse));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_ConferenceResponse), stream);
             Decode_ConferenceResponse((PS_ConferenceResponse) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 21:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultilinkResponse));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MultilinkResponse), stream);
             Decode_MultilinkResponse((PS_MultilinkResponse) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 22:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_LogicalChannelRateAcknowledge));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_LogicalChannelRateAcknowledge), stream);
             Decode_LogicalChannelRateAcknowledge((PS_LogicalChannelRateAcknowledge) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 23:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_LogicalChannelRateReject));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_LogicalChannelRateReject), stream);
             Decode_LogicalChannelRateReject((PS_LogicalChannelRateReject) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
@@ -1020,31 +1051,31 @@ void PER::CommandMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream st
     switch (*pType2)
     {
         case 0:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_NonStandardMessage), stream);
             Decode_NonStandardMessage((PS_NonStandardMessage) *ppDataOut, stream);
             break;
         case 1:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MaintenanceLoopOffCommand));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MaintenanceLoopOffCommand), stream);
             Decode_MaintenanceLoopOffCommand((PS_MaintenanceLoopOffCommand) *ppDataOut, stream);
             break;
         case 2:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_SendTerminalCapabilitySet));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_SendTerminalCapabilitySet), stream);
             Decode_SendTerminalCapabilitySet((PS_SendTerminalCapabilitySet) *ppDataOut, stream);
             break;
         case 3:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_EncryptionCommand));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_EncryptionCommand), stream);
             Decode_EncryptionCommand((PS_EncryptionCommand) *ppDataOut, stream);
             break;
         case 4:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_FlowControlCommand));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_FlowControlCommand), stream);
             Decode_FlowControlCommand((PS_FlowControlCommand) *ppDataOut, stream);
             break;
         case 5:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_EndSessionCommand));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_EndSessionCommand), stream);
             Decode_EndSessionCommand((PS_EndSessionCommand) *ppDataOut, stream);
             break;
         case 6:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MiscellaneousCommand));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MiscellaneousCommand), stream);
             Decode_MiscellaneousCommand((PS_MiscellaneousCommand) *ppDataOut, stream);
             break;
             /* ------------------------------- */
@@ -1052,25 +1083,25 @@ void PER::CommandMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream st
             /* ------------------------------- */
         case 7:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_CommunicationModeCommand));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_CommunicationModeCommand), stream);
             Decode_CommunicationModeCommand((PS_CommunicationModeCommand) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 8:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceCommand));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_ConferenceCommand), stream);
             Decode_ConferenceCommand((PS_ConferenceCommand) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 9:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_H223MultiplexReconfiguration));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_H223MultiplexReconfiguration), stream);
             Decode_H223MultiplexReconfiguration((PS_H223MultiplexReconfiguration) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 10:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_NewATMVCCommand));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_NewATMVCCommand), stream);
             Decode_NewATMVCCommand((PS_NewATMVCCommand) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
@@ -1090,59 +1121,59 @@ void PER::IndicationMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream
     switch (*pType2)
     {
         case 0:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_NonStandardMessage));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_NonStandardMessage), stream);
             Decode_NonStandardMessage((PS_NonStandardMessage) *ppDataOut, stream);
             break;
         case 1:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_FunctionNotUnderstood));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_FunctionNotUnderstood), stream);
             Decode_FunctionNotUnderstood((PS_FunctionNotUnderstood) *ppDataOut, stream);
             break;
         case 2:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MasterSlaveDeterminationRelease));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MasterSlaveDeterminationRelease), stream);
             Decode_MasterSlaveDeterminationRelease((PS_MasterSlaveDeterminationRelease) *ppDataOut, stream);
             break;
         case 3:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_TerminalCapabilitySetRelease));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_TerminalCapabilitySetRelease), stream);
             Decode_TerminalCapabilitySetRelease((PS_TerminalCapabilitySetRelease) *ppDataOut, stream);
             break;
         case 4:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_OpenLogicalChannelConfirm));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_OpenLogicalChannelConfirm), stream);
             Decode_OpenLogicalChannelConfirm((PS_OpenLogicalChannelConfirm) *ppDataOut, stream);
             break;
         case 5:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestChannelCloseRelease));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RequestChannelCloseRelease), stream);
             Decode_RequestChannelCloseRelease((PS_RequestChannelCloseRelease) *ppDataOut, stream);
             break;
         case 6:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultiplexEntrySendRelease));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MultiplexEntrySendRelease), stream);
             Decode_MultiplexEntrySendRelease((PS_MultiplexEntrySendRelease) *ppDataOut, stream);
             break;
         case 7:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestMultiplexEntryRelease));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RequestMultiplexEntryRelease), stream);
             Decode_RequestMultiplexEntryRelease((PS_RequestMultiplexEntryRelease) *ppDataOut, stream);
             break;
         case 8:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_RequestModeRelease));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_RequestModeRelease), stream);
             Decode_RequestModeRelease((PS_RequestModeRelease) *ppDataOut, stream);
             break;
         case 9:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MiscellaneousIndication));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MiscellaneousIndication), stream);
             Decode_MiscellaneousIndication((PS_MiscellaneousIndication) *ppDataOut, stream);
             break;
         case 10:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_JitterIndication));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_JitterIndication), stream);
             Decode_JitterIndication((PS_JitterIndication) *ppDataOut, stream);
             break;
         case 11:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_H223SkewIndication));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_H223SkewIndication), stream);
             Decode_H223SkewIndication((PS_H223SkewIndication) *ppDataOut, stream);
             break;
         case 12:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_NewATMVCIndication));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_NewATMVCIndication), stream);
             Decode_NewATMVCIndication((PS_NewATMVCIndication) *ppDataOut, stream);
             break;
         case 13:
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_UserInputIndication));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_UserInputIndication), stream);
             Decode_UserInputIndication((PS_UserInputIndication) *ppDataOut, stream);
             break;
             /* ------------------------------- */
@@ -1150,49 +1181,49 @@ void PER::IndicationMessage_decode(uint8* *ppDataOut, uint8* pType2, PS_InStream
             /* ------------------------------- */
         case 14:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_H2250MaximumSkewIndication));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_H2250MaximumSkewIndication), stream);
             Decode_H2250MaximumSkewIndication((PS_H2250MaximumSkewIndication) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 15:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MCLocationIndication));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MCLocationIndication), stream);
             Decode_MCLocationIndication((PS_MCLocationIndication) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 16:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_ConferenceIndication));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_ConferenceIndication), stream);
             Decode_ConferenceIndication((PS_ConferenceIndication) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 17:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_VendorIdentification));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_VendorIdentification), stream);
             Decode_VendorIdentification((PS_VendorIdentification) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 18:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_FunctionNotSupported));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_FunctionNotSupported), stream);
             Decode_FunctionNotSupported((PS_FunctionNotSupported) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 19:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_MultilinkIndication));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_MultilinkIndication), stream);
             Decode_MultilinkIndication((PS_MultilinkIndication) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 20:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_LogicalChannelRateRelease));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_LogicalChannelRateRelease), stream);
             Decode_LogicalChannelRateRelease((PS_LogicalChannelRateRelease) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
         case 21:
             GetLengthDet(stream);
-            *ppDataOut = (uint8*)OSCL_DEFAULT_MALLOC(sizeof(S_FlowControlIndication));
+            *ppDataOut = (uint8*)PerDecodeAlloc(sizeof(S_FlowControlIndication), stream);
             Decode_FlowControlIndication((PS_FlowControlIndication) *ppDataOut, stream);
             ReadRemainingBits(stream);
             break;
@@ -58,6 +58,21 @@
 #include "oscl_priqueue.h"
 #endif
 
+/*
+ * Set PVMF_MEDIA_CLOCK_TIMER_WHEEL to 1 to hold the regular and forward NPT
+ * callback timers in a timer wheel instead of a priority queue.  This makes
+ * setting and canceling a callback O(1) when there are many callbacks.
+ */
+#ifndef PVMF_MEDIA_CLOCK_TIMER_WHEEL
+#define PVMF_MEDIA_CLOCK_TIMER_WHEEL 0
+#endif
+
+#if PVMF_MEDIA_CLOCK_TIMER_WHEEL
+#ifndef OSCL_TIMER_WHEEL_H_INCLUDED
+#include "oscl_timer_wheel.h"
+#endif
+#endif
+
 #ifndef OSCL_SCHEDULER_AO_H_INCLUDED
 #include "oscl_scheduler_ao.h"
 #endif
@@ -1157,6 +1172,70 @@ class PVMFMediaClockTimerQueueCompareLessForNPTBackwards
         }
 };
 
+#if PVMF_MEDIA_CLOCK_TIMER_WHEEL
+/*This is one callback element in a PVMFMediaClockTimerWheel*/
+class PVMFMediaClockTimerWheelNode
+{
+    public:
+        OsclTimerWheelLink iLink;
+        PVMFMediaClockTimerQueueElement iElement;
+        PVMFMediaClockTimerWheelNode* iHashNext;
+};
+
+/*This is the comparison class supplied to PVMFMediaClock's timer wheels.
+Equal times are sorted by callback ID, so callbacks set first are made first*/
+class PVMFMediaClockTimerWheelCompareLess
+{
+    public:
+        int compare(OsclTimerWheelLink& a, OsclTimerWheelLink& b) const
+        {
+            if (a.iTime != b.iTime)
+            {
+                uint32 delta = 0;
+                return PVTimeComparisonUtils::IsEarlier(b.iTime, a.iTime, delta);
+            }
+            return (((PVMFMediaClockTimerWheelNode*)a.iOwner)->iElement.callBackID
+                    > ((PVMFMediaClockTimerWheelNode*)b.iOwner)->iElement.callBackID);
+        }
+};
+
+#define PVMF_MEDIA_CLOCK_TIMER_WHEEL_HASH_SIZE 64
+
+/*This is a timer queue with the same interface as the priority queues used in PVMFMediaClock,
+backed by a timer wheel.  Elements are looked up by callback ID for removal.*/
+class PVMFMediaClockTimerWheel
+{
+    public:
+        PVMFMediaClockTimerWheel();
+        ~PVMFMediaClockTimerWheel();
+
+        bool empty() const
+        {
+            return iWheel.Empty();
+        }
+        uint32 size() const
+        {
+            return iWheel.Size();
+        }
+        const PVMFMediaClockTimerQueueElement& top();
+        void pop();
+        void push(const PVMFMediaClockTimerQueueElement& aElement);
+        //Remove an element by callback ID. Returns number of items removed(either 0 or 1).
+        int remove(const PVMFMediaClockTimerQueueElement& aElement);
+        //Return a copy of all elements, in no particular order.
+        const Oscl_Vector<PVMFMediaClockTimerQueueElement, OsclMemAllocator>& vec();
+
+    private:
+        void Release(PVMFMediaClockTimerWheelNode* aNode, PVMFMediaClockTimerWheelNode* aPrev);
+
+        OsclTimerWheel<PVMFMediaClockTimerWheelCompareLess> iWheel;
+        PVMFMediaClockTimerWheelNode* iHash[PVMF_MEDIA_CLOCK_TIMER_WHEEL_HASH_SIZE];
+        PVMFMediaClockTimerWheelNode* iFreeList;
+        OsclMemAllocator iAlloc;
+        Oscl_Vector<PVMFMediaClockTimerQueueElement, OsclMemAllocator> iVec;
+        PVMFMediaClockTimerQueueElement iEmptyElement;
+};
+#endif
 
 class PVMFMediaClock :  public OsclTimerObject,
         public PVMFTimebase,
@@ -1495,8 +1574,12 @@ class PVMFMediaClock :  public OsclTimerObject,
 
         //callback related functions, members
 
+#if PVMF_MEDIA_CLOCK_TIMER_WHEEL
+        PVMFMediaClockTimerWheel iTimersPriQueue;
+#else
         OsclPriorityQueue < PVMFMediaClockTimerQueueElement, OsclMemAllocator, Oscl_Vector<PVMFMediaClockTimerQueueElement, OsclMemAllocator>,
         PVMFMediaClockTimerQueueCompareLess > iTimersPriQueue;
+#endif
 
         //Mutex for multithreading support
         OsclMutex *iMutex;
@@ -1548,8 +1631,12 @@ class PVMFMediaClock :  public OsclTimerObject,
         void CalculateRunLTimerValue(bool aIsNPT, uint32 aCurrentTime, int32& aDelta);
 
         //NPT callbacks related members
+#if PVMF_MEDIA_CLOCK_TIMER_WHEEL
+        PVMFMediaClockTimerWheel iTimersPriQueueNPT;
+#else
         OsclPriorityQueue < PVMFMediaClockTimerQueueElement, OsclMemAllocator, Oscl_Vector<PVMFMediaClockTimerQueueElement, OsclMemAllocator>,
         PVMFMediaClockTimerQueueCompareLess > iTimersPriQueueNPT;
+#endif
 
         OsclPriorityQueue < PVMFMediaClockTimerQueueElement, OsclMemAllocator, Oscl_Vector<PVMFMediaClockTimerQueueElement, OsclMemAllocator>,
         PVMFMediaClockTimerQueueCompareLessForNPTBackwards > iTimersPriQueueNPTBackwards;
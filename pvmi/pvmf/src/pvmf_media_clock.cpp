@@ -2219,3 +2219,130 @@ OSCL_EXPORT_REF void PVMFTimebase_Tickcount::GetCurrentTime32(uint32& aTime, boo
     // Save the current tickcount for next comparison
     iPrevTickcount = currenttickcount;
 }
+
+#if PVMF_MEDIA_CLOCK_TIMER_WHEEL
+PVMFMediaClockTimerWheel::PVMFMediaClockTimerWheel()
+{
+    for (uint32 ii = 0; ii < PVMF_MEDIA_CLOCK_TIMER_WHEEL_HASH_SIZE; ii++)
+    {
+        iHash[ii] = NULL;
+    }
+    iFreeList = NULL;
+    oscl_memset(&iEmptyElement, 0, sizeof(iEmptyElement));
+}
+
+PVMFMediaClockTimerWheel::~PVMFMediaClockTimerWheel()
+{
+    PVMFMediaClockTimerWheelNode* node;
+    for (uint32 ii = 0; ii < PVMF_MEDIA_CLOCK_TIMER_WHEEL_HASH_SIZE; ii++)
+    {
+        while (iHash[ii])
+        {
+            node = iHash[ii];
+            iHash[ii] = node->iHashNext;
+            iWheel.Remove(&node->iLink);
+            node->~PVMFMediaClockTimerWheelNode();
+            iAlloc.deallocate(node);
+        }
+    }
+    while (iFreeList)
+    {
+        node = iFreeList;
+        iFreeList = node->iHashNext;
+        node->~PVMFMediaClockTimerWheelNode();
+        iAlloc.deallocate(node);
+    }
+}
+
+const PVMFMediaClockTimerQueueElement& PVMFMediaClockTimerWheel::top()
+{
+    OsclTimerWheelLink* link = iWheel.Top();
+    if (!link)
+    {
+        return iEmptyElement;
+    }
+    return ((PVMFMediaClockTimerWheelNode*)link->iOwner)->iElement;
+}
+
+void PVMFMediaClockTimerWheel::pop()
+{
+    OsclTimerWheelLink* link = iWheel.Top();
+    if (link)
+    {
+        remove(((PVMFMediaClockTimerWheelNode*)link->iOwner)->iElement);
+    }
+}
+
+void PVMFMediaClockTimerWheel::push(const PVMFMediaClockTimerQueueElement& aElement)
+{
+    //reuse a free node if there is one.
+    PVMFMediaClockTimerWheelNode* node = iFreeList;
+    if (node)
+    {
+        iFreeList = node->iHashNext;
+    }
+    else
+    {
+        OsclAny* ptr = iAlloc.ALLOCATE(sizeof(PVMFMediaClockTimerWheelNode));
+        node = OSCL_PLACEMENT_NEW(ptr, PVMFMediaClockTimerWheelNode());
+    }
+
+    node->iElement = aElement;
+    node->iLink.iTime = aElement.timeOut;
+    node->iLink.iOwner = node;
+
+    uint32 bucket = aElement.callBackID & (PVMF_MEDIA_CLOCK_TIMER_WHEEL_HASH_SIZE - 1);
+    node->iHashNext = iHash[bucket];
+    iHash[bucket] = node;
+
+    iWheel.Add(&node->iLink);
+}
+
+int PVMFMediaClockTimerWheel::remove(const PVMFMediaClockTimerQueueElement& aElement)
+{
+    //callback IDs are sequential, so the hash chains are short.
+    uint32 bucket = aElement.callBackID & (PVMF_MEDIA_CLOCK_TIMER_WHEEL_HASH_SIZE - 1);
+    PVMFMediaClockTimerWheelNode* prev = NULL;
+    for (PVMFMediaClockTimerWheelNode* node = iHash[bucket]; node; node = node->iHashNext)
+    {
+        if (node->iElement == aElement)
+        {
+            Release(node, prev);
+            return 1;
+        }
+        prev = node;
+    }
+    return 0;
+}
+
+const Oscl_Vector<PVMFMediaClockTimerQueueElement, OsclMemAllocator>& PVMFMediaClockTimerWheel::vec()
+{
+    iVec.clear();
+    for (uint32 ii = 0; ii < PVMF_MEDIA_CLOCK_TIMER_WHEEL_HASH_SIZE; ii++)
+    {
+        for (PVMFMediaClockTimerWheelNode* node = iHash[ii]; node; node = node->iHashNext)
+        {
+            iVec.push_back(node->iElement);
+        }
+    }
+    return iVec;
+}
+
+void PVMFMediaClockTimerWheel::Release(PVMFMediaClockTimerWheelNode* aNode, PVMFMediaClockTimerWheelNode* aPrev)
+{
+    uint32 bucket = aNode->iElement.callBackID & (PVMF_MEDIA_CLOCK_TIMER_WHEEL_HASH_SIZE - 1);
+    if (aPrev)
+    {
+        aPrev->iHashNext = aNode->iHashNext;
+    }
+    else
+    {
+        iHash[bucket] = aNode->iHashNext;
+    }
+
+    iWheel.Remove(&aNode->iLink);
+
+    aNode->iHashNext = iFreeList;
+    iFreeList = aNode;
+}
+#endif